@@ -0,0 +1,78 @@
+//===-- BatchingOperatorBenchmark.cpp - Benchmarks --------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Measures the cost of switching between the tuple-at-a-time and the
+/// batch-at-a-time protocol: `BM_Batching` consumes a scan over two columns of
+/// `int64_t` through `BatchingOperator` batch by batch, and `BM_Unbatching`
+/// consumes the batches of a scan through `UnbatchingOperator` tuple by tuple.
+/// Both sum up all values for input sizes from L1-resident to DRAM-resident.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/BatchingOperator.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/UnbatchingOperator.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+void BM_Batching(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeSequence(numRows);
+  const std::vector<int64_t> column2 = makeUniformKeys(numRows, 1 << 20);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    auto batching = makeBatchingOperator(&scan);
+    batching.open();
+    int64_t sum = 0;
+    typename decltype(batching)::BatchType batch;
+    while (batching.computeNextBatch(batch))
+      for (size_t i = 0; i < batch.size(); i++)
+        sum += std::get<0>(batch.get(i)) + std::get<1>(batch.get(i));
+    batching.close();
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+void BM_Unbatching(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeSequence(numRows);
+  const std::vector<int64_t> column2 = makeUniformKeys(numRows, 1 << 20);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    auto unbatching = makeUnbatchingOperator(&scan);
+    unbatching.open();
+    int64_t sum = 0;
+    while (auto const tuple = unbatching.computeNext())
+      sum += std::get<0>(*tuple) + std::get<1>(*tuple);
+    unbatching.close();
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+} // namespace
+
+// From 16 KiB (L1-resident) to 64 MiB (DRAM-resident) of input data.
+BENCHMARK(BM_Batching)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Unbatching)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
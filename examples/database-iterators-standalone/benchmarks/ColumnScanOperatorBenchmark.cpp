@@ -0,0 +1,85 @@
+//===-- ColumnScanOperatorBenchmark.cpp - Benchmarks of scans ---*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Compares the owning `ColumnScanOperator` with the borrowing
+/// `ColumnViewScanOperator` by scanning two columns of `int64_t` and summing
+/// up their values. Each iteration includes the construction of the operator,
+/// i.e., the copy of the input in the case of the owning operator. The counter
+/// `OwnedBytes` reports how much memory each operator holds in addition to
+/// the input.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnScanOperator.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+
+using namespace database_iterators::operators;
+
+namespace {
+
+/// Consumes all tuples of the given operator and returns the sum of all of
+/// their fields.
+template <typename OperatorType>
+int64_t sumAll(OperatorType &scan) {
+  int64_t sum = 0;
+  scan.open();
+  while (auto tuple = scan.computeNext())
+    sum += std::get<0>(*tuple) + std::get<1>(*tuple);
+  scan.close();
+  return sum;
+}
+
+std::vector<int64_t> makeColumn(size_t numRows, int64_t first) {
+  std::vector<int64_t> column(numRows);
+  std::iota(column.begin(), column.end(), first);
+  return column;
+}
+
+void BM_ColumnScan(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeColumn(numRows, 0);
+  const std::vector<int64_t> column2 = makeColumn(numRows, 1);
+
+  for (auto _ : state) {
+    auto scan = makeColumnScanOperator(column1, column2);
+    benchmark::DoNotOptimize(sumAll(scan));
+  }
+
+  const int64_t bytesPerIteration = 2 * numRows * sizeof(int64_t);
+  state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+  state.counters["OwnedBytes"] = static_cast<double>(bytesPerIteration);
+}
+
+void BM_ColumnViewScan(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeColumn(numRows, 0);
+  const std::vector<int64_t> column2 = makeColumn(numRows, 1);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    benchmark::DoNotOptimize(sumAll(scan));
+  }
+
+  const int64_t bytesPerIteration = 2 * numRows * sizeof(int64_t);
+  state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+  state.counters["OwnedBytes"] = 0;
+}
+
+} // namespace
+
+// From 16 KiB (L1-resident) to 256 MiB (DRAM-resident) of input data.
+BENCHMARK(BM_ColumnScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_ColumnViewScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
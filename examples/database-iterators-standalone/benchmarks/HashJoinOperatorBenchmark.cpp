@@ -0,0 +1,176 @@
+//===-- HashJoinOperatorBenchmark.cpp - Hash join benchmarks ----*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Joins two inputs of `int64_t` key/value pairs of the same size, where each
+/// key of the build side occurs twice and each probe-side tuple thus has two
+/// matches. The probe-side keys are a permutation of the build-side keys such
+/// that the lookups access the hash table in random order. The second variant
+/// passes the size of the build side to the operator, which avoids growing the
+/// hash table during the build. The third variant allocates the hash table from
+/// a `utils::Arena` that is created and destroyed in each iteration.
+/// `BM_HashJoinZipf` joins a build side with unique keys with a probe side
+/// whose keys follow Zipf distributions with increasing skew (in hundredths),
+/// such that the hash table lookups concentrate on few cache-resident entries.
+/// `BM_PartitionedHashJoin` runs the first join with
+/// `PartitionedHashJoinOperator` on a varying number of threads, and
+/// `BM_SortMergeJoin` sorts both inputs with `SortOperator` and joins them with
+/// `MergeJoinOperator`.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/HashJoinOperator.h"
+#include "database-iterators/Operators/MergeJoinOperator.h"
+#include "database-iterators/Operators/PartitionedHashJoinOperator.h"
+#include "database-iterators/Operators/SortOperator.h"
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/ThreadPool.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+/// Key and value columns of both inputs.
+struct JoinInput {
+  explicit JoinInput(int64_t numRows)
+      : buildKeys(numRows), buildValues(numRows), probeKeys(numRows),
+        probeValues(numRows) {
+    for (int64_t i = 0; i < numRows; i++) {
+      buildKeys[i] = i / 2;
+      buildValues[i] = i;
+      // 7919 is prime and hence coprime with the power-of-two sizes
+      probeKeys[i] = (i * 7919) % numRows / 2;
+      probeValues[i] = i;
+    }
+  }
+
+  std::vector<int64_t> buildKeys;
+  std::vector<int64_t> buildValues;
+  std::vector<int64_t> probeKeys;
+  std::vector<int64_t> probeValues;
+};
+
+/// Consumes all tuples of the given join and returns the sum of their values.
+template <typename OperatorType>
+int64_t sumValues(OperatorType &hashJoin) {
+  hashJoin.open();
+  int64_t sum = 0;
+  while (auto const tuple = hashJoin.computeNext())
+    sum += std::get<1>(*tuple) + std::get<2>(*tuple);
+  hashJoin.close();
+  return sum;
+}
+
+void runHashJoin(benchmark::State &state, bool useSizeHint, bool useArena) {
+  const auto numRows = static_cast<int64_t>(state.range(0));
+  const JoinInput input(numRows);
+  auto const &[buildKeys, buildValues, probeKeys, probeValues] = input;
+
+  for (auto _ : state) {
+    database_iterators::utils::Arena arena;
+    auto buildScan = makeColumnViewScanOperator(buildKeys, buildValues);
+    auto probeScan = makeColumnViewScanOperator(probeKeys, probeValues);
+    auto hashJoin = makeHashJoinOperator<1>(&buildScan, &probeScan,
+                                            useSizeHint ? numRows : 0,
+                                            useArena ? &arena : nullptr);
+    benchmark::DoNotOptimize(sumValues(hashJoin));
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * numRows);
+}
+
+void BM_HashJoin(benchmark::State &state) {
+  runHashJoin(state, false, false);
+}
+
+void BM_HashJoinWithSizeHint(benchmark::State &state) {
+  runHashJoin(state, true, false);
+}
+
+void BM_HashJoinWithArena(benchmark::State &state) {
+  runHashJoin(state, false, true);
+}
+
+void BM_HashJoinZipf(benchmark::State &state) {
+  const auto numRows = static_cast<int64_t>(state.range(0));
+  const double skew = static_cast<double>(state.range(1)) / 100;
+  const std::vector<int64_t> buildKeys = makeSequence(numRows);
+  const std::vector<int64_t> buildValues = makeSequence(numRows);
+  const std::vector<int64_t> probeKeys = makeZipfKeys(numRows, numRows, skew);
+  const std::vector<int64_t> probeValues = makeSequence(numRows);
+
+  for (auto _ : state) {
+    auto buildScan = makeColumnViewScanOperator(buildKeys, buildValues);
+    auto probeScan = makeColumnViewScanOperator(probeKeys, probeValues);
+    auto hashJoin = makeHashJoinOperator<1>(&buildScan, &probeScan, numRows);
+    benchmark::DoNotOptimize(sumValues(hashJoin));
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * numRows);
+}
+
+void BM_PartitionedHashJoin(benchmark::State &state) {
+  const auto numRows = static_cast<int64_t>(state.range(0));
+  const JoinInput input(numRows);
+  auto const &[buildKeys, buildValues, probeKeys, probeValues] = input;
+  database_iterators::utils::ThreadPool pool(state.range(1));
+
+  for (auto _ : state) {
+    auto buildScan = makeColumnViewScanOperator(buildKeys, buildValues);
+    auto probeScan = makeColumnViewScanOperator(probeKeys, probeValues);
+    auto hashJoin =
+        makePartitionedHashJoinOperator<1>(&buildScan, &probeScan, &pool);
+    benchmark::DoNotOptimize(sumValues(hashJoin));
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * numRows);
+}
+
+void BM_SortMergeJoin(benchmark::State &state) {
+  const auto numRows = static_cast<int64_t>(state.range(0));
+  const JoinInput input(numRows);
+  auto const &[buildKeys, buildValues, probeKeys, probeValues] = input;
+
+  for (auto _ : state) {
+    auto leftScan = makeColumnViewScanOperator(buildKeys, buildValues);
+    auto rightScan = makeColumnViewScanOperator(probeKeys, probeValues);
+    auto leftSort = makeSortOperator<1>(&leftScan);
+    auto rightSort = makeSortOperator<1>(&rightScan);
+    auto mergeJoin = makeMergeJoinOperator<1>(&leftSort, &rightSort);
+    benchmark::DoNotOptimize(sumValues(mergeJoin));
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * numRows);
+}
+
+} // namespace
+
+BENCHMARK(BM_HashJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_HashJoinWithSizeHint)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_HashJoinWithArena)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_HashJoinZipf)
+    ->ArgNames({"rows", "skew"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 22, 64),
+                   benchmark::CreateDenseRange(0, 150, 50)});
+BENCHMARK(BM_SortMergeJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PartitionedHashJoin)
+    ->ArgNames({"rows", "threads"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 22, 8),
+                   benchmark::CreateRange(1, 16, 4)})
+    ->UseRealTime();
@@ -0,0 +1,108 @@
+//===-- InputGenerators.h - Benchmark input generators ----------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_BENCHMARKS_INPUTGENERATORS_H
+#define ITERATORS_BENCHMARKS_INPUTGENERATORS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace database_iterators::benchmarks {
+
+/// Seed of the inputs of all benchmarks. Since the generators below do not
+/// depend on the standard library implementation, the same seed yields the
+/// same inputs on every platform, such that other implementations of a query
+/// (e.g., compiled iterator plans) can be measured on identical data.
+inline constexpr std::uint64_t kDefaultSeed = 42;
+
+/// Small and fast pseudo-random number generator (SplitMix64) with
+/// well-defined output for a given seed.
+class RandomNumberGenerator {
+public:
+  explicit RandomNumberGenerator(std::uint64_t seed = kDefaultSeed)
+      : state(seed) {}
+
+  /// Returns the next pseudo-random 64-bit number.
+  std::uint64_t next() {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  /// Returns a pseudo-random number uniformly distributed in [0, bound).
+  std::uint64_t nextBelow(std::uint64_t bound) {
+    // Multiply-shift range reduction; the bias is negligible for our bounds
+    return static_cast<std::uint64_t>(
+        (static_cast<unsigned __int128>(next()) * bound) >> 64);
+  }
+
+  /// Returns a pseudo-random number uniformly distributed in [0, 1).
+  double nextDouble() { return static_cast<double>(next() >> 11) * 0x1p-53; }
+
+private:
+  std::uint64_t state;
+};
+
+/// Returns `numRows` keys drawn uniformly at random from [0, numDistinct).
+inline std::vector<std::int64_t>
+makeUniformKeys(std::size_t numRows, std::int64_t numDistinct,
+                std::uint64_t seed = kDefaultSeed) {
+  assert(numDistinct > 0 && "key domain must not be empty");
+  RandomNumberGenerator generator(seed);
+  std::vector<std::int64_t> keys(numRows);
+  for (auto &key : keys)
+    key = static_cast<std::int64_t>(
+        generator.nextBelow(static_cast<std::uint64_t>(numDistinct)));
+  return keys;
+}
+
+/// Returns `numRows` keys from [0, numDistinct) drawn from a Zipf
+/// distribution with the given exponent, i.e., key `k` has a probability
+/// proportional to 1 / (k + 1)^skew. A skew of 0 yields uniformly distributed
+/// keys; with a skew of 1, the most frequent key of 1M distinct keys makes up
+/// about 7% of the rows. The keys are drawn by inverting the cumulative
+/// distribution function, which is precomputed for all keys.
+inline std::vector<std::int64_t>
+makeZipfKeys(std::size_t numRows, std::int64_t numDistinct, double skew,
+             std::uint64_t seed = kDefaultSeed) {
+  assert(numDistinct > 0 && "key domain must not be empty");
+  std::vector<double> cumulativeWeights(static_cast<std::size_t>(numDistinct));
+  double totalWeight = 0;
+  for (std::size_t k = 0; k < cumulativeWeights.size(); k++) {
+    totalWeight += std::pow(static_cast<double>(k + 1), -skew);
+    cumulativeWeights[k] = totalWeight;
+  }
+
+  RandomNumberGenerator generator(seed);
+  std::vector<std::int64_t> keys(numRows);
+  for (auto &key : keys) {
+    auto const weight = generator.nextDouble() * totalWeight;
+    auto const it = std::upper_bound(cumulativeWeights.begin(),
+                                     cumulativeWeights.end(), weight);
+    key = std::min<std::int64_t>(it - cumulativeWeights.begin(),
+                                 numDistinct - 1);
+  }
+  return keys;
+}
+
+/// Returns the column 0, 1, ..., numRows - 1.
+inline std::vector<std::int64_t> makeSequence(std::size_t numRows) {
+  std::vector<std::int64_t> column(numRows);
+  for (std::size_t i = 0; i < numRows; i++)
+    column[i] = static_cast<std::int64_t>(i);
+  return column;
+}
+
+} // namespace database_iterators::benchmarks
+
+#endif // ITERATORS_BENCHMARKS_INPUTGENERATORS_H
@@ -0,0 +1,73 @@
+//===-- MapOperatorBenchmark.cpp - Benchmarks -------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Maps two columns of `int64_t` to a single one with a cheap arithmetic
+/// expression and sums up the result for input sizes from L1-resident to
+/// DRAM-resident, using either the tuple-at-a-time or the batch-at-a-time
+/// protocol.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/MapOperator.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+template <bool kUseBatches>
+void runMap(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeSequence(numRows);
+  const std::vector<int64_t> column2 = makeUniformKeys(numRows, 1 << 20);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    auto map = makeMapOperator(&scan, [](auto tuple) {
+      return std::make_tuple(std::get<0>(tuple) * 3 + std::get<1>(tuple));
+    });
+    map.open();
+    int64_t sum = 0;
+    if constexpr (kUseBatches) {
+      typename decltype(map)::BatchType batch;
+      while (map.computeNextBatch(batch))
+        for (size_t i = 0; i < batch.size(); i++)
+          sum += std::get<0>(batch.get(i));
+    } else {
+      while (auto const tuple = map.computeNext())
+        sum += std::get<0>(*tuple);
+    }
+    map.close();
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+void BM_MapTupleAtATime(benchmark::State &state) {
+  runMap</*kUseBatches=*/false>(state);
+}
+
+void BM_MapBatchAtATime(benchmark::State &state) {
+  runMap</*kUseBatches=*/true>(state);
+}
+
+} // namespace
+
+// From 16 KiB (L1-resident) to 64 MiB (DRAM-resident) of input data.
+BENCHMARK(BM_MapTupleAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_MapBatchAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
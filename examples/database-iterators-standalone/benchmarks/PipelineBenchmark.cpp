@@ -0,0 +1,131 @@
+//===-- PipelineBenchmark.cpp - Benchmarks of pipelines ---------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Compares the tuple-at-a-time protocol (`computeNext`) with the
+/// batch-at-a-time protocol (`computeNextBatch`) on the pipeline
+/// scan -> filter -> map -> reduce over two columns of `int64_t`. The filter
+/// lets pass roughly half of the tuples. Since the compiler inlines the
+/// `computeNext` calls of the whole pipeline into a single loop, the batches
+/// only pay off while their copies stay cheap compared to the per-tuple work,
+/// i.e., for cache-resident inputs in this pipeline. `BM_PipelineMorselDriven`
+/// runs the tuple-at-a-time pipeline on the morsels of a
+/// `ParallelColumnScanOperator` with a varying number of threads and serves as
+/// the multi-threaded reference point for compiled query plans.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/FilterOperator.h"
+#include "database-iterators/Operators/MapOperator.h"
+#include "database-iterators/Operators/ParallelColumnScanOperator.h"
+#include "database-iterators/Operators/ReduceOperator.h"
+#include "database-iterators/Utils/PipelineDriver.h"
+#include "database-iterators/Utils/ThreadPool.h"
+
+using namespace database_iterators::operators;
+
+namespace {
+
+std::vector<int64_t> makeColumn(size_t numRows, int64_t first) {
+  std::vector<int64_t> column(numRows);
+  std::iota(column.begin(), column.end(), first);
+  return column;
+}
+
+/// Builds the benchmarked pipeline on top of the given scan and passes its
+/// root to `consume`.
+template <typename ScanType, typename ConsumerType>
+int64_t runPipeline(ScanType &scan, ConsumerType consume) {
+  auto filter = makeFilterOperator(&scan, [](auto tuple) {
+    return (std::get<0>(tuple) ^ std::get<1>(tuple)) & 2;
+  });
+  auto map = makeMapOperator(&filter, [](auto tuple) {
+    return std::make_tuple(std::get<0>(tuple) * 3 + std::get<1>(tuple));
+  });
+  auto reduce = makeReduceOperator(&map, [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  });
+  reduce.open();
+  auto const result = consume(reduce);
+  reduce.close();
+  return result;
+}
+
+void BM_PipelineTupleAtATime(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeColumn(numRows, 0);
+  const std::vector<int64_t> column2 = makeColumn(numRows, 1);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    benchmark::DoNotOptimize(runPipeline(scan, [](auto &root) {
+      auto const tuple = root.computeNext();
+      return tuple ? std::get<0>(tuple.value()) : 0;
+    }));
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+void BM_PipelineBatchAtATime(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeColumn(numRows, 0);
+  const std::vector<int64_t> column2 = makeColumn(numRows, 1);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    benchmark::DoNotOptimize(runPipeline(scan, [](auto &root) {
+      typename std::remove_reference_t<decltype(root)>::BatchType batch;
+      return root.computeNextBatch(batch) ? std::get<0>(batch.get(0)) : 0;
+    }));
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+void BM_PipelineMorselDriven(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeColumn(numRows, 0);
+  const std::vector<int64_t> column2 = makeColumn(numRows, 1);
+  database_iterators::utils::ThreadPool pool(state.range(1));
+
+  for (auto _ : state) {
+    auto scan =
+        makeParallelColumnScanOperator(kDefaultMorselSize, column1, column2);
+    auto const partialSums = database_iterators::utils::runPipelineOnMorsels(
+        pool, scan, int64_t{0}, [](auto &morselScan, int64_t &sum) {
+          sum += runPipeline(morselScan, [](auto &root) {
+            auto const tuple = root.computeNext();
+            return tuple ? std::get<0>(tuple.value()) : 0;
+          });
+        });
+    benchmark::DoNotOptimize(
+        std::accumulate(partialSums.begin(), partialSums.end(), int64_t{0}));
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+} // namespace
+
+BENCHMARK(BM_PipelineTupleAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PipelineBatchAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PipelineMorselDriven)
+    ->ArgNames({"rows", "threads"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 22, 8),
+                   benchmark::CreateRange(1, 16, 4)})
+    ->UseRealTime();
@@ -0,0 +1,149 @@
+//===-- ReduceByKeyOperatorBenchmark.cpp - Benchmarks -----------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Sums up 4M `int64_t` values grouped by an `int64_t` key for varying numbers
+/// of groups, from a handful (L1-resident hash table) to one group per tuple
+/// (DRAM-resident hash table). `BM_ReduceByKeyZipf` draws the keys of 1M
+/// groups from Zipf distributions with increasing skew (in hundredths), where
+/// the hot groups stay in the CPU caches. `BM_ParallelReduceByKey` runs the
+/// uniform query with `ParallelReduceByKeyOperator` on a varying number of
+/// threads, once pulling from a shared scan under a lock and once
+/// (`BM_ParallelReduceByKeyMorsels`) running the scan on morsels per thread.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/ParallelColumnScanOperator.h"
+#include "database-iterators/Operators/ParallelReduceByKeyOperator.h"
+#include "database-iterators/Operators/ReduceByKeyOperator.h"
+#include "database-iterators/Utils/PipelineDriver.h"
+#include "database-iterators/Utils/ThreadPool.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+constexpr int64_t kNumRows = 1 << 22;
+
+/// Key and value columns of the input with the given number of groups.
+struct GroupedInput {
+  explicit GroupedInput(int64_t numGroups) : keys(kNumRows), values(kNumRows) {
+    for (int64_t i = 0; i < kNumRows; i++) {
+      keys[i] = (i * 7919) % numGroups;
+      values[i] = i;
+    }
+  }
+
+  std::vector<int64_t> keys;
+  std::vector<int64_t> values;
+};
+
+/// Consumes all tuples of the given operator and returns the sum of their
+/// values.
+template <typename OperatorType>
+int64_t sumValues(OperatorType &reduceByKey) {
+  reduceByKey.open();
+  int64_t sum = 0;
+  while (auto const tuple = reduceByKey.computeNext())
+    sum += std::get<1>(*tuple);
+  reduceByKey.close();
+  return sum;
+}
+
+void runReduceByKey(benchmark::State &state, const std::vector<int64_t> &keys,
+                    const std::vector<int64_t> &values) {
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(keys, values);
+    auto reduceByKey = makeReduceByKeyOperator<1>(&scan, [](auto t1, auto t2) {
+      return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+    });
+    benchmark::DoNotOptimize(sumValues(reduceByKey));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+void BM_ReduceByKey(benchmark::State &state) {
+  const GroupedInput input(state.range(0));
+  runReduceByKey(state, input.keys, input.values);
+}
+
+void BM_ReduceByKeyZipf(benchmark::State &state) {
+  const double skew = static_cast<double>(state.range(0)) / 100;
+  const std::vector<int64_t> keys = makeZipfKeys(kNumRows, 1 << 20, skew);
+  const std::vector<int64_t> values = makeSequence(kNumRows);
+  runReduceByKey(state, keys, values);
+}
+
+void BM_ParallelReduceByKey(benchmark::State &state) {
+  const GroupedInput input(state.range(0));
+  auto const &[keys, values] = input;
+  database_iterators::utils::ThreadPool pool(state.range(1));
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(keys, values);
+    auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+        &scan,
+        [](auto t1, auto t2) {
+          return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+        },
+        &pool);
+    benchmark::DoNotOptimize(sumValues(reduceByKey));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+void BM_ParallelReduceByKeyMorsels(benchmark::State &state) {
+  const GroupedInput input(state.range(0));
+  auto const &[keys, values] = input;
+  database_iterators::utils::ThreadPool pool(state.range(1));
+
+  for (auto _ : state) {
+    auto scan =
+        makeParallelColumnScanOperator(kDefaultMorselSize, keys, values);
+    auto const pipelineFunction = [](auto &morselScan, auto &consume) {
+      consume(morselScan);
+    };
+    auto pipeline = database_iterators::utils::makeMorselPipeline<
+        std::tuple<int64_t, int64_t>>(&scan, pipelineFunction);
+    auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+        &pipeline,
+        [](auto t1, auto t2) {
+          return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+        },
+        &pool);
+    benchmark::DoNotOptimize(sumValues(reduceByKey));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+} // namespace
+
+BENCHMARK(BM_ReduceByKey)->RangeMultiplier(16)->Range(16, kNumRows);
+BENCHMARK(BM_ReduceByKeyZipf)->ArgName("skew")->DenseRange(0, 150, 25);
+BENCHMARK(BM_ParallelReduceByKey)
+    ->ArgNames({"groups", "threads"})
+    ->ArgsProduct({benchmark::CreateRange(16, kNumRows, 16),
+                   benchmark::CreateRange(1, 16, 4)})
+    ->UseRealTime();
+BENCHMARK(BM_ParallelReduceByKeyMorsels)
+    ->ArgNames({"groups", "threads"})
+    ->ArgsProduct({benchmark::CreateRange(16, kNumRows, 16),
+                   benchmark::CreateRange(1, 16, 4)})
+    ->UseRealTime();
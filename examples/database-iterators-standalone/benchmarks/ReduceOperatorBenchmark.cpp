@@ -0,0 +1,73 @@
+//===-- ReduceOperatorBenchmark.cpp - Benchmarks ----------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Computes the sums of two columns of `int64_t` with `ReduceOperator` for
+/// input sizes from L1-resident to DRAM-resident, using either the
+/// tuple-at-a-time or the batch-at-a-time protocol between the scan and the
+/// reduction.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/ReduceOperator.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+template <bool kUseBatches>
+void runReduce(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  const std::vector<int64_t> column1 = makeSequence(numRows);
+  const std::vector<int64_t> column2 = makeUniformKeys(numRows, 1 << 20);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(column1, column2);
+    auto reduce = makeReduceOperator(&scan, [](auto t1, auto t2) {
+      return std::make_tuple(std::get<0>(t1) + std::get<0>(t2),
+                             std::get<1>(t1) + std::get<1>(t2));
+    });
+    reduce.open();
+    int64_t sum = 0;
+    if constexpr (kUseBatches) {
+      typename decltype(reduce)::BatchType batch;
+      if (reduce.computeNextBatch(batch))
+        sum = std::get<0>(batch.get(0)) + std::get<1>(batch.get(0));
+    } else {
+      if (auto const tuple = reduce.computeNext())
+        sum = std::get<0>(*tuple) + std::get<1>(*tuple);
+    }
+    reduce.close();
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+void BM_ReduceTupleAtATime(benchmark::State &state) {
+  runReduce</*kUseBatches=*/false>(state);
+}
+
+void BM_ReduceBatchAtATime(benchmark::State &state) {
+  runReduce</*kUseBatches=*/true>(state);
+}
+
+} // namespace
+
+// From 16 KiB (L1-resident) to 64 MiB (DRAM-resident) of input data.
+BENCHMARK(BM_ReduceTupleAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ReduceBatchAtATime)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
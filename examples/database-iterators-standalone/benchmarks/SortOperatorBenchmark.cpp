@@ -0,0 +1,88 @@
+//===-- SortOperatorBenchmark.cpp - Benchmarks ------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Sorts tuples of a key and an `int64_t` value with `SortOperator` for varying
+/// input sizes. `BM_SortIntegerKeys` uses random `int64_t` keys and hence the
+/// radix sort with all eight passes; `BM_SortSmallIntegerKeys` uses keys below
+/// 2^16, for which the radix sort skips all but two passes;
+/// `BM_SortZipfKeys` uses keys with many duplicates drawn from a Zipf
+/// distribution with skew 1; and `BM_SortFloatingPointKeys` uses the random
+/// keys as `double`s, which are sorted with `std::stable_sort`.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "InputGenerators.h"
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/SortOperator.h"
+
+using namespace database_iterators::benchmarks;
+using namespace database_iterators::operators;
+
+namespace {
+
+template <typename KeyType>
+void runSort(benchmark::State &state, const std::vector<KeyType> &keys) {
+  const size_t numRows = keys.size();
+  const std::vector<int64_t> values = makeSequence(numRows);
+
+  for (auto _ : state) {
+    auto scan = makeColumnViewScanOperator(keys, values);
+    auto sort = makeSortOperator<1>(&scan);
+    sort.open();
+    int64_t sum = 0;
+    while (auto const tuple = sort.computeNext())
+      sum += std::get<1>(*tuple);
+    sort.close();
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * numRows);
+}
+
+template <typename KeyType>
+std::vector<KeyType> makeRandomKeys(size_t numRows, uint64_t keyMask) {
+  RandomNumberGenerator generator;
+  std::vector<KeyType> keys(numRows);
+  for (auto &key : keys)
+    key =
+        static_cast<KeyType>(static_cast<int64_t>(generator.next() & keyMask));
+  return keys;
+}
+
+void BM_SortIntegerKeys(benchmark::State &state) {
+  runSort(state, makeRandomKeys<int64_t>(state.range(0), ~0ULL));
+}
+
+void BM_SortSmallIntegerKeys(benchmark::State &state) {
+  runSort(state, makeRandomKeys<int64_t>(state.range(0), 0xFFFF));
+}
+
+void BM_SortZipfKeys(benchmark::State &state) {
+  const auto numRows = static_cast<size_t>(state.range(0));
+  runSort(state, makeZipfKeys(numRows, static_cast<int64_t>(numRows), 1.0));
+}
+
+void BM_SortFloatingPointKeys(benchmark::State &state) {
+  runSort(state, makeRandomKeys<double>(state.range(0), ~0ULL));
+}
+
+} // namespace
+
+BENCHMARK(BM_SortIntegerKeys)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SortSmallIntegerKeys)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SortZipfKeys)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SortFloatingPointKeys)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
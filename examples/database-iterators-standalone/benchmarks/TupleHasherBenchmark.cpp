@@ -0,0 +1,140 @@
+//===-- TupleHasherBenchmark.cpp - Tuple hashing benchmarks -----*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Compares the hash combiners of `utils::TupleHasher` on 1M distinct keys
+/// consisting of two `int64_t` fields drawn from different distributions.
+/// `BM_HashTuple` measures the throughput of hashing alone and reports the
+/// fraction of keys that share their hash value (`Collisions`) or their slot
+/// in a power-of-two table that uses the lowest bits of the hash value as
+/// slot (`SlotCollisions`) with another key. `BM_BuildHashTable` measures
+/// inserting the keys into a `utils::FlatHashTable`, which scrambles the hash
+/// values before taking their highest bits.
+///
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Utils/FlatHashTable.h"
+#include "database-iterators/Utils/Tuple.h"
+
+using namespace database_iterators::utils;
+
+namespace {
+
+constexpr int64_t kNumKeys = 1 << 20;
+
+using KeyTuple = std::tuple<int64_t, int64_t>;
+
+/// Composite keys of two small dense domains, such as (customer, day).
+struct GridKeys {
+  static std::vector<KeyTuple> generate() {
+    std::vector<KeyTuple> keys;
+    for (int64_t i = 0; i < kNumKeys; i++)
+      keys.emplace_back(i / 1024, i % 1024);
+    return keys;
+  }
+};
+
+/// Keys whose first field is a multiple of a large power of two, such as
+/// aligned addresses or IDs with flags in their low bits.
+struct StridedKeys {
+  static std::vector<KeyTuple> generate() {
+    std::vector<KeyTuple> keys;
+    for (int64_t i = 0; i < kNumKeys; i++)
+      keys.emplace_back(i << 16, 1);
+    return keys;
+  }
+};
+
+/// Pseudo-random keys from a linear congruential generator.
+struct RandomKeys {
+  static std::vector<KeyTuple> generate() {
+    std::vector<KeyTuple> keys;
+    uint64_t state = 42;
+    auto next = [&]() {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      return static_cast<int64_t>(state >> 16);
+    };
+    for (int64_t i = 0; i < kNumKeys; i++) {
+      auto const first = next();
+      keys.emplace_back(first, next());
+    }
+    return keys;
+  }
+};
+
+/// Returns the fraction of the given values that are equal to another one.
+double computeCollisionRate(std::vector<size_t> values) {
+  std::sort(values.begin(), values.end());
+  auto const numDistinct = static_cast<double>(
+      std::unique(values.begin(), values.end()) - values.begin());
+  return 1.0 - numDistinct / static_cast<double>(values.size());
+}
+
+template <typename CombinerType, typename DistributionType>
+void BM_HashTuple(benchmark::State &state) {
+  const std::vector<KeyTuple> keys = DistributionType::generate();
+  TupleHasher<KeyTuple, CombinerType> hasher;
+
+  for (auto _ : state)
+    for (auto const &key : keys)
+      benchmark::DoNotOptimize(hasher(key));
+
+  std::vector<size_t> hashes;
+  std::vector<size_t> slots;
+  for (auto const &key : keys) {
+    hashes.push_back(hasher(key));
+    slots.push_back(hasher(key) & (2 * kNumKeys - 1));
+  }
+  state.counters["Collisions"] = computeCollisionRate(hashes);
+  state.counters["SlotCollisions"] = computeCollisionRate(slots);
+  state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+template <typename CombinerType, typename DistributionType>
+void BM_BuildHashTable(benchmark::State &state) {
+  const std::vector<KeyTuple> keys = DistributionType::generate();
+
+  for (auto _ : state) {
+    FlatHashTable<KeyTuple, int64_t, TupleHasher<KeyTuple, CombinerType>> table(
+        kNumKeys);
+    for (auto const &key : keys)
+      table.insert(key, 0);
+    benchmark::DoNotOptimize(table.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_HashTuple, XorHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MultiplyAddHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MixingHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, XorHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MultiplyAddHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MixingHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, XorHashCombiner, RandomKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MultiplyAddHashCombiner, RandomKeys);
+BENCHMARK_TEMPLATE(BM_HashTuple, MixingHashCombiner, RandomKeys);
+
+BENCHMARK_TEMPLATE(BM_BuildHashTable, XorHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MultiplyAddHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MixingHashCombiner, GridKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, XorHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MultiplyAddHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MixingHashCombiner, StridedKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, XorHashCombiner, RandomKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MultiplyAddHashCombiner, RandomKeys);
+BENCHMARK_TEMPLATE(BM_BuildHashTable, MixingHashCombiner, RandomKeys);
@@ -0,0 +1,81 @@
+//===-- BatchingOperator.h - BatchingOperator definition --------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `BatchingOperator class` as well
+/// as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_BATCHINGOPERATOR_H
+#define ITERATORS_OPERATORS_BATCHINGOPERATOR_H
+
+#include <optional>
+#include <tuple>
+
+#include "database-iterators/Utils/Batch.h"
+
+namespace database_iterators::operators {
+
+/// Groups the tuples of an upstream operator that only implements
+/// `computeNext` into batches.
+///
+/// This operator adapts an upstream operator that implements the
+/// tuple-at-a-time protocol (`computeNext`) to the batch-at-a-time protocol
+/// (`computeNextBatch`) by collecting its tuples into batches. It also
+/// implements `computeNext` by forwarding to the upstream operator, so it can
+/// be consumed with either protocol.
+template <typename UpstreamType>
+class BatchingOperator {
+public:
+  using OutputTuple = typename UpstreamType::OutputTuple;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Constructs a new `BatchingOperator` that holds a reference on its
+  /// upstream operator.
+  explicit BatchingOperator(UpstreamType *const upstream)
+      : upstream(upstream) {}
+
+  /// Opens the upstream operator.
+  void open() { upstream->open(); }
+
+  /// Returns the next tuple produced by the upstream operator.
+  ReturnType computeNext() { return upstream->computeNext(); }
+
+  /// Consumes tuples produced by the upstream operator until the given batch
+  /// is full or upstream returns "end-of-stream". Returns false (and an empty
+  /// batch) iff the latter happens before any tuple has been consumed.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full()) {
+      auto const tuple = upstream->computeNext();
+      if (!tuple)
+        break;
+      batch.pushBack(tuple.value());
+    }
+    return !batch.empty();
+  }
+
+  /// Closes the upstream operator.
+  void close() { upstream->close(); }
+
+private:
+  /// Reference to the upstream operator.
+  UpstreamType *const upstream;
+};
+
+/// Creates a new `BatchingOperator` deriving its template parameters from the
+/// provided arguments.
+template <typename UpstreamType>
+auto makeBatchingOperator(UpstreamType *const upstream) {
+  return BatchingOperator<UpstreamType>(upstream);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_BATCHINGOPERATOR_H
@@ -14,10 +14,14 @@
 #ifndef ITERATORS_OPERATORS_COLUMNSCANOPERATOR_H
 #define ITERATORS_OPERATORS_COLUMNSCANOPERATOR_H
 
+#include <algorithm>
 #include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "database-iterators/Utils/Batch.h"
+
 namespace database_iterators::operators {
 
 /// Co-iterates over a set of vectors representing the columns of a table.
@@ -31,6 +35,7 @@ class ColumnScanOperator {
 public:
   using OutputTuple = std::tuple<InputTypes...>;
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
 
   /// Copies the given vectors into its internal state. All provided vectors
   /// have to have the same length.
@@ -56,8 +61,22 @@ public:
     return ret;
   }
 
-  /// Does nothing.
-  void close() {}
+  /// Copies the values of the next (up to) `BatchType::capacity()` rows into
+  /// the given batch and advances the current index accordingly. Returns false
+  /// and an empty batch if the current index is past the end.
+  bool computeNextBatch(BatchType &batch) {
+    auto const numRows = std::min(BatchType::capacity(),
+                                  std::get<0>(inputs).size() - currentPos);
+    using IndexSequence =
+        std::make_index_sequence<std::tuple_size_v<OutputTuple>>;
+    copyCurrentRows(batch, numRows, IndexSequence{});
+    batch.resize(numRows);
+    currentPos += numRows;
+    return numRows > 0;
+  }
+
+  /// Rewinds the scan such that it can be opened again.
+  void close() { currentPos = 0; }
 
 private:
   template <std::size_t... kIndices>
@@ -66,18 +85,28 @@ private:
     return std::make_tuple(std::get<kIndices>(inputs).at(currentPos)...);
   }
 
+  template <std::size_t... kIndices>
+  void
+  copyCurrentRows(BatchType &batch, size_t numRows,
+                  const std::index_sequence<kIndices...> & /*unused*/) const {
+    (std::copy_n(std::get<kIndices>(inputs).begin() + currentPos, numRows,
+                 batch.template column<kIndices>().begin()),
+     ...);
+  }
+
   /// Copy of the input data that this operator scans.
   std::tuple<std::vector<InputTypes>...> inputs;
   /// Position of the tuple values that are returned in the next call to
-  /// `computeNext`.
+  /// `computeNext` (or the first ones returned by `computeNextBatch`).
   size_t currentPos{0};
 };
 
 /// Creates a new `ColumnScanOperator` deriving its template parameters from
-/// the provided arguments.
+/// the provided arguments. The vectors are copied once, into the operator; use
+/// `makeColumnViewScanOperator` to scan them without copying.
 template <typename... InputTypes>
 auto makeColumnScanOperator(std::vector<InputTypes>... inputs) {
-  return ColumnScanOperator<InputTypes...>(inputs...);
+  return ColumnScanOperator<InputTypes...>(std::move(inputs)...);
 }
 
 } // namespace database_iterators::operators
@@ -0,0 +1,131 @@
+//===-- ColumnViewScanOperator.h - ColumnViewScanOperator -------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `ColumnViewScanOperator class` as
+/// well as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_COLUMNVIEWSCANOPERATOR_H
+#define ITERATORS_OPERATORS_COLUMNVIEWSCANOPERATOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Utils/Batch.h"
+
+namespace database_iterators::operators {
+
+/// Co-iterates over a set of borrowed arrays representing the columns of a
+/// table.
+///
+/// This operator behaves like `ColumnScanOperator` but does not own its input:
+/// it only holds a pointer to the first value of each column, so the columns
+/// may live in any externally managed memory (such as `std::vector`s, arrays,
+/// or memory-mapped files) and have to outlive the operator. The values are
+/// read without bounds checks, so all columns need to have at least `numRows`
+/// values.
+template <typename... InputTypes>
+class ColumnViewScanOperator {
+public:
+  using OutputTuple = std::tuple<InputTypes...>;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Borrows the columns starting at the given pointers, each of which has to
+  /// point to (at least) `numRows` values.
+  explicit ColumnViewScanOperator(size_t numRows, const InputTypes *...inputs)
+      : inputs(inputs...), numRows(numRows) {}
+
+  /// Does nothing.
+  void open() {}
+
+  /// Returns a tuple consisting of the values in the columns at the current
+  /// index and increments that index if it is not past the end, or returns
+  /// 'end of stream' otherwise.
+  ReturnType computeNext() {
+    // Signal end-of-stream if we are at the end of the input
+    if (currentPos >= numRows)
+      return {};
+
+    // Return current tuple and advance
+    using IndexSequence =
+        std::make_index_sequence<std::tuple_size_v<OutputTuple>>;
+    auto const ret = extractCurrentTuple(IndexSequence{});
+    currentPos++;
+    return ret;
+  }
+
+  /// Copies the values of the next (up to) `BatchType::capacity()` rows into
+  /// the given batch and advances the current index accordingly. Returns false
+  /// and an empty batch if the current index is past the end.
+  bool computeNextBatch(BatchType &batch) {
+    auto const numRowsInBatch =
+        std::min(BatchType::capacity(), numRows - currentPos);
+    using IndexSequence =
+        std::make_index_sequence<std::tuple_size_v<OutputTuple>>;
+    copyCurrentRows(batch, numRowsInBatch, IndexSequence{});
+    batch.resize(numRowsInBatch);
+    currentPos += numRowsInBatch;
+    return numRowsInBatch > 0;
+  }
+
+  /// Rewinds the scan such that it can be opened again.
+  void close() { currentPos = 0; }
+
+private:
+  template <std::size_t... kIndices>
+  OutputTuple extractCurrentTuple(
+      const std::index_sequence<kIndices...> & /*unused*/) const {
+    return std::make_tuple(std::get<kIndices>(inputs)[currentPos]...);
+  }
+
+  template <std::size_t... kIndices>
+  void
+  copyCurrentRows(BatchType &batch, size_t numRowsInBatch,
+                  const std::index_sequence<kIndices...> & /*unused*/) const {
+    (std::copy_n(std::get<kIndices>(inputs) + currentPos, numRowsInBatch,
+                 batch.template column<kIndices>().begin()),
+     ...);
+  }
+
+  /// Pointers to the first values of the borrowed columns.
+  std::tuple<const InputTypes *...> inputs;
+  /// Number of rows of the borrowed columns.
+  size_t numRows;
+  /// Position of the tuple values that are returned in the next call to
+  /// `computeNext` (or the first ones returned by `computeNextBatch`).
+  size_t currentPos{0};
+};
+
+/// Creates a new `ColumnViewScanOperator` deriving its template parameters
+/// from the provided arguments.
+template <typename... InputTypes>
+auto makeColumnViewScanOperator(size_t numRows, const InputTypes *...inputs) {
+  return ColumnViewScanOperator<InputTypes...>(numRows, inputs...);
+}
+
+/// Creates a new `ColumnViewScanOperator` that borrows the given vectors,
+/// which all have to have the same length and must not be resized while the
+/// operator is in use.
+template <typename FirstInputType, typename... InputTypes>
+auto makeColumnViewScanOperator(const std::vector<FirstInputType> &firstInput,
+                                const std::vector<InputTypes> &...inputs) {
+  assert(((inputs.size() == firstInput.size()) && ...) &&
+         "all columns must have the same length");
+  return ColumnViewScanOperator<FirstInputType, InputTypes...>(
+      firstInput.size(), firstInput.data(), inputs.data()...);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_COLUMNVIEWSCANOPERATOR_H
@@ -14,6 +14,7 @@
 #ifndef ITERATORS_OPERATORS_FILTEROPERATOR_H
 #define ITERATORS_OPERATORS_FILTEROPERATOR_H
 
+#include <cstddef>
 #include <optional>
 #include <tuple>
 
@@ -30,6 +31,7 @@ class FilterOperator {
 public:
   using OutputTuple = typename UpstreamType::OutputTuple;
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType = typename UpstreamType::BatchType;
 
   /// Constructs a new `FilterOperator` that holds a reference on its upstream
   /// operator and a copy of the provided `filterFunction`.
@@ -51,6 +53,28 @@ public:
     return {};
   }
 
+  /// Consumes batches produced by the upstream operator and compacts the
+  /// tuples for which the filter function returns true to the front of the
+  /// batch until at least one tuple passes. The compaction is branch-free such
+  /// that the compiler can vectorize it. Returns false (and an empty batch)
+  /// when upstream signals "end-of-stream".
+  bool computeNextBatch(BatchType &batch) {
+    while (upstream->computeNextBatch(batch)) {
+      std::size_t numSelected = 0;
+      for (std::size_t i = 0; i < batch.size(); i++) {
+        auto const tuple = batch.get(i);
+        batch.set(numSelected, tuple);
+        numSelected += static_cast<std::size_t>(filterFunction(tuple));
+      }
+      batch.resize(numSelected);
+
+      if (numSelected > 0)
+        return true;
+    }
+
+    return false;
+  }
+
   /// Closes the upstream operator.
   void close() { upstream->close(); }
 
@@ -14,10 +14,15 @@
 #ifndef ITERATORS_OPERATORS_HASHJOINOPERATOR_H
 #define ITERATORS_OPERATORS_HASHJOINOPERATOR_H
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <tuple>
-#include <unordered_map>
+#include <utility>
 
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/FlatHashTable.h"
 #include "database-iterators/Utils/Tuple.h"
 
 namespace database_iterators::operators {
@@ -32,9 +37,13 @@ namespace database_iterators::operators {
 /// a hash join: It first builds a hash table from the left input, which is
 /// called "build" side; then, while consuming the right input, which is called
 /// "probe" side, probes the hash table for matching tuples in order to produce
-/// the next output tuple.
+/// the next output tuple. The hash table is a `utils::FlatHashTable`, which
+/// can be pre-sized with the expected number of build-side tuples and
+/// allocated from a query-scoped `utils::Arena`. The keys are hashed with
+/// `HasherType` (by default, `utils::TupleHasher` of the key tuple), which
+/// allows to select, e.g., a `utils::MixingHashCombiner`.
 template <typename BuildUpstreamType, typename ProbeUpstreamType,
-          std::size_t kNumKeyAttributes>
+          std::size_t kNumKeyAttributes, typename HasherType = void>
 class HashJoinOperator {
   using BuildSideInputTuple = typename BuildUpstreamType::OutputTuple;
   using ProbeSideInputTuple = typename ProbeUpstreamType::OutputTuple;
@@ -48,19 +57,30 @@ class HashJoinOperator {
   using ValueTuple =
       decltype(std::tuple_cat(std::declval<BuildSideValueTuple>(),
                               std::declval<ProbeSideValueTuple>()));
+  using HashTable = utils::FlatHashTable<
+      KeyTuple, BuildSideValueTuple,
+      utils::TupleHasherOrDefault<HasherType, KeyTuple>, std::uint32_t,
+      utils::ArenaAllocator<std::pair<KeyTuple, BuildSideValueTuple>>>;
 
 public:
   using OutputTuple = decltype(std::tuple_cat(std::declval<KeyTuple>(),
                                               std::declval<ValueTuple>()));
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
 
   /// Constructs a new `HashJoinOperator` that holds a reference on its
-  /// upstream operators.
+  /// upstream operators. If given, the hash table reserves space for
+  /// `expectedBuildSize` tuples, which avoids growing it while building, and
+  /// is allocated from `arena`, which then needs to outlive the operator. The
+  /// operator never resets `arena`; it clears the table in `close` and reuses
+  /// its memory when opened again.
   explicit HashJoinOperator(BuildUpstreamType *const buildUpstream,
-                            ProbeUpstreamType *const probeUpstream)
+                            ProbeUpstreamType *const probeUpstream,
+                            std::size_t expectedBuildSize = 0,
+                            utils::Arena *const arena = nullptr)
       : buildUpstream(buildUpstream), probeUpstream(probeUpstream),
-        currentBuildSideMatchesIt(buildTable.end()),
-        currentBuildSideMatchesEnd(buildTable.end()) {}
+        buildTable(expectedBuildSize,
+                   typename HashTable::allocator_type(arena)) {}
 
   /// Builds the hash table from all output of the build-side upstream
   /// operator and opens the probe-side upstream operator.
@@ -69,7 +89,7 @@ public:
     while (auto const tuple = buildUpstream->computeNext()) {
       auto const key = utils::takeFront<kNumKeyAttributes>(tuple.value());
       auto const value = utils::dropFront<kNumKeyAttributes>(tuple.value());
-      buildTable.emplace(key, value);
+      buildTable.insert(key, value);
     }
     buildUpstream->close();
 
@@ -99,7 +119,7 @@ public:
       currentProbeSideValue =
           utils::dropFront<kNumKeyAttributes>(currentProbeTuple.value());
       std::tie(currentBuildSideMatchesIt, currentBuildSideMatchesEnd) =
-          buildTable.equal_range(key);
+          buildTable.equalRange(key);
     }
 
     // Return a combination of the build-side tuple and the next matching tuple
@@ -111,8 +131,53 @@ public:
     return ret;
   }
 
-  /// Closes the probe-side upstream operator.
-  void close() { probeUpstream->close(); }
+  /// Same as `computeNext` but consumes the probe side batch by batch and
+  /// fills the given batch with (up to) `BatchType::capacity()` matches. The
+  /// iteration over the matches of one probe-side tuple as well as over the
+  /// current probe-side batch may continue in the next call. Returns false
+  /// and an empty batch when the last match of the last probe-side tuple has
+  /// been returned.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full()) {
+      // Return remaining matches of the current probe-side tuple
+      if (currentBuildSideMatchesIt != currentBuildSideMatchesEnd) {
+        batch.pushBack(std::tuple_cat(currentBuildSideMatchesIt->first,
+                                      currentBuildSideMatchesIt->second,
+                                      currentProbeSideValue));
+        currentBuildSideMatchesIt++;
+        continue;
+      }
+
+      // Consume next batch from probe-side upstream if the current one is done
+      if (currentProbeBatchPos == currentProbeBatch.size()) {
+        currentProbeBatchPos = 0;
+        if (!probeUpstream->computeNextBatch(currentProbeBatch)) {
+          currentProbeBatch.clear();
+          break;
+        }
+      }
+
+      // Look up key of next tuple from the probe-side in the build table
+      auto const probeTuple = currentProbeBatch.get(currentProbeBatchPos++);
+      auto const key = utils::takeFront<kNumKeyAttributes>(probeTuple);
+      currentProbeSideValue = utils::dropFront<kNumKeyAttributes>(probeTuple);
+      std::tie(currentBuildSideMatchesIt, currentBuildSideMatchesEnd) =
+          buildTable.equalRange(key);
+    }
+
+    return !batch.empty();
+  }
+
+  /// Closes the probe-side upstream operator and clears the hash table.
+  void close() {
+    probeUpstream->close();
+    buildTable.clear();
+    currentBuildSideMatchesIt = {};
+    currentBuildSideMatchesEnd = {};
+    currentProbeBatch.clear();
+    currentProbeBatchPos = 0;
+  }
 
 private:
   /// Reference to the left (build-side) upstream operator.
@@ -121,28 +186,33 @@ private:
   ProbeUpstreamType *const probeUpstream;
   /// Hash table containing all tuples from the build side (after `open` has
   /// been called).
-  std::unordered_multimap<KeyTuple, BuildSideValueTuple,
-                          utils::TupleHasher<KeyTuple>>
-      buildTable;
+  HashTable buildTable;
   /// Value (i.e., tuple of non-key attributes) from the last probe-side tuple
   /// that will be part of the tuples returned for matching build-side tuples.
   ProbeSideValueTuple currentProbeSideValue;
   /// Iterator to the next element in `buildTable` that matches the last
   /// probe-side tuple.
-  typename decltype(buildTable)::iterator currentBuildSideMatchesIt;
+  typename decltype(buildTable)::MatchIterator currentBuildSideMatchesIt;
   /// Past-the-end iterator of elements in `buildTable` that match the last
   /// probe-side tuple.
-  typename decltype(buildTable)::iterator currentBuildSideMatchesEnd;
+  typename decltype(buildTable)::MatchIterator currentBuildSideMatchesEnd;
+  /// Last batch consumed from the probe side in `computeNextBatch`.
+  typename ProbeUpstreamType::BatchType currentProbeBatch;
+  /// Position of the next tuple in `currentProbeBatch` to be looked up.
+  std::size_t currentProbeBatchPos{0};
 };
 
 /// Creates a new `HashJoinOperator` deriving its template parameters from the
 /// provided arguments.
-template <std::size_t kNumKeyAttributes, typename BuildUpstreamType,
-          typename ProbeUpstreamType>
+template <std::size_t kNumKeyAttributes, typename HasherType = void,
+          typename BuildUpstreamType, typename ProbeUpstreamType>
 auto makeHashJoinOperator(BuildUpstreamType *const buildUpstream,
-                          ProbeUpstreamType *const probeUpstream) {
+                          ProbeUpstreamType *const probeUpstream,
+                          std::size_t expectedBuildSize = 0,
+                          utils::Arena *const arena = nullptr) {
   return HashJoinOperator<BuildUpstreamType, ProbeUpstreamType,
-                          kNumKeyAttributes>(buildUpstream, probeUpstream);
+                          kNumKeyAttributes, HasherType>(
+      buildUpstream, probeUpstream, expectedBuildSize, arena);
 }
 
 } // namespace database_iterators::operators
@@ -14,9 +14,12 @@
 #ifndef ITERATORS_OPERATORS_MAPOPERATOR_H
 #define ITERATORS_OPERATORS_MAPOPERATOR_H
 
+#include <cstddef>
 #include <optional>
 #include <tuple>
 
+#include "database-iterators/Utils/Batch.h"
+
 namespace database_iterators::operators {
 
 /// Maps (or "transforms") all input tuples to a new one using a map function.
@@ -29,6 +32,8 @@ public:
   using OutputTuple = decltype(std::declval<MapFunctionType>()(
       std::declval<typename UpstreamType::OutputTuple>()));
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType =
+      utils::Batch<OutputTuple, UpstreamType::BatchType::capacity()>;
 
   /// Constructs a new `MapOperator` that holds a reference on its upstream
   /// operator and a copy of the provided `mapFunction`.
@@ -51,6 +56,22 @@ public:
     return mapFunction(tuple.value());
   }
 
+  /// Consumes the next batch produced by the upstream operator and fills the
+  /// given batch with the results of applying the given mapFunction to each of
+  /// its tuples. Returns false (and an empty batch) iff the upstream operator
+  /// does so.
+  bool computeNextBatch(BatchType &batch) {
+    if (!upstream->computeNextBatch(inputBatch)) {
+      batch.clear();
+      return false;
+    }
+
+    for (std::size_t i = 0; i < inputBatch.size(); i++)
+      batch.set(i, mapFunction(inputBatch.get(i)));
+    batch.resize(inputBatch.size());
+    return true;
+  }
+
   /// Closes the upstream operator.
   void close() { upstream->close(); }
 
@@ -59,6 +80,8 @@ private:
   UpstreamType *const upstream;
   /// Function that is used to transform the input tuples.
   MapFunctionType mapFunction;
+  /// Buffer for the batches consumed from upstream in `computeNextBatch`.
+  typename UpstreamType::BatchType inputBatch;
 };
 
 /// Creates a new `MapOperator` deriving its template parameters from the
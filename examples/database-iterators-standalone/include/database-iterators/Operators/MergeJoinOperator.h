@@ -0,0 +1,255 @@
+//===-- MergeJoinOperator.h - MergeJoinOperator definition ------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `MergeJoinOperator class` as well
+/// as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_MERGEJOINOPERATOR_H
+#define ITERATORS_OPERATORS_MERGEJOINOPERATOR_H
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/Tuple.h"
+
+namespace database_iterators::operators {
+
+/// Returns tuples from its two upstream operators that have matching keys
+/// using a merge join on inputs that are sorted by their key.
+///
+/// This operator returns the same tuples as `HashJoinOperator`, i.e., any
+/// combination of tuples with matching keys (the first given number of
+/// attributes), each consisting of the key attributes, the remaining
+/// attributes from the left side, and the remaining attributes from the right
+/// side. Both upstream operators must produce their tuples in ascending order
+/// of their keys, for example, by means of a `SortOperator`. The operator
+/// advances through both inputs in lockstep; for each key that occurs on both
+/// sides, it buffers the values of the left-side tuples with that key and
+/// combines them with each right-side tuple with that key. The memory
+/// consumption is thus bounded by the largest group of equal keys on the left
+/// side, and the result is sorted by key as well.
+template <typename LeftUpstreamType, typename RightUpstreamType,
+          std::size_t kNumKeyAttributes>
+class MergeJoinOperator {
+  using LeftInputTuple = typename LeftUpstreamType::OutputTuple;
+  using RightInputTuple = typename RightUpstreamType::OutputTuple;
+
+  using KeyTuple = decltype(utils::takeFront<kNumKeyAttributes>(
+      std::declval<LeftInputTuple>()));
+  using LeftValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
+      std::declval<LeftInputTuple>()));
+  using RightValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
+      std::declval<RightInputTuple>()));
+
+public:
+  using OutputTuple = decltype(std::tuple_cat(
+      std::declval<KeyTuple>(), std::declval<LeftValueTuple>(),
+      std::declval<RightValueTuple>()));
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Constructs a new `MergeJoinOperator` that holds a reference on its
+  /// upstream operators. If given, the buffered left-side values are
+  /// allocated from `arena`, which then needs to outlive the operator.
+  explicit MergeJoinOperator(LeftUpstreamType *const leftUpstream,
+                             RightUpstreamType *const rightUpstream,
+                             utils::Arena *const arena = nullptr)
+      : leftUpstream(leftUpstream), rightUpstream(rightUpstream),
+        currentLeftGroup(utils::ArenaAllocator<LeftValueTuple>(arena)) {}
+
+  /// Opens both upstream operators.
+  void open() {
+    leftUpstream->open();
+    rightUpstream->open();
+  }
+
+  /// Returns the next matching tuple. This combines the next buffered
+  /// left-side value with the current right-side tuple if possible;
+  /// otherwise, it moves on to the next right-side tuple if that has the same
+  /// key, or, if it does not, advances both sides to the next key that occurs
+  /// on both sides and buffers the left-side values with that key. Returns
+  /// "end-of-stream" when one of the sides is exhausted.
+  ReturnType computeNext() { return computeNextMatch</*kUseBatches=*/false>(); }
+
+  /// Same as `computeNext` but consumes the upstream operators batch by batch
+  /// and fills the given batch with (up to) `BatchType::capacity()` matches.
+  /// Returns false and an empty batch when all matches have been returned.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full()) {
+      auto const tuple = computeNextMatch</*kUseBatches=*/true>();
+      if (!tuple)
+        break;
+      batch.pushBack(tuple.value());
+    }
+    return !batch.empty();
+  }
+
+  /// Closes both upstream operators and clears the buffered left-side values.
+  void close() {
+    leftUpstream->close();
+    rightUpstream->close();
+    hasStarted = false;
+    currentLeftGroup.clear();
+    currentLeftGroupPos = 0;
+    leftBatch.clear();
+    leftBatchPos = 0;
+    rightBatch.clear();
+    rightBatchPos = 0;
+  }
+
+private:
+  /// Implements `computeNext` consuming the upstream operators either tuple by
+  /// tuple or batch by batch.
+  template <bool kUseBatches>
+  ReturnType computeNextMatch() {
+    if (!hasStarted) {
+      nextLeftTuple = fetchLeft<kUseBatches>();
+      nextRightTuple = fetchRight<kUseBatches>();
+      hasStarted = true;
+    }
+
+    while (true) {
+      // Combine the current right-side tuple with the next left-side value
+      if (currentLeftGroupPos < currentLeftGroup.size())
+        return std::tuple_cat(currentKey,
+                              currentLeftGroup[currentLeftGroupPos++],
+                              currentRightValue);
+
+      // Move on to the next right-side tuple if it has the same key
+      if (!currentLeftGroup.empty()) {
+        nextRightTuple = fetchRight<kUseBatches>();
+        if (nextRightTuple &&
+            utils::takeFront<kNumKeyAttributes>(nextRightTuple.value()) ==
+                currentKey) {
+          currentRightValue =
+              utils::dropFront<kNumKeyAttributes>(nextRightTuple.value());
+          currentLeftGroupPos = 0;
+          continue;
+        }
+        currentLeftGroup.clear();
+      }
+
+      if (!startNextGroup<kUseBatches>())
+        return {};
+    }
+  }
+
+  /// Advances both sides to the next key that occurs on both sides, buffers
+  /// the values of all left-side tuples with that key, and makes the first
+  /// right-side tuple with that key the current one. Returns false if there
+  /// is no such key.
+  template <bool kUseBatches>
+  bool startNextGroup() {
+    while (nextLeftTuple && nextRightTuple) {
+      auto const leftKey =
+          utils::takeFront<kNumKeyAttributes>(nextLeftTuple.value());
+      auto const rightKey =
+          utils::takeFront<kNumKeyAttributes>(nextRightTuple.value());
+      if (leftKey < rightKey) {
+        nextLeftTuple = fetchLeft<kUseBatches>();
+      } else if (rightKey < leftKey) {
+        nextRightTuple = fetchRight<kUseBatches>();
+      } else {
+        currentKey = leftKey;
+        do {
+          currentLeftGroup.push_back(
+              utils::dropFront<kNumKeyAttributes>(nextLeftTuple.value()));
+          nextLeftTuple = fetchLeft<kUseBatches>();
+        } while (nextLeftTuple &&
+                 utils::takeFront<kNumKeyAttributes>(nextLeftTuple.value()) ==
+                     currentKey);
+        currentRightValue =
+            utils::dropFront<kNumKeyAttributes>(nextRightTuple.value());
+        currentLeftGroupPos = 0;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <bool kUseBatches>
+  std::optional<LeftInputTuple> fetchLeft() {
+    return fetchNext<kUseBatches>(leftUpstream, leftBatch, leftBatchPos);
+  }
+
+  template <bool kUseBatches>
+  std::optional<RightInputTuple> fetchRight() {
+    return fetchNext<kUseBatches>(rightUpstream, rightBatch, rightBatchPos);
+  }
+
+  /// Returns the next tuple of the given upstream operator, either directly
+  /// or from the given batch, which is refilled when it has been consumed.
+  template <bool kUseBatches, typename UpstreamType>
+  static std::optional<typename UpstreamType::OutputTuple>
+  fetchNext(UpstreamType *const upstream,
+            typename UpstreamType::BatchType &batch, std::size_t &batchPos) {
+    if constexpr (kUseBatches) {
+      if (batchPos == batch.size()) {
+        batchPos = 0;
+        if (!upstream->computeNextBatch(batch)) {
+          batch.clear();
+          return {};
+        }
+      }
+      return batch.get(batchPos++);
+    } else {
+      return upstream->computeNext();
+    }
+  }
+
+  /// Reference to the left upstream operator.
+  LeftUpstreamType *const leftUpstream;
+  /// Reference to the right upstream operator.
+  RightUpstreamType *const rightUpstream;
+  /// Tracks whether the first tuples of both sides have been fetched.
+  bool hasStarted = false;
+  /// Next left-side tuple that has not been buffered yet.
+  std::optional<LeftInputTuple> nextLeftTuple;
+  /// Current right-side tuple, which is combined with `currentLeftGroup` if
+  /// it has the key `currentKey`, or the next one otherwise.
+  std::optional<RightInputTuple> nextRightTuple;
+  /// Key of the tuples in `currentLeftGroup`.
+  KeyTuple currentKey;
+  /// Values of the left-side tuples with key `currentKey`.
+  std::vector<LeftValueTuple, utils::ArenaAllocator<LeftValueTuple>>
+      currentLeftGroup;
+  /// Position of the value in `currentLeftGroup` that is combined with the
+  /// current right-side tuple next.
+  std::size_t currentLeftGroupPos{0};
+  /// Value of the current right-side tuple.
+  RightValueTuple currentRightValue;
+  /// Last batches consumed from the upstream operators in `computeNextBatch`
+  /// and the positions of their next tuples.
+  typename LeftUpstreamType::BatchType leftBatch;
+  std::size_t leftBatchPos{0};
+  typename RightUpstreamType::BatchType rightBatch;
+  std::size_t rightBatchPos{0};
+};
+
+/// Creates a new `MergeJoinOperator` deriving its template parameters from
+/// the provided arguments.
+template <std::size_t kNumKeyAttributes, typename LeftUpstreamType,
+          typename RightUpstreamType>
+auto makeMergeJoinOperator(LeftUpstreamType *const leftUpstream,
+                           RightUpstreamType *const rightUpstream,
+                           utils::Arena *const arena = nullptr) {
+  return MergeJoinOperator<LeftUpstreamType, RightUpstreamType,
+                           kNumKeyAttributes>(leftUpstream, rightUpstream,
+                                              arena);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_MERGEJOINOPERATOR_H
@@ -0,0 +1,134 @@
+//===-- ParallelColumnScanOperator.h - Morsel-wise column scan --*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `ParallelColumnScanOperator class`
+/// as well as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_PARALLELCOLUMNSCANOPERATOR_H
+#define ITERATORS_OPERATORS_PARALLELCOLUMNSCANOPERATOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Utils/Batch.h"
+
+namespace database_iterators::operators {
+
+/// Default number of rows per morsel: large enough to amortize the cost of
+/// dispatching a morsel and of setting up a pipeline on it, small enough to
+/// balance the load among threads for moderately sized tables.
+inline constexpr std::size_t kDefaultMorselSize =
+    16 * utils::kDefaultBatchCapacity;
+
+/// Co-iterates over a set of borrowed arrays representing the columns of a
+/// table and additionally splits them into fixed-size row ranges ("morsels")
+/// that can be scanned independently.
+///
+/// Consumed through `computeNext` or `computeNextBatch`, this operator behaves
+/// like `ColumnViewScanOperator`. In addition, `getMorselScan` returns a
+/// `ColumnViewScanOperator` over any of its `getNumMorsels()` morsels, which
+/// is cheap and can be called from several threads concurrently, such that
+/// each thread can run its own copy of a pipeline on the morsels it gets from
+/// a scheduler (see `utils::runPipelineOnMorsels`). All morsels have
+/// `morselSize` rows except for the last one, which may be shorter.
+template <typename... InputTypes>
+class ParallelColumnScanOperator {
+public:
+  using OutputTuple = std::tuple<InputTypes...>;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+  using MorselScanType = ColumnViewScanOperator<InputTypes...>;
+
+  /// Borrows the columns starting at the given pointers, each of which has to
+  /// point to (at least) `numRows` values, and splits them into morsels of
+  /// `morselSize` rows.
+  explicit ParallelColumnScanOperator(std::size_t morselSize,
+                                      std::size_t numRows,
+                                      const InputTypes *...inputs)
+      : inputs(inputs...), numRows(numRows), morselSize(morselSize),
+        fullScan(numRows, inputs...) {
+    assert(morselSize > 0 && "morsels must not be empty");
+  }
+
+  /// Returns the number of morsels of the table.
+  std::size_t getNumMorsels() const {
+    return (numRows + morselSize - 1) / morselSize;
+  }
+
+  /// Returns a new operator scanning the rows of the given morsel.
+  MorselScanType getMorselScan(std::size_t morsel) const {
+    assert(morsel < getNumMorsels() && "morsel out of range");
+    auto const begin = morsel * morselSize;
+    auto const numMorselRows = std::min(morselSize, numRows - begin);
+    return std::apply(
+        [&](auto const *...columns) {
+          return MorselScanType(numMorselRows, (columns + begin)...);
+        },
+        inputs);
+  }
+
+  /// Does nothing.
+  void open() { fullScan.open(); }
+
+  /// Returns the next tuple of the whole table (see
+  /// `ColumnViewScanOperator::computeNext`).
+  ReturnType computeNext() { return fullScan.computeNext(); }
+
+  /// Fills the given batch with the next rows of the whole table (see
+  /// `ColumnViewScanOperator::computeNextBatch`).
+  bool computeNextBatch(BatchType &batch) {
+    return fullScan.computeNextBatch(batch);
+  }
+
+  /// Rewinds the scan of the whole table.
+  void close() { fullScan.close(); }
+
+private:
+  /// Pointers to the first values of the borrowed columns.
+  std::tuple<const InputTypes *...> inputs;
+  /// Number of rows of the borrowed columns.
+  std::size_t numRows;
+  /// Number of rows per morsel.
+  std::size_t morselSize;
+  /// Scan over all rows that serves the sequential protocols.
+  MorselScanType fullScan;
+};
+
+/// Creates a new `ParallelColumnScanOperator` deriving its template parameters
+/// from the provided arguments.
+template <typename... InputTypes>
+auto makeParallelColumnScanOperator(std::size_t morselSize,
+                                    std::size_t numRows,
+                                    const InputTypes *...inputs) {
+  return ParallelColumnScanOperator<InputTypes...>(morselSize, numRows,
+                                                   inputs...);
+}
+
+/// Creates a new `ParallelColumnScanOperator` with morsels of `morselSize`
+/// rows that borrows the given vectors, which all have to have the same length
+/// and must not be resized while the operator is in use.
+template <typename FirstInputType, typename... InputTypes>
+auto makeParallelColumnScanOperator(
+    std::size_t morselSize, const std::vector<FirstInputType> &firstInput,
+    const std::vector<InputTypes> &...inputs) {
+  assert(((inputs.size() == firstInput.size()) && ...) &&
+         "all columns must have the same length");
+  return ParallelColumnScanOperator<FirstInputType, InputTypes...>(
+      morselSize, firstInput.size(), firstInput.data(), inputs.data()...);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_PARALLELCOLUMNSCANOPERATOR_H
@@ -0,0 +1,392 @@
+//===-- ParallelReduceByKeyOperator.h - Parallel reduce-by-key --*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `ParallelReduceByKeyOperator
+/// class` as well as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_PARALLELREDUCEBYKEYOPERATOR_H
+#define ITERATORS_OPERATORS_PARALLELREDUCEBYKEYOPERATOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/FlatHashTable.h"
+#include "database-iterators/Utils/PipelineDriver.h"
+#include "database-iterators/Utils/ThreadPool.h"
+#include "database-iterators/Utils/Tuple.h"
+
+namespace database_iterators::operators {
+
+/// Groups the input tuples by key and reduces the tuples within each group
+/// using all threads of a thread pool.
+///
+/// This operator produces the same tuples as `ReduceByKeyOperator` (in a
+/// different order) and works in two phases, both of which run in `open`:
+///
+/// 1. Each thread repeatedly takes one batch of tuples (a "morsel") from the
+///    upstream operator, whose `computeNextBatch` is called under a lock, and
+///    pre-aggregates it into a thread-local hash table. If the upstream is a
+///    `utils::MorselPipeline`, each thread instead runs its own copy of the
+///    pipeline on the morsels it gets from `utils::runPipelineOnMorsels`, such
+///    that the scan, filters, maps, etc. below this operator run in parallel
+///    without any lock. The table starts small and doubles whenever it fills
+///    up before it has combined at least `kMinTuplesPerGroup` tuples per group
+///    on average, up to `maxLocalGroups` groups. Otherwise, i.e., when the
+///    table is full and either has reduced the input well or has reached its
+///    maximum size, its partial aggregates are spilled into thread-local
+///    partitions based on the hash of their key and the table is cleared.
+///    With few groups, the local tables thus absorb all tuples; with a huge
+///    number of groups, pre-aggregation degrades gracefully into
+///    partitioning.
+/// 2. Each partition is merged in parallel by combining the partial aggregates
+///    that all threads have spilled into it in one hash table per partition.
+///
+/// Since different threads call it concurrently, `reduceFunction` must not
+/// modify shared state. It must be associative and commutative because the
+/// order in which tuples are combined is non-deterministic. The keys are
+/// hashed with `HasherType` (by default, `utils::TupleHasher` of the key
+/// tuple) both for partitioning and in the hash tables.
+///
+/// All state is allocated from per-thread `utils::Arena`s such that the
+/// threads do not contend in the global allocator: the thread-local tables
+/// and partitions of phase 1 from arenas that are released at the end of
+/// `open` and the groups from arenas owned by the operator, which are reset
+/// in `close`.
+template <typename UpstreamType, typename ReduceFunctionType,
+          std::size_t kNumKeyAttributes, typename HasherType = void>
+class ParallelReduceByKeyOperator {
+  using KeyTuple = decltype(utils::takeFront<kNumKeyAttributes>(
+      std::declval<typename UpstreamType::OutputTuple>()));
+  using ValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
+      std::declval<typename UpstreamType::OutputTuple>()));
+  using KeyHasher = utils::TupleHasherOrDefault<HasherType, KeyTuple>;
+  using Entry = std::pair<KeyTuple, ValueTuple>;
+  using HashTable =
+      utils::FlatHashTable<KeyTuple, ValueTuple, KeyHasher, std::uint32_t,
+                           utils::ArenaAllocator<Entry>>;
+  /// Partial aggregates spilled by one thread into each partition.
+  using Partitions =
+      std::vector<std::vector<Entry, utils::ArenaAllocator<Entry>>>;
+
+public:
+  using OutputTuple = typename UpstreamType::OutputTuple;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Default maximum number of groups in a thread-local hash table.
+  static constexpr std::size_t kDefaultMaxLocalGroups = 1 << 18;
+  /// Initial number of groups in a thread-local hash table, which keeps such a
+  /// table in the L1 cache for small keys and values.
+  static constexpr std::size_t kInitialLocalGroups = 1 << 10;
+  /// Average number of tuples per group that a full thread-local table needs
+  /// to have combined in order to be spilled rather than grown.
+  static constexpr std::size_t kMinTuplesPerGroup = 2;
+  /// Logarithm of the number of partitions of the merge phase.
+  static constexpr unsigned kNumPartitionBits = 8;
+
+  /// Constructs a new `ParallelReduceByKeyOperator` that holds a reference on
+  /// its upstream operator and on the thread pool it runs on as well as a copy
+  /// of the provided `reduceFunction`.
+  explicit ParallelReduceByKeyOperator(
+      UpstreamType *const upstream, ReduceFunctionType reduceFunction,
+      utils::ThreadPool *const pool,
+      std::size_t maxLocalGroups = kDefaultMaxLocalGroups)
+      : upstream(upstream), reduceFunction(std::move(reduceFunction)),
+        pool(pool), maxLocalGroups(maxLocalGroups),
+        resultArenas(makeThreadArenas(pool->getNumThreads())) {
+    assert(maxLocalGroups > 0);
+  }
+
+  /// Consumes the upstream operator and computes the groups in parallel.
+  void open() {
+    std::size_t const numThreads = pool->getNumThreads();
+    auto const spillArenas = makeThreadArenas(numThreads);
+    std::vector<LocalAggregation> localAggregations;
+    if constexpr (utils::kIsMorselPipeline<UpstreamType>) {
+      localAggregations = preAggregateMorsels(spillArenas);
+    } else {
+      localAggregations.resize(numThreads);
+      upstream->open();
+      pool->parallelFor(numThreads, [&](std::size_t thread) {
+        initLocalAggregation(localAggregations[thread],
+                             spillArenas[thread].get());
+        preAggregate(localAggregations[thread]);
+      });
+      upstream->close();
+    }
+
+    // Spill the remaining partial aggregates
+    std::vector<Partitions> spilledPartitions(numThreads);
+    pool->parallelFor(numThreads, [&](std::size_t thread) {
+      auto &local = localAggregations[thread];
+      if (local.partitions.empty())
+        initLocalAggregation(local, spillArenas[thread].get());
+      spill(local);
+      spilledPartitions[thread] = std::move(local.partitions);
+    });
+
+    results.assign(kNumPartitions, HashTable());
+    pool->parallelFor(kNumPartitions, [&](std::size_t p) {
+      mergePartition(spilledPartitions, p, results[p], getResultArena());
+    });
+
+    currentPartition = 0;
+    currentPos = 0;
+  }
+
+  /// Returns the next fully reduced tuple, which has been computed in `open`,
+  /// or "end-of-stream" if all tuples have been returned.
+  ReturnType computeNext() {
+    while (currentPartition < results.size()) {
+      auto const &partitionResult = results[currentPartition];
+      if (currentPos < partitionResult.size()) {
+        auto const &entry = partitionResult.begin()[currentPos++];
+        return std::tuple_cat(entry.first, entry.second);
+      }
+      currentPartition++;
+      currentPos = 0;
+    }
+    return {};
+  }
+
+  /// Same as `computeNext` but fills the given batch with (up to)
+  /// `BatchType::capacity()` tuples. Returns false and an empty batch when all
+  /// tuples have been returned.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full() && currentPartition < results.size()) {
+      auto const &partitionResult = results[currentPartition];
+      for (; currentPos < partitionResult.size() && !batch.full();
+           currentPos++) {
+        auto const &entry = partitionResult.begin()[currentPos];
+        batch.pushBack(std::tuple_cat(entry.first, entry.second));
+      }
+      if (currentPos == partitionResult.size()) {
+        currentPartition++;
+        currentPos = 0;
+      }
+    }
+    return !batch.empty();
+  }
+
+  /// Releases the groups.
+  void close() {
+    results.clear();
+    results.shrink_to_fit();
+    for (auto &arena : resultArenas)
+      arena->reset();
+  }
+
+private:
+  static constexpr std::size_t kNumPartitions = std::size_t{1}
+                                                << kNumPartitionBits;
+
+  /// Creates one arena for each of the given number of threads.
+  static std::vector<std::unique_ptr<utils::Arena>>
+  makeThreadArenas(std::size_t numThreads) {
+    std::vector<std::unique_ptr<utils::Arena>> arenas;
+    for (std::size_t i = 0; i < numThreads; i++)
+      arenas.push_back(std::make_unique<utils::Arena>());
+    return arenas;
+  }
+
+  /// Returns the result arena of the thread executing the current iteration
+  /// of a `parallelFor`. If the operator is opened from an iteration of
+  /// another loop, the iterations run sequentially on a thread whose index
+  /// may exceed the number of arenas, hence the modulo.
+  utils::Arena *getResultArena() const {
+    auto const thread = utils::ThreadPool::getThreadIndex();
+    return resultArenas[thread % resultArenas.size()].get();
+  }
+
+  /// Returns the partition of the given key. The hash value is scrambled with
+  /// a different constant than the one `FlatHashTable` uses, such that the
+  /// bits used for partitioning are independent of those that the hash tables
+  /// of the partitions use.
+  static std::size_t computePartition(const KeyTuple &key) {
+    auto const hash = static_cast<std::uint64_t>(KeyHasher()(key));
+    return static_cast<std::size_t>((hash * 0xFF51AFD7ED558CCDULL) >>
+                                    (64 - kNumPartitionBits));
+  }
+
+  /// Thread-local state of phase 1.
+  struct LocalAggregation {
+    /// Partial aggregates that have not been spilled yet.
+    HashTable table;
+    /// Partial aggregates spilled into each partition; empty until
+    /// `initLocalAggregation` has been called.
+    Partitions partitions;
+    /// Number of groups in `table` that makes it grow or spill.
+    std::size_t groupLimit{0};
+    /// Number of tuples combined into `table` since it was last spilled.
+    std::size_t numTuplesSinceSpill{0};
+  };
+
+  /// Prepares `local` for phase 1 allocating its state from `arena`.
+  void initLocalAggregation(LocalAggregation &local,
+                            utils::Arena *const arena) const {
+    utils::ArenaAllocator<Entry> const allocator(arena);
+    local.groupLimit = std::min(kInitialLocalGroups, maxLocalGroups);
+    local.table = HashTable(local.groupLimit, allocator);
+    local.partitions.assign(kNumPartitions,
+                            typename Partitions::value_type(allocator));
+    local.numTuplesSinceSpill = 0;
+  }
+
+  /// Phase 1 on one thread: pre-aggregates morsels taken from the upstream
+  /// operator under a lock into `local`.
+  void preAggregate(LocalAggregation &local) {
+    typename UpstreamType::BatchType inputBatch;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(upstreamMutex);
+        if (!upstream->computeNextBatch(inputBatch))
+          break;
+      }
+      for (std::size_t i = 0; i < inputBatch.size(); i++)
+        preAggregateTuple(local, inputBatch.get(i));
+    }
+  }
+
+  /// Phase 1 with a `utils::MorselPipeline` upstream: runs a copy of the
+  /// pipeline on each morsel and pre-aggregates its output into the state of
+  /// the executing thread, whose table and partitions are allocated from the
+  /// arena of that thread. Returns the states of all threads.
+  std::vector<LocalAggregation> preAggregateMorsels(
+      const std::vector<std::unique_ptr<utils::Arena>> &spillArenas) const {
+    return utils::runPipelineOnMorsels(
+        *pool, upstream->getSource(), LocalAggregation(),
+        [&](auto &morselScan, LocalAggregation &local) {
+          if (local.partitions.empty()) {
+            // Same thread index as the one of the state
+            auto const thread = std::min(utils::ThreadPool::getThreadIndex(),
+                                         spillArenas.size() - 1);
+            initLocalAggregation(local, spillArenas[thread].get());
+          }
+          upstream->run(morselScan, [&](auto &pipeline) {
+            using PipelineType = std::decay_t<decltype(pipeline)>;
+            static_assert(std::is_same_v<typename PipelineType::OutputTuple,
+                                         OutputTuple>,
+                          "pipeline must produce the declared output type");
+            typename PipelineType::BatchType inputBatch;
+            pipeline.open();
+            while (pipeline.computeNextBatch(inputBatch))
+              for (std::size_t i = 0; i < inputBatch.size(); i++)
+                preAggregateTuple(local, inputBatch.get(i));
+            pipeline.close();
+          });
+        });
+  }
+
+  /// Combines `tuple` into the table of `local` and grows or spills the table
+  /// if it is full.
+  void preAggregateTuple(LocalAggregation &local,
+                         const OutputTuple &tuple) const {
+    auto &table = local.table;
+    combine(table, utils::takeFront<kNumKeyAttributes>(tuple),
+            utils::dropFront<kNumKeyAttributes>(tuple));
+    local.numTuplesSinceSpill++;
+    if (table.getNumKeys() < local.groupLimit)
+      return;
+    if (local.groupLimit < maxLocalGroups &&
+        local.numTuplesSinceSpill < kMinTuplesPerGroup * table.getNumKeys()) {
+      local.groupLimit = std::min(2 * local.groupLimit, maxLocalGroups);
+      table.reserve(local.groupLimit);
+    } else {
+      spill(local);
+    }
+  }
+
+  /// Moves the partial aggregates of the table of `local` into its partitions
+  /// and clears the table.
+  static void spill(LocalAggregation &local) {
+    for (auto &entry : local.table)
+      local.partitions[computePartition(entry.first)].push_back(
+          std::move(entry));
+    local.table.clear();
+    local.numTuplesSinceSpill = 0;
+  }
+
+  /// Phase 2 for one partition: combines the partial aggregates that all
+  /// threads have spilled into partition `p` into `result`, which is
+  /// allocated from `arena`.
+  void mergePartition(std::vector<Partitions> &spilledPartitions,
+                      std::size_t p, HashTable &result,
+                      utils::Arena *const arena) const {
+    std::size_t numEntries = 0;
+    for (auto const &partitions : spilledPartitions)
+      numEntries += partitions[p].size();
+    result = HashTable(numEntries, utils::ArenaAllocator<Entry>(arena));
+
+    for (auto &partitions : spilledPartitions) {
+      for (auto &entry : partitions[p])
+        combine(result, std::move(entry.first), std::move(entry.second));
+      partitions[p].clear();
+    }
+  }
+
+  /// Combines the given key/value pair with the aggregate of its group in the
+  /// given table.
+  void combine(HashTable &table, KeyTuple key, ValueTuple value) const {
+    auto const [it, hasInserted] = table.emplace(std::move(key), value);
+    if (!hasInserted)
+      it->second = reduceFunction(it->second, value);
+  }
+
+  /// Reference to the upstream operator.
+  UpstreamType *const upstream;
+  /// Function used to reduce (or fold) upstream tuples pairwise.
+  ReduceFunctionType reduceFunction;
+  /// Reference to the thread pool on which the aggregation runs.
+  utils::ThreadPool *const pool;
+  /// Number of groups in a thread-local table that triggers a spill.
+  std::size_t maxLocalGroups;
+  /// Serializes the calls to the upstream operator.
+  std::mutex upstreamMutex;
+  /// Arenas of the groups, one per thread, which need to outlive `results`.
+  std::vector<std::unique_ptr<utils::Arena>> resultArenas;
+  /// Groups of each partition (after `open` has been called).
+  std::vector<HashTable> results;
+  /// Partition of the tuple returned by the next call to `computeNext`.
+  std::size_t currentPartition{0};
+  /// Position within `currentPartition` of the tuple returned by the next
+  /// call to `computeNext`.
+  std::size_t currentPos{0};
+};
+
+/// Creates a new `ParallelReduceByKeyOperator` deriving its template
+/// parameters from the provided arguments.
+template <std::size_t kNumKeyAttributes, typename HasherType = void,
+          typename UpstreamType, typename ReduceFunctionType>
+auto makeParallelReduceByKeyOperator(
+    UpstreamType *const upstream, ReduceFunctionType reduceFunction,
+    utils::ThreadPool *const pool,
+    std::size_t maxLocalGroups = ParallelReduceByKeyOperator<
+        UpstreamType, ReduceFunctionType, kNumKeyAttributes,
+        HasherType>::kDefaultMaxLocalGroups) {
+  return ParallelReduceByKeyOperator<UpstreamType, ReduceFunctionType,
+                                     kNumKeyAttributes, HasherType>(
+      upstream, std::move(reduceFunction), pool, maxLocalGroups);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_PARALLELREDUCEBYKEYOPERATOR_H
@@ -0,0 +1,347 @@
+//===-- PartitionedHashJoinOperator.h - Radix-partitioned join --*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `PartitionedHashJoinOperator
+/// class` as well as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_PARTITIONEDHASHJOINOPERATOR_H
+#define ITERATORS_OPERATORS_PARTITIONEDHASHJOINOPERATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/FlatHashTable.h"
+#include "database-iterators/Utils/RadixPartitioning.h"
+#include "database-iterators/Utils/ThreadPool.h"
+#include "database-iterators/Utils/Tuple.h"
+
+namespace database_iterators::operators {
+
+/// Returns tuples from its two upstream operators that have matching keys
+/// using a parallel radix-partitioned hash join.
+///
+/// This operator produces the same tuples as `HashJoinOperator` (in a
+/// different order) but is designed for large build sides: in `open`, it
+/// consumes both upstream operators completely and radix-partitions both of
+/// them on the hash of their keys, in one pass or, for large numbers of
+/// partitions, in two passes, such that each build-side partition fits into
+/// the CPU caches. It then joins the pairs of partitions with the same index
+/// in parallel on the given thread pool, each with its own hash table, and
+/// stores the results, which `computeNext` returns one by one. The number of
+/// partitions is derived from the size of the build side unless specified
+/// explicitly. The keys are hashed with `HasherType` (by default,
+/// `utils::TupleHasher` of the key tuple) both for partitioning and in the
+/// hash tables.
+///
+/// The hash tables and the results are allocated from per-thread
+/// `utils::Arena`s such that the threads do not contend in the global
+/// allocator. Each thread reuses one hash table for all partitions it joins;
+/// the tables are released at the end of `open`, the results in `close`.
+template <typename BuildUpstreamType, typename ProbeUpstreamType,
+          std::size_t kNumKeyAttributes, typename HasherType = void>
+class PartitionedHashJoinOperator {
+  using BuildSideInputTuple = typename BuildUpstreamType::OutputTuple;
+  using ProbeSideInputTuple = typename ProbeUpstreamType::OutputTuple;
+
+  using KeyTuple = decltype(utils::takeFront<kNumKeyAttributes>(
+      std::declval<BuildSideInputTuple>()));
+  using BuildSideValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
+      std::declval<BuildSideInputTuple>()));
+  using ProbeSideValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
+      std::declval<ProbeSideInputTuple>()));
+  using ValueTuple =
+      decltype(std::tuple_cat(std::declval<BuildSideValueTuple>(),
+                              std::declval<ProbeSideValueTuple>()));
+  using KeyHasher = utils::TupleHasherOrDefault<HasherType, KeyTuple>;
+  using HashTable = utils::FlatHashTable<
+      KeyTuple, BuildSideValueTuple, KeyHasher, std::uint32_t,
+      utils::ArenaAllocator<std::pair<KeyTuple, BuildSideValueTuple>>>;
+
+public:
+  using OutputTuple = decltype(std::tuple_cat(std::declval<KeyTuple>(),
+                                              std::declval<ValueTuple>()));
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Value of `numPartitionBits` that lets the operator derive the number of
+  /// partitions from the size of the build side.
+  static constexpr unsigned kAutomaticPartitionBits = ~0U;
+  /// Maximum number of partition bits per partitioning pass.
+  static constexpr unsigned kMaxPartitionBitsPerPass = 8;
+  /// Maximum number of partition bits in total.
+  static constexpr unsigned kMaxPartitionBits = 2 * kMaxPartitionBitsPerPass;
+
+  /// Constructs a new `PartitionedHashJoinOperator` that holds a reference on
+  /// its upstream operators and on the thread pool it runs on. The inputs
+  /// are partitioned into `2^numPartitionBits` partitions.
+  explicit PartitionedHashJoinOperator(
+      BuildUpstreamType *const buildUpstream,
+      ProbeUpstreamType *const probeUpstream, utils::ThreadPool *const pool,
+      unsigned numPartitionBits = kAutomaticPartitionBits)
+      : buildUpstream(buildUpstream), probeUpstream(probeUpstream), pool(pool),
+        configuredPartitionBits(numPartitionBits),
+        resultArenas(makeThreadArenas(pool->getNumThreads())) {
+    assert(numPartitionBits == kAutomaticPartitionBits ||
+           numPartitionBits <= kMaxPartitionBits);
+  }
+
+  /// Consumes both upstream operators, partitions their tuples, and joins the
+  /// partitions in parallel.
+  void open() {
+    auto buildSide = consumeUpstream(buildUpstream);
+    auto probeSide = consumeUpstream(probeUpstream);
+
+    numPartitionBits = configuredPartitionBits == kAutomaticPartitionBits
+                           ? computeNumPartitionBits(buildSide.size())
+                           : configuredPartitionBits;
+    auto const buildOffsets = partition(buildSide);
+    auto const probeOffsets = partition(probeSide);
+
+    std::size_t const numThreads = pool->getNumThreads();
+    auto const tableArenas = makeThreadArenas(numThreads);
+    std::vector<HashTable> tables;
+    for (auto const &arena : tableArenas)
+      tables.emplace_back(0, typename HashTable::allocator_type(arena.get()));
+
+    std::size_t const numPartitions = std::size_t{1} << numPartitionBits;
+    results.assign(numPartitions, {});
+    pool->parallelFor(numPartitions, [&](std::size_t p) {
+      // If the operator is opened from an iteration of another loop, the
+      // iterations run sequentially on a thread whose index may exceed the
+      // number of arenas, hence the modulo
+      auto const thread = utils::ThreadPool::getThreadIndex() % numThreads;
+      results[p] = PartitionResult(
+          utils::ArenaAllocator<OutputTuple>(resultArenas[thread].get()));
+      joinPartition(buildSide.data() + buildOffsets[p],
+                    buildOffsets[p + 1] - buildOffsets[p],
+                    probeSide.data() + probeOffsets[p],
+                    probeOffsets[p + 1] - probeOffsets[p], tables[thread],
+                    results[p]);
+    });
+
+    currentPartition = 0;
+    currentPos = 0;
+  }
+
+  /// Returns the next tuple of the join result, which has been computed in
+  /// `open`, or "end-of-stream" if all tuples have been returned.
+  ReturnType computeNext() {
+    while (currentPartition < results.size()) {
+      auto const &partitionResult = results[currentPartition];
+      if (currentPos < partitionResult.size())
+        return partitionResult[currentPos++];
+      currentPartition++;
+      currentPos = 0;
+    }
+    return {};
+  }
+
+  /// Same as `computeNext` but fills the given batch with (up to)
+  /// `BatchType::capacity()` tuples. Returns false and an empty batch when all
+  /// tuples have been returned.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full() && currentPartition < results.size()) {
+      auto const &partitionResult = results[currentPartition];
+      for (; currentPos < partitionResult.size() && !batch.full();
+           currentPos++)
+        batch.pushBack(partitionResult[currentPos]);
+      if (currentPos == partitionResult.size()) {
+        currentPartition++;
+        currentPos = 0;
+      }
+    }
+    return !batch.empty();
+  }
+
+  /// Releases the join result.
+  void close() {
+    results.clear();
+    results.shrink_to_fit();
+    for (auto &arena : resultArenas)
+      arena->reset();
+  }
+
+private:
+  using PartitionResult =
+      std::vector<OutputTuple, utils::ArenaAllocator<OutputTuple>>;
+
+  /// Creates one arena for each of the given number of threads.
+  static std::vector<std::unique_ptr<utils::Arena>>
+  makeThreadArenas(std::size_t numThreads) {
+    std::vector<std::unique_ptr<utils::Arena>> arenas;
+    for (std::size_t i = 0; i < numThreads; i++)
+      arenas.push_back(std::make_unique<utils::Arena>());
+    return arenas;
+  }
+
+  /// Collects all tuples of the given upstream operator.
+  template <typename UpstreamType>
+  static auto consumeUpstream(UpstreamType *const upstream) {
+    std::vector<typename UpstreamType::OutputTuple> tuples;
+    upstream->open();
+    while (auto const tuple = upstream->computeNext())
+      tuples.push_back(tuple.value());
+    upstream->close();
+    return tuples;
+  }
+
+  /// Derives the number of partition bits such that the hash table of a
+  /// build-side partition fits into a typical L2 cache and such that there
+  /// are enough partitions to balance the load among the threads.
+  unsigned computeNumPartitionBits(std::size_t buildSize) const {
+    constexpr std::size_t kTargetPartitionBytes = 256 * 1024;
+    // Entry plus chain index and (at a load factor of 1/2) two slots
+    constexpr std::size_t kBytesPerEntry =
+        sizeof(std::pair<KeyTuple, BuildSideValueTuple>) +
+        3 * sizeof(std::uint32_t);
+    auto const tableBytes = buildSize * kBytesPerEntry;
+
+    unsigned numBits = 0;
+    while (numBits < kMaxPartitionBits &&
+           (tableBytes >> numBits) > kTargetPartitionBytes)
+      numBits++;
+    while (numBits < kMaxPartitionBits &&
+           (std::size_t{1} << numBits) < 4 * pool->getNumThreads())
+      numBits++;
+    return numBits;
+  }
+
+  /// Returns the hash value of the key of the given tuple scrambled with a
+  /// different constant than the one `FlatHashTable` uses, such that the
+  /// bits used for partitioning are independent of those that the hash tables
+  /// of the partitions use.
+  template <typename TupleType>
+  static std::uint64_t computePartitionHash(const TupleType &tuple) {
+    auto const key = utils::takeFront<kNumKeyAttributes>(tuple);
+    auto const hash = static_cast<std::uint64_t>(KeyHasher()(key));
+    return hash * 0xFF51AFD7ED558CCDULL;
+  }
+
+  /// Partitions the given tuples in place using the highest
+  /// `numPartitionBits` bits of their partition hash and returns the offsets
+  /// of the partitions plus the past-the-end offset. Uses two passes if the
+  /// number of partitions exceeds `2^kMaxPartitionBitsPerPass`: the first on
+  /// the higher half of the bits over the whole input and the second on the
+  /// remaining bits within each partition of the first pass.
+  template <typename TupleType>
+  std::vector<std::size_t> partition(std::vector<TupleType> &tuples) const {
+    if (numPartitionBits == 0)
+      return {0, tuples.size()};
+
+    unsigned const numBits1 = numPartitionBits > kMaxPartitionBitsPerPass
+                                  ? (numPartitionBits + 1) / 2
+                                  : numPartitionBits;
+    unsigned const numBits2 = numPartitionBits - numBits1;
+
+    // First pass over the whole input, parallelized over chunks
+    std::vector<TupleType> buffer(tuples.size());
+    auto const offsets1 = utils::radixPartition(
+        tuples.data(), tuples.size(), buffer.data(), std::size_t{1} << numBits1,
+        [&](const TupleType &tuple) {
+          return computePartitionHash(tuple) >> (64 - numBits1);
+        },
+        pool, 4 * pool->getNumThreads());
+    if (numBits2 == 0) {
+      tuples.swap(buffer);
+      return offsets1;
+    }
+
+    // Second pass within each first-pass partition, parallelized over these
+    std::size_t const numPartitions2 = std::size_t{1} << numBits2;
+    std::vector<std::size_t> offsets((std::size_t{1} << numPartitionBits) + 1);
+    pool->parallelFor(offsets1.size() - 1, [&](std::size_t p1) {
+      auto const begin = offsets1[p1];
+      auto const offsets2 = utils::radixPartition(
+          buffer.data() + begin, offsets1[p1 + 1] - begin,
+          tuples.data() + begin, numPartitions2, [&](const TupleType &tuple) {
+            return (computePartitionHash(tuple) >> (64 - numPartitionBits)) &
+                   (numPartitions2 - 1);
+          });
+      for (std::size_t p2 = 0; p2 < numPartitions2; p2++)
+        offsets[p1 * numPartitions2 + p2] = begin + offsets2[p2];
+    });
+    offsets.back() = tuples.size();
+    return offsets;
+  }
+
+  /// Joins one pair of partitions by building `table`, which is cleared
+  /// first, from the build side and appends the result to `result`.
+  static void joinPartition(const BuildSideInputTuple *buildTuples,
+                            std::size_t numBuildTuples,
+                            const ProbeSideInputTuple *probeTuples,
+                            std::size_t numProbeTuples, HashTable &table,
+                            PartitionResult &result) {
+    table.clear();
+    table.reserve(numBuildTuples);
+    for (std::size_t i = 0; i < numBuildTuples; i++)
+      table.insert(utils::takeFront<kNumKeyAttributes>(buildTuples[i]),
+                   utils::dropFront<kNumKeyAttributes>(buildTuples[i]));
+
+    for (std::size_t i = 0; i < numProbeTuples; i++) {
+      auto const key = utils::takeFront<kNumKeyAttributes>(probeTuples[i]);
+      auto const probeValue =
+          utils::dropFront<kNumKeyAttributes>(probeTuples[i]);
+      auto [it, end] = table.equalRange(key);
+      for (; it != end; ++it)
+        result.push_back(std::tuple_cat(it->first, it->second, probeValue));
+    }
+  }
+
+  /// Reference to the left (build-side) upstream operator.
+  BuildUpstreamType *const buildUpstream;
+  /// Reference to the right (probe-side) upstream operator.
+  ProbeUpstreamType *const probeUpstream;
+  /// Reference to the thread pool on which partitioning and joining run.
+  utils::ThreadPool *const pool;
+  /// Logarithm of the number of partitions as passed to the constructor, which
+  /// may be `kAutomaticPartitionBits`.
+  unsigned const configuredPartitionBits;
+  /// Logarithm of the number of partitions of the current run (after `open`
+  /// has been called).
+  unsigned numPartitionBits{0};
+  /// Arenas of the join result, one per thread, which need to outlive
+  /// `results`.
+  std::vector<std::unique_ptr<utils::Arena>> resultArenas;
+  /// Join result of each partition (after `open` has been called).
+  std::vector<PartitionResult> results;
+  /// Partition of the tuple returned by the next call to `computeNext`.
+  std::size_t currentPartition{0};
+  /// Position within `currentPartition` of the tuple returned by the next
+  /// call to `computeNext`.
+  std::size_t currentPos{0};
+};
+
+/// Creates a new `PartitionedHashJoinOperator` deriving its template
+/// parameters from the provided arguments.
+template <std::size_t kNumKeyAttributes, typename HasherType = void,
+          typename BuildUpstreamType, typename ProbeUpstreamType>
+auto makePartitionedHashJoinOperator(
+    BuildUpstreamType *const buildUpstream,
+    ProbeUpstreamType *const probeUpstream, utils::ThreadPool *const pool,
+    unsigned numPartitionBits = PartitionedHashJoinOperator<
+        BuildUpstreamType, ProbeUpstreamType, kNumKeyAttributes,
+        HasherType>::kAutomaticPartitionBits) {
+  return PartitionedHashJoinOperator<BuildUpstreamType, ProbeUpstreamType,
+                                     kNumKeyAttributes, HasherType>(
+      buildUpstream, probeUpstream, pool, numPartitionBits);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_PARTITIONEDHASHJOINOPERATOR_H
@@ -15,10 +15,15 @@
 #define ITERATORS_OPERATORS_REDUCEBYKEYOPERATOR_H
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <tuple>
-#include <unordered_map>
+#include <utility>
 
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/FlatHashTable.h"
 #include "database-iterators/Utils/Tuple.h"
 
 namespace database_iterators::operators {
@@ -33,18 +38,32 @@ namespace database_iterators::operators {
 /// operator. The reduce function must accept two arguments that correspond
 /// both to the value of the tuple produced by the upstream operator (i.e., the
 /// remainder after the key attributes) and return a tuple of the same type.
+/// The groups are held in a `utils::FlatHashTable`, which can be pre-sized with
+/// the expected number of groups and allocated from a query-scoped
+/// `utils::Arena`, and returned in order of their first occurrence. The keys
+/// are hashed with `HasherType` (by default, `utils::TupleHasher` of the key
+/// tuple).
 template <typename UpstreamType, typename ReduceFunctionType,
-          std::size_t kNumKeyAttributes>
+          std::size_t kNumKeyAttributes, typename HasherType = void>
 class ReduceByKeyOperator {
 public:
   using OutputTuple = typename UpstreamType::OutputTuple;
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
 
   /// Constructs a new `ReduceByKeyOperator` that holds a reference on its
-  /// upstream operator and a copy of the provided `reduceFunction`.
+  /// upstream operator and a copy of the provided `reduceFunction`. If given,
+  /// the hash table reserves space for `expectedNumGroups` groups, which
+  /// avoids growing it while consuming the upstream operator, and is
+  /// allocated from `arena`, which then needs to outlive the operator. The
+  /// operator never resets `arena`; it clears the table in `close` and reuses
+  /// its memory when opened again.
   explicit ReduceByKeyOperator(UpstreamType *const upstream,
-                               ReduceFunctionType reduceFunction)
+                               ReduceFunctionType reduceFunction,
+                               std::size_t expectedNumGroups = 0,
+                               utils::Arena *const arena = nullptr)
       : upstream(upstream), reduceFunction(std::move(reduceFunction)),
+        result(expectedNumGroups, typename HashTable::allocator_type(arena)),
         resultIt(result.begin()), resultEnd(result.end()) {}
 
   /// Opens the upstream operator.
@@ -80,20 +99,57 @@ public:
     return ret;
   }
 
-  /// Closes the upstream operator.
-  void close() { upstream->close(); }
+  /// Same as `computeNext` but consumes the upstream operator batch by batch
+  /// in the first call and returns (up to) `BatchType::capacity()` fully
+  /// reduced tuples per call. Returns false and an empty batch when no tuples
+  /// remain in the result.
+  bool computeNextBatch(BatchType &batch) {
+    if (!hasConsumedUpstream)
+      consumeUpstreamBatches();
+
+    batch.clear();
+    for (; resultIt != resultEnd && !batch.full(); resultIt++)
+      batch.pushBack(std::tuple_cat(resultIt->first, resultIt->second));
+    return !batch.empty();
+  }
+
+  /// Closes the upstream operator and clears the groups.
+  void close() {
+    upstream->close();
+    result.clear();
+    resultIt = result.begin();
+    resultEnd = result.end();
+    hasConsumedUpstream = false;
+  }
 
 private:
   /// Runs the actual "reduce-by-key" logic while consuming all upstream.
   void consumeUpstream() {
-    while (auto const tuple = upstream->computeNext()) {
-      auto const key = utils::takeFront<kNumKeyAttributes>(tuple.value());
-      auto const value = utils::dropFront<kNumKeyAttributes>(tuple.value());
-      auto const [it, hasInserted] = result.emplace(key, value);
-      if (!hasInserted)
-        it->second = reduceFunction(it->second, value);
-    }
+    while (auto const tuple = upstream->computeNext())
+      combine(tuple.value());
+    finishConsumption();
+  }
+
+  /// Same as `consumeUpstream` but consumes the upstream batch by batch.
+  void consumeUpstreamBatches() {
+    typename UpstreamType::BatchType inputBatch;
+    while (upstream->computeNextBatch(inputBatch))
+      for (std::size_t i = 0; i < inputBatch.size(); i++)
+        combine(inputBatch.get(i));
+    finishConsumption();
+  }
+
+  /// Combines the given tuple with the aggregate of its group.
+  void combine(const OutputTuple &tuple) {
+    auto const key = utils::takeFront<kNumKeyAttributes>(tuple);
+    auto const value = utils::dropFront<kNumKeyAttributes>(tuple);
+    auto const [it, hasInserted] = result.emplace(key, value);
+    if (!hasInserted)
+      it->second = reduceFunction(it->second, value);
+  }
 
+  /// Prepares `result` for being returned.
+  void finishConsumption() {
     resultIt = result.begin();
     resultEnd = result.end();
     hasConsumedUpstream = true;
@@ -103,6 +159,10 @@ private:
       std::declval<OutputTuple>()));
   using ValueTuple = decltype(utils::dropFront<kNumKeyAttributes>(
       std::declval<OutputTuple>()));
+  using HashTable = utils::FlatHashTable<
+      KeyTuple, ValueTuple, utils::TupleHasherOrDefault<HasherType, KeyTuple>,
+      std::uint32_t,
+      utils::ArenaAllocator<std::pair<KeyTuple, ValueTuple>>>;
 
   /// Reference to the upstream operator.
   UpstreamType *const upstream;
@@ -110,7 +170,7 @@ private:
   ReduceFunctionType reduceFunction;
   /// Holds the tuples to be returned by this operator (after the first call to
   /// `computeNext`).
-  std::unordered_map<KeyTuple, ValueTuple, utils::TupleHasher<KeyTuple>> result;
+  HashTable result;
   /// Iterator to the tuple returned by the next call to `computeNext`.
   typename decltype(result)::iterator resultIt;
   /// Past-the-end iterator of the tuples returned by this operator.
@@ -122,13 +182,15 @@ private:
 
 /// Creates a new `ReduceByKeyOperator` deriving its template parameters from
 /// the provided arguments.
-template <std::size_t kNumKeyAttributes, typename UpstreamType,
-          typename ReduceFunctionType>
+template <std::size_t kNumKeyAttributes, typename HasherType = void,
+          typename UpstreamType, typename ReduceFunctionType>
 auto makeReduceByKeyOperator(UpstreamType *const upstream,
-                             ReduceFunctionType reduceFunction) {
+                             ReduceFunctionType reduceFunction,
+                             std::size_t expectedNumGroups = 0,
+                             utils::Arena *const arena = nullptr) {
   return ReduceByKeyOperator<UpstreamType, ReduceFunctionType,
-                             kNumKeyAttributes>(upstream,
-                                                std::move(reduceFunction));
+                             kNumKeyAttributes, HasherType>(
+      upstream, std::move(reduceFunction), expectedNumGroups, arena);
 }
 
 } // namespace database_iterators::operators
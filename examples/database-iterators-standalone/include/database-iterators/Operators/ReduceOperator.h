@@ -14,9 +14,12 @@
 #ifndef ITERATORS_OPERATORS_REDUCEOPERATOR_H
 #define ITERATORS_OPERATORS_REDUCEOPERATOR_H
 
+#include <cstddef>
 #include <optional>
 #include <tuple>
 
+#include "database-iterators/Utils/Batch.h"
+
 namespace database_iterators::operators {
 
 /// Reduces (or "folds") all input tuples into one given a reduce function.
@@ -32,6 +35,7 @@ class ReduceOperator {
 public:
   using OutputTuple = typename UpstreamType::OutputTuple;
   using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
 
   /// Constructs a new `ReduceOperator` that holds a reference on its upstream
   /// operator and a copy of the provided `reduceFunction`.
@@ -60,6 +64,30 @@ public:
     return aggregate;
   }
 
+  /// Same as `computeNext` but consumes the upstream operator batch by batch.
+  /// Returns a batch with the single aggregated tuple if its upstream operator
+  /// produced any output; returns false and an empty batch otherwise.
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+
+    // Consume first batch, whose first tuple initializes the aggregate
+    typename UpstreamType::BatchType inputBatch;
+    if (!upstream->computeNextBatch(inputBatch))
+      return false;
+
+    // Aggregate remaining tuples of the first and all following batches
+    OutputTuple aggregate = inputBatch.get(0);
+    std::size_t firstRow = 1;
+    do {
+      for (std::size_t i = firstRow; i < inputBatch.size(); i++)
+        aggregate = reduceFunction(aggregate, inputBatch.get(i));
+      firstRow = 0;
+    } while (upstream->computeNextBatch(inputBatch));
+
+    batch.pushBack(aggregate);
+    return true;
+  }
+
   /// Closes the upstream operator.
   void close() { upstream->close(); }
 
@@ -0,0 +1,155 @@
+//===-- SortOperator.h - SortOperator definition ----------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `SortOperator class` as well as
+/// related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_SORTOPERATOR_H
+#define ITERATORS_OPERATORS_SORTOPERATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/RadixSort.h"
+#include "database-iterators/Utils/Tuple.h"
+
+namespace database_iterators::operators {
+
+/// Returns the tuples of its upstream operator sorted by their key.
+///
+/// This operator consumes all tuples produced by its upstream operator and
+/// returns them in ascending order of their key attributes (a given number of
+/// attributes starting at the beginning of each tuple), which are compared
+/// lexicographically. The sort is stable, i.e., tuples with equal keys are
+/// returned in the order in which upstream produced them. If all key
+/// attributes are integers, the tuples are sorted with `utils::radixSort`,
+/// whose passes only depend on the number of tuples and of significant key
+/// bytes; otherwise, they are sorted with `std::stable_sort` (a merge sort).
+/// The tuples are held in a single vector, which can be allocated from a
+/// query-scoped `utils::Arena`, so the memory consumption is proportional to
+/// the input size and independent of the key distribution.
+template <typename UpstreamType, std::size_t kNumKeyAttributes>
+class SortOperator {
+  using KeyTuple = decltype(utils::takeFront<kNumKeyAttributes>(
+      std::declval<typename UpstreamType::OutputTuple>()));
+
+public:
+  using OutputTuple = typename UpstreamType::OutputTuple;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = utils::Batch<OutputTuple>;
+
+  /// Constructs a new `SortOperator` that holds a reference on its upstream
+  /// operator. If given, the tuples are allocated from `arena`, which then
+  /// needs to outlive the operator. The operator never resets `arena`; it
+  /// keeps its buffers across `close` and reuses them when opened again.
+  explicit SortOperator(UpstreamType *const upstream,
+                        utils::Arena *const arena = nullptr)
+      : upstream(upstream), tuples(utils::ArenaAllocator<OutputTuple>(arena)),
+        sortBuffer(utils::ArenaAllocator<OutputTuple>(arena)) {}
+
+  /// Opens the upstream operator.
+  void open() { upstream->open(); }
+
+  /// In the first call to this function, the tuples produced by the upstream
+  /// operator are consumed and sorted. This first and the remaining calls
+  /// return one tuple per call in sorted order. When no tuples remain,
+  /// "end-of-stream" is returned.
+  ReturnType computeNext() {
+    if (!hasConsumedUpstream) {
+      while (auto const tuple = upstream->computeNext())
+        tuples.push_back(tuple.value());
+      sortTuples();
+    }
+
+    if (currentPos == tuples.size())
+      return {};
+    return tuples[currentPos++];
+  }
+
+  /// Same as `computeNext` but consumes the upstream operator batch by batch
+  /// in the first call and returns (up to) `BatchType::capacity()` sorted
+  /// tuples per call. Returns false and an empty batch when no tuples remain.
+  bool computeNextBatch(BatchType &batch) {
+    if (!hasConsumedUpstream) {
+      typename UpstreamType::BatchType inputBatch;
+      while (upstream->computeNextBatch(inputBatch))
+        for (std::size_t i = 0; i < inputBatch.size(); i++)
+          tuples.push_back(inputBatch.get(i));
+      sortTuples();
+    }
+
+    batch.clear();
+    for (; currentPos < tuples.size() && !batch.full(); currentPos++)
+      batch.pushBack(tuples[currentPos]);
+    return !batch.empty();
+  }
+
+  /// Closes the upstream operator and clears the sorted tuples. Without
+  /// arena, their memory is released; with an arena, where that would not
+  /// reclaim anything, it is kept for the next `open`.
+  void close() {
+    upstream->close();
+    tuples.clear();
+    sortBuffer.clear();
+    if (tuples.get_allocator().getArena() == nullptr) {
+      tuples.shrink_to_fit();
+      sortBuffer.shrink_to_fit();
+    }
+    currentPos = 0;
+    hasConsumedUpstream = false;
+  }
+
+private:
+  /// Sorts the consumed tuples by their keys.
+  void sortTuples() {
+    auto const keyOf = [](const OutputTuple &tuple) {
+      return utils::takeFront<kNumKeyAttributes>(tuple);
+    };
+    if constexpr (utils::kIsRadixSortable<KeyTuple>) {
+      utils::radixSort(tuples, keyOf, sortBuffer);
+    } else {
+      std::stable_sort(tuples.begin(), tuples.end(),
+                       [&](const OutputTuple &lhs, const OutputTuple &rhs) {
+                         return keyOf(lhs) < keyOf(rhs);
+                       });
+    }
+    hasConsumedUpstream = true;
+  }
+
+  /// Reference to the upstream operator.
+  UpstreamType *const upstream;
+  /// All tuples produced by the upstream operator (sorted after the first
+  /// call to `computeNext`).
+  std::vector<OutputTuple, utils::ArenaAllocator<OutputTuple>> tuples;
+  /// Scratch space of the radix sort, which may be swapped with `tuples`.
+  std::vector<OutputTuple, utils::ArenaAllocator<OutputTuple>> sortBuffer;
+  /// Position of the tuple returned by the next call to `computeNext`.
+  std::size_t currentPos{0};
+  /// Tracks whether this operator has consumed and sorted the tuples from
+  /// upstream.
+  bool hasConsumedUpstream = false;
+};
+
+/// Creates a new `SortOperator` deriving its template parameters from the
+/// provided arguments.
+template <std::size_t kNumKeyAttributes, typename UpstreamType>
+auto makeSortOperator(UpstreamType *const upstream,
+                      utils::Arena *const arena = nullptr) {
+  return SortOperator<UpstreamType, kNumKeyAttributes>(upstream, arena);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_SORTOPERATOR_H
@@ -0,0 +1,89 @@
+//===-- UnbatchingOperator.h - UnbatchingOperator definition ----*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the `UnbatchingOperator class` as
+/// well as related helpers.
+///
+//===----------------------------------------------------------------------===//
+#ifndef ITERATORS_OPERATORS_UNBATCHINGOPERATOR_H
+#define ITERATORS_OPERATORS_UNBATCHINGOPERATOR_H
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+
+namespace database_iterators::operators {
+
+/// Returns the tuples of an upstream operator that only implements
+/// `computeNextBatch` one at the time.
+///
+/// This operator adapts an upstream operator that implements the
+/// batch-at-a-time protocol (`computeNextBatch`) to the tuple-at-a-time
+/// protocol (`computeNext`) by buffering one batch and returning its tuples
+/// one by one. It also implements `computeNextBatch` by forwarding to the
+/// upstream operator, so it can be consumed with either protocol.
+template <typename UpstreamType>
+class UnbatchingOperator {
+public:
+  using OutputTuple = typename UpstreamType::OutputTuple;
+  using ReturnType = std::optional<OutputTuple>;
+  using BatchType = typename UpstreamType::BatchType;
+
+  /// Constructs a new `UnbatchingOperator` that holds a reference on its
+  /// upstream operator.
+  explicit UnbatchingOperator(UpstreamType *const upstream)
+      : upstream(upstream) {}
+
+  /// Opens the upstream operator.
+  void open() { upstream->open(); }
+
+  /// Returns the next tuple of the current batch. Consumes the next batch
+  /// from the upstream operator if the current one has been returned
+  /// completely (and in the first call). Returns "end-of-stream" iff upstream
+  /// signals "end-of-stream".
+  ReturnType computeNext() {
+    if (currentPos == currentBatch.size()) {
+      currentPos = 0;
+      if (!upstream->computeNextBatch(currentBatch)) {
+        currentBatch.clear();
+        return {};
+      }
+    }
+
+    return currentBatch.get(currentPos++);
+  }
+
+  /// Returns the next batch produced by the upstream operator.
+  bool computeNextBatch(BatchType &batch) {
+    return upstream->computeNextBatch(batch);
+  }
+
+  /// Closes the upstream operator.
+  void close() { upstream->close(); }
+
+private:
+  /// Reference to the upstream operator.
+  UpstreamType *const upstream;
+  /// Last batch consumed from the upstream operator.
+  BatchType currentBatch;
+  /// Position of the tuple in `currentBatch` that is returned in the next call
+  /// to `computeNext`.
+  std::size_t currentPos{0};
+};
+
+/// Creates a new `UnbatchingOperator` deriving its template parameters from
+/// the provided arguments.
+template <typename UpstreamType>
+auto makeUnbatchingOperator(UpstreamType *const upstream) {
+  return UnbatchingOperator<UpstreamType>(upstream);
+}
+
+} // namespace database_iterators::operators
+
+#endif // ITERATORS_OPERATORS_UNBATCHINGOPERATOR_H
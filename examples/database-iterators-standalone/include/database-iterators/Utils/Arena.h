@@ -0,0 +1,187 @@
+//===-- Arena.h - Query-scoped bump allocator -------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_ARENA_H
+#define ITERATORS_UTILS_ARENA_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace database_iterators::utils {
+
+/// Bump allocator that hands out memory from large chunks and frees all of it
+/// at once.
+///
+/// An arena is meant to hold the internal state of the operators of one query
+/// plan (hash tables, sort buffers, etc.; see `ArenaAllocator`): Allocating is
+/// a pointer increment in the common case, individual deallocations are
+/// no-ops, and destroying the arena (or calling `reset`) releases all memory
+/// with one `delete` per chunk instead of one per allocation. As each query
+/// uses its own arena, concurrent queries do not contend in the global
+/// allocator; the arena itself is not thread-safe. Requests larger than half a
+/// chunk get a chunk of their own. The flip side is that memory of containers
+/// that grow by reallocation is only reclaimed with the whole arena, which at
+/// most doubles their footprint with the usual geometric growth; size hints
+/// avoid that.
+///
+/// Operators never reset an arena they are given, as it may be shared by the
+/// whole plan; instead, they clear their containers in `close` and reuse
+/// their memory when they are opened again, such that re-running a plan does
+/// not grow its arena. The owner of the arena resets it once the plan is
+/// closed for good. Operators that build their state on several threads own
+/// one arena per thread instead, which they reset in `close`.
+class Arena {
+public:
+  /// Default size of the chunks.
+  static constexpr std::size_t kDefaultChunkSize = std::size_t{1} << 20;
+
+  /// Creates an empty arena that allocates chunks of `chunkSize` bytes.
+  explicit Arena(std::size_t chunkSize = kDefaultChunkSize)
+      : chunkSize(chunkSize) {
+    assert(chunkSize > 0 && "chunks must not be empty");
+  }
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  /// Returns `numBytes` bytes of uninitialized memory aligned to `alignment`,
+  /// which needs to be a power of two. The memory is valid until the arena is
+  /// reset or destroyed.
+  void *allocate(std::size_t numBytes, std::size_t alignment) {
+    assert((alignment & (alignment - 1)) == 0 && "expected power of two");
+    if (void *const ptr = tryAllocateFromCurrentChunk(numBytes, alignment))
+      return ptr;
+
+    // Serve large requests from a dedicated chunk and keep the current one
+    auto const maxNumBytes = numBytes + alignment - 1;
+    if (maxNumBytes > chunkSize / 2) {
+      chunks.emplace_back(new std::byte[maxNumBytes]);
+      numReservedBytes += maxNumBytes;
+      numAllocatedBytes += numBytes;
+      return alignUp(chunks.back().get(), alignment);
+    }
+
+    chunks.emplace_back(new std::byte[chunkSize]);
+    numReservedBytes += chunkSize;
+    current = chunks.back().get();
+    end = current + chunkSize;
+    return tryAllocateFromCurrentChunk(numBytes, alignment);
+  }
+
+  /// Frees all memory of this arena at once.
+  void reset() {
+    chunks.clear();
+    current = nullptr;
+    end = nullptr;
+    numAllocatedBytes = 0;
+    numReservedBytes = 0;
+  }
+
+  /// Returns the number of bytes handed out since construction or the last
+  /// reset.
+  std::size_t getNumAllocatedBytes() const { return numAllocatedBytes; }
+  /// Returns the number of bytes of all chunks held by this arena.
+  std::size_t getNumReservedBytes() const { return numReservedBytes; }
+
+private:
+  static std::byte *alignUp(std::byte *ptr, std::size_t alignment) {
+    auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+    auto const padding = (alignment - address % alignment) % alignment;
+    return ptr + padding;
+  }
+
+  /// Bumps the pointer into the current chunk if the request fits in its
+  /// remainder; returns `nullptr` otherwise.
+  void *tryAllocateFromCurrentChunk(std::size_t numBytes,
+                                    std::size_t alignment) {
+    if (current == nullptr)
+      return nullptr;
+    auto *const ptr = alignUp(current, alignment);
+    if (ptr > end || static_cast<std::size_t>(end - ptr) < numBytes)
+      return nullptr;
+    current = ptr + numBytes;
+    numAllocatedBytes += numBytes;
+    return ptr;
+  }
+
+  /// Size of regular chunks.
+  std::size_t chunkSize;
+  /// All chunks allocated by this arena.
+  std::vector<std::unique_ptr<std::byte[]>> chunks;
+  /// Start of the free space of the current chunk.
+  std::byte *current = nullptr;
+  /// End of the current chunk.
+  std::byte *end = nullptr;
+  /// Statistics as returned by the getters.
+  std::size_t numAllocatedBytes = 0;
+  std::size_t numReservedBytes = 0;
+};
+
+/// Standard-conforming allocator that allocates from an `Arena` if it has one
+/// and from the global heap otherwise.
+///
+/// Operators with internal state take an optional `Arena *` and allocate their
+/// containers with this allocator, such that the default behavior (without
+/// arena) is unchanged. Deallocations with an arena are no-ops; the memory is
+/// released with the arena, which thus needs to outlive the containers.
+template <typename T>
+class ArenaAllocator {
+public:
+  using value_type = T;
+  // Let the allocator follow the contents of containers such that containers
+  // using different arenas can be assigned and swapped
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  /// Creates an allocator that allocates from the given arena or, if it is
+  /// `nullptr`, from the global heap.
+  explicit ArenaAllocator(Arena *arena = nullptr) : arena(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other)
+      : arena(other.getArena()) {}
+
+  T *allocate(std::size_t n) {
+    if (arena == nullptr)
+      return std::allocator<T>().allocate(n);
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t n) {
+    if (arena == nullptr)
+      std::allocator<T>().deallocate(ptr, n);
+  }
+
+  Arena *getArena() const { return arena; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return arena == other.getArena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const {
+    return arena != other.getArena();
+  }
+
+private:
+  /// Arena from which this allocator allocates or `nullptr` for the heap.
+  Arena *arena;
+};
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_ARENA_H
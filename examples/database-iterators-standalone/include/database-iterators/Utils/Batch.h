@@ -0,0 +1,102 @@
+//===-- Batch.h - Column-oriented batches of tuples -------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_BATCH_H
+#define ITERATORS_UTILS_BATCH_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace database_iterators::utils {
+
+/// Default number of tuples that fit into a `Batch`. Large enough to amortize
+/// the cost of one call to `computeNextBatch` over many tuples and small
+/// enough for the batches of a pipeline to stay in the CPU caches.
+inline constexpr std::size_t kDefaultBatchCapacity = 1024;
+
+/// Holds up to `kCapacity` tuples of type `TupleType` in column-oriented form,
+/// i.e., as one fixed-size array per field (a "struct of arrays") and the
+/// number of tuples that are currently stored. This is the unit of data that
+/// operators exchange through `computeNextBatch`.
+template <typename TupleType, std::size_t kCapacity = kDefaultBatchCapacity>
+class Batch;
+
+template <typename... Types, std::size_t kCapacity>
+class Batch<std::tuple<Types...>, kCapacity> {
+  using IndexSequence = std::index_sequence_for<Types...>;
+
+public:
+  using TupleType = std::tuple<Types...>;
+
+  /// Returns the maximum number of tuples that fit into this batch.
+  static constexpr std::size_t capacity() { return kCapacity; }
+
+  /// Returns the number of tuples currently stored in this batch.
+  std::size_t size() const { return numRows; }
+  bool empty() const { return numRows == 0; }
+  bool full() const { return numRows == kCapacity; }
+
+  /// Sets the number of tuples in this batch to `size`. This is meant to be
+  /// used after writing into the columns directly.
+  void resize(std::size_t size) {
+    assert(size <= kCapacity && "batch size exceeds its capacity");
+    numRows = size;
+  }
+  void clear() { numRows = 0; }
+
+  /// Returns the array holding the values of field `kIndex`. Only the first
+  /// `size()` values are valid.
+  template <std::size_t kIndex>
+  auto &column() {
+    return std::get<kIndex>(columns);
+  }
+  template <std::size_t kIndex>
+  const auto &column() const {
+    return std::get<kIndex>(columns);
+  }
+
+  /// Assembles the tuple at position `row` from the columns.
+  TupleType get(std::size_t row) const { return get(row, IndexSequence{}); }
+
+  /// Scatters the given tuple into the columns at position `row`. Does not
+  /// change the size of the batch.
+  void set(std::size_t row, const TupleType &tuple) {
+    set(row, tuple, IndexSequence{});
+  }
+
+  /// Appends the given tuple to the end of the batch.
+  void pushBack(const TupleType &tuple) {
+    assert(!full() && "cannot append to a full batch");
+    set(numRows++, tuple);
+  }
+
+private:
+  template <std::size_t... kIndices>
+  TupleType get(std::size_t row,
+                const std::index_sequence<kIndices...> & /*unused*/) const {
+    return TupleType(std::get<kIndices>(columns)[row]...);
+  }
+
+  template <std::size_t... kIndices>
+  void set(std::size_t row, const TupleType &tuple,
+           const std::index_sequence<kIndices...> & /*unused*/) {
+    ((std::get<kIndices>(columns)[row] = std::get<kIndices>(tuple)), ...);
+  }
+
+  /// One array of values per field of `TupleType`.
+  std::tuple<std::array<Types, kCapacity>...> columns;
+  /// Number of (valid) tuples in the batch.
+  std::size_t numRows{0};
+};
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_BATCH_H
@@ -0,0 +1,277 @@
+//===-- FlatHashTable.h - Flat open-addressing hash table -------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_FLATHASHTABLE_H
+#define ITERATORS_UTILS_FLATHASHTABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace database_iterators::utils {
+
+/// Hash table with open addressing that stores its entries contiguously.
+///
+/// The key/value pairs are stored in insertion order in a single vector of
+/// entries; iterating over the table iterates over that vector. A separate
+/// power-of-two-sized array of slots maps each distinct key to the index of
+/// its most recently inserted entry using linear probing; entries with the
+/// same key are chained through a side array holding the index of the next
+/// older entry with the same key. Compared to node-based containers such as
+/// `std::unordered_multimap`, this avoids one allocation per entry and keeps
+/// the entries of a lookup close together in memory.
+///
+/// The table can be used as a multimap (`insert` and `equalRange`) or as a map
+/// (`emplace` and `find`), but each instance should only be used in one way.
+/// Entries cannot be removed. Slots and chains store entry indices of type
+/// `IndexType`, which limits the number of entries to its maximum value minus
+/// one (inserting more throws `std::length_error`) but halves the memory of
+/// these arrays by default. All arrays are
+/// allocated with (a rebound copy of) the given allocator, e.g., a
+/// `utils::ArenaAllocator`.
+template <typename KeyType, typename ValueType,
+          typename HasherType = std::hash<KeyType>,
+          typename IndexType = std::uint32_t,
+          typename AllocatorType =
+              std::allocator<std::pair<KeyType, ValueType>>>
+class FlatHashTable {
+  using EntryVector = std::vector<std::pair<KeyType, ValueType>, AllocatorType>;
+  using IndexAllocatorType = typename std::allocator_traits<
+      AllocatorType>::template rebind_alloc<IndexType>;
+  using IndexVector = std::vector<IndexType, IndexAllocatorType>;
+
+  /// Marks empty slots and the end of chains of duplicates.
+  static constexpr IndexType kInvalidIndex =
+      std::numeric_limits<IndexType>::max();
+  /// Minimum number of slots, which needs to be a power of two.
+  static constexpr std::size_t kMinNumSlots = 16;
+
+public:
+  using allocator_type = AllocatorType;
+  using iterator = typename EntryVector::iterator;
+  using const_iterator = typename EntryVector::const_iterator;
+
+  /// Iterates over all entries with the same key, from the most recently
+  /// inserted to the oldest one.
+  class MatchIterator {
+  public:
+    MatchIterator() = default;
+
+    std::pair<KeyType, ValueType> &operator*() const {
+      return table->entries[index];
+    }
+    std::pair<KeyType, ValueType> *operator->() const {
+      return &table->entries[index];
+    }
+    MatchIterator &operator++() {
+      index = table->nextDuplicates[index];
+      return *this;
+    }
+    MatchIterator operator++(int) {
+      MatchIterator ret = *this;
+      ++*this;
+      return ret;
+    }
+    bool operator==(const MatchIterator &other) const {
+      return index == other.index;
+    }
+    bool operator!=(const MatchIterator &other) const {
+      return index != other.index;
+    }
+
+  private:
+    friend class FlatHashTable;
+    MatchIterator(FlatHashTable *table, IndexType index)
+        : table(table), index(index) {}
+
+    FlatHashTable *table = nullptr;
+    IndexType index = kInvalidIndex;
+  };
+
+  /// Creates an empty table with enough space for `expectedNumEntries`
+  /// entries, all of which may have distinct keys.
+  explicit FlatHashTable(std::size_t expectedNumEntries = 0,
+                         const AllocatorType &allocator = AllocatorType())
+      : entries(allocator), nextDuplicates(IndexAllocatorType(allocator)),
+        slots(IndexAllocatorType(allocator)) {
+    slots.assign(kMinNumSlots, kInvalidIndex);
+    reserve(expectedNumEntries);
+  }
+
+  /// Allocates enough space for `numEntries` entries, all of which may have
+  /// distinct keys, such that inserting them does not trigger reallocation or
+  /// rehashing.
+  void reserve(std::size_t numEntries) {
+    entries.reserve(numEntries);
+    nextDuplicates.reserve(numEntries);
+    auto const numSlots = computeNumSlots(numEntries);
+    if (numSlots > slots.size())
+      rehash(numSlots);
+  }
+
+  /// Removes all entries but keeps the allocated memory.
+  void clear() {
+    entries.clear();
+    nextDuplicates.clear();
+    std::fill(slots.begin(), slots.end(), kInvalidIndex);
+    numKeys = 0;
+  }
+
+  std::size_t size() const { return entries.size(); }
+  bool empty() const { return entries.empty(); }
+  /// Returns the number of distinct keys in the table.
+  std::size_t getNumKeys() const { return numKeys; }
+
+  iterator begin() { return entries.begin(); }
+  iterator end() { return entries.end(); }
+  const_iterator begin() const { return entries.begin(); }
+  const_iterator end() const { return entries.end(); }
+
+  /// Inserts the given key/value pair, even if the table already contains
+  /// entries with the same key (i.e., with multimap semantics).
+  void insert(KeyType key, ValueType value) {
+    auto const slot = findSlot(key);
+    if (slots[slot] == kInvalidIndex) {
+      insertNewKey(slot, std::move(key), std::move(value));
+      return;
+    }
+
+    // Prepend new entry to the chain of entries with the same key
+    auto const index = allocateIndex();
+    nextDuplicates.push_back(slots[slot]);
+    slots[slot] = index;
+    entries.emplace_back(std::move(key), std::move(value));
+  }
+
+  /// Inserts the given key/value pair if the table does not contain an entry
+  /// with the same key yet (i.e., with map semantics). Returns an iterator to
+  /// the entry with the given key and whether the insertion took place.
+  std::pair<iterator, bool> emplace(KeyType key, ValueType value) {
+    auto const slot = findSlot(key);
+    if (slots[slot] != kInvalidIndex)
+      return {entries.begin() + slots[slot], false};
+
+    insertNewKey(slot, std::move(key), std::move(value));
+    return {std::prev(entries.end()), true};
+  }
+
+  /// Returns an iterator to the most recently inserted entry with the given
+  /// key or `end()` if there is none.
+  iterator find(const KeyType &key) {
+    auto const slot = findSlot(key);
+    if (slots[slot] == kInvalidIndex)
+      return entries.end();
+    return entries.begin() + slots[slot];
+  }
+
+  /// Returns the range of all entries with the given key.
+  std::pair<MatchIterator, MatchIterator> equalRange(const KeyType &key) {
+    auto const slot = findSlot(key);
+    return {MatchIterator(this, slots[slot]), MatchIterator()};
+  }
+
+private:
+  /// Returns the number of slots needed for `numKeys` distinct keys without
+  /// exceeding the maximum load factor of 3/4.
+  static std::size_t computeNumSlots(std::size_t numKeys) {
+    std::size_t numSlots = kMinNumSlots;
+    while (numSlots / 4 * 3 < numKeys)
+      numSlots *= 2;
+    return numSlots;
+  }
+
+  /// Maps the given key to its home slot. The hash value is multiplied with
+  /// 2^64 divided by the golden ratio such that the high bits, from which the
+  /// slot is taken, depend on all bits of the hash value ("Fibonacci
+  /// hashing"). This makes the table robust against hashers such as
+  /// `std::hash<int>` that return their input unchanged.
+  std::size_t computeHomeSlot(const KeyType &key) const {
+    auto const hash = static_cast<std::uint64_t>(hasher(key));
+    return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ULL) >>
+                                    slotShift);
+  }
+
+  /// Returns the slot that holds the given key or, if the key is not in the
+  /// table, the empty slot where it would be inserted.
+  std::size_t findSlot(const KeyType &key) const {
+    auto const mask = slots.size() - 1;
+    auto slot = computeHomeSlot(key);
+    while (slots[slot] != kInvalidIndex &&
+           !(entries[slots[slot]].first == key))
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  /// Returns the index of the entry that is appended next. Throws
+  /// `std::length_error` if that index isn't representable as `IndexType`.
+  IndexType allocateIndex() const {
+    if (entries.size() >= kInvalidIndex)
+      throw std::length_error("too many entries for IndexType of hash table");
+    return static_cast<IndexType>(entries.size());
+  }
+
+  /// Inserts an entry for a key that is not in the table yet into the given
+  /// (empty) slot and grows the table if necessary.
+  void insertNewKey(std::size_t slot, KeyType key, ValueType value) {
+    assert(slots[slot] == kInvalidIndex);
+    slots[slot] = allocateIndex();
+    nextDuplicates.push_back(kInvalidIndex);
+    entries.emplace_back(std::move(key), std::move(value));
+    numKeys++;
+
+    if (numKeys > slots.size() / 4 * 3)
+      rehash(slots.size() * 2);
+  }
+
+  /// Redistributes the keys into `numSlots` new slots.
+  void rehash(std::size_t numSlots) {
+    assert((numSlots & (numSlots - 1)) == 0 && "expected power of two");
+    IndexVector oldSlots(numSlots, kInvalidIndex, slots.get_allocator());
+    std::swap(slots, oldSlots);
+    slotShift = 64;
+    for (std::size_t n = numSlots; n > 1; n /= 2)
+      slotShift--;
+
+    auto const mask = slots.size() - 1;
+    for (auto const entryIndex : oldSlots) {
+      if (entryIndex == kInvalidIndex)
+        continue;
+      auto slot = computeHomeSlot(entries[entryIndex].first);
+      while (slots[slot] != kInvalidIndex)
+        slot = (slot + 1) & mask;
+      slots[slot] = entryIndex;
+    }
+  }
+
+  /// Key/value pairs in insertion order.
+  EntryVector entries;
+  /// For each entry, the index of the next older entry with the same key or
+  /// `kInvalidIndex` if there is none.
+  IndexVector nextDuplicates;
+  /// For each slot, the index of the most recently inserted entry of the key
+  /// occupying the slot or `kInvalidIndex` if the slot is empty.
+  IndexVector slots;
+  /// Number of bits by which the scrambled hash value is shifted to obtain the
+  /// home slot, i.e., 64 - log2(number of slots).
+  unsigned slotShift = 64 - 4;
+  /// Number of distinct keys, i.e., of occupied slots.
+  std::size_t numKeys = 0;
+  HasherType hasher;
+};
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_FLATHASHTABLE_H
@@ -0,0 +1,131 @@
+//===-- PipelineDriver.h - Morsel-driven pipelines --------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_PIPELINEDRIVER_H
+#define ITERATORS_UTILS_PIPELINEDRIVER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/ThreadPool.h"
+
+namespace database_iterators::utils {
+
+/// Runs a pipeline on all morsels of `source` in parallel on the given pool
+/// and returns one state per thread of the pool.
+///
+/// `source` needs to provide `getNumMorsels()` and `getMorselScan(morsel)`,
+/// such as `ParallelColumnScanOperator`. For each morsel, the thread that
+/// executes it calls `processMorsel(morselScan, localState)`, which typically
+/// assembles a pipeline of operators (e.g., filters, maps) on top of the
+/// morsel scan, drains it, and accumulates the result into `localState`, its
+/// thread-local copy of `initialState` (e.g., a partial aggregate). Building
+/// the operators per morsel is cheap as they are small objects without heap
+/// allocations. The caller is responsible for merging the returned states.
+template <typename SourceType, typename LocalStateType,
+          typename ProcessMorselFunctionType>
+std::vector<LocalStateType>
+runPipelineOnMorsels(ThreadPool &pool, const SourceType &source,
+                     const LocalStateType &initialState,
+                     const ProcessMorselFunctionType &processMorsel) {
+  // Put each state on its own cache lines to avoid false sharing
+  struct alignas(64) PaddedState {
+    LocalStateType state;
+  };
+  std::vector<PaddedState> paddedStates(pool.getNumThreads(),
+                                        PaddedState{initialState});
+
+  pool.parallelFor(source.getNumMorsels(), [&](std::size_t morsel) {
+    // If the loop runs sequentially within a loop of another pool, the thread
+    // index refers to that pool, but then only one thread uses the states
+    auto const threadIndex =
+        std::min(ThreadPool::getThreadIndex(), paddedStates.size() - 1);
+    auto morselScan = source.getMorselScan(morsel);
+    processMorsel(morselScan, paddedStates[threadIndex].state);
+  });
+
+  std::vector<LocalStateType> states;
+  states.reserve(paddedStates.size());
+  for (auto &paddedState : paddedStates)
+    states.push_back(std::move(paddedState.state));
+  return states;
+}
+
+/// Description of a pipeline that runs on the morsels of a source and
+/// produces tuples of type `OutputTupleType`, which parallel operators, such
+/// as `ParallelReduceByKeyOperator`, can consume with one copy of the pipeline
+/// per thread instead of pulling from a shared upstream operator.
+///
+/// `source` needs to provide the same interface as for `runPipelineOnMorsels`.
+/// For each morsel, the consumer calls `run(morselScan, consume)`, which calls
+/// `pipeline(morselScan, consume)`. That function assembles the operators on
+/// top of the morsel scan and passes the last one to `consume`, which opens
+/// it, drains it, and closes it. The output type of that operator cannot be
+/// derived from `pipeline`, which is typically a generic lambda, so it is
+/// given explicitly.
+template <typename OutputTupleType, typename SourceType,
+          typename PipelineFunctionType>
+class MorselPipeline {
+public:
+  using OutputTuple = OutputTupleType;
+  using BatchType = Batch<OutputTuple>;
+
+  /// Holds a reference on `source` and a copy of `pipeline`.
+  explicit MorselPipeline(const SourceType *const source,
+                          PipelineFunctionType pipeline)
+      : source(source), pipeline(std::move(pipeline)) {}
+
+  /// Returns the source whose morsels the pipeline runs on.
+  const SourceType &getSource() const { return *source; }
+
+  /// Builds the pipeline on top of `morselScan` and passes it to `consume`.
+  template <typename MorselScanType, typename ConsumeFunctionType>
+  void run(MorselScanType &morselScan,
+           const ConsumeFunctionType &consume) const {
+    pipeline(morselScan, consume);
+  }
+
+private:
+  /// Reference to the source of the morsels.
+  const SourceType *const source;
+  /// Function assembling the pipeline on top of a morsel scan.
+  PipelineFunctionType pipeline;
+};
+
+/// Creates a new `MorselPipeline` with the given output type deriving the
+/// remaining template parameters from the provided arguments.
+template <typename OutputTupleType, typename SourceType,
+          typename PipelineFunctionType>
+auto makeMorselPipeline(const SourceType *const source,
+                        PipelineFunctionType pipeline) {
+  return MorselPipeline<OutputTupleType, SourceType, PipelineFunctionType>(
+      source, std::move(pipeline));
+}
+
+namespace impl {
+template <typename Type>
+struct IsMorselPipeline : std::false_type {};
+
+template <typename OutputTupleType, typename SourceType,
+          typename PipelineFunctionType>
+struct IsMorselPipeline<
+    MorselPipeline<OutputTupleType, SourceType, PipelineFunctionType>>
+    : std::true_type {};
+} // namespace impl
+
+/// Returns whether the given type is an instance of `MorselPipeline`.
+template <typename Type>
+inline constexpr bool kIsMorselPipeline = impl::IsMorselPipeline<Type>::value;
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_PIPELINEDRIVER_H
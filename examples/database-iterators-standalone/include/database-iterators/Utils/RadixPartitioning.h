@@ -0,0 +1,124 @@
+//===-- RadixPartitioning.h - Parallel radix partitioning -------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_RADIXPARTITIONING_H
+#define ITERATORS_UTILS_RADIXPARTITIONING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "database-iterators/Utils/ThreadPool.h"
+
+namespace database_iterators::utils {
+
+/// Number of bytes buffered per partition before they are written to the
+/// output, i.e., one cache line.
+inline constexpr std::size_t kPartitionBufferBytes = 64;
+
+/// Scatters the `numElements` elements starting at `input` to `output` such
+/// that each element `e` is written to `output[positions[partitionOf(e)]++]`,
+/// i.e., `positions` holds the next write position of each of the
+/// `numPartitions` partitions. The writes go through one cache-line-sized
+/// buffer per partition ("software write combining"), such that every write
+/// to the output fills a full cache line and the number of partitions is not
+/// limited by the number of TLB entries and write buffers of the CPU as much
+/// as with direct scattering.
+template <typename ElementType, typename PartitionFunctionType>
+void scatterToPartitions(const ElementType *input, std::size_t numElements,
+                         ElementType *output, std::size_t *positions,
+                         std::size_t numPartitions,
+                         const PartitionFunctionType &partitionOf) {
+  constexpr std::size_t kBufferSize =
+      std::max<std::size_t>(1, kPartitionBufferBytes / sizeof(ElementType));
+  std::vector<ElementType> buffers(numPartitions * kBufferSize);
+  std::vector<std::size_t> bufferSizes(numPartitions, 0);
+  for (std::size_t i = 0; i < numElements; i++) {
+    auto const p = partitionOf(input[i]);
+    ElementType *buffer = &buffers[p * kBufferSize];
+    buffer[bufferSizes[p]++] = input[i];
+    if (bufferSizes[p] == kBufferSize) {
+      std::copy_n(buffer, kBufferSize, output + positions[p]);
+      positions[p] += kBufferSize;
+      bufferSizes[p] = 0;
+    }
+  }
+  for (std::size_t p = 0; p < numPartitions; p++) {
+    std::copy_n(&buffers[p * kBufferSize], bufferSizes[p],
+                output + positions[p]);
+    positions[p] += bufferSizes[p];
+  }
+}
+
+/// Scatters the `numElements` elements starting at `input` into
+/// `numPartitions` contiguous partitions starting at `output` such that
+/// partition `p` holds all elements `e` with `partitionOf(e) == p` in their
+/// original order. Returns the offsets of the partitions in `output` plus the
+/// past-the-end offset.
+///
+/// Each of `numChunks` chunks of the input is processed by one iteration of a
+/// parallel loop on the given pool (or sequentially if `pool` is null): a
+/// first loop computes the histogram of each chunk, from which the exclusive
+/// prefix sums give each chunk a disjoint output range per partition; a
+/// second loop then scatters each chunk into its ranges with
+/// `scatterToPartitions`.
+template <typename ElementType, typename PartitionFunctionType>
+std::vector<std::size_t>
+radixPartition(const ElementType *input, std::size_t numElements,
+               ElementType *output, std::size_t numPartitions,
+               const PartitionFunctionType &partitionOf,
+               ThreadPool *pool = nullptr, std::size_t numChunks = 1) {
+  numChunks = std::max<std::size_t>(1, std::min(numChunks, numElements));
+  auto const chunkSize = (numElements + numChunks - 1) / numChunks;
+  auto const chunkBegin = [&](std::size_t chunk) {
+    return std::min(chunk * chunkSize, numElements);
+  };
+  auto const runInParallel = [&](const auto &function) {
+    if (pool)
+      pool->parallelFor(numChunks, function);
+    else
+      for (std::size_t chunk = 0; chunk < numChunks; chunk++)
+        function(chunk);
+  };
+
+  // Compute histogram of each chunk
+  std::vector<std::size_t> writePositions(numChunks * numPartitions, 0);
+  runInParallel([&](std::size_t chunk) {
+    std::size_t *histogram = &writePositions[chunk * numPartitions];
+    for (auto i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++)
+      histogram[partitionOf(input[i])]++;
+  });
+
+  // Turn histograms into write positions with an exclusive prefix sum in
+  // partition-major order
+  std::vector<std::size_t> partitionOffsets(numPartitions + 1);
+  std::size_t offset = 0;
+  for (std::size_t p = 0; p < numPartitions; p++) {
+    partitionOffsets[p] = offset;
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+      auto const count = writePositions[chunk * numPartitions + p];
+      writePositions[chunk * numPartitions + p] = offset;
+      offset += count;
+    }
+  }
+  partitionOffsets[numPartitions] = offset;
+
+  // Scatter the elements of each chunk into its ranges
+  runInParallel([&](std::size_t chunk) {
+    auto const begin = chunkBegin(chunk);
+    scatterToPartitions(input + begin, chunkBegin(chunk + 1) - begin, output,
+                        &writePositions[chunk * numPartitions], numPartitions,
+                        partitionOf);
+  });
+
+  return partitionOffsets;
+}
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_RADIXPARTITIONING_H
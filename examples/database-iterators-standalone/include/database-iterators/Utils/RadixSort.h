@@ -0,0 +1,186 @@
+//===-- RadixSort.h - LSD radix sort ----------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_RADIXSORT_H
+#define ITERATORS_UTILS_RADIXSORT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "database-iterators/Utils/RadixPartitioning.h"
+
+namespace database_iterators::utils {
+
+namespace impl {
+/// Minimum input size in bytes from which the partitioning passes scatter
+/// through write-combining buffers. Smaller inputs mostly stay in the CPU
+/// caches, where scattering directly is cheaper.
+inline constexpr std::size_t kMinWriteCombiningBytes = 4 << 20;
+
+template <typename KeyType>
+struct IsRadixSortable : std::is_integral<KeyType> {};
+
+template <typename... Types>
+struct IsRadixSortable<std::tuple<Types...>>
+    : std::conjunction<std::is_integral<Types>...> {};
+
+/// Maps the given integer to an unsigned integer of the same size such that
+/// the order of the results as unsigned integers is the order of the inputs.
+template <typename IntegerType>
+auto toOrderedUnsigned(IntegerType value) {
+  if constexpr (std::is_same_v<IntegerType, bool>) {
+    return static_cast<std::uint8_t>(value);
+  } else {
+    using UnsignedType = std::make_unsigned_t<IntegerType>;
+    auto const bits = static_cast<UnsignedType>(value);
+    if constexpr (std::is_signed_v<IntegerType>) {
+      // Flip the sign bit such that negative numbers come first
+      constexpr auto kSignBit = static_cast<UnsignedType>(
+          UnsignedType{1} << (8 * sizeof(UnsignedType) - 1));
+      return static_cast<UnsignedType>(bits ^ kSignBit);
+    } else {
+      return bits;
+    }
+  }
+}
+
+/// Stably sorts `elements` by component `kIndex` of their key with one
+/// partitioning pass over 256 partitions per byte of that component. The
+/// histograms of all bytes are computed in a single pass upfront, and bytes in
+/// which all keys are equal are skipped. Uses `buffer`, which must have the
+/// same size as `elements`, as scratch space.
+template <std::size_t kIndex, typename ElementType, typename AllocatorType,
+          typename KeyFunctionType>
+void sortByComponent(std::vector<ElementType, AllocatorType> &elements,
+                     std::vector<ElementType, AllocatorType> &buffer,
+                     const KeyFunctionType &keyOf) {
+  auto const digitsOf = [&](const ElementType &element) {
+    return toOrderedUnsigned(std::get<kIndex>(keyOf(element)));
+  };
+  using DigitsType = decltype(digitsOf(elements.front()));
+  constexpr std::size_t kNumBytes = sizeof(DigitsType);
+
+  // Compute the histograms of all bytes
+  std::vector<std::array<std::size_t, 256>> histograms(kNumBytes);
+  for (auto &histogram : histograms)
+    histogram.fill(0);
+  for (auto const &element : elements) {
+    auto const digits = digitsOf(element);
+    for (std::size_t byte = 0; byte < kNumBytes; byte++)
+      histograms[byte][(digits >> (8 * byte)) & 0xFF]++;
+  }
+
+  auto const firstDigits = digitsOf(elements.front());
+  for (std::size_t byte = 0; byte < kNumBytes; byte++) {
+    auto const shift = 8 * byte;
+    auto &histogram = histograms[byte];
+    if (histogram[(firstDigits >> shift) & 0xFF] == elements.size())
+      continue;
+
+    // Turn the histogram into write positions and scatter
+    std::size_t offset = 0;
+    for (auto &count : histogram) {
+      auto const numElements = count;
+      count = offset;
+      offset += numElements;
+    }
+    auto const digitOf = [&](const ElementType &element) {
+      return static_cast<std::size_t>((digitsOf(element) >> shift) & 0xFF);
+    };
+    if (elements.size() * sizeof(ElementType) < kMinWriteCombiningBytes) {
+      for (auto &element : elements)
+        buffer[histogram[digitOf(element)]++] = std::move(element);
+    } else {
+      scatterToPartitions(elements.data(), elements.size(), buffer.data(),
+                          histogram.data(), histogram.size(), digitOf);
+    }
+    elements.swap(buffer);
+  }
+}
+
+template <typename ElementType, typename AllocatorType,
+          typename KeyFunctionType, std::size_t... kIndices>
+void sortByComponents(std::vector<ElementType, AllocatorType> &elements,
+                      std::vector<ElementType, AllocatorType> &buffer,
+                      const KeyFunctionType &keyOf,
+                      const std::index_sequence<kIndices...> & /*unused*/) {
+  constexpr std::size_t kNumComponents = sizeof...(kIndices);
+  buffer.resize(elements.size());
+  // Start with the least significant component
+  (sortByComponent<kNumComponents - 1 - kIndices>(elements, buffer, keyOf),
+   ...);
+}
+} // namespace impl
+
+/// Returns whether `radixSort` can sort by keys of the given type, i.e.,
+/// whether it is an integral type or a tuple of integral types.
+template <typename KeyType>
+inline constexpr bool kIsRadixSortable = impl::IsRadixSortable<KeyType>::value;
+
+/// Minimum number of elements that `radixSort` sorts with a radix sort.
+inline constexpr std::size_t kMinRadixSortSize = 256;
+
+/// Stably sorts the given elements in ascending order of `keyOf(element)`,
+/// which returns an integer or a tuple of integers (compared
+/// lexicographically), using a least-significant-digit radix sort.
+///
+/// The sort makes one stable partitioning pass for each byte of each key
+/// component, starting with the least significant byte of the last
+/// component, but skips the bytes that are equal in all keys. Small key
+/// domains (e.g., 32-bit keys with values below 2^16) thus only take few
+/// passes. Inputs with fewer than `kMinRadixSortSize` elements, for which the
+/// fixed cost of the histograms dominates, are sorted with `std::stable_sort`.
+/// The sort uses `buffer` as scratch space, whose capacity is thus reused if
+/// it is passed to several sorts, and may swap it with `elements`.
+template <typename ElementType, typename AllocatorType,
+          typename KeyFunctionType>
+void radixSort(std::vector<ElementType, AllocatorType> &elements,
+               const KeyFunctionType &keyOf,
+               std::vector<ElementType, AllocatorType> &buffer) {
+  using KeyType = std::decay_t<decltype(keyOf(std::declval<ElementType>()))>;
+  static_assert(kIsRadixSortable<KeyType>, "keys must be integers");
+
+  if (elements.size() < kMinRadixSortSize) {
+    std::stable_sort(elements.begin(), elements.end(),
+                     [&](const ElementType &lhs, const ElementType &rhs) {
+                       return keyOf(lhs) < keyOf(rhs);
+                     });
+    return;
+  }
+
+  if constexpr (std::is_integral_v<KeyType>) {
+    auto const keyTupleOf = [&](const ElementType &element) {
+      return std::make_tuple(keyOf(element));
+    };
+    impl::sortByComponents(elements, buffer, keyTupleOf,
+                           std::make_index_sequence<1>{});
+  } else {
+    using IndexSequence = std::make_index_sequence<std::tuple_size_v<KeyType>>;
+    impl::sortByComponents(elements, buffer, keyOf, IndexSequence{});
+  }
+}
+
+/// Same as above but with a scratch buffer that uses the allocator of
+/// `elements`.
+template <typename ElementType, typename AllocatorType,
+          typename KeyFunctionType>
+void radixSort(std::vector<ElementType, AllocatorType> &elements,
+               const KeyFunctionType &keyOf) {
+  std::vector<ElementType, AllocatorType> buffer(elements.get_allocator());
+  radixSort(elements, keyOf, buffer);
+}
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_RADIXSORT_H
@@ -0,0 +1,241 @@
+//===-- ThreadPool.h - Work-stealing fork-join thread pool ------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ITERATORS_UTILS_THREADPOOL_H
+#define ITERATORS_UTILS_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace database_iterators::utils {
+
+/// Fixed set of worker threads that execute parallel loops.
+///
+/// The pool runs one `parallelFor` at the time: the calling thread publishes
+/// the loop, participates in executing it, and returns once all iterations
+/// are done. The iteration space is split into one contiguous range per
+/// thread, from the front of which the thread takes its iterations one by one,
+/// such that consecutive iterations (e.g., neighboring morsels of a table)
+/// tend to run on the same thread. A thread whose range is exhausted steals
+/// the upper half of the range of another thread, so loops with unevenly
+/// sized iterations are balanced dynamically. Calls to `parallelFor` from
+/// within an iteration run sequentially on the calling thread, such that
+/// parallel code can be nested without deadlocks.
+class ThreadPool {
+public:
+  /// Creates a pool that runs loops on `numThreads` threads in total, i.e.,
+  /// on `numThreads - 1` worker threads and the thread calling `parallelFor`.
+  explicit ThreadPool(std::size_t numThreads = std::max(
+                          1U, std::thread::hardware_concurrency()))
+      : numWorkers(numThreads > 0 ? numThreads - 1 : 0) {
+    for (std::size_t i = 0; i < numWorkers; i++)
+      workers.emplace_back([this, i] { runWorker(i + 1); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Stops and joins all worker threads.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      isStopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  /// Returns the number of threads that execute loops, including the caller.
+  std::size_t getNumThreads() const { return numWorkers + 1; }
+
+  /// Returns the index in `[0, getNumThreads())` of the thread executing the
+  /// current iteration of a `parallelFor`, which is 0 for the caller of
+  /// `parallelFor` and for threads not executing any loop. This allows
+  /// iterations to accumulate into per-thread state without synchronization.
+  static std::size_t getThreadIndex() { return currentThreadIndex(); }
+
+  /// Calls `function(i)` for all `i` in `[0, numIterations)` in parallel and
+  /// returns when all calls have returned.
+  template <typename FunctionType>
+  void parallelFor(std::size_t numIterations, const FunctionType &function) {
+    if (numWorkers == 0 || numIterations <= 1 || isInParallelLoop()) {
+      for (std::size_t i = 0; i < numIterations; i++)
+        function(i);
+      return;
+    }
+
+    // Publish job to the workers
+    std::lock_guard<std::mutex> callerLock(callerMutex);
+    Job job([&function](std::size_t i) { function(i); }, numIterations,
+            getNumThreads());
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      currentJob = &job;
+      currentGeneration++;
+      numBusyWorkers = numWorkers;
+    }
+    jobAvailable.notify_all();
+
+    // Participate and wait for the workers to finish
+    runIterations(job, 0);
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] { return numBusyWorkers == 0; });
+    currentJob = nullptr;
+  }
+
+private:
+  /// Range of iterations `[begin, end)` owned by one thread, packed into a
+  /// single word such that it can be updated atomically by its owner and by
+  /// thieves. Each range sits on its own cache line to avoid false sharing.
+  struct alignas(64) IterationRange {
+    std::atomic<std::uint64_t> bounds{0};
+  };
+
+  static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) {
+    return (begin << 32) | end;
+  }
+  static std::uint64_t getBegin(std::uint64_t bounds) { return bounds >> 32; }
+  static std::uint64_t getEnd(std::uint64_t bounds) {
+    return bounds & 0xFFFFFFFFULL;
+  }
+
+  /// Loop that is currently being executed.
+  struct Job {
+    Job(std::function<void(std::size_t)> function, std::size_t numIterations,
+        std::size_t numThreads)
+        : function(std::move(function)), ranges(numThreads) {
+      assert(numIterations <= std::numeric_limits<std::uint32_t>::max() &&
+             "too many iterations");
+      for (std::size_t t = 0; t < numThreads; t++)
+        ranges[t].bounds = pack(numIterations * t / numThreads,
+                                numIterations * (t + 1) / numThreads);
+    }
+
+    std::function<void(std::size_t)> function;
+    /// Iterations that have not been started yet, one range per thread.
+    std::vector<IterationRange> ranges;
+  };
+
+  /// Returns whether the current thread is executing an iteration.
+  static bool &isInParallelLoop() {
+    thread_local bool isInLoop = false;
+    return isInLoop;
+  }
+
+  /// Returns the index of the current thread in the current loop.
+  static std::size_t &currentThreadIndex() {
+    thread_local std::size_t threadIndex = 0;
+    return threadIndex;
+  }
+
+  /// Takes the first iteration from the given range. Returns false if the
+  /// range is empty.
+  static bool popFront(IterationRange &range, std::size_t &iteration) {
+    auto bounds = range.bounds.load();
+    while (getBegin(bounds) < getEnd(bounds)) {
+      if (range.bounds.compare_exchange_weak(
+              bounds, pack(getBegin(bounds) + 1, getEnd(bounds)))) {
+        iteration = static_cast<std::size_t>(getBegin(bounds));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Moves the upper half of the range of some other thread into the (empty)
+  /// range of thread `self`. Returns false if all ranges are empty.
+  static bool steal(Job &job, std::size_t self) {
+    auto const numThreads = job.ranges.size();
+    for (std::size_t k = 1; k < numThreads; k++) {
+      auto &victim = job.ranges[(self + k) % numThreads];
+      auto bounds = victim.bounds.load();
+      while (getBegin(bounds) < getEnd(bounds)) {
+        auto const begin = getBegin(bounds);
+        auto const end = getEnd(bounds);
+        auto const middle = begin + (end - begin) / 2;
+        if (victim.bounds.compare_exchange_weak(bounds, pack(begin, middle))) {
+          // Indices are never handed out twice, so no other thread can have
+          // observed this value of our range before
+          job.ranges[self].bounds = pack(middle, end);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /// Executes iterations of the given job as thread `self` until there are
+  /// none left.
+  static void runIterations(Job &job, std::size_t self) {
+    isInParallelLoop() = true;
+    currentThreadIndex() = self;
+    do {
+      std::size_t iteration;
+      while (popFront(job.ranges[self], iteration))
+        job.function(iteration);
+    } while (steal(job, self));
+    currentThreadIndex() = 0;
+    isInParallelLoop() = false;
+  }
+
+  /// Main function of the worker threads: waits for jobs and participates in
+  /// them as thread `self` until the pool is destroyed.
+  void runWorker(std::size_t self) {
+    std::size_t seenGeneration = 0;
+    while (true) {
+      Job *job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobAvailable.wait(lock, [&] {
+          return isStopping || currentGeneration != seenGeneration;
+        });
+        if (isStopping)
+          return;
+        seenGeneration = currentGeneration;
+        job = currentJob;
+      }
+
+      runIterations(*job, self);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--numBusyWorkers == 0)
+        jobDone.notify_one();
+    }
+  }
+
+  /// Number of worker threads (excluding the caller of `parallelFor`).
+  std::size_t numWorkers;
+  std::vector<std::thread> workers;
+  /// Serializes concurrent calls to `parallelFor`.
+  std::mutex callerMutex;
+  /// Protects the fields below.
+  std::mutex mutex;
+  std::condition_variable jobAvailable;
+  std::condition_variable jobDone;
+  Job *currentJob = nullptr;
+  /// Incremented for every published job, such that workers recognize new
+  /// jobs.
+  std::size_t currentGeneration = 0;
+  /// Number of workers that have not finished the current job yet.
+  std::size_t numBusyWorkers = 0;
+  bool isStopping = false;
+};
+
+} // namespace database_iterators::utils
+
+#endif // ITERATORS_UTILS_THREADPOOL_H
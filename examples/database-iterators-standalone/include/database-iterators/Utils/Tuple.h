@@ -9,8 +9,10 @@
 #ifndef ITERATORS_UTILS_TUPLE_H
 #define ITERATORS_UTILS_TUPLE_H
 
+#include <cstdint>
 #include <iostream>
 #include <tuple>
+#include <type_traits>
 
 namespace database_iterators::utils {
 
@@ -49,6 +51,54 @@ auto dropFront(const std::tuple<Types...> &tuple) {
   return impl::dropFront<kFrontSize>(tuple, IndexSequence{});
 }
 
+/// Policy for `hashTuple` that combines the field hashes using XOR. This is
+/// cheap but symmetric, so tuples with permuted fields collide and tuples
+/// with two equal fields hash to zero. Furthermore, since `std::hash` is the
+/// identity for integers in common standard libraries, the hash values of
+/// tuples of small integers are small integers. This is the default policy.
+struct XorHashCombiner {
+  static constexpr std::size_t kSeed = 0;
+  static std::size_t combine(std::size_t seed, std::size_t hash) {
+    return seed ^ hash;
+  }
+  static std::size_t finalize(std::size_t seed) { return seed; }
+};
+
+/// Policy for `hashTuple` that combines the field hashes as the coefficients
+/// of a polynomial evaluated at 2^64 divided by the golden ratio. The result
+/// depends on the order of the fields and avoids the collisions of
+/// `XorHashCombiner`, but the hash value of single-field tuples is the hash
+/// value of their field and thus the identity for integers. This preserves the
+/// regular structure of dense integer keys, on which hash tables that scramble
+/// the hash values themselves, such as `FlatHashTable`, produce fewer
+/// collisions than on random hash values.
+struct MultiplyAddHashCombiner {
+  static constexpr std::size_t kSeed = 0;
+  static std::size_t combine(std::size_t seed, std::size_t hash) {
+    return seed * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL) + hash;
+  }
+  static std::size_t finalize(std::size_t seed) { return seed; }
+};
+
+/// Policy for `hashTuple` that combines the field hashes with a
+/// multiply-xorshift scheme: the seed is XORed with the next field hash,
+/// multiplied with 2^64 divided by the golden ratio, and its high half is
+/// folded into its low half. The result depends on the order of the fields and
+/// all of its bits depend on all bits of the field hashes, at the cost of one
+/// multiplication and shift per field. This suits hash tables that use the low
+/// bits of the hash values directly.
+struct MixingHashCombiner {
+  static constexpr std::size_t kSeed =
+      static_cast<std::size_t>(0x243F6A8885A308D3ULL);
+  static std::size_t combine(std::size_t seed, std::size_t hash) {
+    std::uint64_t x = (static_cast<std::uint64_t>(seed) ^
+                       static_cast<std::uint64_t>(hash)) *
+                      0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(x ^ (x >> 32));
+  }
+  static std::size_t finalize(std::size_t seed) { return seed; }
+};
+
 namespace impl {
 template <std::size_t kIndex, typename TupleType>
 std::size_t hashTupleField(const TupleType &tuple) {
@@ -56,29 +106,41 @@ std::size_t hashTupleField(const TupleType &tuple) {
   return hasher(std::get<kIndex>(tuple));
 }
 
-template <typename TupleType, std::size_t... kIndices>
+template <typename CombinerType, typename TupleType, std::size_t... kIndices>
 std::size_t hashTuple(const TupleType &tuple,
                       const std::index_sequence<kIndices...> & /*unused*/) {
-  return (hashTupleField<kIndices>(tuple) ^ ...);
+  std::size_t seed = CombinerType::kSeed;
+  ((seed = CombinerType::combine(seed, hashTupleField<kIndices>(tuple))), ...);
+  return CombinerType::finalize(seed);
 }
 } // namespace impl
 
 /// Computes a hash value from an `std::tuple` combining the values of
-/// `std::hash` of the individual fields using XOR.
-template <typename... Types>
+/// `std::hash` of the individual fields using the given policy, which needs
+/// to provide an initial `kSeed`, a function `combine(seed, hash)` that
+/// combines the current seed with the hash value of the next field, and a
+/// function `finalize(seed)` that computes the final hash value.
+template <typename CombinerType = XorHashCombiner, typename... Types>
 std::size_t hashTuple(const std::tuple<Types...> &tuple) {
   using IndexSequence = std::index_sequence_for<Types...>;
-  return impl::hashTuple(tuple, IndexSequence{});
+  return impl::hashTuple<CombinerType>(tuple, IndexSequence{});
 }
 
 /// Functor class for `hashTuple`.
-template <typename TupleType>
+template <typename TupleType, typename CombinerType = XorHashCombiner>
 struct TupleHasher {
   std::size_t operator()(const TupleType &tuple) const {
-    return hashTuple(tuple);
+    return hashTuple<CombinerType>(tuple);
   }
 };
 
+/// Resolves the `HasherType` parameter of the hash-based operators, where
+/// `void` selects the default `TupleHasher` of the given key tuple type.
+template <typename HasherType, typename TupleType>
+using TupleHasherOrDefault =
+    std::conditional_t<std::is_void_v<HasherType>, TupleHasher<TupleType>,
+                       HasherType>;
+
 namespace impl {
 template <typename TupleType, std::size_t... kIndices>
 void printTupleTail(std::ostream &ostream, const TupleType &tuple,
@@ -0,0 +1,85 @@
+//===-- BatchingOperatorTest.cpp - Unit tests of Batching -------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/BatchingOperator.h"
+#include "database-iterators/Operators/FilterOperator.h"
+
+using namespace database_iterators::operators;
+
+namespace {
+/// Source operator that only implements the tuple-at-a-time protocol and
+/// produces the numbers from 0 to `numTuples - 1`.
+class CountingOperator {
+public:
+  using OutputTuple = std::tuple<int32_t>;
+  using ReturnType = std::optional<OutputTuple>;
+
+  explicit CountingOperator(int32_t numTuples) : numTuples(numTuples) {}
+
+  void open() {}
+  ReturnType computeNext() {
+    if (current >= numTuples)
+      return {};
+    return std::make_tuple(current++);
+  }
+  void close() {}
+
+private:
+  int32_t numTuples;
+  int32_t current{0};
+};
+} // namespace
+
+TEST(BatchingTest, Batches) {
+  CountingOperator counter(1500);
+  auto batching = makeBatchingOperator(&counter);
+  batching.open();
+
+  // Consume result
+  decltype(batching)::BatchType batch;
+  ASSERT_TRUE(batching.computeNextBatch(batch));
+  EXPECT_EQ(batch.size(), 1024U);
+  EXPECT_EQ(batch.get(0), std::make_tuple(0));
+  ASSERT_TRUE(batching.computeNextBatch(batch));
+  EXPECT_EQ(batch.size(), 476U);
+  EXPECT_EQ(batch.get(475), std::make_tuple(1499));
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(batching.computeNextBatch(batch));
+  EXPECT_FALSE(batching.computeNextBatch(batch));
+
+  batching.close();
+}
+
+TEST(BatchingTest, Downstream) {
+  CountingOperator counter(10);
+  auto batching = makeBatchingOperator(&counter);
+  auto filter = makeFilterOperator(
+      &batching, [](auto tuple) { return std::get<0>(tuple) % 3 == 0; });
+  filter.open();
+
+  // Consume result
+  using Result = std::vector<decltype(filter)::OutputTuple>;
+  Result result;
+  decltype(filter)::BatchType batch;
+  while (filter.computeNextBatch(batch))
+    for (size_t i = 0; i < batch.size(); i++)
+      result.emplace_back(batch.get(i));
+
+  // Verify
+  Result referenceResult = {{0}, {3}, {6}, {9}};
+  EXPECT_EQ(result, referenceResult);
+
+  filter.close();
+}
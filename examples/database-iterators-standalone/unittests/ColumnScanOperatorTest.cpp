@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -75,3 +76,34 @@ TEST(ColumnScanTest, MultipleColumn) {
 
   scan.close();
 }
+
+TEST(ColumnScanTest, Batches) {
+  std::vector<int32_t> numbers1(2500);
+  std::vector<int64_t> numbers2(2500);
+  std::iota(numbers1.begin(), numbers1.end(), 0);
+  std::iota(numbers2.begin(), numbers2.end(), 1000);
+  auto scan = makeColumnScanOperator(numbers1, numbers2);
+  scan.open();
+
+  // Consume result
+  decltype(scan)::BatchType batch;
+  std::vector<size_t> batchSizes;
+  std::vector<decltype(scan)::OutputTuple> result;
+  while (scan.computeNextBatch(batch)) {
+    batchSizes.push_back(batch.size());
+    for (size_t i = 0; i < batch.size(); i++)
+      result.push_back(batch.get(i));
+  }
+
+  // Verify
+  EXPECT_EQ(batchSizes, std::vector<size_t>({1024, 1024, 452}));
+  ASSERT_EQ(result.size(), 2500U);
+  for (size_t i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], std::make_tuple(numbers1[i], numbers2[i]));
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(scan.computeNextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+
+  scan.close();
+}
@@ -0,0 +1,140 @@
+//===-- ColumnViewScanOperatorTest.cpp - Unit tests -------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnViewScanOperator.h"
+#include "database-iterators/Operators/ReduceOperator.h"
+
+using namespace database_iterators::operators;
+
+TEST(ColumnViewScanTest, SingleColumn) {
+  std::vector<int32_t> numbers = {1, 2, 3, 4};
+  auto scan = makeColumnViewScanOperator(numbers);
+  scan.open();
+
+  decltype(scan)::ReturnType tuple;
+
+  // Consume the four values
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 1);
+
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 2);
+
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 3);
+
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 4);
+
+  // Check that we have reached the end
+  tuple = scan.computeNext();
+  EXPECT_FALSE(tuple);
+
+  // Check that we can test for the end again
+  tuple = scan.computeNext();
+  EXPECT_FALSE(tuple);
+
+  scan.close();
+}
+
+TEST(ColumnViewScanTest, MultipleColumnsFromPointers) {
+  const int32_t column1[] = {1, 2, 3};
+  const double column2[] = {0.5, 1.5, 2.5};
+  auto scan = makeColumnViewScanOperator(2, column1, column2);
+  scan.open();
+
+  decltype(scan)::ReturnType tuple;
+
+  // Consume only the first two rows
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 1);
+  EXPECT_EQ(std::get<1>(tuple.value()), 0.5);
+
+  tuple = scan.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 2);
+  EXPECT_EQ(std::get<1>(tuple.value()), 1.5);
+
+  // Check that we have reached the end
+  tuple = scan.computeNext();
+  EXPECT_FALSE(tuple);
+
+  scan.close();
+}
+
+TEST(ColumnViewScanTest, BorrowsInput) {
+  std::vector<int32_t> numbers = {1, 2};
+  auto scan = makeColumnViewScanOperator(numbers);
+  scan.open();
+
+  // Modifications of the borrowed column are visible to the scan
+  numbers[1] = 42;
+
+  decltype(scan)::ReturnType tuple;
+  tuple = scan.computeNext();
+  EXPECT_EQ(std::get<0>(tuple.value()), 1);
+  tuple = scan.computeNext();
+  EXPECT_EQ(std::get<0>(tuple.value()), 42);
+
+  scan.close();
+}
+
+TEST(ColumnViewScanTest, Empty) {
+  std::vector<int32_t> numbers;
+  auto scan = makeColumnViewScanOperator(numbers);
+  scan.open();
+  EXPECT_FALSE(scan.computeNext());
+  scan.close();
+}
+
+TEST(ColumnViewScanTest, Upstream) {
+  std::vector<int32_t> numbers = {1, 2, 3, 4};
+  auto scan = makeColumnViewScanOperator(numbers);
+  auto reduce = makeReduceOperator(&scan, [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  });
+  reduce.open();
+
+  auto tuple = reduce.computeNext();
+  EXPECT_TRUE(tuple);
+  EXPECT_EQ(std::get<0>(tuple.value()), 10);
+  EXPECT_FALSE(reduce.computeNext());
+
+  reduce.close();
+}
+
+TEST(ColumnViewScanTest, Batches) {
+  std::vector<int32_t> numbers(1030);
+  for (size_t i = 0; i < numbers.size(); i++)
+    numbers[i] = static_cast<int32_t>(i);
+  auto scan = makeColumnViewScanOperator(numbers);
+  scan.open();
+
+  // Consume result
+  decltype(scan)::BatchType batch;
+  ASSERT_TRUE(scan.computeNextBatch(batch));
+  EXPECT_EQ(batch.size(), 1024U);
+  EXPECT_EQ(batch.column<0>()[1023], 1023);
+  ASSERT_TRUE(scan.computeNextBatch(batch));
+  EXPECT_EQ(batch.size(), 6U);
+  EXPECT_EQ(batch.get(5), std::make_tuple(1029));
+  EXPECT_FALSE(scan.computeNextBatch(batch));
+
+  scan.close();
+}
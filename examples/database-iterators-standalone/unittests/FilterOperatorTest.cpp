@@ -60,3 +60,39 @@ TEST(FilterTest, TwoColumn) {
 
   filter.close();
 }
+
+TEST(FilterTest, Batches) {
+  std::vector<int32_t> numbers1(3000);
+  std::vector<int32_t> numbers2(3000);
+  for (int32_t i = 0; i < 3000; i++) {
+    numbers1[i] = i;
+    numbers2[i] = -i;
+  }
+  auto scan = makeColumnScanOperator(numbers1, numbers2);
+  // Only lets pass tuples from the last of the three input batches
+  auto filter = makeFilterOperator(&scan, [](auto tuple) {
+    return std::get<0>(tuple) % 7 == 0 && std::get<0>(tuple) >= 2048;
+  });
+  filter.open();
+
+  // Consume result
+  using Result = std::vector<decltype(filter)::OutputTuple>;
+  Result result;
+  decltype(filter)::BatchType batch;
+  while (filter.computeNextBatch(batch)) {
+    EXPECT_FALSE(batch.empty());
+    for (size_t i = 0; i < batch.size(); i++)
+      result.emplace_back(batch.get(i));
+  }
+
+  // Verify
+  Result referenceResult;
+  for (int32_t i = 2051; i < 3000; i += 7)
+    referenceResult.emplace_back(i, -i);
+  EXPECT_EQ(result, referenceResult);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(filter.computeNextBatch(batch));
+
+  filter.close();
+}
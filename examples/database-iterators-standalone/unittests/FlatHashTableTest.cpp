@@ -0,0 +1,144 @@
+//===-- FlatHashTableTest.cpp - Unit tests of hash table --------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/FlatHashTable.h"
+#include "database-iterators/Utils/Tuple.h"
+
+using namespace database_iterators::utils;
+
+namespace {
+/// Returns the values of all entries with the given key in sorted order.
+template <typename TableType, typename KeyType>
+auto collectMatches(TableType &table, const KeyType &key) {
+  std::vector<typename decltype(table.begin())::value_type::second_type>
+      values;
+  auto [it, end] = table.equalRange(key);
+  for (; it != end; ++it) {
+    EXPECT_EQ(it->first, key);
+    values.push_back(it->second);
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+} // namespace
+
+TEST(FlatHashTableTest, MultimapSemantics) {
+  FlatHashTable<int32_t, int32_t> table;
+  table.insert(1, 10);
+  table.insert(2, 20);
+  table.insert(1, 11);
+  table.insert(1, 12);
+
+  EXPECT_EQ(table.size(), 4U);
+  EXPECT_EQ(table.getNumKeys(), 2U);
+  EXPECT_EQ(collectMatches(table, 1), std::vector<int32_t>({10, 11, 12}));
+  EXPECT_EQ(collectMatches(table, 2), std::vector<int32_t>({20}));
+  EXPECT_EQ(collectMatches(table, 3), std::vector<int32_t>());
+}
+
+TEST(FlatHashTableTest, MapSemantics) {
+  FlatHashTable<int32_t, int32_t> table;
+  auto [it1, hasInserted1] = table.emplace(1, 10);
+  EXPECT_TRUE(hasInserted1);
+  EXPECT_EQ(it1->second, 10);
+
+  auto [it2, hasInserted2] = table.emplace(1, 11);
+  EXPECT_FALSE(hasInserted2);
+  EXPECT_EQ(it2->second, 10);
+  it2->second = 12;
+
+  EXPECT_EQ(table.find(1)->second, 12);
+  EXPECT_EQ(table.find(2), table.end());
+  EXPECT_EQ(table.size(), 1U);
+}
+
+TEST(FlatHashTableTest, IterationInInsertionOrder) {
+  FlatHashTable<int32_t, int32_t> table;
+  for (int32_t i = 0; i < 5; i++)
+    table.emplace(5 - i, i);
+
+  std::vector<std::pair<int32_t, int32_t>> entries(table.begin(), table.end());
+  std::vector<std::pair<int32_t, int32_t>> referenceEntries = {
+      {5, 0}, {4, 1}, {3, 2}, {2, 3}, {1, 4}};
+  EXPECT_EQ(entries, referenceEntries);
+}
+
+TEST(FlatHashTableTest, Growth) {
+  // Keys that all collide modulo the number of slots without scrambling
+  FlatHashTable<std::tuple<int64_t>, std::tuple<int64_t>,
+                TupleHasher<std::tuple<int64_t>>>
+      table;
+  for (int64_t i = 0; i < 10000; i++) {
+    table.insert(std::make_tuple(i << 20), std::make_tuple(i));
+    table.insert(std::make_tuple(i << 20), std::make_tuple(-i));
+  }
+
+  EXPECT_EQ(table.size(), 20000U);
+  EXPECT_EQ(table.getNumKeys(), 10000U);
+  for (int64_t i = 0; i < 10000; i++) {
+    auto const key = std::make_tuple(i << 20);
+    EXPECT_EQ(collectMatches(table, key),
+              std::vector<std::tuple<int64_t>>({{-i}, {i}}));
+  }
+}
+
+TEST(FlatHashTableTest, Reserve) {
+  FlatHashTable<int32_t, int32_t> table(1000);
+  for (int32_t i = 0; i < 1000; i++)
+    table.emplace(i, i);
+  for (int32_t i = 0; i < 1000; i++)
+    EXPECT_EQ(table.find(i)->second, i);
+}
+
+TEST(FlatHashTableTest, Clear) {
+  FlatHashTable<int32_t, int32_t> table;
+  for (int32_t i = 0; i < 100; i++)
+    table.insert(i % 10, i);
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.getNumKeys(), 0U);
+  EXPECT_EQ(table.find(1), table.end());
+
+  table.insert(1, 10);
+  table.insert(1, 11);
+  EXPECT_EQ(table.size(), 2U);
+  EXPECT_EQ(collectMatches(table, 1), std::vector<int32_t>({10, 11}));
+}
+
+TEST(FlatHashTableTest, IndexTypeOverflow) {
+  // `uint8_t` indices leave room for 255 entries
+  FlatHashTable<int32_t, int32_t, std::hash<int32_t>, uint8_t> table;
+  for (int32_t i = 0; i < 255; i++)
+    table.insert(i % 10, i);
+  EXPECT_THROW(table.insert(1, 255), std::length_error);
+  EXPECT_THROW(table.insert(10, 255), std::length_error);
+  EXPECT_EQ(table.size(), 255U);
+  EXPECT_EQ(table.getNumKeys(), 10U);
+}
+
+TEST(FlatHashTableTest, Arena) {
+  using Allocator = ArenaAllocator<std::pair<int32_t, int32_t>>;
+  Arena arena;
+  FlatHashTable<int32_t, int32_t, std::hash<int32_t>, uint32_t, Allocator>
+      table(0, Allocator(&arena));
+  for (int32_t i = 0; i < 10000; i++)
+    table.insert(i % 1000, i);
+  EXPECT_GE(arena.getNumAllocatedBytes(), 10000 * sizeof(std::pair<int, int>));
+  EXPECT_EQ(table.getNumKeys(), 1000U);
+  EXPECT_EQ(collectMatches(table, 7).size(), 10U);
+}
@@ -9,10 +9,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <tuple>
 #include <vector>
 
 #include "database-iterators/Operators/ColumnScanOperator.h"
 #include "database-iterators/Operators/HashJoinOperator.h"
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Tuple.h"
 
 using namespace database_iterators::operators;
 
@@ -125,3 +128,152 @@ TEST(HashJoinTest, NoValueRight) {
   std::sort(referenceResult.begin(), referenceResult.end());
   EXPECT_EQ(result, referenceResult);
 }
+
+TEST(HashJoinTest, Batches) {
+  // Every probe-side tuple matches three build-side tuples, so the output
+  // spans several batches and batch boundaries fall between the matches of a
+  // single probe-side tuple
+  std::vector<int32_t> leftKeys;
+  std::vector<int32_t> leftValues;
+  for (int32_t i = 0; i < 3; i++) {
+    for (int32_t key = 0; key < 1000; key++) {
+      leftKeys.push_back(key);
+      leftValues.push_back(i);
+    }
+  }
+  std::vector<int32_t> rightKeys(2000);
+  std::vector<int32_t> rightValues(2000);
+  for (int32_t i = 0; i < 2000; i++) {
+    rightKeys[i] = i;
+    rightValues[i] = -i;
+  }
+
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin = makeHashJoinOperator<1>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+
+  // Consume result of hashJoin
+  hashJoin.open();
+  decltype(hashJoin)::BatchType batch;
+  std::vector<ResultTuple> result;
+  while (hashJoin.computeNextBatch(batch))
+    for (size_t i = 0; i < batch.size(); i++)
+      result.emplace_back(batch.get(i));
+
+  // Compare with correct result
+  std::vector<ResultTuple> referenceResult;
+  for (int32_t key = 0; key < 1000; key++)
+    for (int32_t i = 0; i < 3; i++)
+      referenceResult.emplace_back(key, i, -key);
+  std::sort(result.begin(), result.end());
+  EXPECT_EQ(result, referenceResult);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(hashJoin.computeNextBatch(batch));
+
+  hashJoin.close();
+}
+
+TEST(HashJoinTest, Arena) {
+  std::vector<int32_t> leftKeys(1000);
+  std::vector<int32_t> leftValues(1000);
+  std::vector<int32_t> rightKeys(1000);
+  std::vector<int32_t> rightValues(1000);
+  for (int32_t i = 0; i < 1000; i++) {
+    leftKeys[i] = i / 2;
+    leftValues[i] = i;
+    rightKeys[i] = i;
+    rightValues[i] = -i;
+  }
+
+  database_iterators::utils::Arena arena;
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin = makeHashJoinOperator<1>(&leftScan, &rightScan, 0, &arena);
+
+  // Consume result of hashJoin
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+  hashJoin.open();
+  EXPECT_GT(arena.getNumAllocatedBytes(), 0U);
+  std::vector<ResultTuple> result;
+  while (auto const tuple = hashJoin.computeNext())
+    result.push_back(tuple.value());
+  hashJoin.close();
+
+  // Compare with correct result
+  std::vector<ResultTuple> referenceResult;
+  for (int32_t key = 0; key < 500; key++)
+    for (int32_t i = 0; i < 2; i++)
+      referenceResult.emplace_back(key, 2 * key + i, -key);
+  std::sort(result.begin(), result.end());
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(HashJoinTest, MixingHashCombiner) {
+  // Keys that collide with the default `XorHashCombiner`
+  std::vector<int32_t> leftKeys1 = {1, 2, 1, 2};
+  std::vector<int32_t> leftKeys2 = {2, 1, 1, 2};
+  std::vector<int32_t> leftValues = {1, 2, 3, 4};
+  std::vector<int32_t> rightKeys1 = {2, 2, 3};
+  std::vector<int32_t> rightKeys2 = {1, 2, 3};
+  std::vector<int32_t> rightValues = {5, 6, 7};
+
+  auto leftScan = makeColumnScanOperator(leftKeys1, leftKeys2, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys1, rightKeys2, rightValues);
+  using Hasher = database_iterators::utils::TupleHasher<
+      std::tuple<int32_t, int32_t>,
+      database_iterators::utils::MixingHashCombiner>;
+  auto hashJoin = makeHashJoinOperator<2, Hasher>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+
+  // Consume result of hashJoin
+  hashJoin.open();
+  std::vector<ResultTuple> result;
+  while (const auto tuple = hashJoin.computeNext())
+    result.emplace_back(tuple.value());
+  hashJoin.close();
+
+  // Compare with correct result
+  std::vector<ResultTuple> referenceResult = {{2, 1, 2, 5}, {2, 2, 4, 6}};
+  std::sort(result.begin(), result.end());
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(HashJoinTest, Reopen) {
+  std::vector<int32_t> leftKeys(1000);
+  std::vector<int32_t> leftValues(1000);
+  std::vector<int32_t> rightKeys(1000);
+  std::vector<int32_t> rightValues(1000);
+  for (int32_t i = 0; i < 1000; i++) {
+    leftKeys[i] = i / 2;
+    leftValues[i] = i;
+    rightKeys[i] = i;
+    rightValues[i] = -i;
+  }
+
+  database_iterators::utils::Arena arena;
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin = makeHashJoinOperator<1>(&leftScan, &rightScan, 0, &arena);
+
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+  auto const run = [&]() {
+    hashJoin.open();
+    std::vector<ResultTuple> result;
+    while (auto const tuple = hashJoin.computeNext())
+      result.push_back(tuple.value());
+    hashJoin.close();
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  auto const result = run();
+  EXPECT_EQ(result.size(), 1000U);
+  auto const numAllocatedBytes = arena.getNumAllocatedBytes();
+
+  // Running the plan again reuses the hash table instead of growing the arena
+  EXPECT_EQ(run(), result);
+  EXPECT_EQ(arena.getNumAllocatedBytes(), numAllocatedBytes);
+}
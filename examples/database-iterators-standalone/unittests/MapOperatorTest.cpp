@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -77,3 +78,30 @@ TEST(MapTest, TypeChangingMap) {
 
   map.close();
 }
+
+TEST(MapTest, Batches) {
+  std::vector<int32_t> numbers(2000);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  auto scan = makeColumnScanOperator(numbers);
+  auto map = makeMapOperator(&scan, [](auto tuple) {
+    return std::make_tuple(std::get<0>(tuple), std::get<0>(tuple) * 0.5);
+  });
+  map.open();
+
+  // Consume result
+  decltype(map)::BatchType batch;
+  std::vector<decltype(map)::OutputTuple> result;
+  while (map.computeNextBatch(batch))
+    for (size_t i = 0; i < batch.size(); i++)
+      result.push_back(batch.get(i));
+
+  // Verify
+  ASSERT_EQ(result.size(), numbers.size());
+  for (int32_t i = 0; i < 2000; i++)
+    EXPECT_EQ(result[i], std::make_tuple(i, i * 0.5));
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(map.computeNextBatch(batch));
+
+  map.close();
+}
@@ -0,0 +1,210 @@
+//===-- MergeJoinOperatorTest.cpp - Unit tests of MergeJoin -----*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnScanOperator.h"
+#include "database-iterators/Operators/HashJoinOperator.h"
+#include "database-iterators/Operators/MergeJoinOperator.h"
+#include "database-iterators/Operators/SortOperator.h"
+
+using namespace database_iterators::operators;
+
+TEST(MergeJoinTest, SingleColumnKey) {
+  std::vector<int32_t> leftKeys = {1, 1, 2, 2, 5};
+  std::vector<int32_t> leftValues = {1, 2, 1, 2, 5};
+  std::vector<int32_t> rightKeys = {1, 1, 2, 2, 6};
+  std::vector<int32_t> rightValues = {3, 4, 3, 4, 6};
+
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto mergeJoin = makeMergeJoinOperator<1>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(mergeJoin)::OutputTuple;
+
+  // Consume result of mergeJoin
+  mergeJoin.open();
+  std::vector<ResultTuple> result;
+  while (const auto tuple = mergeJoin.computeNext())
+    result.emplace_back(tuple.value());
+
+  // Compare with correct result, which is sorted by key
+  std::vector<ResultTuple> referenceResult = {
+      {1, 1, 3}, {1, 2, 3}, {1, 1, 4}, {1, 2, 4}, //
+      {2, 1, 3}, {2, 2, 3}, {2, 1, 4}, {2, 2, 4}};
+  EXPECT_EQ(result, referenceResult);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(mergeJoin.computeNext());
+
+  mergeJoin.close();
+}
+
+TEST(MergeJoinTest, TwoColumnKey) {
+  std::vector<int32_t> leftKeys1 = {1, 1, 1};
+  std::vector<int32_t> leftKeys2 = {1, 2, 2};
+  std::vector<int32_t> leftValues = {2, 3, 4};
+  std::vector<int32_t> rightKeys1 = {1, 1};
+  std::vector<int32_t> rightKeys2 = {2, 3};
+  std::vector<int32_t> rightValues = {5, 6};
+
+  auto leftScan = makeColumnScanOperator(leftKeys1, leftKeys2, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys1, rightKeys2, rightValues);
+  auto mergeJoin = makeMergeJoinOperator<2>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(mergeJoin)::OutputTuple;
+
+  // Consume result of mergeJoin
+  mergeJoin.open();
+  std::vector<ResultTuple> result;
+  while (const auto tuple = mergeJoin.computeNext())
+    result.emplace_back(tuple.value());
+  mergeJoin.close();
+
+  // Compare with correct result
+  std::vector<ResultTuple> referenceResult = {{1, 2, 3, 5}, {1, 2, 4, 5}};
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(MergeJoinTest, NoMatches) {
+  std::vector<int32_t> leftKeys = {1, 3, 5};
+  std::vector<int32_t> rightKeys = {0, 2, 4, 6};
+
+  auto leftScan = makeColumnScanOperator(leftKeys);
+  auto rightScan = makeColumnScanOperator(rightKeys);
+  auto mergeJoin = makeMergeJoinOperator<1>(&leftScan, &rightScan);
+
+  mergeJoin.open();
+  EXPECT_FALSE(mergeJoin.computeNext());
+  EXPECT_FALSE(mergeJoin.computeNext());
+  mergeJoin.close();
+}
+
+TEST(MergeJoinTest, SortedInputs) {
+  // Unsorted inputs with duplicate keys on both sides
+  std::vector<int32_t> leftKeys(2000);
+  std::vector<int32_t> leftValues(2000);
+  std::vector<int32_t> rightKeys(3000);
+  std::vector<int64_t> rightValues(3000);
+  for (int32_t i = 0; i < 2000; i++) {
+    leftKeys[i] = (i * 7919) % 500;
+    leftValues[i] = i;
+  }
+  for (int32_t i = 0; i < 3000; i++) {
+    rightKeys[i] = (i * 104729) % 1000;
+    rightValues[i] = -i;
+  }
+
+  auto leftScan1 = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan1 = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin = makeHashJoinOperator<1>(&leftScan1, &rightScan1);
+
+  auto leftScan2 = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan2 = makeColumnScanOperator(rightKeys, rightValues);
+  auto leftSort = makeSortOperator<1>(&leftScan2);
+  auto rightSort = makeSortOperator<1>(&rightScan2);
+  auto mergeJoin = makeMergeJoinOperator<1>(&leftSort, &rightSort);
+
+  using ResultTuple = decltype(mergeJoin)::OutputTuple;
+
+  // Consume results of both joins
+  std::vector<ResultTuple> referenceResult;
+  hashJoin.open();
+  while (const auto tuple = hashJoin.computeNext())
+    referenceResult.emplace_back(tuple.value());
+  hashJoin.close();
+
+  std::vector<ResultTuple> result;
+  mergeJoin.open();
+  while (const auto tuple = mergeJoin.computeNext())
+    result.emplace_back(tuple.value());
+  mergeJoin.close();
+
+  // The merge join returns its result sorted by key
+  EXPECT_TRUE(std::is_sorted(result.begin(), result.end(),
+                             [](auto const &lhs, auto const &rhs) {
+                               return std::get<0>(lhs) < std::get<0>(rhs);
+                             }));
+  std::sort(result.begin(), result.end());
+  std::sort(referenceResult.begin(), referenceResult.end());
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(MergeJoinTest, Batches) {
+  // Produces more matches than fit into one batch
+  std::vector<int32_t> leftKeys(2000);
+  std::vector<int32_t> leftValues(2000);
+  std::vector<int32_t> rightKeys(2000);
+  std::vector<int32_t> rightValues(2000);
+  for (int32_t i = 0; i < 2000; i++) {
+    leftKeys[i] = i / 2;
+    leftValues[i] = i;
+    rightKeys[i] = i;
+    rightValues[i] = -i;
+  }
+
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto mergeJoin = makeMergeJoinOperator<1>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(mergeJoin)::OutputTuple;
+
+  // Consume result of mergeJoin
+  mergeJoin.open();
+  decltype(mergeJoin)::BatchType batch;
+  std::vector<ResultTuple> result;
+  size_t numBatches = 0;
+  while (mergeJoin.computeNextBatch(batch)) {
+    numBatches++;
+    for (size_t i = 0; i < batch.size(); i++)
+      result.emplace_back(batch.get(i));
+  }
+
+  // Compare with correct result
+  std::vector<ResultTuple> referenceResult;
+  for (int32_t key = 0; key < 1000; key++) {
+    referenceResult.emplace_back(key, 2 * key, -key);
+    referenceResult.emplace_back(key, 2 * key + 1, -key);
+  }
+  EXPECT_EQ(result, referenceResult);
+  EXPECT_EQ(numBatches, 2U);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(mergeJoin.computeNextBatch(batch));
+
+  mergeJoin.close();
+}
+
+TEST(MergeJoinTest, Reopen) {
+  std::vector<int32_t> leftKeys = {1, 1, 2, 2, 5};
+  std::vector<int32_t> leftValues = {1, 2, 1, 2, 5};
+  std::vector<int32_t> rightKeys = {1, 1, 2, 2, 6};
+  std::vector<int32_t> rightValues = {3, 4, 3, 4, 6};
+
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto mergeJoin = makeMergeJoinOperator<1>(&leftScan, &rightScan);
+
+  using ResultTuple = decltype(mergeJoin)::OutputTuple;
+  auto const run = [&]() {
+    mergeJoin.open();
+    std::vector<ResultTuple> result;
+    while (const auto tuple = mergeJoin.computeNext())
+      result.emplace_back(tuple.value());
+    mergeJoin.close();
+    return result;
+  };
+  auto const result = run();
+  EXPECT_EQ(result.size(), 8U);
+
+  // Closing resets the join such that running the plan again yields the same
+  EXPECT_EQ(run(), result);
+}
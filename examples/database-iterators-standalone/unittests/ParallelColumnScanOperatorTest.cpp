@@ -0,0 +1,142 @@
+//===-- ParallelColumnScanOperatorTest.cpp - Tests --------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/FilterOperator.h"
+#include "database-iterators/Operators/MapOperator.h"
+#include "database-iterators/Operators/ParallelColumnScanOperator.h"
+#include "database-iterators/Operators/ReduceOperator.h"
+#include "database-iterators/Utils/FlatHashTable.h"
+#include "database-iterators/Utils/PipelineDriver.h"
+#include "database-iterators/Utils/ThreadPool.h"
+
+using namespace database_iterators::operators;
+using namespace database_iterators::utils;
+
+TEST(ParallelColumnScanTest, SequentialScan) {
+  std::vector<int32_t> numbers = {1, 2, 3, 4, 5};
+  std::vector<int64_t> squares = {1, 4, 9, 16, 25};
+  auto scan = makeParallelColumnScanOperator(2, numbers, squares);
+  scan.open();
+
+  // Consume result
+  std::vector<std::tuple<int32_t, int64_t>> result;
+  while (const auto tuple = scan.computeNext())
+    result.emplace_back(tuple.value());
+
+  // Compare with correct result
+  std::vector<std::tuple<int32_t, int64_t>> referenceResult = {
+      {1, 1}, {2, 4}, {3, 9}, {4, 16}, {5, 25}};
+  EXPECT_EQ(result, referenceResult);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(scan.computeNext());
+
+  scan.close();
+}
+
+TEST(ParallelColumnScanTest, Morsels) {
+  std::vector<int32_t> numbers(10);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  auto scan = makeParallelColumnScanOperator(4, numbers);
+  ASSERT_EQ(scan.getNumMorsels(), 3U);
+
+  // The last morsel holds the remaining rows
+  std::vector<std::vector<int32_t>> referenceMorsels = {
+      {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9}};
+  for (size_t m = 0; m < scan.getNumMorsels(); m++) {
+    auto morselScan = scan.getMorselScan(m);
+    morselScan.open();
+    std::vector<int32_t> morsel;
+    while (const auto tuple = morselScan.computeNext())
+      morsel.push_back(std::get<0>(tuple.value()));
+    morselScan.close();
+    EXPECT_EQ(morsel, referenceMorsels[m]);
+  }
+}
+
+TEST(ParallelColumnScanTest, EmptyInput) {
+  std::vector<int32_t> numbers;
+  auto scan = makeParallelColumnScanOperator(4, numbers);
+  EXPECT_EQ(scan.getNumMorsels(), 0U);
+}
+
+TEST(PipelineDriverTest, FilterMapReduce) {
+  std::vector<int64_t> numbers(100000);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  auto scan = makeParallelColumnScanOperator(1000, numbers);
+  ThreadPool pool(4);
+
+  // Sum up the squares of the even numbers, one partial sum per thread
+  auto const partialSums = runPipelineOnMorsels(
+      pool, scan, int64_t{0}, [](auto &morselScan, int64_t &sum) {
+        auto filter = makeFilterOperator(&morselScan, [](auto tuple) {
+          return std::get<0>(tuple) % 2 == 0;
+        });
+        auto map = makeMapOperator(&filter, [](auto tuple) {
+          return std::make_tuple(std::get<0>(tuple) * std::get<0>(tuple));
+        });
+        auto reduce = makeReduceOperator(&map, [](auto t1, auto t2) {
+          return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+        });
+        reduce.open();
+        if (auto const tuple = reduce.computeNext())
+          sum += std::get<0>(tuple.value());
+        reduce.close();
+      });
+  EXPECT_EQ(partialSums.size(), pool.getNumThreads());
+
+  int64_t referenceSum = 0;
+  for (int64_t i = 0; i < 100000; i += 2)
+    referenceSum += i * i;
+  EXPECT_EQ(std::accumulate(partialSums.begin(), partialSums.end(), int64_t{0}),
+            referenceSum);
+}
+
+TEST(PipelineDriverTest, PartialAggregation) {
+  std::vector<int32_t> keys(50000);
+  std::vector<int64_t> values(50000);
+  for (int32_t i = 0; i < 50000; i++) {
+    keys[i] = i % 100;
+    values[i] = i;
+  }
+  auto scan = makeParallelColumnScanOperator(512, keys, values);
+  ThreadPool pool(3);
+
+  // Group by key into thread-local tables, then merge them
+  using HashTable = FlatHashTable<int32_t, int64_t>;
+  auto const partialAggregates = runPipelineOnMorsels(
+      pool, scan, HashTable(), [](auto &morselScan, HashTable &table) {
+        morselScan.open();
+        while (auto const tuple = morselScan.computeNext()) {
+          auto const [key, value] = tuple.value();
+          auto const [it, hasInserted] = table.emplace(key, value);
+          if (!hasInserted)
+            it->second += value;
+        }
+        morselScan.close();
+      });
+  HashTable result;
+  for (auto const &table : partialAggregates) {
+    for (auto const &[key, value] : table) {
+      auto const [it, hasInserted] = result.emplace(key, value);
+      if (!hasInserted)
+        it->second += value;
+    }
+  }
+
+  ASSERT_EQ(result.size(), 100U);
+  for (int32_t key = 0; key < 100; key++)
+    EXPECT_EQ(result.find(key)->second, 500 * key + 100 * (499 * 500 / 2));
+}
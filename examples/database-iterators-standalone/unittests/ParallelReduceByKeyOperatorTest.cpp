@@ -0,0 +1,325 @@
+//===-- ParallelReduceByKeyOperatorTest.cpp - Tests -------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnScanOperator.h"
+#include "database-iterators/Operators/FilterOperator.h"
+#include "database-iterators/Operators/MapOperator.h"
+#include "database-iterators/Operators/ParallelColumnScanOperator.h"
+#include "database-iterators/Operators/ParallelReduceByKeyOperator.h"
+#include "database-iterators/Operators/ReduceByKeyOperator.h"
+#include "database-iterators/Utils/PipelineDriver.h"
+#include "database-iterators/Utils/ThreadPool.h"
+#include "database-iterators/Utils/Tuple.h"
+
+using namespace database_iterators::operators;
+using namespace database_iterators::utils;
+
+namespace {
+/// Consumes all tuples of the given operator into a map from key to value
+/// and checks that every key is returned only once.
+template <typename OperatorType>
+std::map<int32_t, int64_t> collectGroups(OperatorType &op) {
+  std::map<int32_t, int64_t> result;
+  op.open();
+  while (const auto tuple = op.computeNext()) {
+    auto const [key, value] = tuple.value();
+    EXPECT_EQ(result.count(key), 0U);
+    result.emplace(key, value);
+  }
+  EXPECT_FALSE(op.computeNext());
+  op.close();
+  return result;
+}
+
+/// Sums up `numTuples` values grouped by keys in `[0, numGroups)` with both
+/// the parallel and the sequential operator and compares their results.
+void testAgainstReduceByKey(ThreadPool &pool, int32_t numTuples,
+                            int32_t numGroups, std::size_t maxLocalGroups) {
+  std::vector<int32_t> keys(numTuples);
+  std::vector<int64_t> values(numTuples);
+  for (int32_t i = 0; i < numTuples; i++) {
+    keys[i] = (i * 7919) % numGroups;
+    values[i] = i;
+  }
+  auto const sum = [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  };
+
+  auto scan1 = makeColumnScanOperator(keys, values);
+  auto reduceByKey = makeReduceByKeyOperator<1>(&scan1, sum);
+  auto scan2 = makeColumnScanOperator(keys, values);
+  auto parallelReduceByKey =
+      makeParallelReduceByKeyOperator<1>(&scan2, sum, &pool, maxLocalGroups);
+
+  auto const referenceResult = collectGroups(reduceByKey);
+  EXPECT_EQ(referenceResult.size(), static_cast<size_t>(numGroups));
+  EXPECT_EQ(collectGroups(parallelReduceByKey), referenceResult);
+}
+} // namespace
+
+TEST(ParallelReduceByKeyTest, SingleColumnKey) {
+  std::vector<int32_t> keys = {1, 2, 1, 2};
+  std::vector<int64_t> values = {1, 2, 3, 4};
+  auto scan = makeColumnScanOperator(keys, values);
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool);
+
+  std::map<int32_t, int64_t> referenceResult = {{1, 4}, {2, 6}};
+  EXPECT_EQ(collectGroups(reduceByKey), referenceResult);
+}
+
+TEST(ParallelReduceByKeyTest, TwoColumnKey) {
+  std::vector<int32_t> keys1 = {1, 1, 1, 1};
+  std::vector<int32_t> keys2 = {1, 2, 1, 2};
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  auto scan = makeColumnScanOperator(keys1, keys2, values);
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<2>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool);
+
+  // Consume result of reduceByKey
+  using ResultType =
+      std::map<std::tuple<int32_t, int32_t>, std::tuple<int32_t>>;
+  ResultType result;
+  reduceByKey.open();
+  while (const auto tuple = reduceByKey.computeNext()) {
+    auto const key = takeFront<2>(tuple.value());
+    auto const value = dropFront<2>(tuple.value());
+    EXPECT_EQ(result.count(key), 0U);
+    result.emplace(key, value);
+  }
+  reduceByKey.close();
+
+  // Compare with correct result
+  ResultType referenceResult = {{{1, 1}, {4}}, {{1, 2}, {6}}};
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(ParallelReduceByKeyTest, EmptyInput) {
+  std::vector<int32_t> keys;
+  std::vector<int64_t> values;
+  auto scan = makeColumnScanOperator(keys, values);
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool);
+
+  EXPECT_TRUE(collectGroups(reduceByKey).empty());
+}
+
+TEST(ParallelReduceByKeyTest, FewGroups) {
+  ThreadPool pool(4);
+  testAgainstReduceByKey(pool, 100000, 10, 1 << 14);
+}
+
+TEST(ParallelReduceByKeyTest, Spilling) {
+  // Every thread-local table overflows many times
+  ThreadPool pool(4);
+  testAgainstReduceByKey(pool, 100000, 20000, 64);
+}
+
+TEST(ParallelReduceByKeyTest, Growth) {
+  // Thread-local tables grow beyond their initial size instead of spilling
+  ThreadPool pool(4);
+  testAgainstReduceByKey(pool, 100000, 20000, 1 << 16);
+}
+
+TEST(ParallelReduceByKeyTest, SingleThread) {
+  ThreadPool pool(1);
+  testAgainstReduceByKey(pool, 10000, 3000, 100);
+}
+
+TEST(ParallelReduceByKeyTest, Batches) {
+  // Produces more groups than fit into one batch
+  std::vector<int32_t> keys(6000);
+  std::vector<int64_t> values(6000);
+  for (int32_t i = 0; i < 6000; i++) {
+    keys[i] = i % 1500;
+    values[i] = i;
+  }
+  auto scan = makeColumnScanOperator(keys, values);
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool);
+
+  // Consume result of reduceByKey
+  reduceByKey.open();
+  decltype(reduceByKey)::BatchType batch;
+  std::map<int32_t, int64_t> result;
+  size_t numBatches = 0;
+  while (reduceByKey.computeNextBatch(batch)) {
+    numBatches++;
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto const [key, value] = batch.get(i);
+      EXPECT_EQ(result.count(key), 0U);
+      result.emplace(key, value);
+    }
+  }
+
+  // Compare with correct result
+  std::map<int32_t, int64_t> referenceResult;
+  for (int32_t key = 0; key < 1500; key++)
+    referenceResult.emplace(key, 4 * key + 1500 * (0 + 1 + 2 + 3));
+  EXPECT_EQ(result, referenceResult);
+  EXPECT_EQ(numBatches, 2U);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(reduceByKey.computeNextBatch(batch));
+
+  reduceByKey.close();
+}
+
+TEST(ParallelReduceByKeyTest, MixingHashCombiner) {
+  // Grid of keys, many of which collide with the default `XorHashCombiner`
+  std::vector<int32_t> keys1;
+  std::vector<int32_t> keys2;
+  std::vector<int64_t> values;
+  for (int32_t i = 0; i < 4 * 64 * 64; i++) {
+    keys1.push_back(i % 64);
+    keys2.push_back(i / 64 % 64);
+    values.push_back(1);
+  }
+  auto scan = makeColumnScanOperator(keys1, keys2, values);
+  ThreadPool pool(4);
+  using Hasher =
+      TupleHasher<std::tuple<int32_t, int32_t>, MixingHashCombiner>;
+  auto reduceByKey = makeParallelReduceByKeyOperator<2, Hasher>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool, 256);
+
+  // Consume result of reduceByKey
+  using ResultType =
+      std::map<std::tuple<int32_t, int32_t>, std::tuple<int64_t>>;
+  ResultType result;
+  reduceByKey.open();
+  while (const auto tuple = reduceByKey.computeNext()) {
+    auto const key = takeFront<2>(tuple.value());
+    auto const value = dropFront<2>(tuple.value());
+    EXPECT_EQ(result.count(key), 0U);
+    result.emplace(key, value);
+  }
+  reduceByKey.close();
+
+  // Compare with correct result
+  ResultType referenceResult;
+  for (int32_t i = 0; i < 64 * 64; i++)
+    referenceResult[{i % 64, i / 64}] = {4};
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(ParallelReduceByKeyTest, Morsels) {
+  std::vector<int32_t> keys(100000);
+  std::vector<int64_t> values(100000);
+  for (int32_t i = 0; i < 100000; i++) {
+    keys[i] = (i * 7919) % 20000;
+    values[i] = i;
+  }
+  auto const isEven = [](auto tuple) { return std::get<1>(tuple) % 2 == 0; };
+  auto const square = [](auto tuple) {
+    return std::make_tuple(std::get<0>(tuple),
+                           std::get<1>(tuple) * std::get<1>(tuple));
+  };
+  auto const sum = [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  };
+
+  // Run the filter and the map on each morsel of the scan
+  auto scan = makeParallelColumnScanOperator(1000, keys, values);
+  auto pipeline = makeMorselPipeline<std::tuple<int32_t, int64_t>>(
+      &scan, [&](auto &morselScan, auto &consume) {
+        auto filter = makeFilterOperator(&morselScan, isEven);
+        auto map = makeMapOperator(&filter, square);
+        consume(map);
+      });
+  ThreadPool pool(4);
+  auto parallelReduceByKey =
+      makeParallelReduceByKeyOperator<1>(&pipeline, sum, &pool, 64);
+
+  auto referenceScan = makeColumnScanOperator(keys, values);
+  auto referenceFilter = makeFilterOperator(&referenceScan, isEven);
+  auto referenceMap = makeMapOperator(&referenceFilter, square);
+  auto reduceByKey = makeReduceByKeyOperator<1>(&referenceMap, sum);
+
+  auto const referenceResult = collectGroups(reduceByKey);
+  EXPECT_EQ(referenceResult.size(), 10000U);
+  EXPECT_EQ(collectGroups(parallelReduceByKey), referenceResult);
+
+  // Opening the operator again runs the pipeline again
+  EXPECT_EQ(collectGroups(parallelReduceByKey), referenceResult);
+}
+
+TEST(ParallelReduceByKeyTest, MorselsEmptyInput) {
+  std::vector<int32_t> keys;
+  std::vector<int64_t> values;
+  auto scan = makeParallelColumnScanOperator(1000, keys, values);
+  auto pipeline = makeMorselPipeline<std::tuple<int32_t, int64_t>>(
+      &scan, [](auto &morselScan, auto &consume) { consume(morselScan); });
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+      &pipeline,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool);
+  EXPECT_TRUE(collectGroups(reduceByKey).empty());
+}
+
+TEST(ParallelReduceByKeyTest, Reopen) {
+  std::vector<int32_t> keys(100000);
+  std::vector<int64_t> values(100000);
+  for (int32_t i = 0; i < 100000; i++) {
+    keys[i] = (i * 7919) % 20000;
+    values[i] = i;
+  }
+  auto scan = makeColumnScanOperator(keys, values);
+  ThreadPool pool(4);
+  auto reduceByKey = makeParallelReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      &pool, 64);
+
+  auto const result = collectGroups(reduceByKey);
+  EXPECT_EQ(result.size(), 20000U);
+  EXPECT_EQ(collectGroups(reduceByKey), result);
+
+  // Opened from within a loop of a larger pool, the iterations run on threads
+  // whose indices exceed the number of per-thread arenas of the operator
+  ThreadPool outerPool(8);
+  outerPool.parallelFor(8, [&](std::size_t i) {
+    if (i == 7) {
+      EXPECT_EQ(collectGroups(reduceByKey), result);
+    }
+  });
+}
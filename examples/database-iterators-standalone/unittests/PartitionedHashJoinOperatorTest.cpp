@@ -0,0 +1,220 @@
+//===-- PartitionedHashJoinOperatorTest.cpp - Tests -------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnScanOperator.h"
+#include "database-iterators/Operators/HashJoinOperator.h"
+#include "database-iterators/Operators/PartitionedHashJoinOperator.h"
+#include "database-iterators/Utils/ThreadPool.h"
+#include "database-iterators/Utils/Tuple.h"
+
+using namespace database_iterators::operators;
+using namespace database_iterators::utils;
+
+namespace {
+/// Consumes all tuples of the given operator and returns them sorted.
+template <typename OperatorType>
+auto collectSorted(OperatorType &op) {
+  std::vector<typename OperatorType::OutputTuple> result;
+  op.open();
+  while (const auto tuple = op.computeNext())
+    result.emplace_back(tuple.value());
+  EXPECT_FALSE(op.computeNext());
+  op.close();
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/// Builds inputs of the given sizes with keys in `[0, numKeys)` and compares
+/// the result of the partitioned hash join with that of `HashJoinOperator`.
+void testAgainstHashJoin(ThreadPool &pool, int32_t numBuildTuples,
+                         int32_t numProbeTuples, int32_t numKeys,
+                         unsigned numPartitionBits) {
+  std::vector<int32_t> leftKeys(numBuildTuples);
+  std::vector<int32_t> leftValues(numBuildTuples);
+  std::vector<int32_t> rightKeys(numProbeTuples);
+  std::vector<int64_t> rightValues(numProbeTuples);
+  for (int32_t i = 0; i < numBuildTuples; i++) {
+    leftKeys[i] = static_cast<int32_t>((int64_t{i} * 7919) % numKeys);
+    leftValues[i] = i;
+  }
+  for (int32_t i = 0; i < numProbeTuples; i++) {
+    rightKeys[i] =
+        static_cast<int32_t>((int64_t{i} * 104729) % (2 * numKeys));
+    rightValues[i] = -i;
+  }
+
+  auto leftScan1 = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan1 = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin = makeHashJoinOperator<1>(&leftScan1, &rightScan1);
+
+  auto leftScan2 = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan2 = makeColumnScanOperator(rightKeys, rightValues);
+  auto partitionedHashJoin = makePartitionedHashJoinOperator<1>(
+      &leftScan2, &rightScan2, &pool, numPartitionBits);
+
+  auto const referenceResult = collectSorted(hashJoin);
+  EXPECT_FALSE(referenceResult.empty());
+  EXPECT_EQ(collectSorted(partitionedHashJoin), referenceResult);
+}
+} // namespace
+
+TEST(PartitionedHashJoinTest, SingleColumnKey) {
+  std::vector<int32_t> leftKeys = {1, 2, 1, 2, 5};
+  std::vector<int32_t> leftValues = {1, 1, 2, 2, 5};
+  std::vector<int32_t> rightKeys = {6, 1, 2, 1, 2};
+  std::vector<int32_t> rightValues = {6, 3, 3, 4, 4};
+
+  ThreadPool pool(2);
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin =
+      makePartitionedHashJoinOperator<1>(&leftScan, &rightScan, &pool);
+
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+  std::vector<ResultTuple> referenceResult = {
+      {1, 1, 3}, {1, 1, 4}, {1, 2, 3}, {1, 2, 4}, //
+      {2, 1, 3}, {2, 1, 4}, {2, 2, 3}, {2, 2, 4}};
+  EXPECT_EQ(collectSorted(hashJoin), referenceResult);
+}
+
+TEST(PartitionedHashJoinTest, TwoColumnKey) {
+  std::vector<int32_t> leftKeys1 = {1, 1, 2, 2};
+  std::vector<int32_t> leftKeys2 = {1, 2, 1, 2};
+  std::vector<int32_t> leftValues = {1, 2, 3, 4};
+  std::vector<int32_t> rightKeys1 = {2, 1, 1};
+  std::vector<int32_t> rightKeys2 = {1, 2, 3};
+  std::vector<int32_t> rightValues = {5, 6, 7};
+
+  ThreadPool pool(3);
+  auto leftScan = makeColumnScanOperator(leftKeys1, leftKeys2, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys1, rightKeys2, rightValues);
+  auto hashJoin =
+      makePartitionedHashJoinOperator<2>(&leftScan, &rightScan, &pool);
+
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+  std::vector<ResultTuple> referenceResult = {{1, 2, 2, 6}, {2, 1, 3, 5}};
+  EXPECT_EQ(collectSorted(hashJoin), referenceResult);
+}
+
+TEST(PartitionedHashJoinTest, NoPartitioning) {
+  ThreadPool pool(2);
+  testAgainstHashJoin(pool, 1000, 1000, 300, 0);
+}
+
+TEST(PartitionedHashJoinTest, OnePass) {
+  ThreadPool pool(4);
+  testAgainstHashJoin(pool, 20000, 30000, 5000, 6);
+}
+
+TEST(PartitionedHashJoinTest, TwoPasses) {
+  ThreadPool pool(4);
+  testAgainstHashJoin(pool, 20000, 30000, 5000, 11);
+}
+
+TEST(PartitionedHashJoinTest, AutomaticPartitioning) {
+  ThreadPool pool(4);
+  testAgainstHashJoin(pool, 200000, 100000, 100000,
+                      decltype(makePartitionedHashJoinOperator<1>(
+                          std::declval<ColumnScanOperator<int32_t> *>(),
+                          std::declval<ColumnScanOperator<int32_t> *>(),
+                          &pool))::kAutomaticPartitionBits);
+}
+
+TEST(PartitionedHashJoinTest, Batches) {
+  std::vector<int32_t> keys(3000);
+  for (int32_t i = 0; i < 3000; i++)
+    keys[i] = i;
+
+  ThreadPool pool(2);
+  auto leftScan = makeColumnScanOperator(keys);
+  auto rightScan = makeColumnScanOperator(keys);
+  auto hashJoin =
+      makePartitionedHashJoinOperator<1>(&leftScan, &rightScan, &pool, 3);
+  hashJoin.open();
+
+  decltype(hashJoin)::BatchType batch;
+  std::vector<int32_t> result;
+  while (hashJoin.computeNextBatch(batch))
+    for (size_t i = 0; i < batch.size(); i++)
+      result.push_back(std::get<0>(batch.get(i)));
+  std::sort(result.begin(), result.end());
+  EXPECT_EQ(result, keys);
+  EXPECT_FALSE(hashJoin.computeNextBatch(batch));
+
+  hashJoin.close();
+}
+
+TEST(PartitionedHashJoinTest, MixingHashCombiner) {
+  // Grid of keys, many of which collide with the default `XorHashCombiner`
+  std::vector<int32_t> leftKeys1;
+  std::vector<int32_t> leftKeys2;
+  std::vector<int32_t> leftValues;
+  for (int32_t i = 0; i < 64 * 64; i++) {
+    leftKeys1.push_back(i % 64);
+    leftKeys2.push_back(i / 64);
+    leftValues.push_back(i);
+  }
+  std::vector<int32_t> rightKeys1 = leftKeys2;
+  std::vector<int32_t> rightKeys2 = leftKeys1;
+  std::vector<int64_t> rightValues(leftValues.begin(), leftValues.end());
+
+  ThreadPool pool(4);
+  using Hasher =
+      TupleHasher<std::tuple<int32_t, int32_t>, MixingHashCombiner>;
+  auto leftScan = makeColumnScanOperator(leftKeys1, leftKeys2, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys1, rightKeys2, rightValues);
+  auto hashJoin = makePartitionedHashJoinOperator<2, Hasher>(
+      &leftScan, &rightScan, &pool, 4);
+
+  // Each key `(x, y)` on the left matches the key `(x, y)` on the right,
+  // which comes from the transposed position
+  using ResultTuple = decltype(hashJoin)::OutputTuple;
+  std::vector<ResultTuple> referenceResult;
+  for (int32_t i = 0; i < 64 * 64; i++)
+    referenceResult.emplace_back(i % 64, i / 64, i, i % 64 * 64 + i / 64);
+  std::sort(referenceResult.begin(), referenceResult.end());
+  EXPECT_EQ(collectSorted(hashJoin), referenceResult);
+}
+
+TEST(PartitionedHashJoinTest, Reopen) {
+  std::vector<int32_t> leftKeys(20000);
+  std::vector<int32_t> leftValues(20000);
+  std::vector<int32_t> rightKeys(20000);
+  std::vector<int32_t> rightValues(20000);
+  for (int32_t i = 0; i < 20000; i++) {
+    leftKeys[i] = i / 2;
+    leftValues[i] = i;
+    rightKeys[i] = i;
+    rightValues[i] = -i;
+  }
+
+  ThreadPool pool(4);
+  auto leftScan = makeColumnScanOperator(leftKeys, leftValues);
+  auto rightScan = makeColumnScanOperator(rightKeys, rightValues);
+  auto hashJoin =
+      makePartitionedHashJoinOperator<1>(&leftScan, &rightScan, &pool, 6);
+
+  auto const result = collectSorted(hashJoin);
+  EXPECT_EQ(result.size(), 20000U);
+  EXPECT_EQ(collectSorted(hashJoin), result);
+
+  // Opened from within a loop of a larger pool, the iterations run on threads
+  // whose indices exceed the number of per-thread arenas of the operator
+  ThreadPool outerPool(8);
+  outerPool.parallelFor(8, [&](std::size_t i) {
+    if (i == 7) {
+      EXPECT_EQ(collectSorted(hashJoin), result);
+    }
+  });
+}
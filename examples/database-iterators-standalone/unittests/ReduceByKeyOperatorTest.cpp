@@ -14,6 +14,8 @@
 
 #include "database-iterators/Operators/ColumnScanOperator.h"
 #include "database-iterators/Operators/ReduceByKeyOperator.h"
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Tuple.h"
 
 using namespace database_iterators::operators;
 using namespace database_iterators::utils;
@@ -71,3 +73,147 @@ TEST(ReduceByKeyTest, TwoColumnKey) {
 
   reduceByKey.close();
 }
+
+TEST(ReduceByKeyTest, Batches) {
+  // Produces more groups than fit into one batch
+  std::vector<int32_t> keys(6000);
+  std::vector<int32_t> values(6000);
+  for (int32_t i = 0; i < 6000; i++) {
+    keys[i] = i % 1500;
+    values[i] = i;
+  }
+  auto scan = makeColumnScanOperator(keys, values);
+  auto reduceByKey = makeReduceByKeyOperator<1>(&scan, [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  });
+
+  // Consume result of reduceByKey
+  reduceByKey.open();
+  decltype(reduceByKey)::BatchType batch;
+  std::map<int32_t, int32_t> result;
+  size_t numBatches = 0;
+  while (reduceByKey.computeNextBatch(batch)) {
+    numBatches++;
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto const [key, value] = batch.get(i);
+      EXPECT_EQ(result.count(key), 0U);
+      result.emplace(key, value);
+    }
+  }
+
+  // Compare with correct result
+  std::map<int32_t, int32_t> referenceResult;
+  for (int32_t key = 0; key < 1500; key++)
+    referenceResult.emplace(key, 4 * key + 1500 * (0 + 1 + 2 + 3));
+  EXPECT_EQ(result, referenceResult);
+  EXPECT_EQ(numBatches, 2U);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(reduceByKey.computeNextBatch(batch));
+
+  reduceByKey.close();
+}
+
+TEST(ReduceByKeyTest, Arena) {
+  std::vector<int32_t> keys(6000);
+  std::vector<int32_t> values(6000);
+  for (int32_t i = 0; i < 6000; i++) {
+    keys[i] = i % 1500;
+    values[i] = i;
+  }
+
+  Arena arena;
+  auto scan = makeColumnScanOperator(keys, values);
+  auto reduceByKey = makeReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      0, &arena);
+
+  // Consume result of reduceByKey
+  reduceByKey.open();
+  std::map<int32_t, int32_t> result;
+  while (const auto tuple = reduceByKey.computeNext())
+    result.emplace(std::get<0>(tuple.value()), std::get<1>(tuple.value()));
+  reduceByKey.close();
+  EXPECT_GT(arena.getNumAllocatedBytes(), 0U);
+
+  // Compare with correct result
+  std::map<int32_t, int32_t> referenceResult;
+  for (int32_t key = 0; key < 1500; key++)
+    referenceResult.emplace(key, 4 * key + 1500 * (0 + 1 + 2 + 3));
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(ReduceByKeyTest, MixingHashCombiner) {
+  // Grid of keys, many of which collide with the default `XorHashCombiner`
+  std::vector<int32_t> keys1;
+  std::vector<int32_t> keys2;
+  std::vector<int32_t> values;
+  for (int32_t i = 0; i < 2 * 32 * 32; i++) {
+    keys1.push_back(i % 32);
+    keys2.push_back(i / 32 % 32);
+    values.push_back(i);
+  }
+  auto scan = makeColumnScanOperator(keys1, keys2, values);
+  using Hasher =
+      TupleHasher<std::tuple<int32_t, int32_t>, MixingHashCombiner>;
+  auto reduceByKey =
+      makeReduceByKeyOperator<2, Hasher>(&scan, [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      });
+
+  // Consume result of reduceByKey
+  using ResultType =
+      std::map<std::tuple<int32_t, int32_t>, std::tuple<int32_t>>;
+  ResultType result;
+  reduceByKey.open();
+  while (const auto tuple = reduceByKey.computeNext()) {
+    auto const key = takeFront<2>(tuple.value());
+    auto const value = dropFront<2>(tuple.value());
+    EXPECT_EQ(result.count(key), 0U);
+    result.emplace(key, value);
+  }
+  reduceByKey.close();
+
+  // Compare with correct result
+  ResultType referenceResult;
+  for (int32_t i = 0; i < 32 * 32; i++)
+    referenceResult[{i % 32, i / 32}] = {2 * i + 32 * 32};
+  EXPECT_EQ(result, referenceResult);
+}
+
+TEST(ReduceByKeyTest, Reopen) {
+  std::vector<int32_t> keys(6000);
+  std::vector<int32_t> values(6000);
+  for (int32_t i = 0; i < 6000; i++) {
+    keys[i] = i % 1500;
+    values[i] = i;
+  }
+
+  Arena arena;
+  auto scan = makeColumnScanOperator(keys, values);
+  auto reduceByKey = makeReduceByKeyOperator<1>(
+      &scan,
+      [](auto t1, auto t2) {
+        return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+      },
+      0, &arena);
+
+  auto const run = [&]() {
+    reduceByKey.open();
+    std::map<int32_t, int32_t> result;
+    while (const auto tuple = reduceByKey.computeNext())
+      result.emplace(std::get<0>(tuple.value()), std::get<1>(tuple.value()));
+    reduceByKey.close();
+    return result;
+  };
+  auto const result = run();
+  EXPECT_EQ(result.size(), 1500U);
+  auto const numAllocatedBytes = arena.getNumAllocatedBytes();
+
+  // Running the plan again reuses the hash table instead of growing the arena
+  EXPECT_EQ(run(), result);
+  EXPECT_EQ(arena.getNumAllocatedBytes(), numAllocatedBytes);
+}
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -65,3 +66,39 @@ TEST(ReduceTest, MulticolumnMinMax) {
 
   reduce.close();
 }
+
+TEST(ReduceTest, Batches) {
+  std::vector<int64_t> numbers(5000);
+  std::iota(numbers.begin(), numbers.end(), 1);
+  auto scan = makeColumnScanOperator(numbers);
+  auto reduce = makeReduceOperator(&scan, [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  });
+  reduce.open();
+
+  // Consume one value
+  decltype(reduce)::BatchType batch;
+  ASSERT_TRUE(reduce.computeNextBatch(batch));
+  ASSERT_EQ(batch.size(), 1U);
+  EXPECT_EQ(batch.get(0), std::make_tuple(int64_t{5000 * 5001 / 2}));
+
+  // Check that we have reached the end
+  EXPECT_FALSE(reduce.computeNextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+
+  reduce.close();
+}
+
+TEST(ReduceTest, BatchesEmptyInput) {
+  std::vector<int32_t> numbers;
+  auto scan = makeColumnScanOperator(numbers);
+  auto reduce = makeReduceOperator(&scan, [](auto t1, auto t2) {
+    return std::make_tuple(std::get<0>(t1) + std::get<0>(t2));
+  });
+  reduce.open();
+
+  decltype(reduce)::BatchType batch;
+  EXPECT_FALSE(reduce.computeNextBatch(batch));
+
+  reduce.close();
+}
@@ -0,0 +1,171 @@
+//===-- SortOperatorTest.cpp - Unit tests of Sort ---------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/ColumnScanOperator.h"
+#include "database-iterators/Operators/SortOperator.h"
+#include "database-iterators/Utils/Arena.h"
+
+using namespace database_iterators::operators;
+using namespace database_iterators::utils;
+
+namespace {
+/// Consumes all tuples of the given operator.
+template <typename OperatorType>
+auto collect(OperatorType &op) {
+  std::vector<typename OperatorType::OutputTuple> result;
+  op.open();
+  while (const auto tuple = op.computeNext())
+    result.emplace_back(tuple.value());
+  EXPECT_FALSE(op.computeNext());
+  op.close();
+  return result;
+}
+} // namespace
+
+TEST(SortTest, SingleColumnKey) {
+  std::vector<int32_t> keys = {3, -1, 2, -1, 3, 0};
+  std::vector<int32_t> values = {1, 2, 3, 4, 5, 6};
+  auto scan = makeColumnScanOperator(keys, values);
+  auto sort = makeSortOperator<1>(&scan);
+
+  // Tuples with equal keys keep their order
+  std::vector<std::tuple<int32_t, int32_t>> referenceResult = {
+      {-1, 2}, {-1, 4}, {0, 6}, {2, 3}, {3, 1}, {3, 5}};
+  EXPECT_EQ(collect(sort), referenceResult);
+}
+
+TEST(SortTest, TwoColumnKey) {
+  std::vector<uint8_t> keys1 = {2, 1, 2, 1};
+  std::vector<int64_t> keys2 = {-5, 7, -6, 7};
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  auto scan = makeColumnScanOperator(keys1, keys2, values);
+  auto sort = makeSortOperator<2>(&scan);
+
+  std::vector<std::tuple<uint8_t, int64_t, int32_t>> referenceResult = {
+      {1, 7, 2}, {1, 7, 4}, {2, -6, 3}, {2, -5, 1}};
+  EXPECT_EQ(collect(sort), referenceResult);
+}
+
+TEST(SortTest, NonIntegerKey) {
+  std::vector<double> keys = {0.5, -1.5, 0.25, -1.5};
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  auto scan = makeColumnScanOperator(keys, values);
+  auto sort = makeSortOperator<1>(&scan);
+
+  std::vector<std::tuple<double, int32_t>> referenceResult = {
+      {-1.5, 2}, {-1.5, 4}, {0.25, 3}, {0.5, 1}};
+  EXPECT_EQ(collect(sort), referenceResult);
+}
+
+TEST(SortTest, EmptyInput) {
+  std::vector<int32_t> keys;
+  auto scan = makeColumnScanOperator(keys);
+  auto sort = makeSortOperator<1>(&scan);
+  EXPECT_TRUE(collect(sort).empty());
+}
+
+TEST(SortTest, LargeInput) {
+  // Keys span all bytes of an int64_t
+  std::vector<int64_t> keys(10000);
+  std::vector<int32_t> values(10000);
+  uint64_t state = 42;
+  for (int32_t i = 0; i < 10000; i++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    keys[i] = static_cast<int64_t>(state) >> (i % 64);
+    values[i] = i;
+  }
+  auto scan = makeColumnScanOperator(keys, values);
+  auto sort = makeSortOperator<1>(&scan);
+
+  std::vector<std::tuple<int64_t, int32_t>> referenceResult;
+  for (int32_t i = 0; i < 10000; i++)
+    referenceResult.emplace_back(keys[i], values[i]);
+  std::stable_sort(referenceResult.begin(), referenceResult.end(),
+                   [](auto const &lhs, auto const &rhs) {
+                     return std::get<0>(lhs) < std::get<0>(rhs);
+                   });
+  EXPECT_EQ(collect(sort), referenceResult);
+}
+
+TEST(SortTest, Batches) {
+  std::vector<int32_t> keys(3000);
+  for (int32_t i = 0; i < 3000; i++)
+    keys[i] = (i * 7919) % 3000;
+  auto scan = makeColumnScanOperator(keys);
+  auto sort = makeSortOperator<1>(&scan);
+
+  // Consume result of sort
+  sort.open();
+  decltype(sort)::BatchType batch;
+  std::vector<int32_t> result;
+  size_t numBatches = 0;
+  while (sort.computeNextBatch(batch)) {
+    numBatches++;
+    for (size_t i = 0; i < batch.size(); i++)
+      result.push_back(std::get<0>(batch.get(i)));
+  }
+
+  // Compare with correct result
+  std::vector<int32_t> referenceResult(3000);
+  for (int32_t i = 0; i < 3000; i++)
+    referenceResult[i] = i;
+  EXPECT_EQ(result, referenceResult);
+  EXPECT_EQ(numBatches, 3U);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(sort.computeNextBatch(batch));
+
+  sort.close();
+}
+
+TEST(SortTest, Arena) {
+  // Large enough to use the radix sort, whose buffer also uses the arena
+  std::vector<int32_t> keys(1000);
+  std::vector<int32_t> values(1000);
+  for (int32_t i = 0; i < 1000; i++) {
+    keys[i] = (i * 7919) % 1000;
+    values[i] = i;
+  }
+
+  Arena arena;
+  auto scan = makeColumnScanOperator(keys, values);
+  auto sort = makeSortOperator<1>(&scan, &arena);
+  auto const result = collect(sort);
+  EXPECT_GE(arena.getNumAllocatedBytes(),
+            2 * 1000 * sizeof(std::tuple<int32_t, int32_t>));
+
+  ASSERT_EQ(result.size(), 1000U);
+  for (int32_t i = 0; i < 1000; i++)
+    EXPECT_EQ(std::get<0>(result[i]), i);
+}
+
+TEST(SortTest, Reopen) {
+  std::vector<int32_t> keys(1000);
+  std::vector<int32_t> values(1000);
+  for (int32_t i = 0; i < 1000; i++) {
+    keys[i] = (i * 7919) % 1000;
+    values[i] = i;
+  }
+
+  Arena arena;
+  auto scan = makeColumnScanOperator(keys, values);
+  auto sort = makeSortOperator<1>(&scan, &arena);
+  auto const result = collect(sort);
+  auto const numAllocatedBytes = arena.getNumAllocatedBytes();
+
+  // Running the plan again reuses the buffers instead of growing the arena
+  EXPECT_EQ(collect(sort), result);
+  EXPECT_EQ(arena.getNumAllocatedBytes(), numAllocatedBytes);
+}
@@ -0,0 +1,89 @@
+//===-- UnbatchingOperatorTest.cpp - Tests of Unbatching --------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <vector>
+
+#include "database-iterators/Operators/MapOperator.h"
+#include "database-iterators/Operators/UnbatchingOperator.h"
+#include "database-iterators/Utils/Batch.h"
+
+using namespace database_iterators::operators;
+using namespace database_iterators::utils;
+
+namespace {
+/// Source operator that only implements the batch-at-a-time protocol and
+/// produces the numbers from 0 to `numTuples - 1` in batches of
+/// `kBatchCapacity` tuples.
+class CountingBatchOperator {
+public:
+  static constexpr size_t kBatchCapacity = 4;
+  using OutputTuple = std::tuple<int32_t>;
+  using BatchType = Batch<OutputTuple, kBatchCapacity>;
+
+  explicit CountingBatchOperator(int32_t numTuples) : numTuples(numTuples) {}
+
+  void open() {}
+  bool computeNextBatch(BatchType &batch) {
+    batch.clear();
+    while (!batch.full() && current < numTuples)
+      batch.pushBack(std::make_tuple(current++));
+    return !batch.empty();
+  }
+  void close() {}
+
+private:
+  int32_t numTuples;
+  int32_t current{0};
+};
+} // namespace
+
+TEST(UnbatchingTest, Tuples) {
+  CountingBatchOperator counter(10);
+  auto unbatching = makeUnbatchingOperator(&counter);
+  unbatching.open();
+
+  // Consume result
+  using Result = std::vector<decltype(unbatching)::OutputTuple>;
+  Result result;
+  while (const auto tuple = unbatching.computeNext())
+    result.emplace_back(tuple.value());
+
+  // Verify
+  Result referenceResult = {{0}, {1}, {2}, {3}, {4},
+                            {5}, {6}, {7}, {8}, {9}};
+  EXPECT_EQ(result, referenceResult);
+
+  // Check that we can test for the end again
+  EXPECT_FALSE(unbatching.computeNext());
+
+  unbatching.close();
+}
+
+TEST(UnbatchingTest, Upstream) {
+  CountingBatchOperator counter(6);
+  auto map = makeMapOperator(&counter, [](auto tuple) {
+    return std::make_tuple(std::get<0>(tuple) * 2);
+  });
+  auto unbatching = makeUnbatchingOperator(&map);
+  unbatching.open();
+
+  // Consume result
+  using Result = std::vector<decltype(unbatching)::OutputTuple>;
+  Result result;
+  while (const auto tuple = unbatching.computeNext())
+    result.emplace_back(tuple.value());
+
+  // Verify
+  Result referenceResult = {{0}, {2}, {4}, {6}, {8}, {10}};
+  EXPECT_EQ(result, referenceResult);
+
+  unbatching.close();
+}
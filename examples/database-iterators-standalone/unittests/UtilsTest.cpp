@@ -8,9 +8,19 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <sstream>
 #include <tuple>
+#include <vector>
 
+#include "database-iterators/Utils/Arena.h"
+#include "database-iterators/Utils/Batch.h"
+#include "database-iterators/Utils/RadixPartitioning.h"
+#include "database-iterators/Utils/RadixSort.h"
+#include "database-iterators/Utils/ThreadPool.h"
 #include "database-iterators/Utils/Tuple.h"
 
 using namespace database_iterators::utils;
@@ -73,6 +83,43 @@ TEST(HashTupleTest, SimpleTests) {
   EXPECT_EQ(hashTuple(std::make_tuple(1, 2)), hasher(1) ^ hasher(2));
 }
 
+TEST(HashTupleTest, MultiplyAddCombiner) {
+  using Combiner = MultiplyAddHashCombiner;
+  std::hash<uint32_t> hasher;
+  EXPECT_EQ(hashTuple<Combiner>(std::make_tuple(1)), hasher(1));
+  EXPECT_EQ(hashTuple<Combiner>(std::make_tuple(1, 2)),
+            Combiner::combine(hasher(1), hasher(2)));
+
+  // Tuples that collide with `XorHashCombiner`
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(1, 2)),
+            hashTuple<Combiner>(std::make_tuple(2, 1)));
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(1, 1)),
+            hashTuple<Combiner>(std::make_tuple(2, 2)));
+
+  // Consistency with the functor
+  TupleHasher<std::tuple<int, int>, Combiner> tupleHasher;
+  EXPECT_EQ(tupleHasher(std::make_tuple(3, 4)),
+            hashTuple<Combiner>(std::make_tuple(3, 4)));
+}
+
+TEST(HashTupleTest, MixingCombiner) {
+  using Combiner = MixingHashCombiner;
+  std::hash<uint32_t> hasher;
+  auto const expectedHash = Combiner::finalize(Combiner::combine(
+      Combiner::combine(Combiner::kSeed, hasher(1)), hasher(2)));
+  EXPECT_EQ(hashTuple<Combiner>(std::make_tuple(1, 2)), expectedHash);
+
+  // Tuples that collide with `XorHashCombiner`
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(1, 2)),
+            hashTuple<Combiner>(std::make_tuple(2, 1)));
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(1, 1)),
+            hashTuple<Combiner>(std::make_tuple(2, 2)));
+
+  // Small integers do not hash to themselves
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(0)), 0U);
+  EXPECT_NE(hashTuple<Combiner>(std::make_tuple(1)), 1U);
+}
+
 TEST(PrintTupleTest, SingleField) {
   std::stringstream stringBuffer;
   printTuple(stringBuffer, std::make_tuple(1));
@@ -84,3 +131,195 @@ TEST(PrintTupleTest, MultipleFields) {
   printTuple(stringBuffer, std::make_tuple(1, 2, 3));
   EXPECT_EQ(stringBuffer.str(), "(1, 2, 3)");
 }
+
+TEST(BatchTest, SetAndGet) {
+  Batch<std::tuple<int32_t, double>, 4> batch;
+  EXPECT_EQ(batch.capacity(), 4U);
+  EXPECT_TRUE(batch.empty());
+
+  batch.pushBack({1, 1.5});
+  batch.pushBack({2, 2.5});
+  EXPECT_EQ(batch.size(), 2U);
+  EXPECT_EQ(batch.get(1), std::make_tuple(2, 2.5));
+  EXPECT_EQ(batch.column<0>()[0], 1);
+  EXPECT_EQ(batch.column<1>()[0], 1.5);
+
+  batch.set(0, {3, 3.5});
+  EXPECT_EQ(batch.get(0), std::make_tuple(3, 3.5));
+  EXPECT_EQ(batch.size(), 2U);
+}
+
+TEST(BatchTest, WriteColumns) {
+  Batch<std::tuple<int32_t, int64_t>, 4> batch;
+  for (size_t i = 0; i < 4; i++) {
+    batch.column<0>()[i] = static_cast<int32_t>(i);
+    batch.column<1>()[i] = static_cast<int64_t>(10 * i);
+  }
+  batch.resize(4);
+  EXPECT_TRUE(batch.full());
+  EXPECT_EQ(batch.get(3), std::make_tuple(3, int64_t{30}));
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.getNumThreads(), 4U);
+
+  // Run several loops on the same pool
+  for (size_t numIterations : {0, 1, 3, 1000}) {
+    std::vector<std::atomic<int32_t>> counts(numIterations);
+    pool.parallelFor(numIterations, [&](size_t i) { counts[i]++; });
+    for (auto const &count : counts)
+      EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, ThreadIndex) {
+  ThreadPool pool(4);
+  std::vector<size_t> threadIndices(1000);
+  pool.parallelFor(threadIndices.size(), [&](size_t i) {
+    threadIndices[i] = ThreadPool::getThreadIndex();
+  });
+  for (auto const threadIndex : threadIndices)
+    EXPECT_LT(threadIndex, pool.getNumThreads());
+  EXPECT_EQ(ThreadPool::getThreadIndex(), 0U);
+}
+
+TEST(ThreadPoolTest, UnevenIterations) {
+  // The first iterations take much longer such that the threads that own
+  // the other iterations need to steal from the first thread
+  ThreadPool pool(4);
+  std::vector<std::atomic<int32_t>> counts(400);
+  pool.parallelFor(counts.size(), [&](size_t i) {
+    int64_t work = i < 100 ? 10000 : 10;
+    for (volatile int64_t j = 0; j < work; j = j + 1) {
+    }
+    counts[i]++;
+  });
+  for (auto const &count : counts)
+    EXPECT_EQ(count.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  ThreadPool pool(3);
+  std::atomic<int32_t> sum{0};
+  pool.parallelFor(10, [&](size_t /*i*/) {
+    pool.parallelFor(10, [&](size_t j) { sum += static_cast<int32_t>(j); });
+  });
+  EXPECT_EQ(sum.load(), 10 * 45);
+}
+
+TEST(RadixPartitionTest, Partitions) {
+  std::vector<int32_t> input(1000);
+  for (int32_t i = 0; i < 1000; i++)
+    input[i] = (i * 7919) % 1000;
+  std::vector<int32_t> output(input.size());
+
+  ThreadPool pool(3);
+  auto const offsets =
+      radixPartition(input.data(), input.size(), output.data(), 8,
+                     [](int32_t value) { return value % 8; }, &pool, 5);
+
+  ASSERT_EQ(offsets.size(), 9U);
+  EXPECT_EQ(offsets.front(), 0U);
+  EXPECT_EQ(offsets.back(), input.size());
+  for (size_t p = 0; p < 8; p++) {
+    // Each partition has the right elements in their original order
+    std::vector<int32_t> referencePartition;
+    std::copy_if(input.begin(), input.end(),
+                 std::back_inserter(referencePartition),
+                 [&](int32_t value) {
+                   return static_cast<size_t>(value % 8) == p;
+                 });
+    std::vector<int32_t> partition(output.begin() + offsets[p],
+                                   output.begin() + offsets[p + 1]);
+    EXPECT_EQ(partition, referencePartition);
+  }
+}
+
+TEST(RadixSortTest, SignedKeys) {
+  std::vector<int16_t> elements = {3, -300, 0, 32767, -32768, 256, -1, 3};
+  // Exceed the threshold below which `std::stable_sort` is used
+  for (int32_t i = 0; i < 1000; i++)
+    elements.push_back(static_cast<int16_t>(i * 7919));
+  auto referenceResult = elements;
+  std::sort(referenceResult.begin(), referenceResult.end());
+  radixSort(elements, [](int16_t element) { return element; });
+  EXPECT_EQ(elements, referenceResult);
+}
+
+TEST(RadixSortTest, TupleKeys) {
+  // Sorts by the first two fields and keeps the order of the third
+  std::vector<std::tuple<uint32_t, int64_t, int32_t>> elements;
+  for (int32_t i = 0; i < 1000; i++)
+    elements.emplace_back((i * 7919) % 7, (i * 104729) % 11 - 5, i);
+  auto referenceResult = elements;
+  std::stable_sort(referenceResult.begin(), referenceResult.end(),
+                   [](auto const &lhs, auto const &rhs) {
+                     return takeFront<2>(lhs) < takeFront<2>(rhs);
+                   });
+
+  radixSort(elements,
+            [](auto const &element) { return takeFront<2>(element); });
+  EXPECT_EQ(elements, referenceResult);
+}
+
+TEST(ArenaTest, Alignment) {
+  Arena arena(1024);
+  for (std::size_t alignment = 1; alignment <= 64; alignment *= 2) {
+    auto *const ptr = arena.allocate(3, alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0U);
+  }
+  EXPECT_EQ(arena.getNumAllocatedBytes(), 7 * 3U);
+  EXPECT_EQ(arena.getNumReservedBytes(), 1024U);
+}
+
+TEST(ArenaTest, LargeAllocations) {
+  Arena arena(1024);
+  auto *const small1 = static_cast<char *>(arena.allocate(100, 1));
+  auto *const large = static_cast<char *>(arena.allocate(10000, 8));
+  auto *const small2 = static_cast<char *>(arena.allocate(100, 1));
+
+  // The large allocation has its own chunk; the small ones share one
+  EXPECT_EQ(small2, small1 + 100);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 8, 0U);
+  std::fill(large, large + 10000, 'x');
+  EXPECT_EQ(arena.getNumAllocatedBytes(), 10200U);
+  EXPECT_GE(arena.getNumReservedBytes(), 1024U + 10000U);
+
+  // New chunks are allocated when the current one is full
+  for (int i = 0; i < 100; i++)
+    arena.allocate(100, 1);
+  EXPECT_GE(arena.getNumReservedBytes(), 10200U + 1024U + 10000U);
+}
+
+TEST(ArenaTest, Reset) {
+  Arena arena(1024);
+  arena.allocate(100, 1);
+  arena.allocate(10000, 1);
+  arena.reset();
+  EXPECT_EQ(arena.getNumAllocatedBytes(), 0U);
+  EXPECT_EQ(arena.getNumReservedBytes(), 0U);
+
+  arena.allocate(100, 1);
+  EXPECT_EQ(arena.getNumAllocatedBytes(), 100U);
+}
+
+TEST(ArenaTest, Allocator) {
+  Arena arena;
+  std::vector<int64_t, ArenaAllocator<int64_t>> values(
+      (ArenaAllocator<int64_t>(&arena)));
+  for (int64_t i = 0; i < 1000; i++)
+    values.push_back(i);
+  EXPECT_EQ(values.get_allocator().getArena(), &arena);
+  EXPECT_GE(arena.getNumAllocatedBytes(), 1000 * sizeof(int64_t));
+  for (int64_t i = 0; i < 1000; i++)
+    EXPECT_EQ(values[i], i);
+
+  // Without arena, the allocator uses the heap
+  std::vector<int64_t, ArenaAllocator<int64_t>> heapValues(1000, 1);
+  EXPECT_EQ(heapValues.get_allocator().getArena(), nullptr);
+  EXPECT_EQ(heapValues.back(), 1);
+}
@@ -27,9 +27,25 @@ public:
   TabularTypeConverter(LLVMTypeConverter &llvmTypeConverter);
 
   /// Maps a TabularViewType to an LLVMStruct of pointers, i.e., to a "struct of
-  /// arrays".
+  /// arrays". Encoded columns are represented by their (nested) structs.
   static std::optional<Type> convertTabularViewType(Type type);
 
+  /// Maps a BitPackedType to an LLVMStruct consisting of the number of rows,
+  /// the pointer to the packed words, and the reference value.
+  static std::optional<Type> convertBitPackedType(Type type);
+
+  /// Maps a RunLengthType to an LLVMStruct consisting of the number of rows,
+  /// the number of runs, and the pointers to the run values and run ends.
+  static std::optional<Type> convertRunLengthType(Type type);
+
+  /// Maps a ChunkedTabularViewType to an LLVMStruct consisting of the number of
+  /// chunks and a pointer to an array of the structs of the chunks.
+  static std::optional<Type> convertChunkedTabularViewType(Type type);
+
+  /// Maps a ZoneMapType to an LLVMStruct consisting of the chunk size, the
+  /// number of chunks, and the pointers to the minima and maxima.
+  static std::optional<Type> convertZoneMapType(Type type);
+
 private:
   LLVMTypeConverter llvmTypeConverter;
 };
@@ -9,6 +9,7 @@
 #ifndef STRUCTURED_CONVERSION_TRITONTOLLVM_TRITONTOLLVM_H
 #define STRUCTURED_CONVERSION_TRITONTOLLVM_TRITONTOLLVM_H
 
+#include <cstdint>
 #include <memory>
 
 namespace mlir {
@@ -22,6 +23,41 @@ class TypeConverter;
 void populateTritonToLLVMConversionPatterns(RewritePatternSet &patterns,
                                             TypeConverter &typeConverter);
 
+/// Populate the given list with patterns that convert loads and stores of 1-D
+/// tensors of pointers to vector loads and stores or gathers and scatters.
+/// These patterns take precedence over the corresponding patterns of
+/// `populateTritonToLLVMConversionPatterns`, which handle the other cases.
+void populateTritonToLLVMVectorizationPatterns(RewritePatternSet &patterns,
+                                               TypeConverter &typeConverter);
+
+/// Populate the given list with a pattern that converts `tt.dot` into a
+/// register-tiled loop nest of vector contractions with tiles of at most the
+/// given sizes in the M, N, and K dimensions. (By default, a tile of the result
+/// with fp32 elements occupies four 512-bit or eight 256-bit vector
+/// registers.) This pattern takes precedence over the corresponding pattern of
+/// `populateTritonToLLVMConversionPatterns`, which handles the other cases.
+void populateTritonToLLVMDotVectorizationPatterns(RewritePatternSet &patterns,
+                                                  TypeConverter &typeConverter,
+                                                  int64_t tileM = 4,
+                                                  int64_t tileN = 16,
+                                                  int64_t tileK = 4);
+
+/// Populate the given list with a pattern that converts `tt.reduce` ops with
+/// common combine regions (such as sums, minimums, maximums, and arg-maximums)
+/// into vector reductions. This pattern takes precedence over the
+/// corresponding pattern of `populateTritonToLLVMConversionPatterns`, which
+/// handles the other cases.
+void populateTritonToLLVMReduceVectorizationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter);
+
+/// Populate the given list with a pattern that converts `tt.atomic_rmw` ops on
+/// tensors of pointers that are equal along some dimensions into a local
+/// reduction per distinct pointer followed by one atomic per pointer. This
+/// pattern takes precedence over the corresponding pattern of
+/// `populateTritonToLLVMConversionPatterns`, which handles the other cases.
+void populateTritonToLLVMAtomicAggregationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter);
+
 /// Create a pass to convert Triton operations to the LLVM dialect.
 std::unique_ptr<OperationPass<ModuleOp>> createConvertTritonToLLVMPass();
 
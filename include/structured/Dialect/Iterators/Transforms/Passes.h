@@ -28,6 +28,12 @@ namespace mlir {
 /// Creates a pass that decomposes iterator states into individual values.
 std::unique_ptr<Pass> createDecomposeIteratorStatesPass();
 
+/// Creates a pass that derives zone map bounds of tabular scans from filters.
+std::unique_ptr<Pass> createZoneMapPushdownPass();
+
+/// Creates a pass that narrows tabular scans to the columns used downstream.
+std::unique_ptr<Pass> createProjectionPushdownPass();
+
 //===----------------------------------------------------------------------===//
 // Registration
 //===----------------------------------------------------------------------===//
@@ -107,10 +107,23 @@ StateTypeComputer::operator()(ReduceOp op,
 
 /// The state of TabularViewToStreamOp consists of a single number that
 /// corresponds to the index of the next struct returned by the iterator and the
-/// input tabular view. Pseudo-code:
+/// input tabular view as well as, if present, the zone map. Pseudo-code:
 ///
-/// template <typename TabularViewType>
-/// struct { int64_t currentIndex; TabularViewType view; }
+/// template <typename TabularViewType, typename ZoneMapType>
+/// struct { int64_t currentIndex; TabularViewType view; ZoneMapType zoneMap; }
+///
+/// If the op scans run-length encoded columns, the state additionally contains
+/// the index of the current run of each of them (in the order of the columns):
+///
+/// struct { ...; int64_t currentRuns[NumRunLengthColumns]; }
+///
+/// For chunked inputs, the state consists of the index of the current chunk,
+/// the index of the next row in that chunk, and the chunked view:
+///
+/// template <typename ChunkedTabularViewType>
+/// struct {
+///   int64_t chunkIndex; int64_t rowIndex; ChunkedTabularViewType view;
+/// }
 template <>
 StateType StateTypeComputer::operator()(
     TabularViewToStreamOp op,
@@ -118,7 +131,13 @@ StateType StateTypeComputer::operator()(
   MLIRContext *context = op->getContext();
   Type indexType = IntegerType::get(context, /*width=*/64);
   Type viewType = typeConverter.convertType(op.getInput().getType());
-  return StateType::get(context, {indexType, viewType});
+  if (op.getInput().getType().isa<tabular::ChunkedTabularViewType>())
+    return StateType::get(context, {indexType, indexType, viewType});
+  SmallVector<Type> fieldTypes = {indexType, viewType};
+  if (Value zoneMap = op.getZoneMap())
+    fieldTypes.push_back(typeConverter.convertType(zoneMap.getType()));
+  fieldTypes.append(op.getNumScannedRunLengthColumns(), indexType);
+  return StateType::get(context, fieldTypes);
 }
 
 /// The state of ValueToStreamOp consists a Boolean indicating whether it has
@@ -20,6 +20,7 @@
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/Interfaces/DataLayoutInterfaces.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "structured/Conversion/TabularToLLVM/TabularToLLVM.h"
 #include "structured/Dialect/Iterators/IR/Iterators.h"
@@ -52,6 +53,10 @@ public:
   IteratorsTypeConverter() {
     addConversion([](Type type) { return type; });
     addConversion(TabularTypeConverter::convertTabularViewType);
+    addConversion(TabularTypeConverter::convertBitPackedType);
+    addConversion(TabularTypeConverter::convertRunLengthType);
+    addConversion(TabularTypeConverter::convertChunkedTabularViewType);
+    addConversion(TabularTypeConverter::convertZoneMapType);
   }
 };
 
@@ -81,6 +86,22 @@ static FlatSymbolRefAttr lookupOrInsertPrintf(OpBuilder &builder,
   return SymbolRefAttr::get(context, "printf");
 }
 
+/// Return a symbol reference to the function with the given name, inserting a
+/// declaration with the given type into the module if necessary.
+static FlatSymbolRefAttr lookupOrInsertFunc(OpBuilder &builder, ModuleOp module,
+                                            StringRef name,
+                                            LLVMFunctionType functionType) {
+  MLIRContext *context = builder.getContext();
+  if (module.lookupSymbol<LLVMFuncOp>(name))
+    return SymbolRefAttr::get(context, name);
+
+  // Insert the function into the body of the parent module.
+  OpBuilder::InsertionGuard insertGuard(builder);
+  builder.setInsertionPointToStart(module.getBody());
+  builder.create<LLVMFuncOp>(module->getLoc(), name, functionType);
+  return SymbolRefAttr::get(context, name);
+}
+
 /// Return a value representing an access into a global string with the given
 /// name, creating the string if necessary.
 static Value getOrCreateGlobalString(OpBuilder &builder, Twine name,
@@ -1096,8 +1117,362 @@ static Value buildOpenBody(TabularViewToStreamOp op, OpBuilder &builder,
   Attribute zeroAttr = b.getI64IntegerAttr(0);
   Value zeroValue =
       b.create<arith::ConstantOp>(i64, zeroAttr.cast<TypedAttr>());
-  return b.create<iterators::InsertValueOp>(initialState, b.getIndexAttr(0),
-                                            zeroValue);
+  Value updatedState = b.create<iterators::InsertValueOp>(
+      initialState, b.getIndexAttr(0), zeroValue);
+
+  // For chunked inputs, also reset the row index.
+  if (op.getInput().getType().isa<ChunkedTabularViewType>())
+    return b.create<iterators::InsertValueOp>(updatedState, b.getIndexAttr(1),
+                                              zeroValue);
+
+  // Reset the run indices of run-length encoded columns, which are the last
+  // fields of the state.
+  auto stateType = initialState.getType().cast<StateType>();
+  unsigned numFields = stateType.getFieldTypes().size();
+  for (unsigned i = numFields - op.getNumScannedRunLengthColumns();
+       i < numFields; i++)
+    updatedState = b.create<iterators::InsertValueOp>(
+        updatedState, b.getIndexAttr(i), zeroValue);
+
+  return updatedState;
+}
+
+/// Builds IR that advances the given index over all chunks that the zone map
+/// in the state proves to contain no value in the range of the op. Chunks are
+/// only skipped if the index points to the beginning of a chunk, which is
+/// always the case when a chunk is entered. Pseudocode:
+///
+/// while (current_index < num_elements &&
+///        current_index % chunk_size == 0 &&
+///        (maxs[current_index / chunk_size] < lower_bound ||
+///         mins[current_index / chunk_size] > upper_bound))
+///   current_index += chunk_size
+static Value buildZoneMapSkipping(TabularViewToStreamOp op, OpBuilder &builder,
+                                  Value initialState, Value currentIndex,
+                                  Value numElements) {
+  Location loc = op->getLoc();
+  ImplicitLocOpBuilder b(loc, builder);
+  MLIRContext *context = builder.getContext();
+  Type i64 = b.getI64Type();
+  Type opaquePtrType = LLVMPointerType::get(context);
+
+  TypedAttr lowerBound = op.getZoneMapLowerBoundAttr();
+  TypedAttr upperBound = op.getZoneMapUpperBoundAttr();
+  Type elementType =
+      op.getZoneMap().getType().cast<ZoneMapType>().getElementType();
+
+  // Extract zone map fields.
+  auto stateType = initialState.getType().cast<StateType>();
+  Value zoneMap = b.create<iterators::ExtractValueOp>(
+      stateType.getFieldTypes()[2], initialState, b.getIndexAttr(2));
+  Value chunkSize = b.create<LLVM::ExtractValueOp>(i64, zoneMap, 0);
+  Value numChunks = b.create<LLVM::ExtractValueOp>(i64, zoneMap, 1);
+  Value minsPtr = b.create<LLVM::ExtractValueOp>(opaquePtrType, zoneMap, 2);
+  Value maxsPtr = b.create<LLVM::ExtractValueOp>(opaquePtrType, zoneMap, 3);
+
+  scf::WhileOp whileOp = b.create<scf::WhileOp>(
+      i64, currentIndex,
+      /*beforeBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        ArithBuilder ab(b, b.getLoc());
+        Value index = args[0];
+
+        // Only consult the zone map at the beginning of a chunk that it
+        // covers.
+        Value zero = b.create<arith::ConstantIntOp>(/*value=*/0, /*width=*/64);
+        Value chunkIndex = b.create<arith::DivSIOp>(index, chunkSize);
+        Value offsetInChunk = b.create<arith::RemSIOp>(index, chunkSize);
+        Value isInRange = ab.slt(index, numElements);
+        Value isChunkStart = b.create<arith::CmpIOp>(arith::CmpIPredicate::eq,
+                                                     offsetInChunk, zero);
+        Value isCovered = ab.slt(chunkIndex, numChunks);
+        Value mayConsult = ab._and(ab._and(isInRange, isChunkStart), isCovered);
+
+        auto ifOp = b.create<scf::IfOp>(
+            /*condition=*/mayConsult,
+            /*thenBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              ImplicitLocOpBuilder b(loc, builder);
+              ArithBuilder ab(b, b.getLoc());
+
+              // Skip if the chunk lies entirely outside of the bounds.
+              Value skip = b.create<arith::ConstantIntOp>(/*value=*/0,
+                                                          /*width=*/1);
+              if (lowerBound) {
+                Value gep = b.create<GEPOp>(opaquePtrType, elementType,
+                                            maxsPtr, chunkIndex);
+                Value chunkMax = b.create<LoadOp>(elementType, gep);
+                Value bound = b.create<arith::ConstantOp>(lowerBound);
+                skip = b.create<arith::OrIOp>(skip, ab.slt(chunkMax, bound));
+              }
+              if (upperBound) {
+                Value gep = b.create<GEPOp>(opaquePtrType, elementType,
+                                            minsPtr, chunkIndex);
+                Value chunkMin = b.create<LoadOp>(elementType, gep);
+                Value bound = b.create<arith::ConstantOp>(upperBound);
+                skip = b.create<arith::OrIOp>(skip, ab.sgt(chunkMin, bound));
+              }
+              b.create<scf::YieldOp>(skip);
+            },
+            /*elseBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              Value noSkip = builder.create<arith::ConstantIntOp>(
+                  loc, /*value=*/0, /*width=*/1);
+              builder.create<scf::YieldOp>(loc, noSkip);
+            });
+
+        b.create<scf::ConditionOp>(ifOp->getResult(0), index);
+      },
+      /*afterBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        ArithBuilder ab(b, b.getLoc());
+        Value nextChunkStart = ab.add(args[0], chunkSize);
+        b.create<scf::YieldOp>(nextChunkStart);
+      });
+
+  return whileOp->getResult(0);
+}
+
+/// Builds IR that assembles an element from the values in the buffers of the
+/// current chunk at the current row index, moving on to the next non-exhausted
+/// chunk first if necessary. Pseudocode:
+///
+/// while (chunk_index < num_chunks &&
+///        row_index >= chunks[chunk_index].num_elements) {
+///   chunk_index++
+///   row_index = 0
+/// }
+/// if (chunk_index == num_chunks) return {}
+/// tuple = (buffer[row_index] for buffer in chunks[chunk_index])
+/// row_index++
+/// return tuple
+static llvm::SmallVector<Value, 4>
+buildChunkedNextBody(TabularViewToStreamOp op, OpBuilder &builder,
+                     Value initialState, Type elementType) {
+  Location loc = op->getLoc();
+  ImplicitLocOpBuilder b(loc, builder);
+  MLIRContext *context = builder.getContext();
+  Type i64 = b.getI64Type();
+  Type opaquePtrType = LLVMPointerType::get(context);
+
+  auto tupleType = elementType.cast<TupleType>();
+  auto viewType = op.getInput().getType().cast<ChunkedTabularViewType>();
+  Type chunkStructType =
+      TabularTypeConverter::convertTabularViewType(viewType.getChunkType())
+          .value();
+
+  // Extract current indices and chunked view.
+  auto stateType = initialState.getType().cast<StateType>();
+  Value chunkIndex =
+      b.create<iterators::ExtractValueOp>(i64, initialState, b.getIndexAttr(0));
+  Value rowIndex =
+      b.create<iterators::ExtractValueOp>(i64, initialState, b.getIndexAttr(1));
+  Value chunkedView = b.create<iterators::ExtractValueOp>(
+      stateType.getFieldTypes()[2], initialState, b.getIndexAttr(2));
+  Value numChunks = b.create<LLVM::ExtractValueOp>(i64, chunkedView, 0);
+  Value chunksPtr =
+      b.create<LLVM::ExtractValueOp>(opaquePtrType, chunkedView, 1);
+
+  // Loads the struct of the chunk with the given index.
+  auto loadChunk = [&](ImplicitLocOpBuilder &b, Value index) -> Value {
+    Value gep =
+        b.create<GEPOp>(opaquePtrType, chunkStructType, chunksPtr, index);
+    return b.create<LoadOp>(chunkStructType, gep);
+  };
+
+  // Skip exhausted (including empty) chunks.
+  scf::WhileOp whileOp = b.create<scf::WhileOp>(
+      TypeRange{i64, i64}, ValueRange{chunkIndex, rowIndex},
+      /*beforeBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        ArithBuilder ab(b, b.getLoc());
+        Value isValidChunk = ab.slt(args[0], numChunks);
+        auto ifOp = b.create<scf::IfOp>(
+            /*condition=*/isValidChunk,
+            /*thenBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              ImplicitLocOpBuilder b(loc, builder);
+              Value chunk = loadChunk(b, args[0]);
+              Value numElements = b.create<LLVM::ExtractValueOp>(i64, chunk, 0);
+              Value isExhausted = b.create<arith::CmpIOp>(
+                  arith::CmpIPredicate::sge, args[1], numElements);
+              b.create<scf::YieldOp>(isExhausted);
+            },
+            /*elseBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              Value constFalse = builder.create<arith::ConstantIntOp>(
+                  loc, /*value=*/0, /*width=*/1);
+              builder.create<scf::YieldOp>(loc, constFalse);
+            });
+        b.create<scf::ConditionOp>(ifOp->getResult(0), args);
+      },
+      /*afterBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        ArithBuilder ab(b, b.getLoc());
+        Value one = b.create<arith::ConstantIntOp>(/*value=*/1, /*width=*/64);
+        Value zero = b.create<arith::ConstantIntOp>(/*value=*/0, /*width=*/64);
+        Value nextChunkIndex = ab.add(args[0], one);
+        b.create<scf::YieldOp>(ValueRange{nextChunkIndex, zero});
+      });
+  Value currentChunkIndex = whileOp->getResult(0);
+  Value currentRowIndex = whileOp->getResult(1);
+
+  // Test if we have reached the end of the last chunk.
+  ArithBuilder ab(b, b.getLoc());
+  Value hasNext = ab.slt(currentChunkIndex, numChunks);
+  auto ifOp = b.create<scf::IfOp>(
+      /*condition=*/hasNext,
+      /*thenBuilder=*/
+      [&](OpBuilder &builder, Location loc) {
+        ImplicitLocOpBuilder b(loc, builder);
+
+        // Increment row index and update state.
+        Value one = b.create<arith::ConstantIntOp>(/*value=*/1, /*width=*/64);
+        ArithBuilder ab(b, b.getLoc());
+        Value updatedRowIndex = ab.add(currentRowIndex, one);
+        Value updatedState = b.create<iterators::InsertValueOp>(
+            initialState, b.getIndexAttr(0), currentChunkIndex);
+        updatedState = b.create<iterators::InsertValueOp>(
+            updatedState, b.getIndexAttr(1), updatedRowIndex);
+
+        // Assemble tuple from values at current row of the current chunk.
+        Value chunk = loadChunk(b, currentChunkIndex);
+        SmallVector<Value> columnElements;
+        for (auto [idx, columnElementType] : llvm::zip_equal(
+                 op.getScannedColumnIndices(), tupleType.getTypes())) {
+          Value columnPtr =
+              b.create<LLVM::ExtractValueOp>(opaquePtrType, chunk, idx + 1);
+          Value gep = b.create<GEPOp>(opaquePtrType, columnElementType,
+                                      columnPtr, currentRowIndex);
+          Value fieldValue = b.create<LoadOp>(columnElementType, gep);
+          columnElements.push_back(fieldValue);
+        }
+
+        // Assemble tuple and yield
+        auto nextElement =
+            b.create<tuple::FromElementsOp>(elementType, columnElements);
+        b.create<scf::YieldOp>(ValueRange{updatedState, nextElement});
+      },
+      /*elseBuilder=*/
+      [&](OpBuilder &builder, Location loc) {
+        // Don't modify state; return tuple with undef elements.
+        ImplicitLocOpBuilder b(loc, builder);
+        SmallVector<Value> elementValues;
+        for (Type type : tupleType.getTypes())
+          elementValues.push_back(b.create<UndefOp>(type));
+        auto nextElement =
+            b.create<tuple::FromElementsOp>(elementType, elementValues);
+        b.create<scf::YieldOp>(ValueRange{initialState, nextElement});
+      });
+  Value finalState = ifOp->getResult(0);
+  Value nextElement = ifOp.getResult(1);
+  return {finalState, hasNext, nextElement};
+}
+
+/// Builds IR that loads the value of the column with the given index at the
+/// given row index from the struct of the given (non-chunked) view, decoding
+/// encoded columns on the fly. For `run_length` columns, the index of the
+/// current run is stored in the state field with the given index, which is
+/// advanced (monotonically) to the run containing the row. Pseudocode:
+///
+/// plain:       value = column[row_index]
+/// bit_packed:  word = column.words[row_index / values_per_word]
+///              shift = (row_index % values_per_word) * bit_width
+///              value = column.reference + ((word >> shift) & mask)
+/// run_length:  while (column.run_ends[run] <= row_index) run++
+///              value = column.values[run]
+static Value buildColumnValue(OpBuilder &builder, Location loc,
+                              Value viewStruct, unsigned columnIndex,
+                              Type columnType, Value rowIndex, Value &state,
+                              unsigned &runStateIndex) {
+  ImplicitLocOpBuilder b(loc, builder);
+  MLIRContext *context = builder.getContext();
+  Type i64 = b.getI64Type();
+  Type opaquePtrType = LLVMPointerType::get(context);
+
+  // Plain column: get element pointer and load.
+  if (!columnType.isa<EncodedColumnTypeInterface>()) {
+    Value columnPtr =
+        b.create<LLVM::ExtractValueOp>(opaquePtrType, viewStruct, columnIndex);
+    Value gep =
+        b.create<GEPOp>(opaquePtrType, columnType, columnPtr, rowIndex);
+    return b.create<LoadOp>(columnType, gep);
+  }
+
+  Type columnStructType =
+      viewStruct.getType().cast<LLVMStructType>().getBody()[columnIndex];
+  Value columnStruct = b.create<LLVM::ExtractValueOp>(columnStructType,
+                                                      viewStruct, columnIndex);
+
+  // Bit-packed column: load the word containing the value and extract it.
+  if (auto bitPackedType = columnType.dyn_cast<BitPackedType>()) {
+    Type valueType = bitPackedType.getValueType();
+    unsigned bitWidth = bitPackedType.getBitWidth();
+    Value wordsPtr =
+        b.create<LLVM::ExtractValueOp>(opaquePtrType, columnStruct, 1);
+    Value reference =
+        b.create<LLVM::ExtractValueOp>(valueType, columnStruct, 2);
+
+    Value valuesPerWord = b.create<arith::ConstantIntOp>(
+        bitPackedType.getValuesPerWord(), /*width=*/64);
+    Value bitWidthValue =
+        b.create<arith::ConstantIntOp>(bitWidth, /*width=*/64);
+    Value mask = b.create<arith::ConstantOp>(b.getIntegerAttr(
+        i64, APInt::getLowBitsSet(/*numBits=*/64, /*loBitsSet=*/bitWidth)));
+
+    Value wordIndex = b.create<arith::DivUIOp>(rowIndex, valuesPerWord);
+    Value slot = b.create<arith::RemUIOp>(rowIndex, valuesPerWord);
+    Value shift = b.create<arith::MulIOp>(slot, bitWidthValue);
+    Value gep = b.create<GEPOp>(opaquePtrType, i64, wordsPtr, wordIndex);
+    Value word = b.create<LoadOp>(i64, gep);
+    Value offset = b.create<arith::AndIOp>(
+        b.create<arith::ShRUIOp>(word, shift), mask);
+    if (valueType != i64)
+      offset = b.create<arith::TruncIOp>(valueType, offset);
+    return b.create<arith::AddIOp>(reference, offset);
+  }
+
+  // Run-length encoded column: advance to the run containing the row.
+  auto runLengthType = columnType.cast<RunLengthType>();
+  Type valueType = runLengthType.getValueType();
+  Value valuesPtr =
+      b.create<LLVM::ExtractValueOp>(opaquePtrType, columnStruct, 2);
+  Value runEndsPtr =
+      b.create<LLVM::ExtractValueOp>(opaquePtrType, columnStruct, 3);
+  Value initialRun = b.create<iterators::ExtractValueOp>(
+      i64, state, b.getIndexAttr(runStateIndex));
+
+  scf::WhileOp whileOp = b.create<scf::WhileOp>(
+      i64, initialRun,
+      /*beforeBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        Value run = args[0];
+        Value gep = b.create<GEPOp>(opaquePtrType, i64, runEndsPtr, run);
+        Value runEnd = b.create<LoadOp>(i64, gep);
+        Value isBeforeRow = b.create<arith::CmpIOp>(arith::CmpIPredicate::sle,
+                                                    runEnd, rowIndex);
+        b.create<scf::ConditionOp>(isBeforeRow, run);
+      },
+      /*afterBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+        Value one = b.create<arith::ConstantIntOp>(/*value=*/1, /*width=*/64);
+        Value nextRun = b.create<arith::AddIOp>(args[0], one);
+        b.create<scf::YieldOp>(nextRun);
+      });
+  Value run = whileOp->getResult(0);
+
+  // Remember the run for the next row and load its value.
+  state = b.create<iterators::InsertValueOp>(
+      state, b.getIndexAttr(runStateIndex), run);
+  runStateIndex++;
+  Value gep = b.create<GEPOp>(opaquePtrType, valueType, valuesPtr, run);
+  return b.create<LoadOp>(valueType, gep);
 }
 
 /// Builds IR that assembles an element from the values in the buffers at the
@@ -1136,13 +1511,15 @@ static Value buildOpenBody(TabularViewToStreamOp op, OpBuilder &builder,
 static llvm::SmallVector<Value, 4>
 buildNextBody(TabularViewToStreamOp op, OpBuilder &builder, Value initialState,
               ArrayRef<IteratorInfo> upstreamInfos, Type elementType) {
+  if (op.getInput().getType().isa<ChunkedTabularViewType>())
+    return buildChunkedNextBody(op, builder, initialState, elementType);
+
   Location loc = op->getLoc();
   ImplicitLocOpBuilder b(loc, builder);
-  MLIRContext *context = builder.getContext();
   Type i64 = b.getI64Type();
-  Type opaquePtrType = LLVMPointerType::get(context);
 
   auto tupleType = elementType.cast<TupleType>();
+  auto viewType = op.getInput().getType().cast<TabularViewType>();
 
   // Extract current index.
   Value currentIndex =
@@ -1158,6 +1535,13 @@ buildNextBody(TabularViewToStreamOp op, OpBuilder &builder, Value initialState,
   Value lastIndex =
       b.create<LLVM::ExtractValueOp>(i64, structOfInputBuffers, 0);
 
+  // Skip chunks that cannot contain matching rows according to the zone map.
+  if (op.getZoneMap() &&
+      (op.getZoneMapLowerBoundAttr() || op.getZoneMapUpperBoundAttr())) {
+    currentIndex =
+        buildZoneMapSkipping(op, b, initialState, currentIndex, lastIndex);
+  }
+
   ArithBuilder ab(b, b.getLoc());
   Value hasNext = ab.slt(currentIndex, lastIndex);
   auto ifOp = b.create<scf::IfOp>(
@@ -1175,18 +1559,17 @@ buildNextBody(TabularViewToStreamOp op, OpBuilder &builder, Value initialState,
             initialState, b.getIndexAttr(0), updatedCurrentIndex);
 
         // Assemble tuple element values values from values at current index of
-        // column buffers.
+        // column buffers, decoding encoded columns. The run indices of
+        // run-length encoded columns are stored after all other state fields.
+        // Only the scanned columns are loaded.
         SmallVector<Value> columnElements;
-        for (auto [idx, columnElementType] :
-             llvm::enumerate(tupleType.getTypes())) {
-          // Extract column pointer.
-          Value columnPtr = b.create<LLVM::ExtractValueOp>(
-              opaquePtrType, structOfInputBuffers, idx + 1);
-
-          // Get element pointer and load.
-          Value gep = b.create<GEPOp>(opaquePtrType, columnElementType,
-                                      columnPtr, currentIndex);
-          Value fieldValue = b.create<LoadOp>(columnElementType, gep);
+        unsigned runStateIndex = stateType.getFieldTypes().size() -
+                                 op.getNumScannedRunLengthColumns();
+        for (int64_t idx : op.getScannedColumnIndices()) {
+          Value fieldValue = buildColumnValue(
+              b, b.getLoc(), structOfInputBuffers, idx + 1,
+              viewType.getColumnType(idx), currentIndex, updatedState,
+              runStateIndex);
           columnElements.push_back(fieldValue);
         }
 
@@ -1237,8 +1620,14 @@ static Value buildStateCreation(TabularViewToStreamOp op,
   Value tabularView = adaptor.getInput();
   Value initialIndex =
       b.create<arith::ConstantIntOp>(/*value=*/0, /*width=*/64);
-  return b.create<CreateStateOp>(stateType,
-                                 ValueRange{initialIndex, tabularView});
+  if (op.getInput().getType().isa<ChunkedTabularViewType>())
+    return b.create<CreateStateOp>(
+        stateType, ValueRange{initialIndex, initialIndex, tabularView});
+  SmallVector<Value> fields = {initialIndex, tabularView};
+  if (Value zoneMap = adaptor.getZoneMap())
+    fields.push_back(zoneMap);
+  fields.append(op.getNumScannedRunLengthColumns(), initialIndex);
+  return b.create<CreateStateOp>(stateType, fields);
 }
 
 //===----------------------------------------------------------------------===//
@@ -1860,6 +2249,198 @@ static SmallVector<Value> convert(StreamToValueOp op,
   return {value, hasValue};
 }
 
+/// Converts the given StreamToTabularOp to LLVM using the converted operands.
+/// This consists of opening the input iterator, consuming all of its elements
+/// into column buffers that grow geometrically, closing the input iterator, and
+/// assembling a tabular view from the buffers. Pseudocode:
+///
+/// capacity = kInitialCapacity
+/// buffers = (malloc(capacity * sizeof(T)) for T in column_types)
+/// size = 0
+/// upstream->Open()
+/// while (nextTuple = upstream->Next()) {
+///   if (size == capacity) {
+///     capacity *= 2
+///     buffers = (realloc(b, capacity * sizeof(T)) for b, T in ...)
+///   }
+///   for (b, value) in zip(buffers, nextTuple)
+///     b[size] = value
+///   size++
+/// }
+/// upstream->Close()
+/// return (size, buffers...)
+static SmallVector<Value> convert(StreamToTabularOp op,
+                                  StreamToTabularOpAdaptor adaptor,
+                                  ArrayRef<IteratorInfo> upstreamInfos,
+                                  OpBuilder &rewriter) {
+  Location loc = op->getLoc();
+  ImplicitLocOpBuilder b(loc, rewriter);
+  MLIRContext *context = b.getContext();
+  auto module = op->getParentOfType<ModuleOp>();
+  Type i1 = b.getI1Type();
+  Type i64 = b.getI64Type();
+  Type opaquePtrType = LLVMPointerType::get(context);
+
+  // Number of rows allocated before the first element is consumed.
+  constexpr int64_t kInitialCapacity = 1024;
+
+  // Look up IteratorInfo about the upstream iterator.
+  IteratorInfo upstreamInfo = upstreamInfos[0];
+
+  Type stateType = upstreamInfo.stateType;
+  SymbolRefAttr openFunc = upstreamInfo.openFunc;
+  SymbolRefAttr nextFunc = upstreamInfo.nextFunc;
+  SymbolRefAttr closeFunc = upstreamInfo.closeFunc;
+
+  // Declare allocation functions.
+  FlatSymbolRefAttr mallocFunc = lookupOrInsertFunc(
+      b, module, "malloc", LLVMFunctionType::get(opaquePtrType, i64));
+  FlatSymbolRefAttr reallocFunc = lookupOrInsertFunc(
+      b, module, "realloc",
+      LLVMFunctionType::get(opaquePtrType, {opaquePtrType, i64}));
+
+  // Compute element sizes of the columns.
+  auto viewType = op.getResult().getType().cast<TabularViewType>();
+  TypeRange columnTypes = viewType.getColumnTypes();
+  size_t numColumns = columnTypes.size();
+  DataLayout dataLayout = DataLayout::closest(op);
+  SmallVector<Value> elementSizes;
+  for (Type columnType : columnTypes) {
+    int64_t size = dataLayout.getTypeSize(columnType);
+    elementSizes.push_back(
+        b.create<arith::ConstantIntOp>(/*value=*/size, /*width=*/64));
+  }
+
+  // Allocate initial buffers. -------------------------------------------------
+  Value zero = b.create<arith::ConstantIntOp>(/*value=*/0, /*width=*/64);
+  Value one = b.create<arith::ConstantIntOp>(/*value=*/1, /*width=*/64);
+  Value initialCapacity =
+      b.create<arith::ConstantIntOp>(/*value=*/kInitialCapacity, /*width=*/64);
+  SmallVector<Value> initialBuffers;
+  for (Value elementSize : elementSizes) {
+    Value numBytes = b.create<arith::MulIOp>(initialCapacity, elementSize);
+    auto mallocCall = b.create<LLVM::CallOp>(opaquePtrType, mallocFunc,
+                                             ValueRange{numBytes});
+    initialBuffers.push_back(mallocCall.getResult());
+  }
+
+  // Open upstream iterator. ---------------------------------------------------
+  Value initialState = adaptor.getInput();
+  auto openCallOp = b.create<func::CallOp>(openFunc, stateType, initialState);
+  Value openedUpstreamState = openCallOp->getResult(0);
+
+  // Consume upstream iterator in while loop. ----------------------------------
+  // The loop carries the upstream state, the current size and capacity, and
+  // the buffer pointers.
+  auto elementType =
+      op.getInput().getType().cast<StreamType>().getElementType();
+  SmallVector<Type> nextResultTypes = {stateType, i1, elementType};
+  SmallVector<Type> loopTypes = {stateType, i64, i64};
+  loopTypes.append(numColumns, opaquePtrType);
+  SmallVector<Value> loopInits = {openedUpstreamState, zero, initialCapacity};
+  loopInits.append(initialBuffers);
+  SmallVector<Type> whileResultTypes = loopTypes;
+  whileResultTypes.push_back(elementType);
+
+  scf::WhileOp whileOp = b.create<scf::WhileOp>(
+      whileResultTypes, loopInits,
+      /*beforeBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+
+        Value currentState = args[0];
+        func::CallOp nextCallOp =
+            b.create<func::CallOp>(nextFunc, nextResultTypes, currentState);
+
+        Value updatedState = nextCallOp->getResult(0);
+        Value hasNext = nextCallOp->getResult(1);
+        Value nextElement = nextCallOp->getResult(2);
+
+        SmallVector<Value> forwarded = {updatedState};
+        forwarded.append(args.begin() + 1, args.end());
+        forwarded.push_back(nextElement);
+        b.create<scf::ConditionOp>(hasNext, forwarded);
+      },
+      /*afterBuilder=*/
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        ImplicitLocOpBuilder b(loc, builder);
+
+        Value currentState = args[0];
+        Value size = args[1];
+        Value capacity = args[2];
+        ValueRange buffers = args.slice(3, numColumns);
+        Value nextElement = args.back();
+
+        // Grow buffers if they are full.
+        Value isFull =
+            b.create<arith::CmpIOp>(arith::CmpIPredicate::eq, size, capacity);
+        SmallVector<Type> growTypes = {i64};
+        growTypes.append(numColumns, opaquePtrType);
+        auto ifOp = b.create<scf::IfOp>(
+            /*condition=*/isFull,
+            /*thenBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              ImplicitLocOpBuilder b(loc, builder);
+              Value two =
+                  b.create<arith::ConstantIntOp>(/*value=*/2, /*width=*/64);
+              Value newCapacity = b.create<arith::MulIOp>(capacity, two);
+              SmallVector<Value> results = {newCapacity};
+              for (auto [buffer, elementSize] :
+                   llvm::zip(buffers, elementSizes)) {
+                Value numBytes =
+                    b.create<arith::MulIOp>(newCapacity, elementSize);
+                auto reallocCall = b.create<LLVM::CallOp>(
+                    opaquePtrType, reallocFunc, ValueRange{buffer, numBytes});
+                results.push_back(reallocCall.getResult());
+              }
+              b.create<scf::YieldOp>(results);
+            },
+            /*elseBuilder=*/
+            [&](OpBuilder &builder, Location loc) {
+              SmallVector<Value> results = {capacity};
+              results.append(buffers.begin(), buffers.end());
+              builder.create<scf::YieldOp>(loc, results);
+            });
+        Value updatedCapacity = ifOp->getResult(0);
+        ValueRange updatedBuffers = ifOp->getResults().drop_front();
+
+        // Store the fields of the element into the buffers.
+        auto toElementsOp =
+            b.create<tuple::ToElementsOp>(columnTypes, nextElement);
+        for (auto [buffer, columnType, value] : llvm::zip(
+                 updatedBuffers, columnTypes, toElementsOp.getElements())) {
+          Value gep =
+              b.create<GEPOp>(opaquePtrType, columnType, buffer, size);
+          b.create<StoreOp>(value, gep);
+        }
+
+        // Forward iterator state and buffers to "before" region.
+        Value updatedSize = b.create<arith::AddIOp>(size, one);
+        SmallVector<Value> yielded = {currentState, updatedSize,
+                                      updatedCapacity};
+        yielded.append(updatedBuffers.begin(), updatedBuffers.end());
+        b.create<scf::YieldOp>(yielded);
+      });
+
+  Value consumedState = whileOp.getResult(0);
+  Value finalSize = whileOp.getResult(1);
+
+  // Close upstream iterator. --------------------------------------------------
+  b.create<func::CallOp>(closeFunc, stateType, consumedState);
+
+  // Assemble tabular view. ----------------------------------------------------
+  Type viewStructType =
+      TabularTypeConverter::convertTabularViewType(viewType).value();
+  Value viewStruct = b.create<UndefOp>(viewStructType);
+  viewStruct = b.create<LLVM::InsertValueOp>(viewStruct, finalSize, 0);
+  for (size_t i = 0; i < numColumns; i++) {
+    Value buffer = whileOp.getResult(3 + i);
+    viewStruct = b.create<LLVM::InsertValueOp>(viewStruct, buffer, i + 1);
+  }
+
+  return {viewStruct};
+}
+
 /// Converts the given op to LLVM using the converted operands from the upstream
 /// iterator. This function is essentially a switch between conversion functions
 /// for sink and non-sink iterator ops.
@@ -1893,7 +2474,7 @@ convertIteratorOp(Operation *op, ValueRange operands, OpBuilder &builder,
         return SmallVector<Value>{
             convert(op, operands, opInfo, upstreamInfos, builder)};
       })
-      .Case<SinkOp, StreamToValueOp>([&](auto op) {
+      .Case<SinkOp, StreamToTabularOp, StreamToValueOp>([&](auto op) {
         using OpAdaptor = typename decltype(op)::Adaptor;
         OpAdaptor adaptor(operands, op->getAttrDictionary());
         return convert(op, adaptor, upstreamInfos, builder);
@@ -1984,7 +2565,8 @@ static void convertIteratorOps(ModuleOp module, TypeConverter &typeConverter) {
   SmallVector<Operation *, 16> workList;
   module->walk<WalkOrder::PreOrder>([&](Operation *op) {
     TypeSwitch<Operation *, void>(op)
-        .Case<IteratorOpInterface, SinkOp, StreamToValueOp>(
+        .Case<IteratorOpInterface, SinkOp, StreamToTabularOp,
+              StreamToValueOp>(
             [&](Operation *op) { workList.push_back(op); });
   });
 
@@ -2036,6 +2618,18 @@ static void convertIteratorOps(ModuleOp module, TypeConverter &typeConverter) {
           op->getResult(0).replaceAllUsesWith(converted[0]);
           op->getResult(1).replaceAllUsesWith(converted[1]);
         })
+        .Case<StreamToTabularOp>([&](auto op) {
+          // Special case: uses will not be converted, so cast the view struct
+          // back to the view type and replace them.
+          assert(converted.size() == 1 &&
+                 "Expected StreamToTabularOp to be converted to one value.");
+          Value view = rewriter
+                           .create<UnrealizedConversionCastOp>(
+                               op->getLoc(), op.getResult().getType(),
+                               converted[0])
+                           .getResult(0);
+          op->getResult(0).replaceAllUsesWith(view);
+        })
         .Case<SinkOp>([&](auto op) {
           // Special case: no result, nothing to do.
           assert(converted.empty() &&
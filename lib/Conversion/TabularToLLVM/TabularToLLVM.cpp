@@ -39,6 +39,10 @@ TabularTypeConverter::TabularTypeConverter(LLVMTypeConverter &llvmTypeConverter)
     : llvmTypeConverter(llvmTypeConverter) {
   addConversion([](Type type) { return type; });
   addConversion(convertTabularViewType);
+  addConversion(convertBitPackedType);
+  addConversion(convertRunLengthType);
+  addConversion(convertChunkedTabularViewType);
+  addConversion(convertZoneMapType);
 
   // Convert MemRefType using LLVMTypeConverter.
   addConversion([&](Type type) -> std::optional<Type> {
@@ -55,12 +59,60 @@ std::optional<Type> TabularTypeConverter::convertTabularViewType(Type type) {
     SmallVector<Type> fieldTypes{dynamicSize};
     fieldTypes.reserve(viewType.getNumColumnTypes() + 1);
     llvm::transform(viewType.getColumnTypes(), std::back_inserter(fieldTypes),
-                    [&](Type t) { return LLVMPointerType::get(context); });
+                    [&](Type t) -> Type {
+                      if (auto convertedType = convertBitPackedType(t))
+                        return *convertedType;
+                      if (auto convertedType = convertRunLengthType(t))
+                        return *convertedType;
+                      return LLVMPointerType::get(context);
+                    });
     return LLVMStructType::getLiteral(context, fieldTypes);
   }
   return std::nullopt;
 }
 
+std::optional<Type> TabularTypeConverter::convertBitPackedType(Type type) {
+  if (auto bitPackedType = type.dyn_cast<BitPackedType>()) {
+    MLIRContext *context = type.getContext();
+    Type i64 = IntegerType::get(context, /*width=*/64);
+    Type ptrType = LLVMPointerType::get(context);
+    return LLVMStructType::getLiteral(
+        context, {i64, ptrType, bitPackedType.getValueType()});
+  }
+  return std::nullopt;
+}
+
+std::optional<Type> TabularTypeConverter::convertRunLengthType(Type type) {
+  if (type.isa<RunLengthType>()) {
+    MLIRContext *context = type.getContext();
+    Type i64 = IntegerType::get(context, /*width=*/64);
+    Type ptrType = LLVMPointerType::get(context);
+    return LLVMStructType::getLiteral(context, {i64, i64, ptrType, ptrType});
+  }
+  return std::nullopt;
+}
+
+std::optional<Type>
+TabularTypeConverter::convertChunkedTabularViewType(Type type) {
+  if (type.isa<ChunkedTabularViewType>()) {
+    MLIRContext *context = type.getContext();
+    Type numChunksType = IntegerType::get(context, /*width=*/64);
+    Type chunksType = LLVMPointerType::get(context);
+    return LLVMStructType::getLiteral(context, {numChunksType, chunksType});
+  }
+  return std::nullopt;
+}
+
+std::optional<Type> TabularTypeConverter::convertZoneMapType(Type type) {
+  if (auto zoneMapType = type.dyn_cast<ZoneMapType>()) {
+    MLIRContext *context = type.getContext();
+    Type i64 = IntegerType::get(context, /*width=*/64);
+    Type ptrType = LLVMPointerType::get(context);
+    return LLVMStructType::getLiteral(context, {i64, i64, ptrType, ptrType});
+  }
+  return std::nullopt;
+}
+
 /// Lowers view_as_tabular to LLVM IR that extracts the bare pointers and the
 /// number of elements from the given memrefs.
 ///
@@ -93,6 +145,17 @@ struct ViewAsTabularOpLowering : public OpConversionPattern<ViewAsTabularOp> {
     // Extract column pointers and number of elements.
     Value numElements;
     for (auto [index, operand] : llvm::enumerate(adaptor.getOperands())) {
+      // Encoded columns: insert their struct as is.
+      if (op->getOperandTypes()[index].isa<EncodedColumnTypeInterface>()) {
+        if (index == 0) {
+          numElements = rewriter.create<LLVM::ExtractValueOp>(
+              loc, rewriter.getI64Type(), operand, 0);
+        }
+        viewStruct = rewriter.create<LLVM::InsertValueOp>(loc, viewStruct,
+                                                          operand, index + 1);
+        continue;
+      }
+
       assert(op->getOperandTypes()[index]
                  .cast<MemRefType>()
                  .getLayout()
@@ -121,9 +184,269 @@ struct ViewAsTabularOpLowering : public OpConversionPattern<ViewAsTabularOp> {
   }
 };
 
+/// Lowers view_as_chunked_tabular to LLVM IR that stores the structs of the
+/// given views into an array on the stack and combines a pointer to that array
+/// with the number of chunks.
+///
+/// Possible result:
+///
+/// %c2 = llvm.mlir.constant(2 : i64) : i64
+/// %2 = llvm.alloca %c2 x !llvm.struct<(i64, ptr)> : (i64) -> !llvm.ptr
+/// %3 = llvm.getelementptr %2[0] : (!llvm.ptr) -> !llvm.ptr, !llvm.struct<...>
+/// llvm.store %0, %3 : !llvm.struct<(i64, ptr)>, !llvm.ptr
+/// %4 = llvm.getelementptr %2[1] : (!llvm.ptr) -> !llvm.ptr, !llvm.struct<...>
+/// llvm.store %1, %4 : !llvm.struct<(i64, ptr)>, !llvm.ptr
+/// %5 = llvm.mlir.undef : !llvm.struct<(i64, ptr)>
+/// %6 = llvm.insertvalue %c2, %5[0] : !llvm.struct<(i64, ptr)>
+/// %7 = llvm.insertvalue %2, %6[1] : !llvm.struct<(i64, ptr)>
+struct ViewAsChunkedTabularOpLowering
+    : public OpConversionPattern<ViewAsChunkedTabularOp> {
+  ViewAsChunkedTabularOpLowering(TypeConverter &typeConverter,
+                                 MLIRContext *context,
+                                 PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(ViewAsChunkedTabularOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    Type i64 = rewriter.getI64Type();
+    Type opaquePtrType = LLVMPointerType::get(rewriter.getContext());
+
+    // Allocate array of chunks on the stack.
+    auto viewType = op.getView().getType().cast<ChunkedTabularViewType>();
+    Type chunkStructType =
+        typeConverter->convertType(viewType.getChunkType());
+    int64_t numChunks = adaptor.getChunks().size();
+    Value numChunksValue = rewriter.create<LLVM::ConstantOp>(
+        loc, i64, rewriter.getI64IntegerAttr(numChunks));
+    Value chunksPtr = rewriter.create<AllocaOp>(
+        loc, opaquePtrType, chunkStructType, numChunksValue);
+
+    // Store chunk structs into array.
+    for (auto [index, chunk] : llvm::enumerate(adaptor.getChunks())) {
+      Value gep = rewriter.create<GEPOp>(
+          loc, opaquePtrType, chunkStructType, chunksPtr,
+          ArrayRef<GEPArg>{static_cast<int32_t>(index)});
+      rewriter.create<StoreOp>(loc, chunk, gep);
+    }
+
+    // Assemble struct of chunked view.
+    Type viewStructType = typeConverter->convertType(viewType);
+    Value viewStruct = rewriter.create<UndefOp>(loc, viewStructType);
+    viewStruct = rewriter.create<LLVM::InsertValueOp>(loc, viewStruct,
+                                                      numChunksValue, 0);
+    viewStruct =
+        rewriter.create<LLVM::InsertValueOp>(loc, viewStruct, chunksPtr, 1);
+
+    // Replace original op.
+    rewriter.replaceOp(op, {viewStruct});
+
+    return success();
+  }
+};
+
+/// Lowers view_as_bit_packed to LLVM IR that extracts the bare pointer from the
+/// given memref and combines it with the number of rows and the reference.
+///
+/// Possible result:
+///
+/// %2 = llvm.mlir.undef : !llvm.struct<(i64, ptr, i32)>
+/// %3 = llvm.extractvalue %0[1] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %4 = llvm.insertvalue %numrows, %2[0] : !llvm.struct<(i64, ptr, i32)>
+/// %5 = llvm.insertvalue %3, %4[1] : !llvm.struct<(i64, ptr, i32)>
+/// %6 = llvm.insertvalue %reference, %5[2] : !llvm.struct<(i64, ptr, i32)>
+struct ViewAsBitPackedOpLowering
+    : public OpConversionPattern<ViewAsBitPackedOp> {
+  ViewAsBitPackedOpLowering(TypeConverter &typeConverter, MLIRContext *context,
+                            PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(ViewAsBitPackedOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    Type structType = typeConverter->convertType(op.getColumn().getType());
+    Value column = rewriter.create<UndefOp>(loc, structType);
+
+    MemRefDescriptor wordsDescriptor(adaptor.getWords());
+    Value wordsPtr = wordsDescriptor.alignedPtr(rewriter, loc);
+
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column,
+                                                  adaptor.getNumRows(), 0);
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column, wordsPtr, 1);
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column,
+                                                  adaptor.getReference(), 2);
+
+    rewriter.replaceOp(op, {column});
+    return success();
+  }
+};
+
+/// Lowers view_as_run_length to LLVM IR that extracts the bare pointers and the
+/// number of runs from the given memrefs and combines them with the number of
+/// rows.
+///
+/// Possible result:
+///
+/// %2 = llvm.mlir.undef : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %3 = llvm.extractvalue %0[1] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %4 = llvm.extractvalue %1[1] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %5 = llvm.extractvalue %0[3, 0] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %6 = llvm.insertvalue %numrows, %2[0] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %7 = llvm.insertvalue %5, %6[1] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %8 = llvm.insertvalue %3, %7[2] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %9 = llvm.insertvalue %4, %8[3] : !llvm.struct<(i64, i64, ptr, ptr)>
+struct ViewAsRunLengthOpLowering
+    : public OpConversionPattern<ViewAsRunLengthOp> {
+  ViewAsRunLengthOpLowering(TypeConverter &typeConverter, MLIRContext *context,
+                            PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(ViewAsRunLengthOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    Type structType = typeConverter->convertType(op.getColumn().getType());
+    Value column = rewriter.create<UndefOp>(loc, structType);
+
+    MemRefDescriptor valuesDescriptor(adaptor.getValues());
+    MemRefDescriptor runEndsDescriptor(adaptor.getRunEnds());
+    Value valuesPtr = valuesDescriptor.alignedPtr(rewriter, loc);
+    Value runEndsPtr = runEndsDescriptor.alignedPtr(rewriter, loc);
+    Value numRuns = valuesDescriptor.size(rewriter, loc, 0);
+
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column,
+                                                  adaptor.getNumRows(), 0);
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column, numRuns, 1);
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column, valuesPtr, 2);
+    column = rewriter.create<LLVM::InsertValueOp>(loc, column, runEndsPtr, 3);
+
+    rewriter.replaceOp(op, {column});
+    return success();
+  }
+};
+
+/// Lowers view_as_zone_map to LLVM IR that extracts the bare pointers and the
+/// number of chunks from the given memrefs and combines them with the chunk
+/// size.
+///
+/// Possible result:
+///
+/// %2 = llvm.mlir.undef : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %3 = llvm.extractvalue %0[1] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %4 = llvm.extractvalue %1[1] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %5 = llvm.extractvalue %0[3, 0] :
+///        !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+/// %6 = llvm.insertvalue %chunksize, %2[0] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %7 = llvm.insertvalue %5, %6[1] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %8 = llvm.insertvalue %3, %7[2] : !llvm.struct<(i64, i64, ptr, ptr)>
+/// %9 = llvm.insertvalue %4, %8[3] : !llvm.struct<(i64, i64, ptr, ptr)>
+struct ViewAsZoneMapOpLowering : public OpConversionPattern<ViewAsZoneMapOp> {
+  ViewAsZoneMapOpLowering(TypeConverter &typeConverter, MLIRContext *context,
+                          PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(ViewAsZoneMapOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    // Create empty struct for zone map.
+    Type zoneMapStructType =
+        typeConverter->convertType(op.getZoneMap().getType());
+    Value zoneMapStruct = rewriter.create<UndefOp>(loc, zoneMapStructType);
+
+    // Extract pointers and number of chunks from memref descriptors.
+    MemRefDescriptor minsDescriptor(adaptor.getMins());
+    MemRefDescriptor maxsDescriptor(adaptor.getMaxs());
+    Value minsPtr = minsDescriptor.alignedPtr(rewriter, loc);
+    Value maxsPtr = maxsDescriptor.alignedPtr(rewriter, loc);
+    Value numChunks = minsDescriptor.size(rewriter, loc, 0);
+
+    // Insert everything into zone map struct.
+    zoneMapStruct = rewriter.create<LLVM::InsertValueOp>(
+        loc, zoneMapStruct, adaptor.getChunkSize(), 0);
+    zoneMapStruct =
+        rewriter.create<LLVM::InsertValueOp>(loc, zoneMapStruct, numChunks, 1);
+    zoneMapStruct =
+        rewriter.create<LLVM::InsertValueOp>(loc, zoneMapStruct, minsPtr, 2);
+    zoneMapStruct =
+        rewriter.create<LLVM::InsertValueOp>(loc, zoneMapStruct, maxsPtr, 3);
+
+    // Replace original op.
+    rewriter.replaceOp(op, {zoneMapStruct});
+
+    return success();
+  }
+};
+
+/// Returns a symbol reference to the free function, inserting it into the
+/// module if necessary.
+static FlatSymbolRefAttr lookupOrInsertFree(OpBuilder &builder,
+                                            ModuleOp module) {
+  MLIRContext *context = builder.getContext();
+  if (module.lookupSymbol<LLVMFuncOp>("free"))
+    return SymbolRefAttr::get(context, "free");
+
+  // Create a function declaration for free, the signature is:
+  //   * `void (i8*)`
+  LLVMPointerType opaquePtrType = LLVMPointerType::get(context);
+  LLVMFunctionType freeFunctionType =
+      LLVMFunctionType::get(LLVMVoidType::get(context), opaquePtrType);
+
+  // Insert the free function into the body of the parent module.
+  OpBuilder::InsertionGuard insertGuard(builder);
+  builder.setInsertionPointToStart(module.getBody());
+  builder.create<LLVMFuncOp>(module->getLoc(), "free", freeFunctionType);
+  return SymbolRefAttr::get(context, "free");
+}
+
+/// Lowers dealloc to calls to free with each of the column pointers.
+///
+/// Possible result:
+///
+/// %1 = llvm.extractvalue %0[1] : !llvm.struct<(i64, ptr)>
+/// llvm.call @free(%1) : (!llvm.ptr) -> ()
+struct DeallocOpLowering : public OpConversionPattern<DeallocOp> {
+  DeallocOpLowering(TypeConverter &typeConverter, MLIRContext *context,
+                    PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(DeallocOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    Type opaquePtrType = LLVMPointerType::get(rewriter.getContext());
+    auto module = op->getParentOfType<ModuleOp>();
+    FlatSymbolRefAttr freeRef = lookupOrInsertFree(rewriter, module);
+
+    auto viewType = op.getView().getType().cast<TabularViewType>();
+    for (size_t i = 0; i < viewType.getNumColumnTypes(); i++) {
+      Value ptr = rewriter.create<LLVM::ExtractValueOp>(
+          loc, opaquePtrType, adaptor.getView(), i + 1);
+      rewriter.create<LLVM::CallOp>(loc, TypeRange(), freeRef, ptr);
+    }
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 void mlir::tabular::populateTabularToLLVMConversionPatterns(
     RewritePatternSet &patterns, TypeConverter &typeConverter) {
-  patterns.add<ViewAsTabularOpLowering>(typeConverter, patterns.getContext());
+  patterns.add<DeallocOpLowering, ViewAsBitPackedOpLowering,
+               ViewAsChunkedTabularOpLowering, ViewAsRunLengthOpLowering,
+               ViewAsTabularOpLowering, ViewAsZoneMapOpLowering>(
+      typeConverter, patterns.getContext());
 }
 
 void ConvertTabularToLLVMPass::runOnOperation() {
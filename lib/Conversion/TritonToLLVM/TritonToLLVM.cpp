@@ -19,10 +19,17 @@
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/SCF/Transforms/Transforms.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "triton/Dialect/Triton/IR/Dialect.h"
+#include "llvm/ADT/SmallBitVector.h"
+#include "llvm/ADT/TypeSwitch.h"
 
+#include <algorithm>
 #include <numeric>
 
 namespace mlir {
@@ -129,6 +136,593 @@ LLVM::AtomicBinOp convertRMWOpToLLVM(triton::RMWOp rmwOp) {
   return mapping.at(rmwOp);
 }
 
+/// Pointers to consecutive elements starting at `basePtr[offset + rangeStart]`.
+struct ContiguousPtrTensor {
+  /// Scalar pointer of the original IR that all pointers are derived from.
+  Value basePtr;
+  /// Scalar offset of the original IR added to all pointers (or null).
+  Value offset;
+  /// Start of the `tt.make_range` that makes the pointers consecutive.
+  int64_t rangeStart;
+};
+
+/// Analyzes the (original, unconverted) definition of the given tensor of
+/// pointers and returns its base pointer and offset if it is a 1-D tensor
+/// whose elements point to consecutive memory locations. This is the case for
+/// the pattern emitted by the Triton frontend for `ptr + offset + arange(...)`,
+/// i.e., `tt.addptr(tt.splat(ptr), offsets)` where `offsets` is either a
+/// `tt.make_range` or the sum of a `tt.make_range` and a `tt.splat`.
+std::optional<ContiguousPtrTensor> matchContiguousPtrTensor(Value ptrTensor) {
+  auto tensorType = ptrTensor.getType().dyn_cast<RankedTensorType>();
+  if (!tensorType || tensorType.getRank() != 1)
+    return std::nullopt;
+
+  auto addPtrOp = ptrTensor.getDefiningOp<triton::AddPtrOp>();
+  if (!addPtrOp)
+    return std::nullopt;
+  auto splatPtrOp = addPtrOp.getPtr().getDefiningOp<triton::SplatOp>();
+  if (!splatPtrOp)
+    return std::nullopt;
+
+  // Offsets of the form `make_range`.
+  Value offsets = addPtrOp.getOffset();
+  if (auto rangeOp = offsets.getDefiningOp<triton::MakeRangeOp>())
+    return ContiguousPtrTensor{splatPtrOp.getSrc(), Value(),
+                               rangeOp.getStart()};
+
+  // Offsets of the form `make_range + splat` or `splat + make_range`.
+  auto addOp = offsets.getDefiningOp<arith::AddIOp>();
+  if (!addOp)
+    return std::nullopt;
+  for (auto [lhs, rhs] : {std::make_pair(addOp.getLhs(), addOp.getRhs()),
+                          std::make_pair(addOp.getRhs(), addOp.getLhs())}) {
+    auto rangeOp = lhs.getDefiningOp<triton::MakeRangeOp>();
+    auto splatOffsetOp = rhs.getDefiningOp<triton::SplatOp>();
+    if (rangeOp && splatOffsetOp)
+      return ContiguousPtrTensor{splatPtrOp.getSrc(), splatOffsetOp.getSrc(),
+                                 rangeOp.getStart()};
+  }
+
+  return std::nullopt;
+}
+
+/// Builds a pointer to a vector of the given type that points to the first
+/// element of the given tensor of pointers of the original IR if that tensor
+/// points to consecutive elements; returns null otherwise.
+Value buildContiguousVectorPtr(ConversionPatternRewriter &rewriter,
+                               Location loc, Value ptrTensor,
+                               VectorType vectorType) {
+  std::optional<ContiguousPtrTensor> contiguousPtrs =
+      matchContiguousPtrTensor(ptrTensor);
+  if (!contiguousPtrs)
+    return {};
+
+  Value basePtr = rewriter.getRemappedValue(contiguousPtrs->basePtr);
+  if (!basePtr)
+    return {};
+  auto basePtrType = basePtr.getType().dyn_cast<LLVMPointerType>();
+  if (!basePtrType)
+    return {};
+
+  // Compute the offset of the first element.
+  Value offset;
+  if (contiguousPtrs->offset) {
+    offset = rewriter.getRemappedValue(contiguousPtrs->offset);
+    if (!offset)
+      return {};
+  }
+  Type offsetType = offset ? offset.getType() : rewriter.getI32Type();
+  Value rangeStart = rewriter.create<arith::ConstantOp>(
+      loc, rewriter.getIntegerAttr(offsetType, contiguousPtrs->rangeStart));
+  offset = offset ? rewriter.create<arith::AddIOp>(loc, offset, rangeStart)
+                  : rangeStart;
+
+  // Reinterpret the pointer to the first element as pointer to a vector.
+  Value firstPtr =
+      rewriter.create<LLVM::GEPOp>(loc, basePtrType, basePtr, offset);
+  auto vectorPtrType =
+      LLVMPointerType::get(vectorType, basePtrType.getAddressSpace());
+  return rewriter.create<LLVM::BitcastOp>(loc, vectorPtrType, firstPtr);
+}
+
+/// Reads the given statically shaped tensor into a vector of the same shape.
+Value buildVectorFromTensor(OpBuilder &builder, Location loc, Value tensor) {
+  auto tensorType = tensor.getType().cast<RankedTensorType>();
+  Type elementType = tensorType.getElementType();
+  auto vectorType = VectorType::get(tensorType.getShape(), elementType);
+  Value zero = builder.create<arith::ConstantIndexOp>(loc, 0);
+  SmallVector<Value> indices(tensorType.getRank(), zero);
+  SmallVector<bool> inBounds(tensorType.getRank(), true);
+  Value padding =
+      builder.create<arith::ConstantOp>(loc, builder.getZeroAttr(elementType));
+  return builder.create<vector::TransferReadOp>(loc, vectorType, tensor,
+                                                indices, padding, inBounds);
+}
+
+/// Writes the given vector into a new tensor of the same shape.
+Value buildTensorFromVector(OpBuilder &builder, Location loc, Value values) {
+  auto vectorType = values.getType().cast<VectorType>();
+  Value tensor = builder.create<tensor::EmptyOp>(loc, vectorType.getShape(),
+                                                 vectorType.getElementType());
+  Value zero = builder.create<arith::ConstantIndexOp>(loc, 0);
+  SmallVector<Value> indices(vectorType.getRank(), zero);
+  SmallVector<bool> inBounds(vectorType.getRank(), true);
+  return builder
+      .create<vector::TransferWriteOp>(loc, values, tensor, indices, inBounds)
+      .getResult();
+}
+
+/// Builds a vector of LLVM pointers from the given (converted) tensor of
+/// addresses.
+Value buildPtrVector(OpBuilder &builder, Location loc, Value addresses,
+                     Type llvmPtrType) {
+  auto tensorType = addresses.getType().cast<RankedTensorType>();
+  int64_t numElements = tensorType.getDimSize(0);
+  Value ptrs = buildVectorFromTensor(builder, loc, addresses);
+  auto i64VectorType = VectorType::get({numElements}, builder.getI64Type());
+  ptrs = builder.create<arith::IndexCastOp>(loc, i64VectorType, ptrs);
+  Type ptrVectorType = LLVM::getFixedVectorType(llvmPtrType, numElements);
+  return builder.create<LLVM::IntToPtrOp>(loc, ptrVectorType, ptrs);
+}
+
+/// Builds the mask vector of a vectorized load or store from the given
+/// (converted) mask tensor or an all-true mask if there is none.
+Value buildMaskVector(OpBuilder &builder, Location loc, Value mask,
+                      int64_t numElements) {
+  if (mask)
+    return buildVectorFromTensor(builder, loc, mask);
+  auto maskType = VectorType::get({numElements}, builder.getI1Type());
+  auto allTrue = DenseElementsAttr::get(maskType, true);
+  return builder.create<arith::ConstantOp>(loc, maskType, allTrue);
+}
+
+/// Returns the neutral element of the given kind of reduction on the given
+/// integer or float type, i.e., the value that doesn't change the result when
+/// combined with any other value.
+TypedAttr getNeutralElementAttr(vector::CombiningKind kind, Type type) {
+  using Kind = vector::CombiningKind;
+  if (auto floatType = type.dyn_cast<FloatType>()) {
+    const llvm::fltSemantics &semantics = floatType.getFloatSemantics();
+    switch (kind) {
+    case Kind::ADD:
+      return FloatAttr::get(type,
+                            APFloat::getZero(semantics, /*Negative=*/true));
+    case Kind::MUL:
+      return FloatAttr::get(type, APFloat::getOne(semantics));
+    case Kind::MAXF:
+      return FloatAttr::get(type,
+                            APFloat::getInf(semantics, /*Negative=*/true));
+    case Kind::MINF:
+      return FloatAttr::get(type, APFloat::getInf(semantics));
+    default:
+      llvm_unreachable("unsupported kind of float reduction");
+    }
+  }
+
+  unsigned bitWidth = type.getIntOrFloatBitWidth();
+  switch (kind) {
+  case Kind::ADD:
+  case Kind::OR:
+  case Kind::XOR:
+  case Kind::MAXUI:
+    return IntegerAttr::get(type, APInt::getZero(bitWidth));
+  case Kind::MUL:
+    return IntegerAttr::get(type, APInt(bitWidth, 1));
+  case Kind::AND:
+  case Kind::MINUI:
+    return IntegerAttr::get(type, APInt::getAllOnes(bitWidth));
+  case Kind::MAXSI:
+    return IntegerAttr::get(type, APInt::getSignedMinValue(bitWidth));
+  case Kind::MINSI:
+    return IntegerAttr::get(type, APInt::getSignedMaxValue(bitWidth));
+  default:
+    llvm_unreachable("unsupported kind of integer reduction");
+  }
+}
+
+/// Returns the kind of the reduction computed by `select(cond, lhs, rhs)` if
+/// `cond` is a comparison of `lhs` and `rhs` that selects the larger or the
+/// smaller of the two.
+std::optional<vector::CombiningKind> matchExtremumSelect(Value cond, Value lhs,
+                                                         Value rhs) {
+  using Kind = vector::CombiningKind;
+  Operation *cmpOp = cond.getDefiningOp();
+  if (!cmpOp || !isa<arith::CmpFOp, arith::CmpIOp>(cmpOp))
+    return std::nullopt;
+
+  // Find out whether the comparison has its operands in the same order as the
+  // select; otherwise, it selects the opposite extremum.
+  bool isSwapped;
+  if (cmpOp->getOperand(0) == lhs && cmpOp->getOperand(1) == rhs)
+    isSwapped = false;
+  else if (cmpOp->getOperand(0) == rhs && cmpOp->getOperand(1) == lhs)
+    isSwapped = true;
+  else
+    return std::nullopt;
+
+  auto selectKind = [&](bool isMax, Kind maxKind,
+                        Kind minKind) -> std::optional<Kind> {
+    return isMax != isSwapped ? maxKind : minKind;
+  };
+
+  if (auto cmpFOp = dyn_cast<arith::CmpFOp>(cmpOp)) {
+    switch (cmpFOp.getPredicate()) {
+    case CmpFPredicate::OGT:
+    case CmpFPredicate::OGE:
+    case CmpFPredicate::UGT:
+    case CmpFPredicate::UGE:
+      return selectKind(true, Kind::MAXF, Kind::MINF);
+    case CmpFPredicate::OLT:
+    case CmpFPredicate::OLE:
+    case CmpFPredicate::ULT:
+    case CmpFPredicate::ULE:
+      return selectKind(false, Kind::MAXF, Kind::MINF);
+    default:
+      return std::nullopt;
+    }
+  }
+
+  switch (cast<arith::CmpIOp>(cmpOp).getPredicate()) {
+  case CmpIPredicate::sgt:
+  case CmpIPredicate::sge:
+    return selectKind(true, Kind::MAXSI, Kind::MINSI);
+  case CmpIPredicate::slt:
+  case CmpIPredicate::sle:
+    return selectKind(false, Kind::MAXSI, Kind::MINSI);
+  case CmpIPredicate::ugt:
+  case CmpIPredicate::uge:
+    return selectKind(true, Kind::MAXUI, Kind::MINUI);
+  case CmpIPredicate::ult:
+  case CmpIPredicate::ule:
+    return selectKind(false, Kind::MAXUI, Kind::MINUI);
+  default:
+    return std::nullopt;
+  }
+}
+
+/// Returns the kind of the reduction computed by the given value if it is the
+/// result of a binary op on `lhs` and `rhs` (in any order) that corresponds
+/// to a `vector::CombiningKind` or of a `select` that picks the larger or
+/// smaller of the two.
+std::optional<vector::CombiningKind> matchCombiningKind(Value result,
+                                                        Value lhs, Value rhs) {
+  using Kind = vector::CombiningKind;
+  Operation *op = result.getDefiningOp();
+  if (!op)
+    return std::nullopt;
+
+  if (auto selectOp = dyn_cast<arith::SelectOp>(op)) {
+    if (selectOp.getTrueValue() == lhs && selectOp.getFalseValue() == rhs)
+      return matchExtremumSelect(selectOp.getCondition(), lhs, rhs);
+    if (selectOp.getTrueValue() == rhs && selectOp.getFalseValue() == lhs)
+      return matchExtremumSelect(selectOp.getCondition(), rhs, lhs);
+    return std::nullopt;
+  }
+
+  if (op->getNumOperands() != 2 ||
+      !((op->getOperand(0) == lhs && op->getOperand(1) == rhs) ||
+        (op->getOperand(0) == rhs && op->getOperand(1) == lhs)))
+    return std::nullopt;
+
+  return llvm::TypeSwitch<Operation *, std::optional<Kind>>(op)
+      .Case<arith::AddFOp, arith::AddIOp>([](auto) { return Kind::ADD; })
+      .Case<arith::MulFOp, arith::MulIOp>([](auto) { return Kind::MUL; })
+      .Case<arith::MaxFOp>([](auto) { return Kind::MAXF; })
+      .Case<arith::MinFOp>([](auto) { return Kind::MINF; })
+      .Case<arith::MaxSIOp>([](auto) { return Kind::MAXSI; })
+      .Case<arith::MinSIOp>([](auto) { return Kind::MINSI; })
+      .Case<arith::MaxUIOp>([](auto) { return Kind::MAXUI; })
+      .Case<arith::MinUIOp>([](auto) { return Kind::MINUI; })
+      .Case<arith::AndIOp>([](auto) { return Kind::AND; })
+      .Case<arith::OrIOp>([](auto) { return Kind::OR; })
+      .Case<arith::XOrIOp>([](auto) { return Kind::XOR; })
+      .Default([](Operation *) { return std::nullopt; });
+}
+
+/// Combine region of a `tt.reduce` op that `VectorizedReduceOpConversion`
+/// supports.
+struct ReduceCombiner {
+  /// Kind of the reduction of the (first) operand.
+  vector::CombiningKind kind;
+  /// Whether the op has a second operand holding the indices of the values
+  /// of the first one and computes the index of the extremal value next to
+  /// that value (like `tl.argmax`). Ties resolve to the smallest index.
+  bool isArgReduction;
+};
+
+/// Analyzes the combine region of the given `tt.reduce` op. Recognizes
+/// regions with a single op that corresponds to a `vector::CombiningKind`
+/// (such as the ones of `tl.sum` or `tl.max`) as well as arg-reductions of
+/// pairs of values and indices (such as the ones of `tl.argmax`), i.e.,
+/// `(select(c, v1, v2), select(c, i1, i2))` where `c` compares `v1` with `v2`,
+/// optionally with the tie-break `|| (v1 == v2 && i1 < i2)`.
+std::optional<ReduceCombiner> matchReduceCombiner(triton::ReduceOp op) {
+  Region &combineOp = op.getCombineOp();
+  if (!combineOp.hasOneBlock())
+    return std::nullopt;
+  Block &block = combineOp.front();
+  Operation *returnOp = block.getTerminator();
+
+  // Reductions of a single operand.
+  if (op->getNumOperands() == 1) {
+    std::optional<vector::CombiningKind> kind = matchCombiningKind(
+        returnOp->getOperand(0), block.getArgument(0), block.getArgument(1));
+    if (!kind)
+      return std::nullopt;
+    return ReduceCombiner{*kind, /*isArgReduction=*/false};
+  }
+
+  // Arg-reductions of values and indices.
+  if (op->getNumOperands() != 2 ||
+      !op->getOperand(1)
+           .getType()
+           .cast<RankedTensorType>()
+           .getElementType()
+           .isa<IntegerType>())
+    return std::nullopt;
+  Value v1 = block.getArgument(0);
+  Value i1 = block.getArgument(1);
+  Value v2 = block.getArgument(2);
+  Value i2 = block.getArgument(3);
+  auto valueSelectOp = returnOp->getOperand(0).getDefiningOp<arith::SelectOp>();
+  auto indexSelectOp = returnOp->getOperand(1).getDefiningOp<arith::SelectOp>();
+  if (!valueSelectOp || !indexSelectOp ||
+      valueSelectOp.getCondition() != indexSelectOp.getCondition() ||
+      valueSelectOp.getTrueValue() != v1 ||
+      valueSelectOp.getFalseValue() != v2 ||
+      indexSelectOp.getTrueValue() != i1 || indexSelectOp.getFalseValue() != i2)
+    return std::nullopt;
+
+  // Strip the tie-break from the condition if there is one.
+  auto isOperandPair = [](Operation *op, Value lhs, Value rhs) {
+    return (op->getOperand(0) == lhs && op->getOperand(1) == rhs) ||
+           (op->getOperand(0) == rhs && op->getOperand(1) == lhs);
+  };
+  auto isTieBreak = [&](Value value) {
+    auto andOp = value.getDefiningOp<arith::AndIOp>();
+    if (!andOp)
+      return false;
+    auto isEqual = [&](Value value) {
+      if (auto cmpOp = value.getDefiningOp<arith::CmpFOp>())
+        return cmpOp.getPredicate() == CmpFPredicate::OEQ &&
+               isOperandPair(cmpOp, v1, v2);
+      if (auto cmpOp = value.getDefiningOp<arith::CmpIOp>())
+        return cmpOp.getPredicate() == CmpIPredicate::eq &&
+               isOperandPair(cmpOp, v1, v2);
+      return false;
+    };
+    auto isFirstIndex = [&](Value value) {
+      auto cmpOp = value.getDefiningOp<arith::CmpIOp>();
+      return cmpOp && cmpOp.getPredicate() == CmpIPredicate::slt &&
+             cmpOp.getLhs() == i1 && cmpOp.getRhs() == i2;
+    };
+    return (isEqual(andOp.getLhs()) && isFirstIndex(andOp.getRhs())) ||
+           (isEqual(andOp.getRhs()) && isFirstIndex(andOp.getLhs()));
+  };
+  Value cond = valueSelectOp.getCondition();
+  if (auto orOp = cond.getDefiningOp<arith::OrIOp>()) {
+    if (isTieBreak(orOp.getRhs()))
+      cond = orOp.getLhs();
+    else if (isTieBreak(orOp.getLhs()))
+      cond = orOp.getRhs();
+  }
+
+  std::optional<vector::CombiningKind> kind =
+      matchExtremumSelect(cond, v1, v2);
+  if (!kind)
+    return std::nullopt;
+  return ReduceCombiner{*kind, /*isArgReduction=*/true};
+}
+
+/// Returns the kind of the reduction that combines the values of several
+/// atomic RMW ops of the given kind on elements of the given type into the
+/// value of a single one, if such a reduction exists.
+std::optional<vector::CombiningKind>
+getAtomicCombiningKind(triton::RMWOp rmwOp, Type elementType) {
+  using Kind = vector::CombiningKind;
+  if (elementType.isa<FloatType>()) {
+    if (rmwOp == RMWOp::FADD)
+      return Kind::ADD;
+    return std::nullopt;
+  }
+  if (!elementType.isa<IntegerType>())
+    return std::nullopt;
+  switch (rmwOp) {
+  case RMWOp::ADD:
+    return Kind::ADD;
+  case RMWOp::AND:
+    return Kind::AND;
+  case RMWOp::OR:
+    return Kind::OR;
+  case RMWOp::XOR:
+    return Kind::XOR;
+  case RMWOp::MAX:
+    return Kind::MAXSI;
+  case RMWOp::MIN:
+    return Kind::MINSI;
+  case RMWOp::UMAX:
+    return Kind::MAXUI;
+  case RMWOp::UMIN:
+    return Kind::MINUI;
+  default:
+    return std::nullopt;
+  }
+}
+
+/// Returns the dimensions along which all elements of the given tensor are
+/// equal because the tensor is the result of a splat or a broadcast or is
+/// computed elementwise from such tensors (as in `ptr + cols[None, :]`).
+llvm::SmallBitVector getUniformDims(Value tensor) {
+  int64_t rank = tensor.getType().cast<RankedTensorType>().getRank();
+  Operation *op = tensor.getDefiningOp();
+  if (!op)
+    return llvm::SmallBitVector(rank);
+
+  DenseElementsAttr attr;
+  if (isa<triton::SplatOp>(op) ||
+      (matchPattern(tensor, m_Constant(&attr)) && attr.isSplat()))
+    return llvm::SmallBitVector(rank, /*t=*/true);
+
+  if (auto broadcastOp = dyn_cast<triton::BroadcastOp>(op)) {
+    Value src = broadcastOp.getSrc();
+    llvm::SmallBitVector uniformDims = getUniformDims(src);
+    auto srcType = src.getType().cast<RankedTensorType>();
+    for (auto [dim, size] : llvm::enumerate(srcType.getShape())) {
+      if (size == 1)
+        uniformDims.set(dim);
+    }
+    return uniformDims;
+  }
+
+  // Elements of the result of an elementwise op are equal where the elements
+  // of all operands are.
+  if (!op->hasTrait<OpTrait::Elementwise>() || op->getNumResults() != 1)
+    return llvm::SmallBitVector(rank);
+  llvm::SmallBitVector uniformDims(rank, /*t=*/true);
+  for (Value operand : op->getOperands()) {
+    auto operandType = operand.getType().dyn_cast<RankedTensorType>();
+    if (!operandType || operandType.getRank() != rank)
+      return llvm::SmallBitVector(rank);
+    uniformDims &= getUniformDims(operand);
+  }
+  return uniformDims;
+}
+
+/// Converts atomic RMW ops on tensors of pointers that only have a few
+/// distinct targets, i.e., whose pointers are equal along some dimensions (as
+/// for `tl.atomic_add(ptr + cols[None, :] + zeros, x)`), into one atomic per
+/// distinct pointer. The values of the elements with the same pointer (and a
+/// set mask) are first combined locally, which replaces many contended atomics
+/// with a reduction in registers. This is only possible for kinds of RMW ops
+/// that can be combined (i.e., not `xchg`) and if the old values returned by
+/// the op are unused, since those depend on the order of the individual
+/// atomics. All other atomic RMW ops are left to `AtomicRMWOpConversion`.
+struct AggregatedAtomicRMWOpConversion
+    : public OpConversionPattern<triton::AtomicRMWOp> {
+  AggregatedAtomicRMWOpConversion(TypeConverter &typeConverter,
+                                  MLIRContext *context,
+                                  PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(triton::AtomicRMWOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    auto tensorType = op.getPtr().getType().dyn_cast<RankedTensorType>();
+    if (!tensorType || !tensorType.hasStaticShape())
+      return rewriter.notifyMatchFailure(
+          loc, "only static tensors of pointers supported");
+    if (!op->use_empty())
+      return rewriter.notifyMatchFailure(loc, "old values must be unused");
+
+    auto valueType = adaptor.getVal().getType().cast<RankedTensorType>();
+    Type elementType = valueType.getElementType();
+    std::optional<vector::CombiningKind> kind =
+        getAtomicCombiningKind(adaptor.getAtomicRmwOp(), elementType);
+    if (!kind)
+      return rewriter.notifyMatchFailure(loc, "values can't be combined");
+
+    // Reduce along the dimensions where the pointers are equal.
+    llvm::SmallBitVector uniformDims = getUniformDims(op.getPtr());
+    if (uniformDims.none())
+      return rewriter.notifyMatchFailure(loc, "pointers may all be distinct");
+    ArrayRef<int64_t> shape = tensorType.getShape();
+    SmallVector<int64_t> reductionDims;
+    SmallVector<int64_t> keptDims;
+    SmallVector<int64_t> reducedShape;
+    for (auto [dim, size] : llvm::enumerate(shape)) {
+      if (uniformDims.test(dim)) {
+        reductionDims.push_back(dim);
+      } else {
+        keptDims.push_back(dim);
+        reducedShape.push_back(size);
+      }
+    }
+
+    // Builds a `linalg.reduce` op that combines the elements of the given
+    // tensor along the reduction dimensions.
+    auto buildReduction = [&](Value tensor, TypedAttr init,
+                              vector::CombiningKind reductionKind) -> Value {
+      Value initValue = rewriter.create<arith::ConstantOp>(loc, init);
+      auto reducedType = RankedTensorType::get(reducedShape, init.getType());
+      Value inits =
+          rewriter.create<tensor::SplatOp>(loc, initValue, reducedType);
+      auto reduceOp = rewriter.create<linalg::ReduceOp>(
+          loc, tensor, inits, reductionDims,
+          [&](OpBuilder &b, Location loc, ValueRange args) {
+            Value combined =
+                vector::makeArithReduction(b, loc, reductionKind, args[0],
+                                           args[1]);
+            b.create<linalg::YieldOp>(loc, combined);
+          });
+      return reduceOp->getResult(0);
+    };
+
+    // Combine the values per pointer, replacing the values of the elements
+    // that are masked out with the neutral element of the combination. Also
+    // combine the mask such that we only issue an atomic for pointers where at
+    // least one element is active.
+    TypedAttr neutralElement = getNeutralElementAttr(*kind, elementType);
+    Value values = adaptor.getVal();
+    Value mask = adaptor.getMask();
+    if (mask) {
+      Value neutralValue =
+          rewriter.create<arith::ConstantOp>(loc, neutralElement);
+      Value neutralValues =
+          rewriter.create<tensor::SplatOp>(loc, neutralValue, valueType);
+      values =
+          rewriter.create<arith::SelectOp>(loc, mask, values, neutralValues);
+      mask = buildReduction(mask, rewriter.getBoolAttr(false),
+                            vector::CombiningKind::OR);
+    }
+    values = buildReduction(values, neutralElement, *kind);
+
+    // Issue one atomic per distinct pointer, which we extract from the first
+    // element along the reduction dimensions.
+    Type llvmPtrType = typeConverter->convertType(
+        tensorType.getElementType().cast<triton::PointerType>());
+    LLVM::AtomicBinOp binOp = convertRMWOpToLLVM(adaptor.getAtomicRmwOp());
+    LLVM::AtomicOrdering ordering = convertMemSemanticToLLVM(adaptor.getSem());
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value one = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    SmallVector<Value> lbs(reducedShape.size(), zero);
+    SmallVector<Value> steps(reducedShape.size(), one);
+    SmallVector<Value> ubs;
+    for (int64_t size : reducedShape)
+      ubs.push_back(rewriter.create<arith::ConstantIndexOp>(loc, size));
+    scf::buildLoopNest(
+        rewriter, loc, lbs, ubs, steps,
+        [&](OpBuilder &b, Location loc, ValueRange ivs) {
+          SmallVector<Value> ptrIndices(shape.size(), zero);
+          for (auto [dim, iv] : llvm::zip(keptDims, ivs))
+            ptrIndices[dim] = iv;
+
+          Value ptr =
+              b.create<tensor::ExtractOp>(loc, adaptor.getPtr(), ptrIndices);
+          ptr = b.create<arith::IndexCastOp>(loc, b.getI64Type(), ptr);
+          ptr = b.create<LLVM::IntToPtrOp>(loc, llvmPtrType, ptr);
+          Value value = b.create<tensor::ExtractOp>(loc, values, ivs);
+
+          // Unmasked.
+          if (!mask) {
+            b.create<LLVM::AtomicRMWOp>(loc, binOp, ptr, value, ordering);
+            return;
+          }
+
+          // Masked.
+          Value active = b.create<tensor::ExtractOp>(loc, mask, ivs);
+          b.create<scf::IfOp>(loc, active, [&](OpBuilder &b, Location loc) {
+            b.create<LLVM::AtomicRMWOp>(loc, binOp, ptr, value, ordering);
+            b.create<scf::YieldOp>(loc);
+          });
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 struct AtomicCASOpConversion : public OpConversionPattern<triton::AtomicCASOp> {
   AtomicCASOpConversion(TypeConverter &typeConverter, MLIRContext *context,
                         PatternBenefit benefit = 1)
@@ -437,10 +1031,29 @@ struct BroadcastOpConversion : public OpConversionPattern<triton::BroadcastOp> {
     auto collapseOp = rewriter.create<tensor::CollapseShapeOp>(
         loc, adaptor.getSrc(), reassociationMap);
 
-    // Broadcast collapsed value to empty tensor of desired shape.
+    // Broadcast collapsed value to empty tensor of desired shape. We use a
+    // `linalg.generic` op whose indexing map of the input drops the broadcast
+    // dimensions rather than `linalg.broadcast`: `linalg-fuse-elementwise-ops`
+    // fuses the former into its elementwise consumers, which then read the
+    // collapsed value directly, such that the broadcast is never materialized.
+    SmallVector<AffineExpr> inputExprs;
+    for (int64_t dim = 0; dim < rank; dim++) {
+      if (!llvm::is_contained(broadcastDims, dim))
+        inputExprs.push_back(rewriter.getAffineDimExpr(dim));
+    }
+    SmallVector<AffineMap> indexingMaps = {
+        AffineMap::get(rank, /*symbolCount=*/0, inputExprs,
+                       rewriter.getContext()),
+        rewriter.getMultiDimIdentityMap(rank)};
+    SmallVector<utils::IteratorType> iteratorTypes(
+        rank, utils::IteratorType::parallel);
     auto init = rewriter.create<tensor::EmptyOp>(loc, resultShape, elementType);
-    rewriter.replaceOpWithNewOp<linalg::BroadcastOp>(op, collapseOp, init,
-                                                     broadcastDims);
+    rewriter.replaceOpWithNewOp<linalg::GenericOp>(
+        op, init.getType(), ValueRange{collapseOp}, ValueRange{init},
+        indexingMaps, iteratorTypes,
+        [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg::YieldOp>(loc, args[0]);
+        });
 
     return success();
   }
@@ -545,9 +1158,10 @@ struct LoadOpConversion : OpConversionPattern<triton::LoadOp> {
 
     // Tensor of pointers.
     // TODO(ingomueller): This is a manual tiling by one. That is fine in order
-    //     to get things running but drops a lot of information. Eventually, we
-    //     want to map this to a vectorized load/gather in order to distribute
-    //     the loading over SIMT threads.
+    //     to get things running but drops a lot of information. Loads from
+    //     1-D tensors of pointers to scalars are vectorized by
+    //     `VectorizedLoadOpConversion`; the remaining cases should eventually
+    //     be mapped to vectorized loads/gathers as well.
     Type originalPointerType = op.getPtr().getType();
     if (auto tensorType = originalPointerType.dyn_cast<RankedTensorType>()) {
       if (!tensorType.hasStaticShape())
@@ -685,20 +1299,13 @@ struct MakeRangeOpConversion : public OpConversionPattern<triton::MakeRangeOp> {
   }
 };
 
-struct ReduceReturnOpConversion
-    : public OpConversionPattern<triton::ReduceReturnOp> {
-  ReduceReturnOpConversion(TypeConverter &typeConverter, MLIRContext *context,
-                           PatternBenefit benefit = 1)
-      : OpConversionPattern(typeConverter, context, benefit) {}
-
-  LogicalResult
-  matchAndRewrite(triton::ReduceReturnOp op, OpAdaptor adaptor,
-                  ConversionPatternRewriter &rewriter) const override {
-    rewriter.replaceOpWithNewOp<linalg::YieldOp>(op, adaptor.getOperands());
-    return success();
-  }
-};
-
+/// Converts `tt.reduce` into a tree of element-wise combinations: each step
+/// combines the first half of the slices along the reduction axis with the
+/// second half using a `linalg.generic` op whose body is the combine region.
+/// Unlike a reduction into an init value, this works for any combine region,
+/// not only those with a known neutral element, and takes a logarithmic
+/// number of steps. The combine region must thus be associative and
+/// commutative, which Triton requires anyway.
 struct ReduceOpConversion : public OpConversionPattern<triton::ReduceOp> {
   ReduceOpConversion(TypeConverter &typeConverter, MLIRContext *context,
                      PatternBenefit benefit = 1)
@@ -708,62 +1315,116 @@ struct ReduceOpConversion : public OpConversionPattern<triton::ReduceOp> {
   matchAndRewrite(triton::ReduceOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
     Location loc = op->getLoc();
+    MLIRContext *context = rewriter.getContext();
+
+    auto inputType =
+        adaptor.getOperands().front().getType().cast<RankedTensorType>();
+    if (!inputType.hasStaticShape())
+      return rewriter.notifyMatchFailure(
+          loc, "only static shapes supported for now");
+    int64_t rank = inputType.getRank();
+    int64_t axis = op.getAxis();
+    int64_t numOperands = op->getNumOperands();
+    Block &combineBlock = op.getCombineOp().front();
+
+    // Returns the offsets, sizes, and strides of the slices
+    // [offset, offset + size) along the reduction axis of the given tensor.
+    auto getSliceParams = [&](Value tensor, int64_t offset, int64_t size) {
+      auto tensorType = tensor.getType().cast<RankedTensorType>();
+      SmallVector<OpFoldResult> offsets(rank, rewriter.getIndexAttr(0));
+      SmallVector<OpFoldResult> sizes =
+          getAsIndexOpFoldResult(context, tensorType.getShape());
+      SmallVector<OpFoldResult> strides(rank, rewriter.getIndexAttr(1));
+      offsets[axis] = rewriter.getIndexAttr(offset);
+      sizes[axis] = rewriter.getIndexAttr(size);
+      return std::make_tuple(offsets, sizes, strides);
+    };
+    auto extractSlices = [&](Value tensor, int64_t offset,
+                             int64_t size) -> Value {
+      auto [offsets, sizes, strides] = getSliceParams(tensor, offset, size);
+      return rewriter.create<tensor::ExtractSliceOp>(loc, tensor, offsets,
+                                                     sizes, strides);
+    };
+
+    // Combine the two halves of the slices until only one slice is left. If
+    // the number of slices is odd, the middle slice is carried over as is.
+    SmallVector<Value> values(adaptor.getOperands());
+    SmallVector<AffineMap> indexingMaps(3 * numOperands,
+                                        rewriter.getMultiDimIdentityMap(rank));
+    SmallVector<utils::IteratorType> iteratorTypes(
+        rank, utils::IteratorType::parallel);
+    for (int64_t size = inputType.getDimSize(axis); size > 1;) {
+      int64_t half = size / 2;
+      int64_t remaining = size - half;
+
+      SmallVector<Value> inputs;
+      for (Value value : values)
+        inputs.push_back(extractSlices(value, 0, half));
+      for (Value value : values)
+        inputs.push_back(extractSlices(value, remaining, half));
+      SmallVector<Value> inits;
+      for (Value input : ArrayRef<Value>(inputs).take_front(numOperands)) {
+        auto sliceType = input.getType().cast<RankedTensorType>();
+        inits.push_back(rewriter.create<tensor::EmptyOp>(
+            loc, sliceType.getShape(), sliceType.getElementType()));
+      }
+      auto genericOp = rewriter.create<linalg::GenericOp>(
+          loc, ValueRange(inits).getTypes(), inputs, inits, indexingMaps,
+          iteratorTypes);
+
+      // Clone the combine region into the body. Its arguments are those of
+      // the inputs; the ones of the inits are unused.
+      {
+        OpBuilder::InsertionGuard guard(rewriter);
+        SmallVector<Type> argTypes(combineBlock.getArgumentTypes());
+        for (Value init : inits)
+          argTypes.push_back(
+              init.getType().cast<RankedTensorType>().getElementType());
+        SmallVector<Location> argLocs(argTypes.size(), loc);
+        Block *body = rewriter.createBlock(&genericOp.getRegion(),
+                                           genericOp.getRegion().end(),
+                                           argTypes, argLocs);
+        IRMapping mapping;
+        mapping.map(combineBlock.getArguments(),
+                    body->getArguments().take_front(2 * numOperands));
+        for (Operation &combineOp : combineBlock.without_terminator())
+          rewriter.clone(combineOp, mapping);
+        SmallVector<Value> yieldedValues;
+        for (Value value : combineBlock.getTerminator()->getOperands())
+          yieldedValues.push_back(mapping.lookupOrDefault(value));
+        rewriter.create<linalg::YieldOp>(loc, yieldedValues);
+      }
 
-    // Derive types. `tt.reduce` treats reducing a 1-D tensor with a special
-    // case that returns a scalar, but we treat it as a 0-D tensor in these
-    // types.
-    auto convertedInputTensorTypes =
-        llvm::map_range(adaptor.getOperands().getTypes(),
-                        [](Type t) { return t.cast<TensorType>(); });
-    auto originalResultTensorTypes =
-        llvm::map_range(op.getResultTypes(), [](Type t) -> TensorType {
-          if (auto tensorType = t.dyn_cast<TensorType>())
-            return tensorType;
-          return RankedTensorType::get({}, t);
-        });
-    assert(llvm::all_equal(llvm::map_range(
-        convertedInputTensorTypes, [](TensorType t) { return t.getShape(); })));
-    assert(llvm::all_equal(llvm::map_range(
-        originalResultTensorTypes, [](TensorType t) { return t.getShape(); })));
-    ArrayRef<int64_t> resultShape =
-        (*originalResultTensorTypes.begin()).getShape();
-    auto convertedResultTensorTypes =
-        llvm::map_range(originalResultTensorTypes, [&](TensorType t) {
-          return RankedTensorType::get(resultShape, t.getElementType());
-        });
-
-    // Create empty vectors as init values.
-    llvm::SmallVector<Value> initVals;
-    for (TensorType t : convertedResultTensorTypes) {
-      TypedAttr zeroAttr = rewriter.getZeroAttr(t.getElementType());
-      Value zero = rewriter.create<arith::ConstantOp>(loc, zeroAttr);
-      auto emptyOp = rewriter.create<tensor::SplatOp>(loc, t, zero);
-      initVals.push_back(emptyOp);
-    }
-
-    // Create a linalg.reduce on the same input and move the combine region
-    // there. (ReduceReturnOpConversion will take care of the terminator.)
-    auto reduceOp = rewriter.create<linalg::ReduceOp>(
-        loc, /*resultTypes=*/SmallVector<Type>(convertedResultTensorTypes),
-        /*inputs=*/adaptor.getOperands(), /*inits=*/initVals,
-        /*dimensions=*/ArrayRef<int64_t>{op.getAxis()});
-    rewriter.inlineRegionBefore(op.getCombineOp(), reduceOp.getCombiner(),
-                                reduceOp.getCombiner().end());
-
-    // If the result on tt.reduce are tensors with rank > 0, we are done.
-    if (!resultShape.empty()) {
-      rewriter.replaceOp(op, reduceOp);
-      return success();
+      for (int64_t i = 0; i < numOperands; i++) {
+        Value combined = genericOp->getResult(i);
+        if (remaining != half) {
+          Value prefix = extractSlices(values[i], 0, remaining);
+          auto [offsets, sizes, strides] = getSliceParams(prefix, 0, half);
+          combined = rewriter.create<tensor::InsertSliceOp>(
+              loc, combined, prefix, offsets, sizes, strides);
+        }
+        values[i] = combined;
+      }
+      size = remaining;
     }
 
-    // Otherwise, the result has to be a scalar, so we need to extract the
-    // scalar from the 0-ranked result tensor.
+    // Drop the reduction axis. `tt.reduce` treats reducing a 1-D tensor with a
+    // special case that returns a scalar.
     SmallVector<Value> results;
-    for (auto [tensor, type] :
-         llvm::zip(reduceOp->getResults(), convertedResultTensorTypes)) {
-      Value scalar = rewriter.create<tensor::ExtractOp>(
-          loc, type.getElementType(), tensor, /*indices=*/ValueRange{});
-      results.push_back(scalar);
+    for (auto [value, resultType] : llvm::zip(values, op.getResultTypes())) {
+      auto resultTensorType = resultType.dyn_cast<RankedTensorType>();
+      if (!resultTensorType) {
+        Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+        results.push_back(
+            rewriter.create<tensor::ExtractOp>(loc, value, ValueRange{zero}));
+        continue;
+      }
+      auto [offsets, sizes, strides] = getSliceParams(value, 0, 1);
+      auto valueType = value.getType().cast<RankedTensorType>();
+      auto convertedResultType = RankedTensorType::get(
+          resultTensorType.getShape(), valueType.getElementType());
+      results.push_back(rewriter.create<tensor::ExtractSliceOp>(
+          loc, convertedResultType, value, offsets, sizes, strides));
     }
     rewriter.replaceOp(op, results);
 
@@ -845,9 +1506,10 @@ struct StoreOpConversion : OpConversionPattern<triton::StoreOp> {
 
     // Tensor of pointers.
     // TODO(ingomueller): This is a manual tiling by one. That is fine in order
-    //     to get things running but drops a lot of information. Eventually, we
-    //     want to map this to a vectorized store/scatter in order to distribute
-    //     the storing over SIMT threads.
+    //     to get things running but drops a lot of information. Stores to 1-D
+    //     tensors of pointers to scalars are vectorized by
+    //     `VectorizedStoreOpConversion`; the remaining cases should eventually
+    //     be mapped to vectorized stores/scatters as well.
     Type originalPointerType = op.getPtr().getType();
     if (auto tensorType = originalPointerType.dyn_cast<RankedTensorType>()) {
       if (!tensorType.hasStaticShape())
@@ -930,6 +1592,495 @@ struct StoreOpConversion : OpConversionPattern<triton::StoreOp> {
   }
 };
 
+/// Converts `tt.dot` on static 2-D tensors into a register-tiled loop nest of
+/// vector contractions. The two outer loops iterate over the tiles of the
+/// result, each of which is kept in a vector (i.e., in registers) while the
+/// inner loop accumulates the products of the corresponding tiles of A and B
+/// into it. `convert-vector-to-llvm` later lowers the contractions to outer
+/// products and FMAs. Inputs with a narrower element type than the result
+/// (such as fp16 or bf16 inputs accumulating into fp32) are extended tile by
+/// tile. Dots whose shapes are not multiples of the tile sizes are left to
+/// `DotOpConversion`.
+struct VectorizedDotOpConversion : OpConversionPattern<triton::DotOp> {
+  /// Creates a pattern with the given maximum sizes of the register tiles in
+  /// the M, N, and K dimensions.
+  VectorizedDotOpConversion(TypeConverter &typeConverter, MLIRContext *context,
+                            int64_t maxTileM, int64_t maxTileN,
+                            int64_t maxTileK, PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit),
+        maxTileM(maxTileM), maxTileN(maxTileN), maxTileK(maxTileK) {}
+
+  LogicalResult
+  matchAndRewrite(triton::DotOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    MLIRContext *context = rewriter.getContext();
+
+    auto typeA = op.getA().getType().cast<RankedTensorType>();
+    auto typeB = op.getB().getType().cast<RankedTensorType>();
+    auto typeC = op.getC().getType().cast<RankedTensorType>();
+    if (typeA.getRank() != 2 || !typeA.hasStaticShape() ||
+        !typeB.hasStaticShape() || !typeC.hasStaticShape())
+      return rewriter.notifyMatchFailure(
+          loc, "only static 2-D tensors supported");
+
+    // Determine tile sizes.
+    int64_t m = typeC.getDimSize(0);
+    int64_t n = typeC.getDimSize(1);
+    int64_t k = typeA.getDimSize(1);
+    int64_t tileM = std::min(maxTileM, m);
+    int64_t tileN = std::min(maxTileN, n);
+    int64_t tileK = std::min(maxTileK, k);
+    if (m % tileM != 0 || n % tileN != 0 || k % tileK != 0)
+      return rewriter.notifyMatchFailure(
+          loc, "shapes must be multiples of the tile sizes");
+
+    // Check that the inputs can be extended to the type of the result.
+    Type resultElementType = typeC.getElementType();
+    auto canExtend = [&](Type type) {
+      if (type == resultElementType)
+        return true;
+      if (type.isa<FloatType>() && resultElementType.isa<FloatType>())
+        return type.getIntOrFloatBitWidth() <
+               resultElementType.getIntOrFloatBitWidth();
+      if (type.isa<IntegerType>() && resultElementType.isa<IntegerType>())
+        return type.getIntOrFloatBitWidth() <
+               resultElementType.getIntOrFloatBitWidth();
+      return false;
+    };
+    if (!canExtend(typeA.getElementType()) ||
+        !canExtend(typeB.getElementType()))
+      return rewriter.notifyMatchFailure(
+          loc, "input element types must not be wider than result type");
+
+    auto tileTypeA = VectorType::get({tileM, tileK}, typeA.getElementType());
+    auto tileTypeB = VectorType::get({tileK, tileN}, typeB.getElementType());
+    auto tileTypeC = VectorType::get({tileM, tileN}, resultElementType);
+
+    // Reads the tile at the given indices into a vector, extending its
+    // elements to the type of the result if necessary.
+    auto readTile = [&](OpBuilder &b, Location loc, VectorType tileType,
+                        Value tensor, ValueRange indices) -> Value {
+      Type elementType = tileType.getElementType();
+      Value padding =
+          b.create<arith::ConstantOp>(loc, b.getZeroAttr(elementType));
+      Value tile = b.create<vector::TransferReadOp>(
+          loc, tileType, tensor, indices, padding,
+          /*inBounds=*/ArrayRef<bool>{true, true});
+      if (elementType == resultElementType)
+        return tile;
+      auto extendedType =
+          VectorType::get(tileType.getShape(), resultElementType);
+      if (elementType.isa<FloatType>())
+        return b.create<arith::ExtFOp>(loc, extendedType, tile);
+      return b.create<arith::ExtSIOp>(loc, extendedType, tile);
+    };
+
+    // Contraction of one tile: C[m, n] += A[m, k] * B[k, n].
+    AffineExpr dm, dn, dk;
+    bindDims(context, dm, dn, dk);
+    using MapList = ArrayRef<ArrayRef<AffineExpr>>;
+    SmallVector<vector::IteratorType> iteratorTypes = {
+        vector::IteratorType::parallel, vector::IteratorType::parallel,
+        vector::IteratorType::reduction};
+
+    // Compute bounds of loops.
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    SmallVector<Value> lbs = {zero, zero};
+    SmallVector<Value> ubs = {
+        rewriter.create<arith::ConstantIndexOp>(loc, m),
+        rewriter.create<arith::ConstantIndexOp>(loc, n)};
+    SmallVector<Value> steps = {
+        rewriter.create<arith::ConstantIndexOp>(loc, tileM),
+        rewriter.create<arith::ConstantIndexOp>(loc, tileN)};
+    Value ubK = rewriter.create<arith::ConstantIndexOp>(loc, k);
+    Value stepK = rewriter.create<arith::ConstantIndexOp>(loc, tileK);
+
+    // Compute one tile of the result at a time.
+    LoopNest forOp = scf::buildLoopNest(
+        rewriter, loc, lbs, ubs, steps, adaptor.getC(),
+        [&](OpBuilder &b, Location loc, ValueRange ivs, ValueRange args) {
+          Value result = args[0];
+          Value ivM = ivs[0];
+          Value ivN = ivs[1];
+
+          // Accumulate into the tile of the result in registers.
+          Value accumulator =
+              readTile(b, loc, tileTypeC, result, ValueRange{ivM, ivN});
+          auto reductionOp = b.create<scf::ForOp>(
+              loc, zero, ubK, stepK, accumulator,
+              [&](OpBuilder &b, Location loc, Value ivK, ValueRange iterArgs) {
+                Value tileA = readTile(b, loc, tileTypeA, adaptor.getA(),
+                                       ValueRange{ivM, ivK});
+                Value tileB = readTile(b, loc, tileTypeB, adaptor.getB(),
+                                       ValueRange{ivK, ivN});
+                Value product = b.create<vector::ContractionOp>(
+                    loc, tileA, tileB, iterArgs[0],
+                    MapList{{dm, dk}, {dk, dn}, {dm, dn}}, iteratorTypes);
+                b.create<scf::YieldOp>(loc, product);
+              });
+
+          // Write the tile back.
+          auto writeOp = b.create<vector::TransferWriteOp>(
+              loc, reductionOp.getResult(0), result, ValueRange{ivM, ivN},
+              /*inBounds=*/ArrayRef<bool>{true, true});
+          return SmallVector<Value>{writeOp.getResult()};
+        });
+
+    rewriter.replaceOp(op, forOp.results[0]);
+    return success();
+  }
+
+private:
+  int64_t maxTileM;
+  int64_t maxTileN;
+  int64_t maxTileK;
+};
+
+/// Converts loads from 1-D tensors of pointers to integers or floats into
+/// vector loads. If the pointers point to consecutive elements, the load
+/// becomes a single (masked) load of a vector; otherwise, it becomes a masked
+/// gather. All other loads are left to `LoadOpConversion`.
+struct VectorizedLoadOpConversion : OpConversionPattern<triton::LoadOp> {
+  VectorizedLoadOpConversion(TypeConverter &typeConverter,
+                             MLIRContext *context, PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    auto tensorType = op.getPtr().getType().dyn_cast<RankedTensorType>();
+    if (!tensorType || tensorType.getRank() != 1 ||
+        !tensorType.hasStaticShape())
+      return rewriter.notifyMatchFailure(
+          loc, "only static 1-D tensors of pointers supported");
+
+    // Derive types.
+    auto elementPtrType =
+        tensorType.getElementType().cast<triton::PointerType>();
+    Type llvmPtrType = typeConverter->convertType(elementPtrType);
+    Type llvmElementType = llvmPtrType.cast<LLVMPointerType>().getElementType();
+    if (!llvmElementType.isIntOrFloat())
+      return rewriter.notifyMatchFailure(
+          loc, "only pointers to integers or floats supported");
+    int64_t numElements = tensorType.getDimSize(0);
+    auto vectorType = VectorType::get({numElements}, llvmElementType);
+    unsigned alignment =
+        DataLayout::closest(op).getTypeABIAlignment(llvmElementType);
+
+    // Prepare mask and pass-through values.
+    Value mask = buildMaskVector(rewriter, loc, adaptor.getMask(), numElements);
+    Value passThru;
+    if (op.getOther())
+      passThru = buildVectorFromTensor(rewriter, loc, adaptor.getOther());
+    else
+      passThru = rewriter.create<LLVM::UndefOp>(loc, vectorType);
+
+    // Load consecutive elements with a vector load, others with a gather.
+    Value values;
+    if (Value vectorPtr =
+            buildContiguousVectorPtr(rewriter, loc, op.getPtr(), vectorType)) {
+      if (!op.getMask())
+        values = rewriter.create<LLVM::LoadOp>(loc, vectorPtr, alignment);
+      else
+        values = rewriter.create<LLVM::MaskedLoadOp>(
+            loc, vectorType, vectorPtr, mask, passThru, alignment);
+    } else {
+      Value ptrs = buildPtrVector(rewriter, loc, adaptor.getPtr(), llvmPtrType);
+      values = rewriter.create<LLVM::masked_gather>(loc, vectorType, ptrs, mask,
+                                                    passThru, alignment);
+    }
+
+    rewriter.replaceOp(op, buildTensorFromVector(rewriter, loc, values));
+    return success();
+  }
+};
+
+/// Converts `tt.reduce` ops with a combine region recognized by
+/// `matchReduceCombiner` on static tensors of integers or floats into vector
+/// reductions. If the reduction axis is the innermost dimension, each row is
+/// reduced horizontally with a `vector.reduction`; otherwise, the slices along
+/// the axis are combined vertically with a tree of element-wise ops on
+/// vectors. Arg-reductions first reduce the values and then find the smallest
+/// index of the extremal value in each row, or, in the vertical case, carry
+/// the indices through the tree. All other reductions are left to
+/// `ReduceOpConversion`.
+struct VectorizedReduceOpConversion : OpConversionPattern<triton::ReduceOp> {
+  VectorizedReduceOpConversion(TypeConverter &typeConverter,
+                               MLIRContext *context, PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(triton::ReduceOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    for (Value operand : adaptor.getOperands()) {
+      auto tensorType = operand.getType().cast<RankedTensorType>();
+      if (!tensorType.hasStaticShape() ||
+          !tensorType.getElementType().isIntOrFloat())
+        return rewriter.notifyMatchFailure(
+            loc, "only static tensors of integers or floats supported");
+    }
+    std::optional<ReduceCombiner> combiner = matchReduceCombiner(op);
+    if (!combiner)
+      return rewriter.notifyMatchFailure(loc, "unsupported combine region");
+    vector::CombiningKind kind = combiner->kind;
+
+    // Derive shapes.
+    auto inputType =
+        adaptor.getOperands().front().getType().cast<RankedTensorType>();
+    ArrayRef<int64_t> inputShape = inputType.getShape();
+    int64_t rank = inputType.getRank();
+    int64_t axis = op.getAxis();
+    int64_t size = inputShape[axis];
+    SmallVector<int64_t> resultShape(inputShape);
+    resultShape.erase(resultShape.begin() + axis);
+    int64_t numRows = std::accumulate(resultShape.begin(), resultShape.end(),
+                                      int64_t{1}, std::multiplies<int64_t>());
+    bool isInnerReduction = axis == rank - 1;
+
+    // Reads the given tensor into a vector of rows: in the horizontal case,
+    // each row is one slice of the reduction axis; in the vertical case, each
+    // row is one slice of the remaining axes.
+    auto readRows = [&](Value tensor) {
+      Value values = buildVectorFromTensor(rewriter, loc, tensor);
+      Type elementType =
+          tensor.getType().cast<RankedTensorType>().getElementType();
+      if (isInnerReduction) {
+        auto rowsType = VectorType::get({numRows, size}, elementType);
+        values = rewriter.create<vector::ShapeCastOp>(loc, rowsType, values);
+      } else {
+        if (axis != 0) {
+          SmallVector<int64_t> permutation = {axis};
+          for (int64_t i = 0; i < rank; i++)
+            if (i != axis)
+              permutation.push_back(i);
+          values = rewriter.create<vector::TransposeOp>(loc, values,
+                                                        permutation);
+        }
+        auto rowsType = VectorType::get({size, numRows}, elementType);
+        values = rewriter.create<vector::ShapeCastOp>(loc, rowsType, values);
+      }
+      SmallVector<Value> rows;
+      int64_t numVectorRows = isInnerReduction ? numRows : size;
+      for (int64_t i = 0; i < numVectorRows; i++)
+        rows.push_back(rewriter.create<vector::ExtractOp>(
+            loc, values, ArrayRef<int64_t>{i}));
+      return rows;
+    };
+
+    // Builds a comparison of `lhs` and `rhs` that is true if `lhs` is
+    // strictly more extreme than `rhs` (or equal to it) according to `kind`.
+    auto buildCompare = [&](Value lhs, Value rhs, bool isEqual) -> Value {
+      using Kind = vector::CombiningKind;
+      if (lhs.getType().cast<VectorType>().getElementType().isa<FloatType>()) {
+        CmpFPredicate predicate =
+            kind == Kind::MAXF ? CmpFPredicate::OGT : CmpFPredicate::OLT;
+        if (isEqual)
+          predicate = CmpFPredicate::OEQ;
+        return rewriter.create<arith::CmpFOp>(loc, predicate, lhs, rhs);
+      }
+      CmpIPredicate predicate;
+      switch (kind) {
+      case Kind::MAXSI:
+        predicate = CmpIPredicate::sgt;
+        break;
+      case Kind::MINSI:
+        predicate = CmpIPredicate::slt;
+        break;
+      case Kind::MAXUI:
+        predicate = CmpIPredicate::ugt;
+        break;
+      default:
+        predicate = CmpIPredicate::ult;
+        break;
+      }
+      if (isEqual)
+        predicate = CmpIPredicate::eq;
+      return rewriter.create<arith::CmpIOp>(loc, predicate, lhs, rhs);
+    };
+
+    // Builds a vector of the given type with the neutral element of the given
+    // kind of reduction in all elements.
+    auto buildNeutralVector = [&](vector::CombiningKind reductionKind,
+                                  VectorType vectorType) -> Value {
+      Attribute neutralElement =
+          getNeutralElementAttr(reductionKind, vectorType.getElementType());
+      return rewriter.create<arith::ConstantOp>(
+          loc, vectorType, DenseElementsAttr::get(vectorType, neutralElement));
+    };
+
+    // Reduce each operand (or, for arg-reductions, the pairs of values and
+    // indices) to a vector of `numRows` elements (or a scalar).
+    SmallVector<Value> results;
+    if (isInnerReduction) {
+      SmallVector<SmallVector<Value>> rowsPerOperand;
+      for (Value operand : adaptor.getOperands())
+        rowsPerOperand.push_back(readRows(operand));
+
+      // Reduces one row of each operand to a scalar.
+      auto reduceRow = [&](int64_t i) -> SmallVector<Value> {
+        Value valueRow = rowsPerOperand[0][i];
+        Value reduced =
+            rewriter.create<vector::ReductionOp>(loc, kind, valueRow);
+        if (!combiner->isArgReduction)
+          return {reduced};
+
+        // Find the smallest index among the elements equal to the extremum by
+        // replacing the other indices with the neutral element of `min`.
+        Value indexRow = rowsPerOperand[1][i];
+        Value extremum = rewriter.create<vector::BroadcastOp>(
+            loc, valueRow.getType(), reduced);
+        Value isExtremum = buildCompare(valueRow, extremum, /*isEqual=*/true);
+        Value noIndex =
+            buildNeutralVector(vector::CombiningKind::MINSI,
+                               indexRow.getType().cast<VectorType>());
+        Value indices = rewriter.create<arith::SelectOp>(loc, isExtremum,
+                                                         indexRow, noIndex);
+        Value index = rewriter.create<vector::ReductionOp>(
+            loc, vector::CombiningKind::MINSI, indices);
+        return {reduced, index};
+      };
+
+      // Reducing a 1-D tensor results in scalars.
+      if (resultShape.empty()) {
+        rewriter.replaceOp(op, reduceRow(0));
+        return success();
+      }
+
+      // Otherwise, insert the scalars of all rows into vectors.
+      for (auto [i, operand] : llvm::enumerate(adaptor.getOperands())) {
+        Type elementType =
+            operand.getType().cast<RankedTensorType>().getElementType();
+        auto resultType = VectorType::get({numRows}, elementType);
+        results.push_back(buildNeutralVector(
+            i == 0 ? kind : vector::CombiningKind::MINSI, resultType));
+      }
+      for (int64_t i = 0; i < numRows; i++) {
+        SmallVector<Value> reduced = reduceRow(i);
+        for (size_t j = 0; j < results.size(); j++)
+          results[j] = rewriter.create<vector::InsertOp>(
+              loc, reduced[j], results[j], ArrayRef<int64_t>{i});
+      }
+    } else {
+      SmallVector<Value> valueRows = readRows(adaptor.getOperands()[0]);
+      SmallVector<Value> indexRows;
+      if (combiner->isArgReduction)
+        indexRows = readRows(adaptor.getOperands()[1]);
+
+      // Combine adjacent rows until one is left.
+      while (valueRows.size() > 1) {
+        SmallVector<Value> combinedValueRows;
+        SmallVector<Value> combinedIndexRows;
+        for (size_t i = 0; i + 1 < valueRows.size(); i += 2) {
+          Value lhs = valueRows[i];
+          Value rhs = valueRows[i + 1];
+          if (!combiner->isArgReduction) {
+            combinedValueRows.push_back(
+                vector::makeArithReduction(rewriter, loc, kind, lhs, rhs));
+            continue;
+          }
+
+          // Same as the combine region of `tl.argmax` with tie-break.
+          Value lhsIndex = indexRows[i];
+          Value rhsIndex = indexRows[i + 1];
+          Value isMoreExtreme = buildCompare(lhs, rhs, /*isEqual=*/false);
+          Value isEqual = buildCompare(lhs, rhs, /*isEqual=*/true);
+          Value isSmallerIndex = rewriter.create<arith::CmpIOp>(
+              loc, CmpIPredicate::slt, lhsIndex, rhsIndex);
+          Value isTie =
+              rewriter.create<arith::AndIOp>(loc, isEqual, isSmallerIndex);
+          Value pickLhs =
+              rewriter.create<arith::OrIOp>(loc, isMoreExtreme, isTie);
+          combinedValueRows.push_back(
+              rewriter.create<arith::SelectOp>(loc, pickLhs, lhs, rhs));
+          combinedIndexRows.push_back(rewriter.create<arith::SelectOp>(
+              loc, pickLhs, lhsIndex, rhsIndex));
+        }
+        if (valueRows.size() % 2 != 0) {
+          combinedValueRows.push_back(valueRows.back());
+          if (combiner->isArgReduction)
+            combinedIndexRows.push_back(indexRows.back());
+        }
+        valueRows = std::move(combinedValueRows);
+        indexRows = std::move(combinedIndexRows);
+      }
+
+      results.push_back(valueRows.front());
+      if (combiner->isArgReduction)
+        results.push_back(indexRows.front());
+    }
+
+    // Write the vectors into tensors of the result shape.
+    for (Value &result : results) {
+      auto resultType = VectorType::get(
+          resultShape, result.getType().cast<VectorType>().getElementType());
+      result = rewriter.create<vector::ShapeCastOp>(loc, resultType, result);
+      result = buildTensorFromVector(rewriter, loc, result);
+    }
+    rewriter.replaceOp(op, results);
+
+    return success();
+  }
+};
+
+/// Converts stores to 1-D tensors of pointers to integers or floats into
+/// vector stores. If the pointers point to consecutive elements, the store
+/// becomes a single (masked) store of a vector; otherwise, it becomes a masked
+/// scatter. All other stores are left to `StoreOpConversion`.
+struct VectorizedStoreOpConversion : OpConversionPattern<triton::StoreOp> {
+  VectorizedStoreOpConversion(TypeConverter &typeConverter,
+                              MLIRContext *context, PatternBenefit benefit = 1)
+      : OpConversionPattern(typeConverter, context, benefit) {}
+
+  LogicalResult
+  matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+
+    auto tensorType = op.getPtr().getType().dyn_cast<RankedTensorType>();
+    if (!tensorType || tensorType.getRank() != 1 ||
+        !tensorType.hasStaticShape())
+      return rewriter.notifyMatchFailure(
+          loc, "only static 1-D tensors of pointers supported");
+
+    // Derive types.
+    auto elementPtrType =
+        tensorType.getElementType().cast<triton::PointerType>();
+    Type llvmPtrType = typeConverter->convertType(elementPtrType);
+    Type llvmElementType = llvmPtrType.cast<LLVMPointerType>().getElementType();
+    if (!llvmElementType.isIntOrFloat())
+      return rewriter.notifyMatchFailure(
+          loc, "only pointers to integers or floats supported");
+    int64_t numElements = tensorType.getDimSize(0);
+    auto vectorType = VectorType::get({numElements}, llvmElementType);
+    unsigned alignment =
+        DataLayout::closest(op).getTypeABIAlignment(llvmElementType);
+
+    Value values = buildVectorFromTensor(rewriter, loc, adaptor.getValue());
+    Value mask = buildMaskVector(rewriter, loc, adaptor.getMask(), numElements);
+
+    // Store consecutive elements with a vector store, others with a scatter.
+    if (Value vectorPtr =
+            buildContiguousVectorPtr(rewriter, loc, op.getPtr(), vectorType)) {
+      if (!op.getMask())
+        rewriter.create<LLVM::StoreOp>(loc, values, vectorPtr, alignment);
+      else
+        rewriter.create<LLVM::MaskedStoreOp>(loc, values, vectorPtr, mask,
+                                             alignment);
+    } else {
+      Value ptrs = buildPtrVector(rewriter, loc, adaptor.getPtr(), llvmPtrType);
+      rewriter.create<LLVM::masked_scatter>(loc, values, ptrs, mask, alignment);
+    }
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 struct ViewOpConversion : public OpConversionPattern<triton::ViewOp> {
   ViewOpConversion(TypeConverter &typeConverter, MLIRContext *context,
                    PatternBenefit benefit = 1)
@@ -947,13 +2098,43 @@ struct ViewOpConversion : public OpConversionPattern<triton::ViewOp> {
         op.getResult().getType().cast<ShapedType>().getShape();
     auto resultType = RankedTensorType::get(shape, elementType);
 
-    // Create constant tensor describing new shape.
-    DenseIntElementsAttr shapeAttr = rewriter.getIndexTensorAttr(shape);
-    auto shapeTensor = rewriter.create<arith::ConstantOp>(loc, shapeAttr);
+    // Reshape with static reassociations rather than with `tensor.reshape`:
+    // both `tensor.collapse_shape` and `tensor.expand_shape` bufferize to views
+    // of the source buffer and fold with neighboring reshapes and elementwise
+    // ops. If the shapes don't have a common refinement, we go through 1-D.
+    Value src = adaptor.getSrc();
+    if (srcTensorType == resultType) {
+      rewriter.replaceOp(op, src);
+      return success();
+    }
+    std::optional<SmallVector<ReassociationIndices>> reassociation =
+        getReassociationIndicesForReshape(srcTensorType, resultType);
+    if (reassociation && srcTensorType.getRank() > resultType.getRank()) {
+      rewriter.replaceOpWithNewOp<tensor::CollapseShapeOp>(op, resultType, src,
+                                                           *reassociation);
+      return success();
+    }
+    if (reassociation && srcTensorType.getRank() < resultType.getRank()) {
+      rewriter.replaceOpWithNewOp<tensor::ExpandShapeOp>(op, resultType, src,
+                                                         *reassociation);
+      return success();
+    }
 
-    // Replace op with reshape op.
-    rewriter.replaceOpWithNewOp<tensor::ReshapeOp>(
-        op, resultType, adaptor.getSrc(), shapeTensor);
+    auto flatType =
+        RankedTensorType::get({srcTensorType.getNumElements()}, elementType);
+    SmallVector<ReassociationIndices> collapseMap(1);
+    for (int64_t dim = 0; dim < srcTensorType.getRank(); dim++)
+      collapseMap[0].push_back(dim);
+    if (srcTensorType.getRank() != 1)
+      src = rewriter.create<tensor::CollapseShapeOp>(loc, flatType, src,
+                                                     collapseMap);
+    SmallVector<ReassociationIndices> expandMap(1);
+    for (int64_t dim = 0; dim < resultType.getRank(); dim++)
+      expandMap[0].push_back(dim);
+    if (resultType.getRank() != 1)
+      src = rewriter.create<tensor::ExpandShapeOp>(loc, resultType, src,
+                                                   expandMap);
+    rewriter.replaceOp(op, src);
 
     return success();
   }
@@ -980,13 +2161,47 @@ void mlir::populateTritonToLLVMConversionPatterns(
       ExpandDimsOpConversion,
       MakeRangeOpConversion,
       ReduceOpConversion,
-      ReduceReturnOpConversion,
       SplatOpConversion,
       ViewOpConversion
       // clang-format on
       >(typeConverter, patterns.getContext());
 }
 
+void mlir::populateTritonToLLVMVectorizationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter) {
+  // Take precedence over the scalar patterns, which handle the remaining cases.
+  patterns.add<
+      // clang-format off
+      VectorizedLoadOpConversion,
+      VectorizedStoreOpConversion
+      // clang-format on
+      >(typeConverter, patterns.getContext(), /*benefit=*/2);
+}
+
+void mlir::populateTritonToLLVMDotVectorizationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter, int64_t tileM,
+    int64_t tileN, int64_t tileK) {
+  // Take precedence over `DotOpConversion`, which handles the remaining cases.
+  patterns.add<VectorizedDotOpConversion>(typeConverter, patterns.getContext(),
+                                          tileM, tileN, tileK, /*benefit=*/2);
+}
+
+void mlir::populateTritonToLLVMReduceVectorizationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter) {
+  // Take precedence over `ReduceOpConversion`, which handles the remaining
+  // cases.
+  patterns.add<VectorizedReduceOpConversion>(
+      typeConverter, patterns.getContext(), /*benefit=*/2);
+}
+
+void mlir::populateTritonToLLVMAtomicAggregationPatterns(
+    RewritePatternSet &patterns, TypeConverter &typeConverter) {
+  // Take precedence over `AtomicRMWOpConversion`, which handles the remaining
+  // cases.
+  patterns.add<AggregatedAtomicRMWOpConversion>(
+      typeConverter, patterns.getContext(), /*benefit=*/2);
+}
+
 void ConvertTritonToLLVMPass::runOnOperation() {
   auto module = getOperation();
 
@@ -1039,12 +2254,33 @@ void ConvertTritonToLLVMPass::runOnOperation() {
   // Convert the remaining ops of this dialect using dialect conversion.
   ConversionTarget target(getContext());
   target.addLegalDialect<ArithDialect, LinalgDialect, LLVMDialect, SCFDialect,
-                         TensorDialect>();
+                         TensorDialect, vector::VectorDialect>();
   target.addLegalOp<ModuleOp>();
   RewritePatternSet patterns(&getContext());
 
   // Load patterns specific this pass.
   populateTritonToLLVMConversionPatterns(patterns, typeConverter);
+  if (vectorizeMemoryAccesses)
+    populateTritonToLLVMVectorizationPatterns(patterns, typeConverter);
+  if (vectorizeDotOps) {
+    if (dotTileSizes.empty()) {
+      populateTritonToLLVMDotVectorizationPatterns(patterns, typeConverter);
+    } else {
+      if (dotTileSizes.size() != 3 ||
+          llvm::any_of(dotTileSizes, [](int64_t size) { return size <= 0; })) {
+        module.emitError()
+            << "expected three positive dot tile sizes (M, N, and K)";
+        return signalPassFailure();
+      }
+      populateTritonToLLVMDotVectorizationPatterns(
+          patterns, typeConverter, dotTileSizes[0], dotTileSizes[1],
+          dotTileSizes[2]);
+    }
+  }
+  if (vectorizeReductions)
+    populateTritonToLLVMReduceVectorizationPatterns(patterns, typeConverter);
+  if (aggregateAtomics)
+    populateTritonToLLVMAtomicAggregationPatterns(patterns, typeConverter);
 
   // Add patterns that converts function signature and calls.
   populateFunctionOpInterfaceTypeConversionPattern<func::FuncOp>(patterns,
@@ -15,6 +15,7 @@
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/InliningUtils.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/TypeSwitch.h"
 
 using namespace mlir;
@@ -75,6 +76,38 @@ static void printInsertValueType(AsmPrinter & /*printer*/, Operation * /*op*/,
                                  Type /*valueType*/, Type /*stateType*/,
                                  IntegerAttr /*indexAttr*/) {}
 
+static ParseResult parseTabularViewInputType(AsmParser &parser,
+                                             Type &inputType,
+                                             Type resultType) {
+  auto elementType = resultType.cast<StreamType>().getElementType();
+  auto tupleType = elementType.dyn_cast<TupleType>();
+  if (!tupleType)
+    return parser.emitError(parser.getCurrentLocation())
+           << "expected stream of tuples";
+  if (succeeded(parser.parseOptionalKeyword("from")))
+    return parser.parseType(inputType);
+  if (succeeded(parser.parseOptionalKeyword("chunked")))
+    inputType = ChunkedTabularViewType::get(parser.getContext(),
+                                            tupleType.getTypes());
+  else
+    inputType =
+        TabularViewType::get(parser.getContext(), tupleType.getTypes());
+  return success();
+}
+
+static void printTabularViewInputType(AsmPrinter &printer, Operation * /*op*/,
+                                      Type inputType, Type resultType) {
+  auto tupleType =
+      resultType.cast<StreamType>().getElementType().cast<TupleType>();
+  MLIRContext *context = inputType.getContext();
+  if (inputType == TabularViewType::get(context, tupleType.getTypes()))
+    return;
+  if (inputType == ChunkedTabularViewType::get(context, tupleType.getTypes()))
+    printer << "chunked";
+  else
+    printer << "from " << inputType;
+}
+
 #define GET_OP_CLASSES
 #include "structured/Dialect/Iterators/IR/IteratorsOps.cpp.inc"
 
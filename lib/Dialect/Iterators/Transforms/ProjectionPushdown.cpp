@@ -0,0 +1,233 @@
+//===-- ProjectionPushdown.cpp - Pass Implementation ------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/SymbolTable.h"
+#include "structured/Dialect/Iterators/IR/Iterators.h"
+#include "structured/Dialect/Iterators/Transforms/Passes.h"
+#include "structured/Dialect/Tuple/IR/Tuple.h"
+#include "llvm/ADT/SmallBitVector.h"
+
+namespace mlir {
+#define GEN_PASS_CLASSES
+#include "structured/Dialect/Iterators/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+using namespace mlir::iterators;
+
+namespace {
+
+/// Returns the function that the given filter, reduce, or map op applies.
+static func::FuncOp getAppliedFunc(Operation *op) {
+  if (auto filterOp = dyn_cast<FilterOp>(op))
+    return filterOp.getPredicate();
+  if (auto reduceOp = dyn_cast<ReduceOp>(op))
+    return reduceOp.getReduceFunc();
+  return cast<MapOp>(op).getMapFunc();
+}
+
+/// Returns the fields of the tuple arguments of the given function that the
+/// function uses, i.e., for a reduce function, the fields that either of its
+/// two arguments uses. Returns std::nullopt if that cannot be determined,
+/// i.e., if the function is external or uses an argument other than through
+/// `tuple.to_elements`.
+static std::optional<llvm::SmallBitVector> getUsedFields(func::FuncOp funcOp,
+                                                         TupleType tupleType) {
+  if (!funcOp || funcOp.isExternal())
+    return std::nullopt;
+
+  llvm::SmallBitVector usedFields(tupleType.size());
+  for (BlockArgument arg : funcOp.getArguments()) {
+    for (Operation *user : arg.getUsers()) {
+      auto toElementsOp = dyn_cast<tuple::ToElementsOp>(user);
+      if (!toElementsOp)
+        return std::nullopt;
+      for (auto [idx, element] : llvm::enumerate(toElementsOp.getElements()))
+        if (!element.use_empty())
+          usedFields.set(idx);
+    }
+  }
+  return usedFields;
+}
+
+/// Returns whether each tuple that the given function returns is built by a
+/// `tuple.from_elements` op that has no other use, such that the result can be
+/// narrowed along with the arguments.
+static bool hasProjectableResult(func::FuncOp funcOp) {
+  WalkResult result = funcOp.walk([](func::ReturnOp returnOp) {
+    for (Value operand : returnOp.getOperands()) {
+      if (!operand.getDefiningOp<tuple::FromElementsOp>() ||
+          !operand.hasOneUse())
+        return WalkResult::interrupt();
+    }
+    return WalkResult::advance();
+  });
+  return !result.wasInterrupted();
+}
+
+/// Creates a copy of the given function whose tuple arguments only consist of
+/// the fields with the given indices, as does its result if `projectResult`
+/// is set. The copy is inserted into the given symbol table under a fresh
+/// name.
+static func::FuncOp createProjectedFunc(func::FuncOp funcOp,
+                                       ArrayRef<int64_t> keptFields,
+                                       TupleType projectedType,
+                                       bool projectResult,
+                                       SymbolTable &symbolTable) {
+  func::FuncOp projectedFuncOp = funcOp.clone();
+  projectedFuncOp.setName((funcOp.getName() + "_projected").str());
+  projectedFuncOp.setPrivate();
+  symbolTable.insert(projectedFuncOp, std::next(funcOp->getIterator()));
+
+  FunctionType funcType = projectedFuncOp.getFunctionType();
+  SmallVector<Type> argTypes(funcType.getNumInputs(), projectedType);
+  SmallVector<Type> resultTypes(funcType.getResults());
+  if (projectResult)
+    resultTypes.assign(resultTypes.size(), projectedType);
+  projectedFuncOp.setFunctionType(
+      FunctionType::get(funcOp.getContext(), argTypes, resultTypes));
+
+  // Replace the unpacking of the arguments with one of the projected type.
+  for (BlockArgument arg : projectedFuncOp.getArguments()) {
+    arg.setType(projectedType);
+    for (Operation *user : llvm::make_early_inc_range(arg.getUsers())) {
+      auto toElementsOp = cast<tuple::ToElementsOp>(user);
+      OpBuilder builder(toElementsOp);
+      auto projectedOp = builder.create<tuple::ToElementsOp>(
+          toElementsOp.getLoc(), projectedType.getTypes(), arg);
+      for (auto [newIdx, oldIdx] : llvm::enumerate(keptFields))
+        toElementsOp.getElements()[oldIdx].replaceAllUsesWith(
+            projectedOp.getElements()[newIdx]);
+      toElementsOp->erase();
+    }
+  }
+
+  // Replace the packing of the results with one of the projected type.
+  if (projectResult) {
+    projectedFuncOp.walk([&](func::ReturnOp returnOp) {
+      for (Value operand : returnOp.getOperands()) {
+        auto fromElementsOp = operand.getDefiningOp<tuple::FromElementsOp>();
+        SmallVector<Value> keptElements;
+        for (int64_t idx : keptFields)
+          keptElements.push_back(fromElementsOp.getElements()[idx]);
+        OpBuilder builder(fromElementsOp);
+        auto projectedOp = builder.create<tuple::FromElementsOp>(
+            fromElementsOp.getLoc(), projectedType, keptElements);
+        fromElementsOp.getResult().replaceAllUsesWith(projectedOp.getResult());
+        fromElementsOp->erase();
+      }
+    });
+  }
+
+  return projectedFuncOp;
+}
+
+/// Narrows the columns that the given scan produces to those that are used by
+/// the chain of filters and reduces and the map downstream from it, if any.
+static void pushDownProjection(TabularViewToStreamOp scanOp,
+                               SymbolTable &symbolTable) {
+  // Collect the (exclusive) chain of filters and reduces that ends in a map.
+  // The fields that the map does not use are thus never observed downstream,
+  // even if a reduce passes them on unchanged (e.g., for a single input
+  // tuple).
+  SmallVector<Operation *> consumers;
+  Value stream = scanOp.getResult();
+  while (true) {
+    if (!stream.hasOneUse())
+      return;
+    Operation *user = *stream.getUsers().begin();
+    consumers.push_back(user);
+    if (isa<MapOp>(user))
+      break;
+    if (auto reduceOp = dyn_cast<ReduceOp>(user)) {
+      func::FuncOp reduceFuncOp = reduceOp.getReduceFunc();
+      if (!reduceFuncOp || reduceFuncOp.isExternal() ||
+          !hasProjectableResult(reduceFuncOp))
+        return;
+    } else if (!isa<FilterOp>(user)) {
+      return;
+    }
+    stream = user->getResult(0);
+  }
+
+  // Compute the fields used by any of the consumers.
+  auto rowType = scanOp.getResult()
+                     .getType()
+                     .cast<StreamType>()
+                     .getElementType()
+                     .cast<TupleType>();
+  llvm::SmallBitVector usedFields(rowType.size());
+  for (Operation *op : consumers) {
+    std::optional<llvm::SmallBitVector> fields =
+        getUsedFields(getAppliedFunc(op), rowType);
+    if (!fields)
+      return;
+    usedFields |= *fields;
+  }
+  if (usedFields.all())
+    return;
+
+  // Compute the projected row type and the corresponding input columns.
+  SmallVector<int64_t> scannedColumns = scanOp.getScannedColumnIndices();
+  SmallVector<int64_t> keptFields;
+  SmallVector<int64_t> columnIndices;
+  SmallVector<Type> projectedTypes;
+  for (unsigned idx : usedFields.set_bits()) {
+    keptFields.push_back(idx);
+    columnIndices.push_back(scannedColumns[idx]);
+    projectedTypes.push_back(rowType.getType(idx));
+  }
+  MLIRContext *context = scanOp->getContext();
+  auto projectedType = TupleType::get(context, projectedTypes);
+  auto projectedStreamType = StreamType::get(context, projectedType);
+
+  // Narrow the scan.
+  scanOp.setColumnIndicesAttr(DenseI64ArrayAttr::get(context, columnIndices));
+  scanOp.getResult().setType(projectedStreamType);
+
+  // Make the consumers work on the narrowed tuples.
+  for (Operation *op : consumers) {
+    bool isReduce = isa<ReduceOp>(op);
+    func::FuncOp projectedFuncOp =
+        createProjectedFunc(getAppliedFunc(op), keptFields, projectedType,
+                            /*projectResult=*/isReduce, symbolTable);
+    auto funcRef = FlatSymbolRefAttr::get(projectedFuncOp);
+    if (auto filterOp = dyn_cast<FilterOp>(op)) {
+      filterOp.setPredicateRefAttr(funcRef);
+      filterOp.getResult().setType(projectedStreamType);
+    } else if (auto reduceOp = dyn_cast<ReduceOp>(op)) {
+      reduceOp.setReduceFuncRefAttr(funcRef);
+      reduceOp.getResult().setType(projectedStreamType);
+    } else {
+      cast<MapOp>(op).setMapFuncRefAttr(funcRef);
+    }
+  }
+}
+
+struct ProjectionPushdownPass
+    : public ProjectionPushdownBase<ProjectionPushdownPass> {
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    SymbolTable symbolTable(module);
+
+    // Collect the scans first since the rewrite inserts new functions.
+    SmallVector<TabularViewToStreamOp> scanOps;
+    module.walk([&](TabularViewToStreamOp op) { scanOps.push_back(op); });
+
+    for (TabularViewToStreamOp scanOp : scanOps)
+      pushDownProjection(scanOp, symbolTable);
+  };
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::createProjectionPushdownPass() {
+  return std::make_unique<ProjectionPushdownPass>();
+}
@@ -0,0 +1,215 @@
+//===-- ZoneMapPushdown.cpp - Pass Implementation ---------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "structured/Dialect/Iterators/IR/Iterators.h"
+#include "structured/Dialect/Iterators/Transforms/Passes.h"
+#include "structured/Dialect/Tuple/IR/Tuple.h"
+
+namespace mlir {
+#define GEN_PASS_CLASSES
+#include "structured/Dialect/Iterators/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+using namespace mlir::iterators;
+
+namespace {
+
+/// Inclusive range of values derived from a predicate. Absent bounds are
+/// represented by null attributes.
+struct Bounds {
+  TypedAttr lower;
+  TypedAttr upper;
+};
+
+/// Returns true if lhs < rhs for two integer or float attributes of the same
+/// type.
+static bool isLess(TypedAttr lhs, TypedAttr rhs) {
+  if (auto lhsInt = lhs.dyn_cast<IntegerAttr>())
+    return lhsInt.getValue().slt(rhs.cast<IntegerAttr>().getValue());
+  return lhs.cast<FloatAttr>().getValue() < rhs.cast<FloatAttr>().getValue();
+}
+
+/// Narrows the given bounds by the given lower and upper bound.
+static void narrow(Bounds &bounds, TypedAttr lower, TypedAttr upper) {
+  if (lower && (!bounds.lower || isLess(bounds.lower, lower)))
+    bounds.lower = lower;
+  if (upper && (!bounds.upper || isLess(upper, bounds.upper)))
+    bounds.upper = upper;
+}
+
+/// Kind of bound that a comparison of the form `column <op> constant` implies.
+enum class BoundKind { None, Lower, Upper, Both };
+
+static BoundKind getBoundKind(arith::CmpIPredicate predicate) {
+  switch (predicate) {
+  case arith::CmpIPredicate::sge:
+  case arith::CmpIPredicate::sgt:
+    return BoundKind::Lower;
+  case arith::CmpIPredicate::sle:
+  case arith::CmpIPredicate::slt:
+    return BoundKind::Upper;
+  case arith::CmpIPredicate::eq:
+    return BoundKind::Both;
+  default:
+    return BoundKind::None;
+  }
+}
+
+static BoundKind getBoundKind(arith::CmpFPredicate predicate) {
+  switch (predicate) {
+  case arith::CmpFPredicate::OGE:
+  case arith::CmpFPredicate::OGT:
+    return BoundKind::Lower;
+  case arith::CmpFPredicate::OLE:
+  case arith::CmpFPredicate::OLT:
+    return BoundKind::Upper;
+  case arith::CmpFPredicate::OEQ:
+    return BoundKind::Both;
+  default:
+    return BoundKind::None;
+  }
+}
+
+/// Swaps lower and upper bound, i.e., turns `constant <op> column` into
+/// `column <swapped op> constant`.
+static BoundKind swap(BoundKind kind) {
+  switch (kind) {
+  case BoundKind::Lower:
+    return BoundKind::Upper;
+  case BoundKind::Upper:
+    return BoundKind::Lower;
+  default:
+    return kind;
+  }
+}
+
+/// Narrows the given bounds with the comparison of `column` in `lhs` and `rhs`
+/// (if any) with a constant.
+static void collectComparisonBounds(Value column, Value lhs, Value rhs,
+                                    BoundKind kind, Bounds &bounds) {
+  if (rhs == column) {
+    std::swap(lhs, rhs);
+    kind = swap(kind);
+  }
+  if (lhs != column || kind == BoundKind::None)
+    return;
+
+  auto constantOp = rhs.getDefiningOp<arith::ConstantOp>();
+  if (!constantOp)
+    return;
+  auto bound = constantOp.getValue().dyn_cast<TypedAttr>();
+  if (!bound || bound.getType() != column.getType())
+    return;
+
+  bool isLower = kind == BoundKind::Lower || kind == BoundKind::Both;
+  bool isUpper = kind == BoundKind::Upper || kind == BoundKind::Both;
+  narrow(bounds, isLower ? bound : TypedAttr(), isUpper ? bound : TypedAttr());
+}
+
+/// Narrows the given bounds with all comparisons in the conjunction rooted at
+/// `condition`. Terms that are not understood are ignored, which is correct
+/// since each term of a conjunction needs to hold for the whole conjunction to
+/// hold.
+static void collectBounds(Value column, Value condition, Bounds &bounds) {
+  Operation *op = condition.getDefiningOp();
+  if (!op)
+    return;
+
+  if (auto andOp = dyn_cast<arith::AndIOp>(op)) {
+    collectBounds(column, andOp.getLhs(), bounds);
+    collectBounds(column, andOp.getRhs(), bounds);
+    return;
+  }
+  if (auto cmpOp = dyn_cast<arith::CmpIOp>(op)) {
+    collectComparisonBounds(column, cmpOp.getLhs(), cmpOp.getRhs(),
+                            getBoundKind(cmpOp.getPredicate()), bounds);
+    return;
+  }
+  if (auto cmpOp = dyn_cast<arith::CmpFOp>(op)) {
+    collectComparisonBounds(column, cmpOp.getLhs(), cmpOp.getRhs(),
+                            getBoundKind(cmpOp.getPredicate()), bounds);
+    return;
+  }
+}
+
+/// Derives the bounds on the given column of its argument that the given
+/// predicate implies, if any.
+static std::optional<Bounds> analyzePredicate(func::FuncOp predicate,
+                                              uint64_t columnIndex) {
+  if (predicate.isExternal() || !predicate.getBody().hasOneBlock())
+    return std::nullopt;
+
+  Block &body = predicate.getBody().front();
+  auto returnOp = dyn_cast<func::ReturnOp>(body.getTerminator());
+  if (!returnOp || returnOp->getNumOperands() != 1)
+    return std::nullopt;
+
+  // Find the value of the column in the tuple argument.
+  Value column;
+  for (Operation *user : body.getArgument(0).getUsers()) {
+    if (auto toElementsOp = dyn_cast<tuple::ToElementsOp>(user)) {
+      column = toElementsOp.getElements()[columnIndex];
+      break;
+    }
+  }
+  if (!column)
+    return std::nullopt;
+
+  Bounds bounds;
+  collectBounds(column, returnOp->getOperand(0), bounds);
+  if (!bounds.lower && !bounds.upper)
+    return std::nullopt;
+  return bounds;
+}
+
+struct ZoneMapPushdownPass : public ZoneMapPushdownBase<ZoneMapPushdownPass> {
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+
+    module.walk([](FilterOp filterOp) {
+      auto scanOp =
+          filterOp.getInput().getDefiningOp<TabularViewToStreamOp>();
+      if (!scanOp || !scanOp.getZoneMap() || !scanOp->hasOneUse())
+        return;
+
+      func::FuncOp predicate = filterOp.getPredicate();
+      if (!predicate)
+        return;
+
+      // Find the position of the zone-mapped column in the scanned tuples.
+      SmallVector<int64_t> scannedColumns = scanOp.getScannedColumnIndices();
+      auto it = llvm::find(scannedColumns,
+                           static_cast<int64_t>(*scanOp.getZoneMapColumn()));
+      if (it == scannedColumns.end())
+        return;
+
+      std::optional<Bounds> bounds =
+          analyzePredicate(predicate, it - scannedColumns.begin());
+      if (!bounds)
+        return;
+
+      // Combine with bounds that the scan may already have.
+      narrow(*bounds, scanOp.getZoneMapLowerBoundAttr(),
+             scanOp.getZoneMapUpperBoundAttr());
+      if (bounds->lower)
+        scanOp.setZoneMapLowerBoundAttr(bounds->lower);
+      if (bounds->upper)
+        scanOp.setZoneMapUpperBoundAttr(bounds->upper);
+    });
+  };
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::createZoneMapPushdownPass() {
+  return std::make_unique<ZoneMapPushdownPass>();
+}
@@ -59,8 +59,18 @@ LogicalResult ViewAsTabularOp::verify() {
            << getMemrefs().size() << ", found: " << columnTypes.size() << ").";
   }
   for (auto [idx, columnType] : llvm::enumerate(columnTypes)) {
-    Type memrefElementType =
-        getMemrefs().getTypes()[idx].cast<MemRefType>().getElementType();
+    Type operandType = getMemrefs().getTypes()[idx];
+    if (operandType.isa<EncodedColumnTypeInterface>()) {
+      if (operandType != columnType) {
+        return emitOpError()
+               << "type mismatch: returned tabular view has column type "
+               << columnType << " at index " << idx << " but should have type "
+               << operandType << ", the type of the encoded column at the "
+               << "same index.";
+      }
+      continue;
+    }
+    Type memrefElementType = operandType.cast<MemRefType>().getElementType();
     if (memrefElementType != columnType) {
       return emitOpError()
              << "type mismatch: returned tabular view has column type "
@@ -71,13 +81,15 @@ LogicalResult ViewAsTabularOp::verify() {
   }
 
   // Verify all memrefs are of equal static length.
-  if (!llvm::all_equal(llvm::map_range(getMemrefs().getTypes(), [](Type t) {
+  auto memrefTypes = llvm::make_filter_range(
+      getMemrefs().getTypes(), [](Type t) { return t.isa<MemRefType>(); });
+  if (!llvm::all_equal(llvm::map_range(memrefTypes, [](Type t) {
         return t.cast<MemRefType>().getDimSize(0);
       }))) {
     std::string lengths;
     {
       llvm::raw_string_ostream stream(lengths);
-      llvm::interleaveComma(getMemrefs().getTypes(), stream, [&](Type type) {
+      llvm::interleaveComma(memrefTypes, stream, [&](Type type) {
         stream << type.cast<MemRefType>().getDimSize(0);
       });
     }
@@ -89,9 +101,100 @@ LogicalResult ViewAsTabularOp::verify() {
   return success();
 }
 
+LogicalResult ViewAsChunkedTabularOp::verify() {
+  auto viewType = getView().getType().cast<ChunkedTabularViewType>();
+  TabularViewType chunkType = viewType.getChunkType();
+  for (auto [idx, type] : llvm::enumerate(getChunks().getTypes())) {
+    if (type != chunkType) {
+      return emitOpError()
+             << "type mismatch: chunk at index " << idx << " has type " << type
+             << " but should have type " << chunkType
+             << ", the chunk type of the result.";
+    }
+  }
+  return success();
+}
+
+LogicalResult ViewAsBitPackedOp::verify() {
+  auto columnType = getColumn().getType().cast<BitPackedType>();
+  if (getReference().getType() != columnType.getValueType()) {
+    return emitOpError()
+           << "type mismatch: returned column has value type "
+           << columnType.getValueType() << " but should have type "
+           << getReference().getType() << ", the type of the reference value.";
+  }
+  return success();
+}
+
+LogicalResult ViewAsRunLengthOp::verify() {
+  auto columnType = getColumn().getType().cast<RunLengthType>();
+  Type memrefElementType =
+      getValues().getType().cast<MemRefType>().getElementType();
+  if (memrefElementType != columnType.getValueType()) {
+    return emitOpError()
+           << "type mismatch: returned column has value type "
+           << columnType.getValueType() << " but should have type "
+           << memrefElementType << ", the element type of the memref of "
+           << "values.";
+  }
+  return success();
+}
+
+LogicalResult DeallocOp::verify() {
+  auto viewType = getView().getType().cast<TabularViewType>();
+  if (viewType.hasEncodedColumns())
+    return emitOpError() << "does not support views with encoded columns";
+  return success();
+}
+
+LogicalResult ViewAsZoneMapOp::verify() {
+  Type elementType =
+      getZoneMap().getType().cast<ZoneMapType>().getElementType();
+  Type memrefElementType =
+      getMins().getType().cast<MemRefType>().getElementType();
+  if (memrefElementType != elementType) {
+    return emitOpError()
+           << "type mismatch: returned zone map has element type "
+           << elementType << " but should have type " << memrefElementType
+           << ", the element type of the input memrefs.";
+  }
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // Tabular types
 //===----------------------------------------------------------------------===//
 
 #define GET_TYPEDEF_CLASSES
 #include "structured/Dialect/Tabular/IR/TabularOpsTypes.cpp.inc"
+
+TupleType TabularViewType::getRowType() const {
+  SmallVector<Type> rowTypes;
+  rowTypes.reserve(getNumColumnTypes());
+  for (Type columnType : getColumnTypes()) {
+    if (auto encodedType = columnType.dyn_cast<EncodedColumnTypeInterface>())
+      rowTypes.push_back(encodedType.getDecodedType());
+    else
+      rowTypes.push_back(columnType);
+  }
+  return TupleType::get(getContext(), rowTypes);
+}
+
+bool TabularViewType::hasEncodedColumns() const {
+  return llvm::any_of(getColumnTypes(), [](Type t) {
+    return t.isa<EncodedColumnTypeInterface>();
+  });
+}
+
+LogicalResult
+BitPackedType::verify(llvm::function_ref<InFlightDiagnostic()> emitError,
+                      Type valueType, unsigned bitWidth) {
+  auto integerType = valueType.dyn_cast<IntegerType>();
+  if (!integerType || integerType.getWidth() > 64)
+    return emitError() << "expected integer value type of at most 64 bits "
+                       << "but got " << valueType;
+  if (bitWidth < 1 || bitWidth > integerType.getWidth())
+    return emitError() << "expected bit width between 1 and "
+                       << integerType.getWidth() << " but got " << bitWidth;
+  return success();
+}
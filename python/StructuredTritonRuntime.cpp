@@ -0,0 +1,460 @@
+//===-- StructuredTritonRuntime.cpp - CPU runtime of Triton -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the runtime for Triton kernels compiled for CPU by
+// `mlir_structured.triton.compiler`, most importantly the grid launcher, which
+// executes the programs of a grid on a persistent pool of worker threads.
+//
+//===----------------------------------------------------------------------===//
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace py = pybind11;
+
+namespace {
+
+/// Packed interface of a compiled function as generated by MLIR's execution
+/// engine (`_mlir_<name>`): it takes an array of pointers to its arguments.
+using PackedFunction = void (*)(void **);
+
+/// Returns the IDs of the CPUs that the current process may run on, ordered
+/// by NUMA node (if the topology is known) and ID. Assigning consecutive
+/// workers to consecutive CPUs of this list thus fills one node before using
+/// the next one, which keeps the workers of small pools on the same node.
+std::vector<int> getCpusByNumaNode() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t allowedCpus;
+  CPU_ZERO(&allowedCpus);
+  if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0)
+    return cpus;
+  auto isAllowed = [&](int cpu) {
+    return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowedCpus) &&
+           std::find(cpus.begin(), cpus.end(), cpu) == cpus.end();
+  };
+
+  // Parse the CPU lists (such as "0-3,8-11") of all nodes in order.
+  for (int node = 0;; node++) {
+    std::ifstream cpuList("/sys/devices/system/node/node" +
+                          std::to_string(node) + "/cpulist");
+    if (!cpuList)
+      break;
+    std::string range;
+    while (std::getline(cpuList, range, ',')) {
+      size_t dash = range.find('-');
+      int first = std::stoi(range.substr(0, dash));
+      int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++)
+        if (isAllowed(cpu))
+          cpus.push_back(cpu);
+    }
+  }
+
+  // Add the CPUs that don't belong to any node (or all if there are none).
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    if (isAllowed(cpu))
+      cpus.push_back(cpu);
+#endif
+  return cpus;
+}
+
+/// Pins the calling thread to the given CPU. Fails silently if the platform
+/// doesn't support pinning.
+void pinCurrentThread(int cpu) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+}
+
+/// Persistent pool of worker threads that execute parallel loops.
+///
+/// The workers are created once and sleep between loops, so a loop only costs
+/// one wake-up of the pool. The iterations of a loop are claimed dynamically
+/// through an atomic counter, which balances the load between workers if
+/// iterations differ in cost. The calling thread participates in the loop.
+class WorkerPool {
+public:
+  /// Creates a pool that runs loops on `numThreads` threads (including the
+  /// calling thread). If `pinThreads` is set, the workers are pinned to
+  /// distinct CPUs, filling one NUMA node after the other.
+  WorkerPool(unsigned numThreads, bool pinThreads) {
+    std::vector<int> cpus;
+    if (pinThreads)
+      cpus = getCpusByNumaNode();
+    // Worker `i` runs on CPU `i`, leaving CPU 0 to the calling thread.
+    for (unsigned i = 1; i < numThreads; i++) {
+      int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+      workers.emplace_back([this, cpu] {
+        if (cpu >= 0)
+          pinCurrentThread(cpu);
+        runWorker();
+      });
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      isShuttingDown = true;
+    }
+    loopStarted.notify_all();
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  /// Returns the number of threads that run loops (including the caller).
+  unsigned getNumThreads() const { return workers.size() + 1; }
+
+  /// Calls `body(i)` for all `i` in [0, numIterations) on the threads of the
+  /// pool and returns once all calls have returned. Loops started concurrently
+  /// from several threads run one after the other.
+  void parallelFor(int64_t numIterations,
+                   const std::function<void(int64_t)> &body) {
+    if (numIterations <= 0)
+      return;
+
+    // The pool runs one loop at a time; hold the lock until the loop finished
+    // such that concurrent callers don't overwrite its state.
+    std::lock_guard<std::mutex> launchLock(launchMutex);
+
+    // Run small loops inline without waking up the workers.
+    if (numIterations == 1 || workers.empty()) {
+      for (int64_t i = 0; i < numIterations; i++)
+        body(i);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      currentBody = &body;
+      currentNumIterations = numIterations;
+      nextIteration.store(0, std::memory_order_relaxed);
+      numBusyWorkers = workers.size();
+      currentLoop++;
+    }
+    loopStarted.notify_all();
+
+    runIterations(body, numIterations);
+
+    // Wait for the workers to finish their last iteration.
+    std::unique_lock<std::mutex> lock(mutex);
+    loopFinished.wait(lock, [&] { return numBusyWorkers == 0; });
+    currentBody = nullptr;
+  }
+
+private:
+  void runIterations(const std::function<void(int64_t)> &body,
+                     int64_t numIterations) {
+    for (int64_t i = nextIteration.fetch_add(1, std::memory_order_relaxed);
+         i < numIterations;
+         i = nextIteration.fetch_add(1, std::memory_order_relaxed))
+      body(i);
+  }
+
+  void runWorker() {
+    uint64_t lastLoop = 0;
+    while (true) {
+      const std::function<void(int64_t)> *body;
+      int64_t numIterations;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        loopStarted.wait(
+            lock, [&] { return isShuttingDown || currentLoop != lastLoop; });
+        if (isShuttingDown)
+          return;
+        lastLoop = currentLoop;
+        body = currentBody;
+        numIterations = currentNumIterations;
+      }
+
+      runIterations(*body, numIterations);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--numBusyWorkers == 0)
+        loopFinished.notify_one();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  /// Serializes the loops of concurrent callers of `parallelFor`.
+  std::mutex launchMutex;
+  std::mutex mutex;
+  std::condition_variable loopStarted;
+  std::condition_variable loopFinished;
+  /// State of the current loop; protected by `mutex` except for the counter.
+  const std::function<void(int64_t)> *currentBody = nullptr;
+  int64_t currentNumIterations = 0;
+  std::atomic<int64_t> nextIteration{0};
+  size_t numBusyWorkers = 0;
+  uint64_t currentLoop = 0;
+  bool isShuttingDown = false;
+};
+
+/// Storage of the value of a scalar kernel argument.
+union ArgValue {
+  int8_t i8;
+  int16_t i16;
+  int32_t i32;
+  int64_t i64;
+  uint32_t u32;
+  uint64_t u64;
+  float f32;
+  double f64;
+  void *ptr;
+};
+
+/// A compiled kernel function together with the types of its arguments.
+///
+/// The types are parsed from the Triton signature once when the kernel is
+/// created, such that each launch only needs to convert the Python arguments
+/// into the values of the packed interface of the kernel function.
+class Kernel {
+public:
+  /// The C types that kernel arguments are passed as.
+  enum class ArgKind { Ptr, I8, I16, I32, I64, U32, U64, F32, F64 };
+
+  /// Creates a kernel for the packed interface of a function at the address
+  /// `function` with the arguments of the given Triton types (such as "*fp32"
+  /// or "i32").
+  Kernel(uintptr_t function, const std::vector<std::string> &signature)
+      : function(reinterpret_cast<PackedFunction>(function)) {
+    static const std::map<std::string, ArgKind> scalarKinds = {
+        {"i1", ArgKind::I32},   {"i8", ArgKind::I8},    {"i16", ArgKind::I16},
+        {"i32", ArgKind::I32},  {"i64", ArgKind::I64},  {"u32", ArgKind::U32},
+        {"u64", ArgKind::U64},  {"fp16", ArgKind::F32}, {"bf16", ArgKind::F32},
+        {"fp32", ArgKind::F32}, {"f32", ArgKind::F32},  {"fp64", ArgKind::F64}};
+    for (const std::string &type : signature) {
+      if (!type.empty() && type[0] == '*') {
+        argKinds.push_back(ArgKind::Ptr);
+        continue;
+      }
+      auto it = scalarKinds.find(type);
+      if (it == scalarKinds.end())
+        throw std::invalid_argument("unsupported argument type '" + type + "'");
+      argKinds.push_back(it->second);
+    }
+  }
+
+  PackedFunction getFunction() const { return function; }
+  size_t getNumArgs() const { return argKinds.size(); }
+
+  /// Converts the given Python objects into the arguments of the kernel:
+  /// `values` receives the argument values and `argPtrs` their addresses.
+  /// Pointer arguments are either integers or objects with a `data_ptr`
+  /// method (such as tensors). Must be called with the GIL held.
+  void packArgs(const py::tuple &args, std::vector<ArgValue> &values,
+                std::vector<void *> &argPtrs) const {
+    if (args.size() != argKinds.size())
+      throw std::invalid_argument(
+          "expected " + std::to_string(argKinds.size()) +
+          " kernel arguments, got " + std::to_string(args.size()));
+
+    values.resize(argKinds.size());
+    argPtrs.resize(argKinds.size());
+    for (size_t i = 0; i < argKinds.size(); i++) {
+      PyObject *arg = args[i].ptr();
+      ArgValue &value = values[i];
+      switch (argKinds[i]) {
+      case ArgKind::Ptr:
+        value.ptr = PyLong_Check(arg)
+                        ? PyLong_AsVoidPtr(arg)
+                        : reinterpret_cast<void *>(
+                              args[i].attr("data_ptr")().cast<uintptr_t>());
+        break;
+      case ArgKind::I8:
+        value.i8 = PyLong_AsLongLong(arg);
+        break;
+      case ArgKind::I16:
+        value.i16 = PyLong_AsLongLong(arg);
+        break;
+      case ArgKind::I32:
+        value.i32 = PyLong_AsLongLong(arg);
+        break;
+      case ArgKind::I64:
+        value.i64 = PyLong_AsLongLong(arg);
+        break;
+      case ArgKind::U32:
+        value.u32 = PyLong_AsUnsignedLongLong(arg);
+        break;
+      case ArgKind::U64:
+        value.u64 = PyLong_AsUnsignedLongLong(arg);
+        break;
+      case ArgKind::F32:
+        value.f32 = PyFloat_AsDouble(arg);
+        break;
+      case ArgKind::F64:
+        value.f64 = PyFloat_AsDouble(arg);
+        break;
+      }
+      if (PyErr_Occurred())
+        throw py::error_already_set();
+      argPtrs[i] = &value;
+    }
+  }
+
+private:
+  PackedFunction function;
+  std::vector<ArgKind> argKinds;
+};
+
+/// Launches the programs of a grid on a `WorkerPool`.
+///
+/// The programs are numbered with x varying fastest, then y, then z, and are
+/// split into tasks of `grainSize` consecutive programs each, such that the
+/// cost of scheduling a task is amortized over many small programs. Each task
+/// calls the packed interface of the kernel function, which takes the program
+/// ID and number of programs in each dimension followed by the kernel
+/// arguments, once per program in a sequential loop.
+class GridLauncher {
+public:
+  /// Creates a launcher with `numThreads` threads (or one per CPU if 0) and
+  /// the given grain size (or one chosen based on the grid size if 0).
+  GridLauncher(unsigned numThreads, int64_t grainSize, bool pinThreads)
+      : pool(numThreads > 0 ? numThreads
+                            : std::max(1u, std::thread::hardware_concurrency()),
+             pinThreads),
+        grainSize(grainSize) {
+    if (grainSize < 0)
+      throw std::invalid_argument("grain size must not be negative");
+  }
+
+  unsigned getNumThreads() const { return pool.getNumThreads(); }
+  int64_t getGrainSize() const { return grainSize; }
+
+  /// Runs the kernel at the address `kernel` for each program of the grid of
+  /// the given size with the given arguments, which are the addresses of the
+  /// argument values.
+  void launch(uintptr_t kernel, int32_t numProgramsX, int32_t numProgramsY,
+              int32_t numProgramsZ, const std::vector<uintptr_t> &args) {
+    std::vector<void *> argPtrs;
+    argPtrs.reserve(args.size());
+    for (uintptr_t arg : args)
+      argPtrs.push_back(reinterpret_cast<void *>(arg));
+    launchPacked(reinterpret_cast<PackedFunction>(kernel), numProgramsX,
+                 numProgramsY, numProgramsZ, argPtrs);
+  }
+
+  /// Runs the given kernel for each program of the grid of the given size
+  /// with the given Python objects as arguments. The arguments are converted
+  /// while holding the GIL, which is released while the grid runs.
+  void launchKernel(const Kernel &kernel, int32_t numProgramsX,
+                    int32_t numProgramsY, int32_t numProgramsZ,
+                    const py::tuple &args) {
+    std::vector<ArgValue> values;
+    std::vector<void *> argPtrs;
+    kernel.packArgs(args, values, argPtrs);
+
+    py::gil_scoped_release release;
+    launchPacked(kernel.getFunction(), numProgramsX, numProgramsY,
+                 numProgramsZ, argPtrs);
+  }
+
+private:
+  void launchPacked(PackedFunction function, int32_t numProgramsX,
+                    int32_t numProgramsY, int32_t numProgramsZ,
+                    const std::vector<void *> &args) {
+    if (numProgramsX < 0 || numProgramsY < 0 || numProgramsZ < 0)
+      throw std::invalid_argument("grid dimensions must not be negative");
+    int64_t numPrograms = int64_t{numProgramsX} * numProgramsY * numProgramsZ;
+    if (numPrograms == 0)
+      return;
+
+    // Without explicit grain size, create a few tasks per thread such that
+    // threads that finish early can help others.
+    int64_t tasksPerThread = 4;
+    int64_t effectiveGrainSize =
+        grainSize > 0
+            ? grainSize
+            : std::max<int64_t>(1, numPrograms / (tasksPerThread *
+                                                  pool.getNumThreads()));
+    int64_t numTasks = (numPrograms + effectiveGrainSize - 1) /
+                       effectiveGrainSize;
+
+    int32_t numProgramsArray[3] = {numProgramsX, numProgramsY, numProgramsZ};
+    pool.parallelFor(numTasks, [&](int64_t task) {
+      // Prepare the packed arguments of this task.
+      int32_t programId[3];
+      std::vector<void *> packedArgs;
+      packedArgs.reserve(6 + args.size());
+      for (int32_t &id : programId)
+        packedArgs.push_back(&id);
+      for (int32_t &numProgramsDim : numProgramsArray)
+        packedArgs.push_back(&numProgramsDim);
+      packedArgs.insert(packedArgs.end(), args.begin(), args.end());
+
+      int64_t begin = task * effectiveGrainSize;
+      int64_t end = std::min(begin + effectiveGrainSize, numPrograms);
+      for (int64_t program = begin; program < end; program++) {
+        programId[0] = program % numProgramsX;
+        programId[1] = (program / numProgramsX) % numProgramsY;
+        programId[2] = program / (int64_t{numProgramsX} * numProgramsY);
+        function(packedArgs.data());
+      }
+    });
+  }
+
+  WorkerPool pool;
+  int64_t grainSize;
+};
+
+} // namespace
+
+PYBIND11_MODULE(_structuredTritonRuntime, m) {
+  m.doc() = "CPU runtime of Triton kernels compiled by MLIR Structured";
+
+  py::class_<Kernel>(m, "Kernel")
+      .def(py::init<uintptr_t, std::vector<std::string>>(),
+           py::arg("function"), py::arg("signature"),
+           "Creates a kernel for the packed interface of the function at the "
+           "given address with arguments of the given Triton types.")
+      .def_property_readonly("num_args", &Kernel::getNumArgs);
+
+  py::class_<GridLauncher>(m, "GridLauncher")
+      .def(py::init<unsigned, int64_t, bool>(), py::arg("num_threads") = 0,
+           py::arg("grain_size") = 0, py::arg("pin_threads") = false)
+      .def_property_readonly("num_threads", &GridLauncher::getNumThreads)
+      .def_property_readonly("grain_size", &GridLauncher::getGrainSize)
+      .def("launch", &GridLauncher::launch, py::arg("kernel"),
+           py::arg("num_programs_x"), py::arg("num_programs_y"),
+           py::arg("num_programs_z"), py::arg("args"),
+           py::call_guard<py::gil_scoped_release>(),
+           "Runs the kernel with the given address (the packed interface of "
+           "a function with program IDs and numbers of programs as first six "
+           "arguments) for each program of the grid.")
+      .def("launch_kernel", &GridLauncher::launchKernel, py::arg("kernel"),
+           py::arg("num_programs_x"), py::arg("num_programs_y"),
+           py::arg("num_programs_z"), py::arg("args"),
+           "Runs the given `Kernel` for each program of the grid with the "
+           "given Python objects as arguments.");
+}
@@ -1,4 +1,6 @@
 import ctypes
+import ctypes.util
+import weakref
 
 import numpy as np
 import pandas as pd
@@ -8,14 +10,21 @@ def make_tabular_view_descriptor(column_types: list[object]):
   '''
   Creates an empty instance a ctype.Structure corresponding to the
   LLVMSTructType that the tabular view type with the given column types lowers
-  to. The column types must be provided as ctypes.
+  to. The column types must be provided as ctypes. Encoded columns are given by
+  the type of their descriptor (see to_bit_packed_descriptor and
+  to_run_length_descriptor), which is then embedded by value.
   '''
 
+  def field_type(dtype):
+    if issubclass(dtype, ctypes.Structure):
+      return dtype
+    return ctypes.POINTER(dtype)
+
   class TabularViewDescriptor(ctypes.Structure):
     '''A descriptor of a tabular view with columns of a particular type.'''
 
     _fields_ = [('num_elements', ctypes.c_longlong)] \
-      + [('column' + str(i), ctypes.POINTER(dtype))
+      + [('column' + str(i), field_type(dtype))
          for i, dtype in enumerate(column_types)]
 
   return TabularViewDescriptor()
@@ -31,8 +40,226 @@ def to_tabular_view_descriptor(df: pd.DataFrame):
 
   dtypes = [np.ctypeslib.as_ctypes_type(t) for t in df.dtypes]
   descriptor = make_tabular_view_descriptor(dtypes)
+  _fill_tabular_view_descriptor(descriptor, df, dtypes)
+  return descriptor
+
+
+def _fill_tabular_view_descriptor(descriptor: ctypes.Structure,
+                                  df: pd.DataFrame, dtypes: list[object]):
   descriptor.num_elements = ctypes.c_longlong(len(df.index))
   for i, (dtype, col) in enumerate(zip(dtypes, df.columns)):
     setattr(descriptor, 'column' + str(i),
             df[col].values.ctypes.data_as(ctypes.POINTER(dtype)))
+
+
+def to_chunked_tabular_view_descriptor(dfs: list[pd.DataFrame]):
+  '''
+  Converts the given DataFrames, which all need to have the same dtypes, to an
+  instance of ctype.Structure equivalent to what an instance of a
+  corresponding tabular.ChunkedTabularViewType would get lowered to by
+  TabularToLLVM, with one chunk per DataFrame. Like
+  to_tabular_view_descriptor, this is zero-copy for the data; only the array of
+  chunk descriptors is allocated, which the returned descriptor keeps alive.
+  '''
+
+  assert len(dfs) > 0
+  dtypes = [np.ctypeslib.as_ctypes_type(t) for t in dfs[0].dtypes]
+  chunk_type = type(make_tabular_view_descriptor(dtypes))
+  chunks = (chunk_type * len(dfs))()
+  for chunk, df in zip(chunks, dfs):
+    assert list(df.dtypes) == list(dfs[0].dtypes)
+    _fill_tabular_view_descriptor(chunk, df, dtypes)
+
+  class ChunkedTabularViewDescriptor(ctypes.Structure):
+    '''A descriptor of a chunked tabular view.'''
+
+    _fields_ = [('num_chunks', ctypes.c_longlong),
+                ('chunks', ctypes.POINTER(chunk_type))]
+
+  descriptor = ChunkedTabularViewDescriptor()
+  descriptor.num_chunks = ctypes.c_longlong(len(dfs))
+  descriptor.chunks = ctypes.cast(chunks, ctypes.POINTER(chunk_type))
+  descriptor._chunks = chunks
+  return descriptor
+
+
+def to_numpy_arrays(descriptor: ctypes.Structure, owning: bool = False):
+  '''
+  Wraps the columns of the given tabular view descriptor into NumPy arrays
+  without copying. If owning is True, the arrays take ownership of the column
+  buffers, which must have been allocated with malloc (as is the case for the
+  result of iterators.stream_to_tabular): each buffer is freed once its array
+  (and all views derived from it) have been garbage-collected.
+  '''
+
+  num_columns = len(descriptor._fields_) - 1
+  libc = ctypes.CDLL(ctypes.util.find_library('c')) if owning else None
+  arrays = []
+  for i in range(num_columns):
+    ptr = getattr(descriptor, 'column' + str(i))
+    array = np.ctypeslib.as_array(ptr, shape=(descriptor.num_elements,))
+    if owning:
+      address = ctypes.cast(ptr, ctypes.c_void_p)
+      weakref.finalize(array, libc.free, address)
+    arrays.append(array)
+  return arrays
+
+
+def compute_zone_map(values: np.ndarray, chunk_size: int):
+  '''
+  Computes the per-chunk minima and maxima of the given one-dimensional array
+  for chunks of chunk_size rows each (the last chunk may be shorter). Returns
+  a pair of arrays with the same dtype as values.
+  '''
+
+  assert chunk_size > 0
+  starts = np.arange(0, len(values), chunk_size)
+  if len(starts) == 0:
+    return np.empty(0, values.dtype), np.empty(0, values.dtype)
+  mins = np.minimum.reduceat(values, starts)
+  maxs = np.maximum.reduceat(values, starts)
+  return mins, maxs
+
+
+def to_zone_map_descriptor(mins: np.ndarray, maxs: np.ndarray,
+                           chunk_size: int):
+  '''
+  Converts the given per-chunk minima and maxima to an instance of
+  ctype.Structure equivalent to what tabular.ZoneMapType gets lowered to by
+  TabularToLLVM. Like to_tabular_view_descriptor, this is zero-copy, so the
+  arrays need to outlive the descriptor.
+  '''
+
+  assert mins.dtype == maxs.dtype and len(mins) == len(maxs)
+  dtype = np.ctypeslib.as_ctypes_type(mins.dtype)
+
+  class ZoneMapDescriptor(ctypes.Structure):
+    '''A descriptor of a zone map of a particular element type.'''
+
+    _fields_ = [('chunk_size', ctypes.c_longlong),
+                ('num_chunks', ctypes.c_longlong),
+                ('mins', ctypes.POINTER(dtype)),
+                ('maxs', ctypes.POINTER(dtype))]
+
+  descriptor = ZoneMapDescriptor()
+  descriptor.chunk_size = ctypes.c_longlong(chunk_size)
+  descriptor.num_chunks = ctypes.c_longlong(len(mins))
+  descriptor.mins = mins.ctypes.data_as(ctypes.POINTER(dtype))
+  descriptor.maxs = maxs.ctypes.data_as(ctypes.POINTER(dtype))
+  return descriptor
+
+
+def bit_pack(values: np.ndarray, bit_width: int):
+  '''
+  Encodes the given one-dimensional integer array in the format of
+  tabular.BitPackedType with the given bit width: the offsets of the values
+  from their minimum (the reference) are packed into 64-bit words, starting at
+  the least significant bits, without any value straddling two words. Returns
+  the pair of the words (as an array of int64) and the reference.
+  '''
+
+  assert 0 < bit_width <= 64
+  reference = values.min() if len(values) > 0 else values.dtype.type(0)
+  offsets = (values.astype(np.int64) - np.int64(reference)).astype(np.uint64)
+  assert bit_width == 64 or np.all(
+      offsets < (np.uint64(1) << np.uint64(bit_width)))
+  values_per_word = 64 // bit_width
+  num_words = -(-len(values) // values_per_word)
+  padded = np.zeros(num_words * values_per_word, np.uint64)
+  padded[:len(values)] = offsets
+  shifts = np.arange(values_per_word, dtype=np.uint64) * np.uint64(bit_width)
+  slots = padded.reshape(num_words, values_per_word) << shifts
+  words = np.bitwise_or.reduce(slots, axis=1)
+  return words.view(np.int64), reference
+
+
+def to_bit_packed_descriptor(words: np.ndarray, reference, num_rows: int):
+  '''
+  Converts the given words and reference (as returned by bit_pack) to an
+  instance of ctype.Structure equivalent to what tabular.BitPackedType gets
+  lowered to by TabularToLLVM. This is zero-copy, so the words need to outlive
+  the descriptor.
+  '''
+
+  dtype = np.ctypeslib.as_ctypes_type(np.asarray(reference).dtype)
+
+  class BitPackedDescriptor(ctypes.Structure):
+    '''A descriptor of a bit-packed column of a particular value type.'''
+
+    _fields_ = [('num_rows', ctypes.c_longlong),
+                ('words', ctypes.POINTER(ctypes.c_longlong)),
+                ('reference', dtype)]
+
+  descriptor = BitPackedDescriptor()
+  descriptor.num_rows = ctypes.c_longlong(num_rows)
+  descriptor.words = words.ctypes.data_as(ctypes.POINTER(ctypes.c_longlong))
+  descriptor.reference = dtype(int(reference))
+  return descriptor
+
+
+def run_length_encode(values: np.ndarray):
+  '''
+  Encodes the given one-dimensional array in the format of
+  tabular.RunLengthType. Returns the pair of the values of the runs and their
+  (exclusive) ends (as an array of int64).
+  '''
+
+  if len(values) == 0:
+    return values[:0], np.empty(0, np.int64)
+  run_starts = np.flatnonzero(values[1:] != values[:-1]) + 1
+  run_ends = np.append(run_starts, len(values)).astype(np.int64)
+  return values[run_ends - 1], run_ends
+
+
+def to_run_length_descriptor(run_values: np.ndarray, run_ends: np.ndarray,
+                             num_rows: int):
+  '''
+  Converts the given run values and run ends (as returned by
+  run_length_encode) to an instance of ctype.Structure equivalent to what
+  tabular.RunLengthType gets lowered to by TabularToLLVM. This is zero-copy, so
+  the arrays need to outlive the descriptor.
+  '''
+
+  assert len(run_values) == len(run_ends)
+  dtype = np.ctypeslib.as_ctypes_type(run_values.dtype)
+
+  class RunLengthDescriptor(ctypes.Structure):
+    '''A descriptor of a run-length encoded column of a particular type.'''
+
+    _fields_ = [('num_rows', ctypes.c_longlong),
+                ('num_runs', ctypes.c_longlong),
+                ('values', ctypes.POINTER(dtype)),
+                ('run_ends', ctypes.POINTER(ctypes.c_longlong))]
+
+  descriptor = RunLengthDescriptor()
+  descriptor.num_rows = ctypes.c_longlong(num_rows)
+  descriptor.num_runs = ctypes.c_longlong(len(run_values))
+  descriptor.values = run_values.ctypes.data_as(ctypes.POINTER(dtype))
+  descriptor.run_ends = run_ends.ctypes.data_as(
+      ctypes.POINTER(ctypes.c_longlong))
+  return descriptor
+
+
+def to_encoded_tabular_view_descriptor(columns: list[object]):
+  '''
+  Assembles a tabular view descriptor from the given columns, each of which is
+  either a one-dimensional NumPy array or a descriptor of an encoded column
+  (see to_bit_packed_descriptor and to_run_length_descriptor). The number of
+  rows is taken from the first column. Like to_tabular_view_descriptor, this
+  is zero-copy for the data.
+  '''
+
+  assert len(columns) > 0
+  dtypes = [
+      type(c) if isinstance(c, ctypes.Structure) else
+      np.ctypeslib.as_ctypes_type(c.dtype) for c in columns
+  ]
+  descriptor = make_tabular_view_descriptor(dtypes)
+  first = columns[0]
+  descriptor.num_elements = ctypes.c_longlong(
+      first.num_rows if isinstance(first, ctypes.Structure) else len(first))
+  for i, (dtype, column) in enumerate(zip(dtypes, columns)):
+    if not isinstance(column, ctypes.Structure):
+      column = column.ctypes.data_as(ctypes.POINTER(dtype))
+    setattr(descriptor, 'column' + str(i), column)
   return descriptor
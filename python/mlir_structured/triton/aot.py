@@ -0,0 +1,298 @@
+'''Ahead-of-time compilation of Triton kernels to static CPU libraries.
+
+This module compiles `@jit` kernels with fixed signatures and constants with
+the same pass pipeline as `compiler.py` but, instead of running them in the
+JIT, writes their object code into an object file (`.o`), static library
+(`.a`), or LLVM IR file (`.ll`, e.g., for LTO with the host code) together with
+a C header that declares their entry points. For each kernel `name`, these
+are:
+
+  void name_grid(int32_t num_programs_x, int32_t num_programs_y,
+                 int32_t num_programs_z, <kernel args>);
+  void name(int32_t program_id_x, int32_t program_id_y, int32_t program_id_z,
+            int32_t num_programs_x, int32_t num_programs_y,
+            int32_t num_programs_z, <kernel args>);
+
+The former runs all programs of the given grid in parallel; the latter runs a
+single program, for hosts that schedule the programs themselves. Binaries
+using the grid functions need to link against the MLIR runtime libraries (see
+`compiler.get_runtime_libs`). The code is compiled for the host CPU unless
+another target CPU is given and is position independent, so the objects can
+be linked into shared libraries as well.
+
+The module can also be used as a tool:
+
+  python -m mlir_structured.triton.aot kernels.py:add_kernel \\
+      --signature "*fp32,*fp32,i32,1024" -o libkernels.a
+'''
+
+import argparse
+import importlib.util
+import os
+import shutil
+import subprocess
+import tempfile
+from collections import namedtuple
+
+from mlir_structured.ir import Context
+from mlir_structured.triton.compiler import (compile_llvm_ir, lower_to_llvm,
+                                             translate_to_llvm_ir)
+
+__all__ = [
+    "AOTKernel",
+    "compile_kernels",
+    "generate_header",
+]
+
+_AR_ENV = "AR"
+_AR_DEFAULT = "ar"
+_CC_ENV = "CC"
+_CC_DEFAULT = "cc"
+
+# C types of the scalar Triton types. Pointers to types without C equivalent
+# are declared as `void *`.
+_C_TYPES = {
+    "i1": "bool",
+    "i8": "int8_t",
+    "i16": "int16_t",
+    "i32": "int32_t",
+    "i64": "int64_t",
+    "u8": "uint8_t",
+    "u16": "uint16_t",
+    "u32": "uint32_t",
+    "u64": "uint64_t",
+    "fp32": "float",
+    "f32": "float",
+    "fp64": "double",
+}
+
+
+class AOTKernel:
+  '''A kernel to compile ahead of time: the `JITFunction` `fn` specialized for
+     the given signature and constants, exported under `name` (by default, the
+     name of the Python function).
+
+     `signature` maps the names or indices of the non-constexpr arguments to
+     their Triton types (such as `"*fp32"` or `"i32"`) or is a list of these
+     types in the order of the arguments; `constants` maps the names or
+     indices of the constexpr arguments to their values.'''
+
+  def __init__(self, fn, signature, constants=None, name=None):
+    self.fn = fn
+    self.name = name or fn.__name__
+    if not self.name.isidentifier():
+      raise ValueError(f"'{self.name}' is not a valid C identifier")
+
+    constants = {self._get_index(k): v for k, v in (constants or {}).items()}
+    if isinstance(signature, dict):
+      signature = {self._get_index(k): v for k, v in signature.items()}
+    else:
+      indices = [i for i in range(len(fn.arg_names)) if i not in constants]
+      if len(indices) != len(signature):
+        raise ValueError(f"expected {len(indices)} argument types for "
+                         f"'{self.name}', got {len(signature)}")
+      signature = dict(zip(indices, signature))
+
+    missing_constants = set(fn.constexprs) - set(constants)
+    if missing_constants:
+      names = ", ".join(fn.arg_names[i] for i in sorted(missing_constants))
+      raise ValueError(f"missing values of constexpr arguments of "
+                       f"'{self.name}': {names}")
+
+    self.signature = dict(sorted(signature.items()))
+    self.constants = constants
+
+  def _get_index(self, arg):
+    if isinstance(arg, int):
+      return arg
+    return self.fn.arg_names.index(arg)
+
+  def get_c_args(self):
+    '''Returns the C types and names of the kernel arguments.'''
+    c_args = []
+    for idx, ty in self.signature.items():
+      if ty[0] == "*":
+        c_type = _C_TYPES.get(ty[1:], "void") + " *"
+      elif ty in _C_TYPES:
+        c_type = _C_TYPES[ty] + " "
+      else:
+        raise ValueError(f"unsupported type '{ty}' of argument "
+                         f"'{self.fn.arg_names[idx]}' of '{self.name}'")
+      c_args.append(c_type + self.fn.arg_names[idx])
+    return c_args
+
+
+def generate_header(kernels, guard="STRUCTURED_TRITON_KERNELS_H"):
+  '''Returns a C header that declares the entry points of the given
+     `AOTKernel`s.'''
+  lines = [
+      "// Generated by mlir_structured.triton.aot. Do not edit.",
+      "",
+      f"#ifndef {guard}",
+      f"#define {guard}",
+      "",
+      "#include <stdbool.h>",
+      "#include <stdint.h>",
+      "",
+      "#ifdef __cplusplus",
+      'extern "C" {',
+      "#endif",
+  ]
+  grid_args = [f"int32_t num_programs_{d}" for d in "xyz"]
+  program_args = [f"int32_t program_id_{d}" for d in "xyz"] + grid_args
+  for kernel in kernels:
+    c_args = kernel.get_c_args()
+    lines += [
+        "",
+        f"// Runs all programs of the given grid of `{kernel.name}`.",
+        f"void {kernel.name}_grid({', '.join(grid_args + c_args)});",
+        f"// Runs a single program of `{kernel.name}`.",
+        f"void {kernel.name}({', '.join(program_args + c_args)});",
+    ]
+  lines += [
+      "",
+      "#ifdef __cplusplus",
+      "}",
+      "#endif",
+      "",
+      f"#endif // {guard}",
+      "",
+  ]
+  return "\n".join(lines)
+
+
+def _compile_kernel(kernel, tmp_dir, emit_llvm, debug, target_cpu):
+  '''Compiles the given kernel into a file in `tmp_dir` and returns its path.'''
+  # Triton specializes kernels on the alignment of their arguments; we can't
+  # know anything about the arguments of future calls.
+  config = namedtuple("instance_descriptor",
+                      ["divisible_by_16", "equal_to_1"])(tuple(), tuple())
+
+  with Context():
+    mod = lower_to_llvm(kernel.fn, kernel.signature, kernel.constants, config,
+                        debug, kernel.name)
+    ll_path = os.path.join(tmp_dir, kernel.name + ".ll")
+    translate_to_llvm_ir(mod, ll_path)
+
+  if emit_llvm:
+    return ll_path
+
+  path = os.path.join(tmp_dir, kernel.name + ".o")
+  compile_llvm_ir(ll_path, path, target_cpu)
+  return path
+
+
+def compile_kernels(kernels, output, header=None, debug=False, target_cpu=None):
+  '''Compiles the given `AOTKernel`s into `output`, which is an object file,
+     a static library, or an LLVM IR file depending on its extension (`.o`,
+     `.a`, or `.ll`, respectively). Object code is compiled for `target_cpu`
+     (a CPU name as accepted by `clang -march`; by default, the host CPU). If
+     `header` is given, also writes a C header declaring the entry points of
+     the kernels to that path.'''
+  kernels = list(kernels)
+  names = [kernel.name for kernel in kernels]
+  duplicates = {name for name in names if names.count(name) > 1}
+  if duplicates:
+    raise ValueError(f"duplicate kernel names: {', '.join(sorted(duplicates))}")
+
+  extension = os.path.splitext(output)[1]
+  if extension not in (".o", ".a", ".ll"):
+    raise ValueError(f"unsupported output file type '{extension}'")
+
+  with tempfile.TemporaryDirectory() as tmp_dir:
+    paths = [
+        _compile_kernel(kernel, tmp_dir, extension == ".ll", debug,
+                        target_cpu)
+        for kernel in kernels
+    ]
+
+    if len(paths) == 1 and extension != ".a":
+      shutil.copyfile(paths[0], output)
+    elif extension == ".a":
+      if os.path.exists(output):
+        os.remove(output)
+      ar = os.getenv(_AR_ENV, _AR_DEFAULT)
+      subprocess.run([ar, "rcs", output] + paths, check=True)
+    elif extension == ".o":
+      # Merge the objects with a relocatable link.
+      cc = os.getenv(_CC_ENV, _CC_DEFAULT)
+      subprocess.run([cc, "-r", "-nostdlib", "-o", output] + paths,
+                     check=True)
+    else:
+      raise ValueError("LLVM IR output only supports a single kernel")
+
+  if header is not None:
+    guard = "".join(c if c.isalnum() else "_"
+                    for c in os.path.basename(header)).upper()
+    with open(header, "w") as f:
+      f.write(generate_header(kernels, guard))
+
+
+def _load_jit_function(spec):
+  path, fn_name = spec.rsplit(":", 1)
+  module_spec = importlib.util.spec_from_file_location("kernels", path)
+  module = importlib.util.module_from_spec(module_spec)
+  module_spec.loader.exec_module(module)
+  return getattr(module, fn_name)
+
+
+def _parse_kernel(spec, signature, name):
+  '''Creates an `AOTKernel` from command line arguments. The signature lists
+     the types of the arguments in order, with the values of the constexpr
+     arguments in place of their types.'''
+  fn = _load_jit_function(spec)
+  types = [s.strip() for s in signature.split(",")]
+  if len(types) != len(fn.arg_names):
+    raise ValueError(f"expected {len(fn.arg_names)} entries in signature "
+                     f"of '{fn.__name__}', got {len(types)}")
+  constants = {}
+  for idx in fn.constexprs:
+    value = types[idx]
+    constants[idx] = float(value) if "." in value else int(value)
+  arg_types = [ty for idx, ty in enumerate(types) if idx not in constants]
+  return AOTKernel(fn, arg_types, constants, name)
+
+
+def main(argv=None):
+  parser = argparse.ArgumentParser(
+      description="Compiles Triton kernels ahead of time for the CPU.")
+  parser.add_argument("kernels",
+                      nargs="+",
+                      metavar="FILE:FUNCTION",
+                      help="@jit functions to compile")
+  parser.add_argument("--signature",
+                      "-s",
+                      action="append",
+                      required=True,
+                      help="comma-separated argument types and constexpr "
+                      "values of each kernel (in order)")
+  parser.add_argument("--name",
+                      "-n",
+                      action="append",
+                      help="exported name of each kernel (in order)")
+  parser.add_argument("--output",
+                      "-o",
+                      required=True,
+                      help="output file (.o, .a, or .ll)")
+  parser.add_argument("--header", help="path of the generated C header")
+  parser.add_argument("--target-cpu",
+                      help="CPU to compile for (default: the host CPU)")
+  parser.add_argument("--debug", action="store_true")
+  args = parser.parse_args(argv)
+
+  if len(args.signature) != len(args.kernels):
+    parser.error("expected one --signature per kernel")
+  names = args.name or [None] * len(args.kernels)
+  if len(names) != len(args.kernels):
+    parser.error("expected one --name per kernel")
+
+  kernels = [
+      _parse_kernel(spec, signature, name)
+      for spec, signature, name in zip(args.kernels, args.signature, names)
+  ]
+  header = args.header or os.path.splitext(args.output)[0] + ".h"
+  compile_kernels(kernels, args.output, header, args.debug, args.target_cpu)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,231 @@
+'''Autotuning of Triton kernels on the CPU.
+
+This module provides drop-in replacements for `triton.autotune` and
+`triton.Config`. Upstream's autotuner times kernels with CUDA events; the one
+of this module measures the wall-clock time of complete launches instead.
+Besides the meta-parameters of the kernel (such as `BLOCK_SIZE`), configs may
+set the CPU-specific options `num_threads` (the number of threads that run the
+grid) and `dot_tile_sizes` (the maximum register tile sizes (M, N, K) of
+`tt.dot` ops); `num_warps` and `num_stages` have no effect on the CPU. For
+example:
+
+  @autotune(configs=[
+      Config({'BLOCK_SIZE': 1024}),
+      Config({'BLOCK_SIZE': 4096}, num_threads=4),
+  ], key=['n'])
+  @jit
+  def kernel(x_ptr, n, BLOCK_SIZE: tl.constexpr):
+    ...
+
+The best config is determined on the first launch with each new key, which
+consists of the values of the arguments named in `key` (or their shapes, for
+tensors) and the types of all tensor arguments.
+'''
+
+import statistics
+import time
+
+import triton
+from triton.runtime.jit import KernelInterface
+
+__all__ = [
+    "Autotuner",
+    "Config",
+    "autotune",
+]
+
+
+class Config(triton.Config):
+  '''A config of `triton.Config` with additional CPU-specific options.
+
+     `num_threads` is the number of threads that run the grid (by default,
+     those of the shared launcher, see `launcher.py`) and `dot_tile_sizes` is
+     a tuple with the maximum register tile sizes (M, N, K) of `tt.dot` ops
+     (by default, those of `convert-triton-to-llvm`).'''
+
+  def __init__(self,
+               kwargs,
+               num_warps=4,
+               num_stages=2,
+               num_threads=None,
+               dot_tile_sizes=None,
+               pre_hook=None):
+    super().__init__(kwargs,
+                     num_warps=num_warps,
+                     num_stages=num_stages,
+                     pre_hook=pre_hook)
+    self.num_threads = num_threads
+    self.dot_tile_sizes = None if dot_tile_sizes is None else tuple(
+        dot_tile_sizes)
+
+  def __str__(self):
+    res = [super().__str__()]
+    if self.num_threads is not None:
+      res.append(f'num_threads: {self.num_threads}')
+    if self.dot_tile_sizes is not None:
+      res.append(f'dot_tile_sizes: {self.dot_tile_sizes}')
+    return ', '.join(res)
+
+
+def _get_cpu_options(config):
+  '''Returns the CPU-specific launch options of the given config, which may
+     also be a plain `triton.Config`.'''
+  return {
+      'num_threads': getattr(config, 'num_threads', None),
+      'dot_tile_sizes': getattr(config, 'dot_tile_sizes', None),
+  }
+
+
+def do_bench(fn, warmup=25, rep=100):
+  '''Returns the median run time of `fn` in milliseconds. `fn` runs for about
+     `warmup` milliseconds before and `rep` milliseconds during the
+     measurement (but at least once each).'''
+  # Estimate the run time with a first call, which may also compile.
+  fn()
+  start = time.perf_counter()
+  fn()
+  estimate = max((time.perf_counter() - start) * 1000, 1e-6)
+
+  for _ in range(max(1, int(warmup / estimate))):
+    fn()
+
+  times = []
+  for _ in range(max(1, int(rep / estimate))):
+    start = time.perf_counter()
+    fn()
+    times.append((time.perf_counter() - start) * 1000)
+  return statistics.median(times)
+
+
+class Autotuner(KernelInterface):
+  '''Launches the given `JITFunction` with the fastest of the given configs
+     for the key of each launch (see the module documentation).'''
+
+  def __init__(self,
+               fn,
+               arg_names,
+               configs,
+               key,
+               reset_to_zero=None,
+               prune_configs_by=None,
+               warmup=25,
+               rep=100):
+    if not configs:
+      configs = [Config({})]
+    self.fn = fn
+    self.arg_names = arg_names
+    self.configs = configs
+    self.key_idx = [arg_names.index(k) for k in key]
+    self.reset_idx = [arg_names.index(k) for k in reset_to_zero or []]
+    prune_configs_by = prune_configs_by or {}
+    self.perf_model = prune_configs_by.get('perf_model')
+    self.configs_top_k = prune_configs_by.get('top_k', 1.0)
+    self.early_config_prune = prune_configs_by.get('early_config_prune')
+    self.warmup = warmup
+    self.rep = rep
+
+    # Best config per key and the timings of all configs of the last tuning.
+    self.cache = {}
+    self.configs_timings = None
+    self.best_config = None
+
+  def _get_key(self, args):
+    key = []
+    for idx in self.key_idx:
+      arg = args[idx]
+      key.append(tuple(arg.shape) if hasattr(arg, 'shape') else arg)
+    key += [str(arg.dtype) for arg in args if hasattr(arg, 'dtype')]
+    return tuple(key)
+
+  def _prune_configs(self, kwargs):
+    configs = self.configs
+    if self.early_config_prune:
+      configs = self.early_config_prune(configs, self.nargs)
+    if self.perf_model:
+      top_k = self.configs_top_k
+      if isinstance(top_k, float) and top_k <= 1.0:
+        top_k = int(len(configs) * top_k)
+      if len(configs) > top_k:
+        est_timing = {
+            config:
+                self.perf_model(**self.nargs,
+                                **kwargs,
+                                **config.kwargs,
+                                num_stages=config.num_stages,
+                                num_warps=config.num_warps)
+            for config in configs
+        }
+        configs = sorted(est_timing, key=est_timing.get)[:top_k]
+    return configs
+
+  def _launch(self, args, config, kwargs):
+    if config.pre_hook is not None:
+      config.pre_hook(dict(self.nargs, **config.kwargs))
+    return self.fn.run(*args,
+                       num_warps=config.num_warps,
+                       num_stages=config.num_stages,
+                       **_get_cpu_options(config),
+                       **kwargs,
+                       **config.kwargs)
+
+  def _bench(self, args, config, kwargs):
+    # Check for conflicts, i.e., meta-parameters both provided as kwargs and
+    # by the autotuner.
+    conflicts = kwargs.keys() & config.kwargs.keys()
+    if conflicts:
+      raise ValueError(f"Conflicting meta-parameters: {', '.join(conflicts)}."
+                       " Make sure that you don't re-define auto-tuned"
+                       " symbols.")
+
+    def kernel_call():
+      for idx in self.reset_idx:
+        args[idx].zero_()
+      self._launch(args, config, kwargs)
+
+    try:
+      return do_bench(kernel_call, warmup=self.warmup, rep=self.rep)
+    except RuntimeError:
+      # Configs that fail to compile (for example, because their block sizes
+      # aren't supported by the CPU backend) are never the best.
+      return float('inf')
+
+  def run(self, *args, **kwargs):
+    self.nargs = dict(zip(self.arg_names, args))
+    if len(self.configs) > 1:
+      key = self._get_key(args)
+      if key not in self.cache:
+        pruned_configs = self._prune_configs(kwargs)
+        timings = {
+            config: self._bench(args, config, kwargs)
+            for config in pruned_configs
+        }
+        self.configs_timings = timings
+        config = min(timings, key=timings.get)
+        # If all configs failed, launch one anyway to report its error.
+        if timings[config] != float('inf'):
+          self.cache[key] = config
+      else:
+        config = self.cache[key]
+    else:
+      config = self.configs[0]
+    self.best_config = config
+    ret = self._launch(args, config, kwargs)
+    self.nargs = None
+    return ret
+
+
+def autotune(configs,
+             key,
+             prune_configs_by=None,
+             reset_to_zero=None,
+             warmup=25,
+             rep=100):
+  '''Decorator for auto-tuning a `JITFunction` on the CPU with the same
+     arguments as `triton.autotune`. `warmup` and `rep` are the times in
+     milliseconds that each config runs before and during its measurement.'''
+
+  def decorator(fn):
+    return Autotuner(fn, fn.arg_names, configs, key, reset_to_zero,
+                     prune_configs_by, warmup, rep)
+
+  return decorator
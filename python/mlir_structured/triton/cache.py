@@ -0,0 +1,214 @@
+import ctypes
+import functools
+import hashlib
+import logging
+import os
+import platform
+import re
+import subprocess
+import tempfile
+
+__all__ = [
+    "get_cache_key",
+    "get_num_load_failures",
+    "load_kernel",
+    "store_kernel",
+]
+
+_logger = logging.getLogger(__name__)
+
+_CACHE_DIR_ENV = "STRUCTURED_TRITON_CACHE_DIR"
+_CACHE_DIR_DEFAULT = os.path.join("~", ".cache", "mlir_structured", "triton")
+_CACHE_DISABLE_ENV = "STRUCTURED_TRITON_CACHE_DISABLE"
+_CC_ENV = "CC"
+_CC_DEFAULT = "cc"
+
+# Bump this version whenever the format of the cached files or the calling
+# convention of the compiled kernels changes.
+_CACHE_FORMAT_VERSION = 2
+
+# Name of the packed interface of the kernel function in the compiled code.
+_KERNEL_SYMBOL = "_mlir_kernel"
+
+# Number of cache entries that existed but could not be loaded.
+_num_load_failures = 0
+
+
+def _get_cache_dir():
+  if os.getenv(_CACHE_DISABLE_ENV, "0") not in ("", "0", "false"):
+    return None
+  cache_dir = os.getenv(_CACHE_DIR_ENV, _CACHE_DIR_DEFAULT)
+  return os.path.expanduser(cache_dir)
+
+
+def _get_host_fingerprint():
+  '''Returns a description of the host CPU. The JIT compiles for the features
+     of the host, so code compiled on one machine may not run on another.'''
+  fingerprint = platform.machine()
+  try:
+    with open("/proc/cpuinfo") as cpuinfo:
+      for line in cpuinfo:
+        if line.startswith(("model name", "flags", "Features")):
+          fingerprint += line.strip()
+  except OSError:
+    pass
+  return fingerprint
+
+
+@functools.lru_cache(maxsize=None)
+def _get_compiler_fingerprint():
+  '''Returns a description of the build of the compiler. The passes of the
+     pipeline are part of the native libraries of this package, so rebuilding
+     them may change the compiled code even if the pipeline stays the same.'''
+  from mlir_structured import _mlir_libs
+  libs_dir = os.path.dirname(_mlir_libs.__file__)
+  fingerprint = ""
+  for name in sorted(os.listdir(libs_dir)):
+    if ".so" in name or name.endswith((".dylib", ".dll")):
+      stat = os.stat(os.path.join(libs_dir, name))
+      fingerprint += f"{name}:{stat.st_size}:{stat.st_mtime_ns};"
+  return fingerprint
+
+
+def get_cache_key(fn, specialization, pipeline):
+  '''Returns the key of the compiled code of the given `JITFunction` with the
+     given specialization (a description of the signature, constants, and
+     other compile options) compiled with the given pass pipeline by the
+     current build of this package for the current host.'''
+  fn_key = getattr(fn, "cache_key", None) or fn.src
+  key = "\n".join([
+      str(_CACHE_FORMAT_VERSION),
+      fn_key,
+      repr(specialization),
+      pipeline,
+      _get_compiler_fingerprint(),
+      _get_host_fingerprint(),
+  ])
+  return hashlib.sha256(key.encode("utf-8")).hexdigest()
+
+
+def _get_library_path(cache_key):
+  cache_dir = _get_cache_dir()
+  if cache_dir is None:
+    return None
+  return os.path.join(cache_dir, cache_key[:2], cache_key + ".so")
+
+
+def get_num_load_failures():
+  '''Returns the number of cache entries that this process found but failed
+     to load (and hence recompiled).'''
+  return _num_load_failures
+
+
+def load_kernel(cache_key, runtime_libs):
+  '''Loads the compiled code with the given key from the cache. Returns the
+     loaded library and the address of the packed interface of the kernel
+     function or `None` if the cache has no code for that key.'''
+  global _num_load_failures
+  library_path = _get_library_path(cache_key)
+  if library_path is None or not os.path.exists(library_path):
+    return None
+
+  try:
+    # Make the symbols of the runtime libraries available to the kernel.
+    for lib in runtime_libs:
+      ctypes.CDLL(lib, mode=ctypes.RTLD_GLOBAL)
+
+    library = ctypes.CDLL(library_path)
+    kernel_ptr = ctypes.cast(getattr(library, _KERNEL_SYMBOL),
+                             ctypes.c_void_p).value
+  except (OSError, AttributeError) as e:
+    # Treat broken entries like misses; they are overwritten by the caller.
+    _num_load_failures += 1
+    _logger.warning("Failed to load cached kernel '%s': %s", library_path, e)
+    return None
+  return library, kernel_ptr
+
+
+def _split_params(params):
+  '''Splits the parameter list of an LLVM IR function at its top-level
+     commas.'''
+  result, depth, start = [], 0, 0
+  for i, c in enumerate(params):
+    if c in "([{<":
+      depth += 1
+    elif c in ")]}>":
+      depth -= 1
+    elif c == "," and depth == 0:
+      result.append(params[start:i].strip())
+      start = i + 1
+  if params.strip():
+    result.append(params[start:].strip())
+  return result
+
+
+def _get_param_type(param):
+  '''Returns the type of the given LLVM IR function parameter without its
+     attributes and name.'''
+  match = re.match(r"ptr addrspace\(\d+\)|[<{\[][^%]*?[>}\]](?=\s|$)|\S+",
+                   param)
+  return match.group(0)
+
+
+def _append_packed_interface(ll_path, function_name):
+  '''Appends the packed interface of the given void function, which takes
+     an array of pointers to its arguments, to the LLVM IR file `ll_path`.
+     This is the interface that the execution engine generates when the JIT
+     compiles the kernel; the compiled kernels are called through it.'''
+  with open(ll_path) as f:
+    ir = f.read()
+  match = re.search(r"^define [^@\n]*\bvoid @" + re.escape(function_name) +
+                    r"\(", ir, re.MULTILINE)
+  if match is None:
+    raise RuntimeError(f"function '{function_name}' not found in LLVM IR")
+  depth, end = 1, match.end()
+  while depth > 0:
+    depth += {"(": 1, ")": -1}.get(ir[end], 0)
+    end += 1
+  types = [_get_param_type(p) for p in _split_params(ir[match.end():end - 1])]
+
+  lines = [f"define void @_mlir_{function_name}(ptr %args) {{"]
+  for i, ty in enumerate(types):
+    lines += [
+        f"  %arg{i}.gep = getelementptr ptr, ptr %args, i64 {i}",
+        f"  %arg{i}.ptr = load ptr, ptr %arg{i}.gep",
+        f"  %arg{i} = load {ty}, ptr %arg{i}.ptr",
+    ]
+  args = ", ".join(f"{ty} %arg{i}" for i, ty in enumerate(types))
+  lines += [f"  call void @{function_name}({args})", "  ret void", "}", ""]
+  with open(ll_path, "a") as f:
+    f.write("\n" + "\n".join(lines))
+
+
+def store_kernel(cache_key, mod):
+  '''Stores the code of the given module in the LLVM dialect in the cache
+     under the given key. The module is compiled to position-independent code
+     for the host CPU and linked into a shared library, which is written
+     atomically such that concurrent processes never load partially written
+     files. Failures are only logged since the cache is an optimization.'''
+  # Imported here because the compiler imports this module.
+  from mlir_structured.triton.compiler import (compile_llvm_ir,
+                                               translate_to_llvm_ir)
+
+  library_path = _get_library_path(cache_key)
+  if library_path is None:
+    return
+
+  cache_dir = os.path.dirname(library_path)
+  try:
+    os.makedirs(cache_dir, exist_ok=True)
+    with tempfile.TemporaryDirectory(dir=cache_dir) as tmp_dir:
+      ll_path = os.path.join(tmp_dir, "kernel.ll")
+      object_path = os.path.join(tmp_dir, "kernel.o")
+      tmp_library_path = os.path.join(tmp_dir, "kernel.so")
+      translate_to_llvm_ir(mod, ll_path)
+      _append_packed_interface(ll_path, _KERNEL_SYMBOL[len("_mlir_"):])
+      compile_llvm_ir(ll_path, object_path)
+
+      cc = os.getenv(_CC_ENV, _CC_DEFAULT)
+      subprocess.run([cc, "-shared", "-o", tmp_library_path, object_path],
+                     check=True,
+                     capture_output=True)
+      os.replace(tmp_library_path, library_path)
+  except (OSError, subprocess.CalledProcessError, RuntimeError) as e:
+    _logger.debug("Failed to store kernel in cache '%s': %s", library_path, e)
@@ -1,35 +1,104 @@
-import ctypes
 import os
+import subprocess
 
 from triton.compiler.code_generator import ast_to_ttir
 
+from mlir_structured._mlir_libs._structuredTritonRuntime import Kernel
 from mlir_structured.execution_engine import ExecutionEngine
 from mlir_structured.ir import Context, Module, StringAttr, SymbolTable
 from mlir_structured.passmanager import PassManager
 from mlir_structured.dialects import triton as tt
+from mlir_structured.triton import cache
+from mlir_structured.triton.launcher import get_launcher
 
 __all__ = [
     "compile",
+    "compile_llvm_ir",
+    "get_runtime_libs",
+    "lower_to_llvm",
+    "translate_to_llvm_ir",
 ]
 
+_CLANG_ENV = "CLANG"
+_CLANG_DEFAULT = "clang"
+
 _MLIR_ASYNC_RUNTIME_LIB_ENV = "MLIR_ASYNC_RUNTIME_LIB"
 _MLIR_ASYNC_RUNTIME_LIB_DEFAULT = "libmlir_async_runtime.so"
 _MLIR_C_RUNNER_UTILS_LIB_ENV = "MLIR_C_RUNNER_UTILS_LIB"
 _MLIR_C_RUNNER_UTILS_LIB_DEFAULT = "libmlir_c_runner_utils.so"
 _MLIR_RUNNER_UTILS_LIB_ENV = "MLIR_RUNNER_UTILS_LIB"
 _MLIR_RUNNER_UTILS_LIB_DEFAULT = "libmlir_runner_utils.so"
+_MLIR_TRANSLATE_ENV = "MLIR_TRANSLATE"
+_MLIR_TRANSLATE_DEFAULT = "mlir-translate"
+
+# Pass pipeline that compiles Triton IR to LLVM. Its text is part of the keys
+# of the kernel cache, so changes invalidate previously compiled kernels.
+_PIPELINE = ('builtin.module('
+             '  convert-triton-func-to-func,'
+             '  convert-triton-spmd-to-func-args,'
+             '  func.func(llvm-request-c-wrappers),'
+             '  convert-triton-to-llvm,'
+             '  async-parallel-for,'
+             '  async-to-async-runtime,'
+             '  async-runtime-ref-counting,'
+             '  async-runtime-ref-counting-opt,'
+             '  convert-elementwise-to-linalg,'
+             '  linalg-fuse-elementwise-ops,'
+             '  empty-tensor-to-alloc-tensor,'
+             '  inline,'
+             '  one-shot-bufferize,'
+             '  func.func(convert-linalg-to-loops),'
+             '  func.func(convert-vector-to-scf{full-unroll=true}),'
+             '  convert-async-to-llvm,'
+             '  convert-scf-to-cf,'
+             '  convert-vector-to-llvm{reassociate-fp-reductions=true},'
+             '  finalize-memref-to-llvm,'
+             '  arith-expand,'
+             '  memref-expand,'
+             '  convert-func-to-llvm,'
+             '  canonicalize'
+             ')')
+
+
+def _get_pipeline(dot_tile_sizes=None):
+  '''Returns the pass pipeline with the given CPU-specific options: the
+     maximum register tile sizes (M, N, K) of `tt.dot` ops.'''
+  if dot_tile_sizes is None:
+    return _PIPELINE
+  sizes = ','.join(str(size) for size in dot_tile_sizes)
+  return _PIPELINE.replace('convert-triton-to-llvm,',
+                           f'convert-triton-to-llvm{{dot-tile-sizes={sizes}}},')
+
+
+def get_runtime_libs():
+  return [
+      os.getenv(_MLIR_RUNNER_UTILS_LIB_ENV, _MLIR_RUNNER_UTILS_LIB_DEFAULT),
+      os.getenv(_MLIR_C_RUNNER_UTILS_LIB_ENV, _MLIR_C_RUNNER_UTILS_LIB_DEFAULT),
+      os.getenv(_MLIR_ASYNC_RUNTIME_LIB_ENV, _MLIR_ASYNC_RUNTIME_LIB_DEFAULT)
+  ]
 
 
 class CompiledKernel:
   '''This class serves as a drop-in replacement for
      `triton.compiler.compiler.CompiledKernel` for usage in `jit.py`.'''
 
-  def __init__(self, context, module, engine, signature):
-    self.context = context
-    self.module = module
-    self.engine = engine
+  def __init__(self, kernel_ptr, signature, code_owner, num_threads=None):
+    # Address of the packed interface of the kernel function, which runs one
+    # program of the grid.
+    self.kernel_ptr = kernel_ptr
     self.signature = signature
 
+    # Number of threads that run the grid (or `None` for the default).
+    self.num_threads = num_threads
+
+    # Native kernel, which converts the arguments of each launch according to
+    # the signature parsed once here.
+    self.kernel = Kernel(kernel_ptr, list(signature.values()))
+
+    # Object that owns the compiled code (the execution engine or the library
+    # loaded from the cache), which needs to stay alive with the kernel.
+    self.code_owner = code_owner
+
     # Add dummy properties that are accessed in jit.py.
     self.num_warps = None
     self.shared = None
@@ -37,132 +106,141 @@ class CompiledKernel:
 
   def c_wrapper(self, *args, **kwargs):
     '''This function serves as a drop-in replacement for the original function
-       with the same name for usage in `jit.py`. It converts the kernel
-       arguments into the format that MLIR's `ExecutionEngine` understands, and,
-       for the time being, emulates grid execution with a nested loop.'''
-
-    # Extract useful arguments.
+       with the same name for usage in `jit.py`. It runs the grid on the shared
+       grid launcher (see `launcher.py`), which converts the kernel arguments
+       into the format of the packed interface of the kernel function.'''
     n_x, n_y, n_z = args[0:3]
-    kernel_args = args[10:]
-
-    # Extract kernel arguments.
-    ctype_args = []
-    for value, (idx, ty) in zip(kernel_args, self.signature.items()):
-      if ty[0] == '*':
-        addr = value.data_ptr()
-        ctype_arg = ctypes.cast(addr, ctypes.c_void_p)
-      else:
-        to_ctype_value = {
-            "i1": ctypes.c_int32,
-            "i8": ctypes.c_int8,
-            "i16": ctypes.c_int16,
-            "i32": ctypes.c_int32,
-            "i64": ctypes.c_int64,
-            "u32": ctypes.c_uint32,
-            "u64": ctypes.c_uint64,
-            "fp16": ctypes.c_float,
-            "bf16": ctypes.c_float,
-            "fp32": ctypes.c_float,
-            "f32": ctypes.c_float,
-            "fp64": ctypes.c_double,
-        }[ty]
-        ctype_arg = to_ctype_value(value)
-      ctype_arg = ctypes.pointer(ctype_arg)
-      ctype_args.append(ctype_arg)
-
-    # Run kernel through the grid wrapper.
-    N_args = [ctypes.pointer(ctypes.c_int32(n)) for n in [n_x, n_y, n_z]]
-    self.engine.invoke('kernel_grid', *(N_args + ctype_args))
+    launcher = get_launcher(self.num_threads)
+    launcher.launch_kernel(self.kernel, n_x, n_y, n_z, args[10:])
+
+
+def lower_to_llvm(fn,
+                  signature,
+                  constants,
+                  config,
+                  debug,
+                  kernel_name,
+                  dot_tile_sizes=None):
+  '''Converts the given `JITFunction` with the given signature, constants, and
+     specialization config to Triton IR, renames its kernel function to
+     `kernel_name`, and compiles the result to the LLVM dialect with the pass
+     pipeline of this module and the given maximum register tile sizes of dots
+     (if any). Must be called with an active MLIR context.
+     Returns the compiled module, which contains the per-program function
+     `kernel_name` and the grid function `<kernel_name>_grid` (see
+     `convert-triton-spmd-to-func-args`).'''
+
+  # Convert AST to Triton IR.
+  ttir = ast_to_ttir(fn, signature, config, constants, debug=debug, arch=None)
+
+  # Parse Triton IR in our extension.
+  tt.register_dialect()
+  try:
+    mod = Module.parse(str(ttir))
+  except Exception as e:
+    raise RuntimeError(f'Failed to parse Triton IR:\n\n{ttir}') from e
+
+  # Find function name of the kernel: there should only be one public function
+  # at this point.
+  kernel_func_name = None
+  for op in mod.body.operations:
+    if 'sym_name' in op.attributes and 'sym_visibility' in op.attributes:
+      visibility = StringAttr(op.attributes['sym_visibility']).value
+      if visibility != 'public':
+        continue
+      assert not kernel_func_name
+      kernel_func_name = StringAttr(op.attributes['sym_name']).value
+  assert kernel_func_name
+
+  # Replace kernel function name with the given name such that we can call it
+  # easily.
+  symbol_table = SymbolTable(mod.operation)
+  src_sym = symbol_table[kernel_func_name]
+  SymbolTable.set_symbol_name(src_sym, kernel_name)
+  SymbolTable.replace_all_symbol_uses(kernel_func_name, kernel_name,
+                                      mod.operation)
+
+  # Compile with custom pipeline.
+  pm = PassManager.parse(_get_pipeline(dot_tile_sizes))
+  try:
+    pm.run(mod.operation)
+  except Exception as e:
+    raise RuntimeError(f'Failed compile Triton IR:\n\n{ttir}') from e
+
+  return mod
+
+
+def _run_tool(args):
+  '''Runs the given command and raises a `RuntimeError` with its error
+     output if it fails.'''
+  result = subprocess.run(args, capture_output=True, text=True)
+  if result.returncode != 0:
+    raise RuntimeError(f"'{' '.join(args)}' failed:\n\n{result.stderr}")
+
+
+def translate_to_llvm_ir(mod, path):
+  '''Translates the given module in the LLVM dialect to LLVM IR and writes
+     the result to `path` (next to a copy of the module as `<path>.mlir`).'''
+  mlir_path = path + ".mlir"
+  with open(mlir_path, "w") as f:
+    f.write(str(mod))
+  mlir_translate = os.getenv(_MLIR_TRANSLATE_ENV, _MLIR_TRANSLATE_DEFAULT)
+  _run_tool([mlir_translate, "--mlir-to-llvmir", "-o", path, mlir_path])
+
+
+def compile_llvm_ir(ll_path, object_path, target_cpu=None):
+  '''Compiles the LLVM IR file `ll_path` into the object file `object_path`
+     for the given target CPU (by default, the host CPU). The object code is
+     position independent such that it can be linked into shared libraries
+     without text relocations.'''
+  clang = os.getenv(_CLANG_ENV, _CLANG_DEFAULT)
+  _run_tool([
+      clang, "-c", "-O3", "-fPIC", f"-march={target_cpu or 'native'}",
+      "-o", object_path, ll_path
+  ])
 
 
 def compile(fn, **kwargs):
   '''This function serves as drop-in replacement for `triton.compile` but uses
      a custom pipeline using MLIR Python bindings and returns a custom
-     `CompiledKernel`.'''
+     `CompiledKernel`. Besides the arguments of `triton.compile`, it accepts
+     the CPU-specific options `num_threads` (the number of threads that run
+     the grid) and `dot_tile_sizes` (the maximum register tile sizes (M, N, K)
+     of `tt.dot` ops); `num_warps` and `num_stages` are ignored.'''
 
-  # Convert AST to Triton IR.
   configs = kwargs['configs']
   constants = kwargs['constants']
   debug = kwargs['debug']
   signature = kwargs['signature']
-  ttir = ast_to_ttir(fn,
-                     signature,
-                     configs[0],
-                     constants,
-                     debug=debug,
-                     arch=None)
-
-  with Context() as ctx:
-    # Parse Triton IR in our extension.
-    tt.register_dialect()
-    try:
-      mod = Module.parse(str(ttir))
-    except Exception as e:
-      raise RuntimeError(f'Failed to parse Triton IR:\n\n{ttir}') from e
-
-    # Find function name of the kernel: there should only be one public function
-    # at this point.
-    kernel_func_name = None
-    for op in mod.body.operations:
-      if 'sym_name' in op.attributes and 'sym_visibility' in op.attributes:
-        visibility = StringAttr(op.attributes['sym_visibility']).value
-        if visibility != 'public':
-          continue
-        assert not kernel_func_name
-        kernel_func_name = StringAttr(op.attributes['sym_name']).value
-    assert kernel_func_name
-
-    # Replace kernel function name a fixed name such that we can call it easily.
-    symbol_table = SymbolTable(mod.operation)
-    src_sym = symbol_table[kernel_func_name]
-    dst_sym = 'kernel'
-    SymbolTable.set_symbol_name(src_sym, dst_sym)
-    SymbolTable.replace_all_symbol_uses(kernel_func_name, dst_sym,
-                                        mod.operation)
-
-    # Compile with custom pipeline.
-    pm = PassManager.parse('builtin.module('
-                           '  convert-triton-func-to-func,'
-                           '  convert-triton-spmd-to-func-args,'
-                           '  func.func(llvm-request-c-wrappers),'
-                           '  convert-triton-to-llvm,'
-                           '  async-parallel-for,'
-                           '  async-to-async-runtime,'
-                           '  async-runtime-ref-counting,'
-                           '  async-runtime-ref-counting-opt,'
-                           '  convert-elementwise-to-linalg,'
-                           '  linalg-fuse-elementwise-ops,'
-                           '  empty-tensor-to-alloc-tensor,'
-                           '  inline,'
-                           '  one-shot-bufferize,'
-                           '  func.func(convert-linalg-to-loops),'
-                           '  convert-async-to-llvm,'
-                           '  convert-scf-to-cf,'
-                           '  finalize-memref-to-llvm,'
-                           '  arith-expand,'
-                           '  memref-expand,'
-                           '  convert-func-to-llvm,'
-                           '  canonicalize'
-                           ')')
-    try:
-      pm.run(mod.operation)
-    except Exception as e:
-      raise RuntimeError(f'Failed compile Triton IR:\n\n{ttir}') from e
+  num_threads = kwargs.get('num_threads')
+  dot_tile_sizes = kwargs.get('dot_tile_sizes')
+
+  # Load previously compiled code from the cache if possible.
+  specialization = (sorted(signature.items()), sorted(constants.items()),
+                    configs[0], debug)
+  pipeline = _get_pipeline(dot_tile_sizes)
+  cache_key = cache.get_cache_key(fn, specialization, pipeline)
+  cached_kernel = cache.load_kernel(cache_key, get_runtime_libs())
+  if cached_kernel:
+    library, kernel_ptr = cached_kernel
+    return CompiledKernel(kernel_ptr, signature, library, num_threads)
+
+  with Context():
+    mod = lower_to_llvm(fn, signature, constants, configs[0], debug, 'kernel',
+                        dot_tile_sizes)
 
     # Create execution engine.
     try:
-      shared_libs = [
-          os.getenv(_MLIR_RUNNER_UTILS_LIB_ENV, _MLIR_RUNNER_UTILS_LIB_DEFAULT),
-          os.getenv(_MLIR_C_RUNNER_UTILS_LIB_ENV,
-                    _MLIR_C_RUNNER_UTILS_LIB_DEFAULT),
-          os.getenv(_MLIR_ASYNC_RUNTIME_LIB_ENV,
-                    _MLIR_ASYNC_RUNTIME_LIB_DEFAULT)
-      ]
-
-      engine = ExecutionEngine(mod, shared_libs=shared_libs, opt_level=3)
+      engine = ExecutionEngine(mod,
+                               shared_libs=get_runtime_libs(),
+                               opt_level=3)
     except Exception as e:
       raise RuntimeError(f'Failed to create execution engine.\n\n'
-                         f'Triton IR:\n\n{ttir}\n\n'
                          f'Compiled IR:\n\n{mod}\n\n') from e
 
-    return CompiledKernel(ctx, mod, engine, signature)
+    kernel_ptr = engine.raw_lookup('kernel')
+
+    # Store the compiled code such that other processes can reuse it.
+    cache.store_kernel(cache_key, mod)
+
+    return CompiledKernel(kernel_ptr, signature, engine, num_threads)
@@ -8,6 +8,9 @@
 # 4. Have the `JITFunction` class of this file inherit from the `JITFunction`
 #    class of the original package such that `instanceof` tests in other parts
 #    of Triton continue to work.
+# 5. Accepting the CPU-specific launch options `num_threads` and
+#    `dot_tile_sizes`, which are part of the key of the compiled kernel and are
+#    passed to our compile function.
 
 from __future__ import annotations, division
 
@@ -330,11 +333,13 @@ class JITFunction(triton.runtime.jit.JITFunction):
     grid_args = ','.join([f'"{arg}": {arg}' for arg in self.arg_names])
 
     src = f"""
-def {self.fn.__name__}({', '.join(self.arg_names)}, grid, num_warps=4, num_stages=3, extern_libs=None, stream=None, warmup=False, device=None):
+def {self.fn.__name__}({', '.join(self.arg_names)}, grid, num_warps=4, num_stages=3, extern_libs=None, stream=None, warmup=False, device=None, num_threads=None, dot_tile_sizes=None):
     sig_key =  {sig_keys},
     constexpr_key = {f'{constexpr_keys},' if len(constexpr_keys) > 0 else ()}
     spec_key = {f'{spec_keys},' if len(spec_keys) > 0 else ()}
-    key = (version_key, sig_key, constexpr_key, spec_key, num_warps, num_stages, self.debug)
+    if dot_tile_sizes is not None:
+      dot_tile_sizes = tuple(dot_tile_sizes)
+    key = (version_key, sig_key, constexpr_key, spec_key, num_warps, num_stages, num_threads, dot_tile_sizes, self.debug)
     if not extern_libs is None:
       key = (key, tuple(extern_libs.items()))
     assert num_warps > 0 and (num_warps & (num_warps - 1)) == 0, "num_warps must be a power of 2"
@@ -370,7 +375,7 @@ def {self.fn.__name__}({', '.join(self.arg_names)}, grid, num_warps=4, num_stage
         if callable(arg):
           raise TypeError(f"Callable constexpr at index {{i}} is not supported")
       if not self._call_hook(key, signature, device, constants, num_warps, num_stages, extern_libs, configs):
-        bin = triton_compile(self, signature=signature, device=device, constants=constants, num_warps=num_warps, num_stages=num_stages, extern_libs=extern_libs, configs=configs, debug=self.debug)
+        bin = triton_compile(self, signature=signature, device=device, constants=constants, num_warps=num_warps, num_stages=num_stages, extern_libs=extern_libs, configs=configs, debug=self.debug, num_threads=num_threads, dot_tile_sizes=dot_tile_sizes)
         if not warmup:
             bin.c_wrapper(grid_0, grid_1, grid_2, bin.num_warps, bin.shared, stream, bin.cu_function, triton.compiler.CompiledKernel.launch_enter_hook, triton.compiler.CompiledKernel.launch_exit_hook, bin, *args)
         self.cache[device][key] = bin
@@ -0,0 +1,69 @@
+import os
+
+from mlir_structured._mlir_libs._structuredTritonRuntime import GridLauncher
+
+__all__ = [
+    "configure",
+    "get_launcher",
+]
+
+_NUM_THREADS_ENV = "STRUCTURED_TRITON_NUM_THREADS"
+_GRAIN_SIZE_ENV = "STRUCTURED_TRITON_GRAIN_SIZE"
+_PIN_THREADS_ENV = "STRUCTURED_TRITON_PIN_THREADS"
+
+# Launcher shared by all kernels such that its worker threads are reused across
+# launches.
+_launcher = None
+
+# Launchers with a specific number of threads (for kernels tuned for that
+# number), which otherwise share the configuration of the default launcher.
+_launchers_by_num_threads = {}
+_pin_threads = False
+
+
+def configure(num_threads=None, grain_size=None, pin_threads=None):
+  '''(Re-)creates the grid launcher that runs all kernels and returns it.
+
+     `num_threads` is the number of threads that run the programs of a grid
+     (by default, one per CPU); `grain_size` is the number of consecutive
+     programs that each task of the thread pool runs (by default, chosen such
+     that each thread gets a few tasks); `pin_threads` pins the worker threads
+     to distinct CPUs, filling one NUMA node after the other. Unspecified values
+     are taken from the environment variables `STRUCTURED_TRITON_NUM_THREADS`,
+     `STRUCTURED_TRITON_GRAIN_SIZE`, and `STRUCTURED_TRITON_PIN_THREADS`,
+     respectively, or use their defaults.'''
+  global _launcher, _pin_threads
+
+  if num_threads is None:
+    num_threads = int(os.getenv(_NUM_THREADS_ENV, "0"))
+  if grain_size is None:
+    grain_size = int(os.getenv(_GRAIN_SIZE_ENV, "0"))
+  if pin_threads is None:
+    pin_threads = os.getenv(_PIN_THREADS_ENV, "0") not in ("", "0", "false")
+
+  # Shut down the workers of the previous launchers before starting new ones.
+  _launcher = None
+  _launchers_by_num_threads.clear()
+  _pin_threads = pin_threads
+  _launcher = GridLauncher(num_threads=num_threads,
+                           grain_size=grain_size,
+                           pin_threads=pin_threads)
+  return _launcher
+
+
+def get_launcher(num_threads=None):
+  '''Returns the grid launcher that runs all kernels, creating it on first
+     use. If `num_threads` is given, returns a launcher with that number of
+     threads and the configuration of the default launcher otherwise.'''
+  if _launcher is None:
+    configure()
+  if num_threads is None or num_threads == _launcher.num_threads:
+    return _launcher
+
+  launcher = _launchers_by_num_threads.get(num_threads)
+  if launcher is None:
+    launcher = GridLauncher(num_threads=num_threads,
+                            grain_size=_launcher.grain_size,
+                            pin_threads=_pin_threads)
+    _launchers_by_num_threads[num_threads] = launcher
+  return launcher
@@ -0,0 +1,34 @@
+// RUN: structured-opt %s -convert-iterators-to-llvm \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK-DAG: llvm.func @malloc(i64) -> !llvm.ptr
+// CHECK-DAG: llvm.func @realloc(!llvm.ptr, i64) -> !llvm.ptr
+
+func.func @main(%input : !tabular.tabular_view<i32>) -> !tabular.tabular_view<i32> {
+// CHECK-LABEL:  func.func @main(
+  %stream = iterators.tabular_view_to_stream %input
+              to !iterators.stream<tuple<i32>>
+  // CHECK:        %[[V0:.*]] = iterators.createstate({{.*}}) : [[upstreamStateType:.*]]
+  %view = iterators.stream_to_tabular %stream
+            to !tabular.tabular_view<i32>
+  // CHECK:        %[[SIZE:.*]] = arith.constant 4 : i64
+  // CHECK:        %[[CAP:.*]] = arith.constant 1024 : i64
+  // CHECK:        %[[BYTES:.*]] = arith.muli %[[CAP]], %[[SIZE]] : i64
+  // CHECK-NEXT:   %[[BUF:.*]] = llvm.call @malloc(%[[BYTES]]) : (i64) -> !llvm.ptr
+  // CHECK-NEXT:   %[[V1:.*]] = call @iterators.tabular_view_to_stream.open.0(%[[V0]]) : ([[upstreamStateType]]) -> [[upstreamStateType]]
+  // CHECK-NEXT:   %[[V2:.*]]:5 = scf.while ({{.*}}) : ([[upstreamStateType]], i64, i64, !llvm.ptr) -> ([[upstreamStateType]], i64, i64, !llvm.ptr, tuple<i32>) {
+  // CHECK:          %[[V3:.*]]:3 = func.call @iterators.tabular_view_to_stream.next.0
+  // CHECK:          scf.condition(%[[V3]]#1)
+  // CHECK:        } do {
+  // CHECK:          scf.if
+  // CHECK:            llvm.call @realloc
+  // CHECK:          tuple.to_elements
+  // CHECK:          llvm.getelementptr
+  // CHECK-NEXT:     llvm.store
+  // CHECK:        }
+  // CHECK-NEXT:   %[[V4:.*]] = call @iterators.tabular_view_to_stream.close.0(%[[V2]]#0) : ([[upstreamStateType]]) -> [[upstreamStateType]]
+  // CHECK-NEXT:   %[[V5:.*]] = llvm.mlir.undef : !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:   %[[V6:.*]] = llvm.insertvalue %[[V2]]#1, %[[V5]][0] : !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:   %[[V7:.*]] = llvm.insertvalue %[[V2]]#3, %[[V6]][1] : !llvm.struct<(i64, ptr)>
+  return %view : !tabular.tabular_view<i32>
+}
@@ -0,0 +1,31 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-iterators-to-llvm -reconcile-unrealized-casts \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.next.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>) -> (!iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>, i1, tuple<i32>)
+// CHECK-NEXT:    %[[V0:.*]] = iterators.extractvalue %[[arg0:.*]][0] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    %[[V1:.*]] = iterators.extractvalue %[[arg0]][1] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    %[[V2:.*]] = iterators.extractvalue %[[arg0]][2] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    %[[NC:.*]] = llvm.extractvalue %[[V2]][0] : !llvm.struct<(i64, ptr)>
+// CHECK-NEXT:    %[[CP:.*]] = llvm.extractvalue %[[V2]][1] : !llvm.struct<(i64, ptr)>
+// CHECK-NEXT:    %[[W:.*]]:2 = scf.while (%{{.*}} = %[[V0]], %{{.*}} = %[[V1]]) : (i64, i64) -> (i64, i64) {
+// CHECK:           llvm.getelementptr %[[CP]][%{{.*}}] : (!llvm.ptr, i64) -> !llvm.ptr, !llvm.struct<(i64, ptr)>
+// CHECK:           arith.cmpi sge
+// CHECK:         } do {
+// CHECK:         }
+// CHECK-NEXT:    %[[HASNEXT:.*]] = arith.cmpi slt, %[[W]]#0, %[[NC]] : i64
+// CHECK-NEXT:    scf.if %[[HASNEXT]]
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.open.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>) -> !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    %[[V0:.*]] = arith.constant 0 : i64
+// CHECK-NEXT:    %[[V1:.*]] = iterators.insertvalue %[[V0]] into %[[arg0:.*]][0] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    %[[V2:.*]] = iterators.insertvalue %[[V0]] into %[[V1]][1] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+// CHECK-NEXT:    return %[[V2]] : !iterators.state<i64, i64, !llvm.struct<(i64, ptr)>>
+
+func.func @main(%input : !tabular.chunked_tabular_view<i32>) {
+// CHECK-LABEL:  func.func @main(
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32>> chunked
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i32>>) -> ()
+  return
+}
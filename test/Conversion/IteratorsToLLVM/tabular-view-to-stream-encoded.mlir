@@ -0,0 +1,54 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-iterators-to-llvm -reconcile-unrealized-casts \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.next.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>) -> (!iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>, i1, tuple<i32, i64>)
+// CHECK:         scf.if
+// CHECK:           %[[BP:.*]] = llvm.extractvalue %{{.*}}[1] : !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>
+// CHECK-NEXT:      %[[WORDS:.*]] = llvm.extractvalue %[[BP]][1] : !llvm.struct<(i64, ptr, i32)>
+// CHECK-NEXT:      %[[REF:.*]] = llvm.extractvalue %[[BP]][2] : !llvm.struct<(i64, ptr, i32)>
+// CHECK-DAG:       %[[PERWORD:.*]] = arith.constant 16 : i64
+// CHECK-DAG:       %[[MASK:.*]] = arith.constant 15 : i64
+// CHECK:           %[[WORDIDX:.*]] = arith.divui %{{.*}}, %[[PERWORD]] : i64
+// CHECK-NEXT:      %[[SLOT:.*]] = arith.remui %{{.*}}, %[[PERWORD]] : i64
+// CHECK-NEXT:      %[[SHIFT:.*]] = arith.muli %[[SLOT]], %{{.*}} : i64
+// CHECK-NEXT:      %[[GEP:.*]] = llvm.getelementptr %[[WORDS]][%[[WORDIDX]]] : (!llvm.ptr, i64) -> !llvm.ptr, i64
+// CHECK-NEXT:      %[[WORD:.*]] = llvm.load %[[GEP]] : !llvm.ptr -> i64
+// CHECK-NEXT:      %[[SHIFTED:.*]] = arith.shrui %[[WORD]], %[[SHIFT]] : i64
+// CHECK-NEXT:      %[[MASKED:.*]] = arith.andi %[[SHIFTED]], %[[MASK]] : i64
+// CHECK-NEXT:      %[[TRUNC:.*]] = arith.trunci %[[MASKED]] : i64 to i32
+// CHECK-NEXT:      %[[DECODED:.*]] = arith.addi %[[REF]], %[[TRUNC]] : i32
+// CHECK-NEXT:      %[[RLE:.*]] = llvm.extractvalue %{{.*}}[2] : !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>
+// CHECK-NEXT:      %[[VALUES:.*]] = llvm.extractvalue %[[RLE]][2] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:      %[[RUNENDS:.*]] = llvm.extractvalue %[[RLE]][3] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:      %[[RUN0:.*]] = iterators.extractvalue %{{.*}}[2] : !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>
+// CHECK-NEXT:      %[[RUN:.*]] = scf.while (%[[ARG:.*]] = %[[RUN0]]) : (i64) -> i64 {
+// CHECK-NEXT:        %[[ENDPTR:.*]] = llvm.getelementptr %[[RUNENDS]][%[[ARG]]] : (!llvm.ptr, i64) -> !llvm.ptr, i64
+// CHECK-NEXT:        %[[END:.*]] = llvm.load %[[ENDPTR]] : !llvm.ptr -> i64
+// CHECK-NEXT:        %[[COND:.*]] = arith.cmpi sle, %[[END]], %{{.*}} : i64
+// CHECK-NEXT:        scf.condition(%[[COND]]) %[[ARG]] : i64
+// CHECK-NEXT:      } do {
+// CHECK:           }
+// CHECK-NEXT:      %[[STATE:.*]] = iterators.insertvalue %[[RUN]] into %{{.*}}[2] : !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>
+// CHECK-NEXT:      %[[VALPTR:.*]] = llvm.getelementptr %[[VALUES]][%[[RUN]]] : (!llvm.ptr, i64) -> !llvm.ptr, i64
+// CHECK-NEXT:      %[[VAL:.*]] = llvm.load %[[VALPTR]] : !llvm.ptr -> i64
+// CHECK-NEXT:      %[[TUPLE:.*]] = tuple.from_elements %[[DECODED]], %[[VAL]] : tuple<i32, i64>
+// CHECK-NEXT:      scf.yield %[[STATE]], %[[TUPLE]]
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.open.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>) -> !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>
+// CHECK-NEXT:    %[[V0:.*]] = arith.constant 0 : i64
+// CHECK-NEXT:    %[[V1:.*]] = iterators.insertvalue %[[V0]] into %[[arg0:.*]][0] : !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>
+// CHECK-NEXT:    %[[V2:.*]] = iterators.insertvalue %[[V0]] into %[[V1]][2] : !iterators.state<i64, !llvm.struct<(i64, struct<(i64, ptr, i32)>, struct<(i64, i64, ptr, ptr)>)>, i64>
+// CHECK-NEXT:    return %[[V2]]
+
+func.func @main(%input : !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>) {
+// CHECK-LABEL:  func.func @main(
+// CHECK-SAME:      %[[arg0:.*]]: [[tabularViewType:.*]]) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64>>
+                from !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>
+  // CHECK-NEXT:   %[[V1:.*]] = arith.constant 0 : i64
+  // CHECK-NEXT:   %[[V2:.*]] = iterators.createstate(%[[V1]], %[[arg0]], %[[V1]]) : !iterators.state<i64, [[tabularViewType]], i64>
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  return
+}
@@ -0,0 +1,21 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-iterators-to-llvm -reconcile-unrealized-casts \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.next.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, !llvm.struct<(i64, ptr, ptr, ptr)>>) -> (!iterators.state<i64, !llvm.struct<(i64, ptr, ptr, ptr)>>, i1, tuple<i64>)
+// CHECK:         scf.if
+// CHECK:           %[[V0:.*]] = iterators.insertvalue
+// CHECK-NEXT:      %[[V1:.*]] = llvm.extractvalue %{{.*}}[2] : !llvm.struct<(i64, ptr, ptr, ptr)>
+// CHECK-NEXT:      %[[V2:.*]] = llvm.getelementptr %[[V1]][%{{.*}}] : (!llvm.ptr, i64) -> !llvm.ptr, i64
+// CHECK-NEXT:      %[[V3:.*]] = llvm.load %[[V2]] : !llvm.ptr -> i64
+// CHECK-NEXT:      %[[V4:.*]] = tuple.from_elements %[[V3]] : tuple<i64>
+// CHECK-NEXT:      scf.yield %[[V0]], %[[V4]] : !iterators.state<i64, !llvm.struct<(i64, ptr, ptr, ptr)>>, tuple<i64>
+
+func.func @main(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                {columnIndices = array<i64: 1>}
+                to !iterators.stream<tuple<i64>>
+                from !tabular.tabular_view<i32, i64, f64>
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i64>>) -> ()
+  return
+}
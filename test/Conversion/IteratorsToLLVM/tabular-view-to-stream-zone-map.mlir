@@ -0,0 +1,39 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-iterators-to-llvm -reconcile-unrealized-casts \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK-LABEL: func private @iterators.tabular_view_to_stream.next.{{[0-9]+}}(%{{.*}}: !iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>) -> (!iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>, i1, tuple<i32>)
+// CHECK-NEXT:    %[[V0:.*]] = iterators.extractvalue %[[arg0:.*]][0] : !iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>
+// CHECK-NEXT:    %[[V1:.*]] = iterators.extractvalue %[[arg0]][1] : !iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>
+// CHECK-NEXT:    %[[V2:.*]] = llvm.extractvalue %[[V1]][0] : !llvm.struct<(i64, ptr)>
+// CHECK-NEXT:    %[[V3:.*]] = iterators.extractvalue %[[arg0]][2] : !iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>
+// CHECK-NEXT:    %[[CS:.*]] = llvm.extractvalue %[[V3]][0] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:    %[[NC:.*]] = llvm.extractvalue %[[V3]][1] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:    %[[MINS:.*]] = llvm.extractvalue %[[V3]][2] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:    %[[MAXS:.*]] = llvm.extractvalue %[[V3]][3] : !llvm.struct<(i64, i64, ptr, ptr)>
+// CHECK-NEXT:    %[[IDX:.*]] = scf.while (%[[ARG1:.*]] = %[[V0]]) : (i64) -> i64 {
+// CHECK:           %[[CHUNK:.*]] = arith.divsi %[[ARG1]], %[[CS]] : i64
+// CHECK:           %[[SKIP:.*]] = scf.if %{{.*}} -> (i1) {
+// CHECK:             llvm.getelementptr %[[MAXS]][%[[CHUNK]]] : (!llvm.ptr, i64) -> !llvm.ptr, i32
+// CHECK:             arith.cmpi slt, %{{.*}}, %{{.*}} : i32
+// CHECK:             llvm.getelementptr %[[MINS]][%[[CHUNK]]] : (!llvm.ptr, i64) -> !llvm.ptr, i32
+// CHECK:             arith.cmpi sgt, %{{.*}}, %{{.*}} : i32
+// CHECK:           scf.condition(%[[SKIP]]) %[[ARG1]] : i64
+// CHECK:         } do {
+// CHECK-NEXT:    ^{{.*}}(%[[ARG2:.*]]: i64):
+// CHECK-NEXT:      %[[NEXT:.*]] = arith.addi %[[ARG2]], %[[CS]] : i64
+// CHECK-NEXT:      scf.yield %[[NEXT]] : i64
+// CHECK-NEXT:    }
+// CHECK-NEXT:    %[[HASNEXT:.*]] = arith.cmpi slt, %[[IDX]], %[[V2]] : i64
+
+func.func @main(%input : !tabular.tabular_view<i32>,
+                %zonemap : !tabular.zone_map<i32>) {
+// CHECK-LABEL:  func.func @main(
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i32>)
+                {zoneMapColumn = 0 : i64,
+                 zoneMapLowerBound = 10 : i32, zoneMapUpperBound = 20 : i32}
+                to !iterators.stream<tuple<i32>>
+// CHECK:          %[[state:.*]] = iterators.createstate(%{{.*}}, %{{.*}}, %{{.*}}) : !iterators.state<i64, !llvm.struct<(i64, ptr)>, !llvm.struct<(i64, i64, ptr, ptr)>>
+  return
+}
@@ -0,0 +1,16 @@
+// RUN: structured-opt %s -convert-tabular-to-llvm \
+// RUN: | FileCheck --enable-var-scope %s
+
+// CHECK: llvm.func @free(!llvm.ptr)
+
+func.func @main(%view : !tabular.tabular_view<i32, f64>) {
+  // CHECK-LABEL: func.func @main(%{{.*}}: !llvm.struct<(i64, ptr, ptr)>) {
+  tabular.dealloc %view : !tabular.tabular_view<i32, f64>
+  // CHECK-NEXT:    %[[V0:.*]] = llvm.extractvalue %[[arg0:.*]][1] : !llvm.struct<(i64, ptr, ptr)>
+  // CHECK-NEXT:    llvm.call @free(%[[V0]]) : (!llvm.ptr) -> ()
+  // CHECK-NEXT:    %[[V1:.*]] = llvm.extractvalue %[[arg0]][2] : !llvm.struct<(i64, ptr, ptr)>
+  // CHECK-NEXT:    llvm.call @free(%[[V1]]) : (!llvm.ptr) -> ()
+  return
+  // CHECK-NEXT:    return
+}
+// CHECK-NEXT:    }
@@ -0,0 +1,26 @@
+// RUN: structured-opt %s -convert-tabular-to-llvm \
+// RUN: | FileCheck --enable-var-scope %s
+
+func.func @main(%words : memref<?xi64>, %reference : i32, %numrows : i64) {
+  // CHECK-LABEL: func.func @main(
+  // CHECK-SAME:                  %[[ARG0:[^:]*]]: !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>,
+  // CHECK-SAME:                  %[[ARG1:[^:]*]]: i32,
+  // CHECK-SAME:                  %[[ARG2:[^:]*]]: i64) {
+  %column = tabular.view_as_bit_packed %words, %reference, %numrows
+    : (memref<?xi64>, i32, i64) -> !tabular.bit_packed<i32, 7>
+  // CHECK-NEXT:    %[[V0:.*]] = llvm.mlir.undef : !llvm.struct<(i64, ptr, i32)>
+  // CHECK-NEXT:    %[[V1:.*]] = llvm.extractvalue %[[ARG0]][1] : !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+  // CHECK-NEXT:    %[[V2:.*]] = llvm.insertvalue %[[ARG2]], %[[V0]][0] : !llvm.struct<(i64, ptr, i32)>
+  // CHECK-NEXT:    %[[V3:.*]] = llvm.insertvalue %[[V1]], %[[V2]][1] : !llvm.struct<(i64, ptr, i32)>
+  // CHECK-NEXT:    %[[V4:.*]] = llvm.insertvalue %[[ARG1]], %[[V3]][2] : !llvm.struct<(i64, ptr, i32)>
+  %view = tabular.view_as_tabular %column
+    : (!tabular.bit_packed<i32, 7>)
+        -> !tabular.tabular_view<!tabular.bit_packed<i32, 7>>
+  // CHECK-NEXT:    %[[V5:.*]] = llvm.mlir.undef : !llvm.struct<(i64, struct<(i64, ptr, i32)>)>
+  // CHECK-NEXT:    %[[V6:.*]] = llvm.extractvalue %[[V4]][0] : !llvm.struct<(i64, ptr, i32)>
+  // CHECK-NEXT:    %[[V7:.*]] = llvm.insertvalue %[[V4]], %[[V5]][1] : !llvm.struct<(i64, struct<(i64, ptr, i32)>)>
+  // CHECK-NEXT:    %[[V8:.*]] = llvm.insertvalue %[[V6]], %[[V7]][0] : !llvm.struct<(i64, struct<(i64, ptr, i32)>)>
+  return
+  // CHECK-NEXT:    return
+}
+// CHECK-NEXT:    }
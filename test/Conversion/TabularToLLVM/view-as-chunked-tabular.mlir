@@ -0,0 +1,24 @@
+// RUN: structured-opt %s -convert-tabular-to-llvm \
+// RUN: | FileCheck --enable-var-scope %s
+
+func.func @main(%view1 : !tabular.tabular_view<i32>,
+                %view2 : !tabular.tabular_view<i32>) {
+  // CHECK-LABEL: func.func @main(
+  // CHECK-SAME:                  %[[ARG0:[^:]*]]: !llvm.struct<(i64, ptr)>,
+  // CHECK-SAME:                  %[[ARG1:[^:]*]]: !llvm.struct<(i64, ptr)>) {
+  %chunked = tabular.view_as_chunked_tabular %view1, %view2
+    : (!tabular.tabular_view<i32>, !tabular.tabular_view<i32>)
+        -> !tabular.chunked_tabular_view<i32>
+  // CHECK-NEXT:    %[[V0:.*]] = llvm.mlir.constant(2 : i64) : i64
+  // CHECK-NEXT:    %[[V1:.*]] = llvm.alloca %[[V0]] x !llvm.struct<(i64, ptr)> : (i64) -> !llvm.ptr
+  // CHECK-NEXT:    %[[V2:.*]] = llvm.getelementptr %[[V1]][0] : (!llvm.ptr) -> !llvm.ptr, !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:    llvm.store %[[ARG0]], %[[V2]] : !llvm.struct<(i64, ptr)>, !llvm.ptr
+  // CHECK-NEXT:    %[[V3:.*]] = llvm.getelementptr %[[V1]][1] : (!llvm.ptr) -> !llvm.ptr, !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:    llvm.store %[[ARG1]], %[[V3]] : !llvm.struct<(i64, ptr)>, !llvm.ptr
+  // CHECK-NEXT:    %[[V4:.*]] = llvm.mlir.undef : !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:    %[[V5:.*]] = llvm.insertvalue %[[V0]], %[[V4]][0] : !llvm.struct<(i64, ptr)>
+  // CHECK-NEXT:    %[[V6:.*]] = llvm.insertvalue %[[V1]], %[[V5]][1] : !llvm.struct<(i64, ptr)>
+  return
+  // CHECK-NEXT:    return
+}
+// CHECK-NEXT:    }
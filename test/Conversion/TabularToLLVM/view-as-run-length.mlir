@@ -0,0 +1,22 @@
+// RUN: structured-opt %s -convert-tabular-to-llvm \
+// RUN: | FileCheck --enable-var-scope %s
+
+func.func @main(%values : memref<?xi32>, %runends : memref<?xi64>, %numrows : i64) {
+  // CHECK-LABEL: func.func @main(
+  // CHECK-SAME:                  %[[ARG0:[^:]*]]: !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>,
+  // CHECK-SAME:                  %[[ARG1:[^:]*]]: !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>,
+  // CHECK-SAME:                  %[[ARG2:[^:]*]]: i64) {
+  %column = tabular.view_as_run_length %values, %runends, %numrows
+    : (memref<?xi32>, memref<?xi64>, i64) -> !tabular.run_length<i32>
+  // CHECK-NEXT:    %[[V0:.*]] = llvm.mlir.undef : !llvm.struct<(i64, i64, ptr, ptr)>
+  // CHECK-NEXT:    %[[V1:.*]] = llvm.extractvalue %[[ARG0]][1] : !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+  // CHECK-NEXT:    %[[V2:.*]] = llvm.extractvalue %[[ARG1]][1] : !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+  // CHECK-NEXT:    %[[V3:.*]] = llvm.extractvalue %[[ARG0]][3, 0] : !llvm.struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>
+  // CHECK-NEXT:    %[[V4:.*]] = llvm.insertvalue %[[ARG2]], %[[V0]][0] : !llvm.struct<(i64, i64, ptr, ptr)>
+  // CHECK-NEXT:    %[[V5:.*]] = llvm.insertvalue %[[V3]], %[[V4]][1] : !llvm.struct<(i64, i64, ptr, ptr)>
+  // CHECK-NEXT:    %[[V6:.*]] = llvm.insertvalue %[[V1]], %[[V5]][2] : !llvm.struct<(i64, i64, ptr, ptr)>
+  // CHECK-NEXT:    %[[V7:.*]] = llvm.insertvalue %[[V2]], %[[V6]][3] : !llvm.struct<(i64, i64, ptr, ptr)>
+  return
+  // CHECK-NEXT:    return
+}
+// CHECK-NEXT:    }
@@ -0,0 +1,85 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN: | FileCheck %s
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: !llvm.ptr<f32, 1>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4xf32>,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<4xi1>) {
+// CHECK:         %[[V0:.*]] = tensor.splat %{{.*}} : tensor<4xindex>
+// CHECK-NEXT:    %[[V1:.*]] = arith.constant -0.000000e+00 : f32
+// CHECK-NEXT:    %[[V2:.*]] = tensor.splat %[[V1]] : tensor<4xf32>
+// CHECK-NEXT:    %[[V3:.*]] = arith.select %[[ARG2]], %[[ARG1]], %[[V2]] : tensor<4xi1>, tensor<4xf32>
+// CHECK-NEXT:    %[[V4:.*]] = arith.constant false
+// CHECK-NEXT:    %[[V5:.*]] = tensor.splat %[[V4]] : tensor<i1>
+// CHECK-NEXT:    %[[V6:.*]] = linalg.reduce ins(%[[ARG2]] : tensor<4xi1>) outs(%[[V5]] : tensor<i1>) dimensions = [0]
+// CHECK:             arith.ori
+// CHECK:         %[[V7:.*]] = arith.constant -0.000000e+00 : f32
+// CHECK-NEXT:    %[[V8:.*]] = tensor.splat %[[V7]] : tensor<f32>
+// CHECK-NEXT:    %[[V9:.*]] = linalg.reduce ins(%[[V3]] : tensor<4xf32>) outs(%[[V8]] : tensor<f32>) dimensions = [0]
+// CHECK:             arith.addf
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[Va:.*]] = tensor.extract %[[V0]][%[[C0]]] : tensor<4xindex>
+// CHECK-NEXT:    %[[Vb:.*]] = arith.index_cast %[[Va]] : index to i64
+// CHECK-NEXT:    %[[Vc:.*]] = llvm.inttoptr %[[Vb]] : i64 to !llvm.ptr<f32, 1>
+// CHECK-NEXT:    %[[Vd:.*]] = tensor.extract %[[V9]][] : tensor<f32>
+// CHECK-NEXT:    %[[Ve:.*]] = tensor.extract %[[V6]][] : tensor<i1>
+// CHECK-NEXT:    scf.if %[[Ve]] {
+// CHECK-NEXT:      %{{.*}} = llvm.atomicrmw fadd %[[Vc]], %[[Vd]] monotonic : !llvm.ptr<f32, 1>, f32
+// CHECK-NEXT:    }
+// CHECK-NEXT:    return
+func.func public @kernel(%arg0: !tt.ptr<f32>, %arg1: tensor<4xf32>, %arg2: tensor<4xi1>) {
+  %0 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<4x!tt.ptr<f32>>
+  %1 = "tt.atomic_rmw" (%0, %arg1, %arg2) {atomic_rmw_op = 5 : i32, sem = 1 : i32} : (tensor<4x!tt.ptr<f32>>, tensor<4xf32>, tensor<4xi1>) -> tensor<4xf32>
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<1x4xindex>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<2x4xi32>) {
+// CHECK:         %[[V0:.*]] = arith.constant 0 : i32
+// CHECK-NEXT:    %[[V1:.*]] = tensor.splat %[[V0]] : tensor<4xi32>
+// CHECK-NEXT:    %[[V2:.*]] = linalg.reduce ins(%[[ARG1]] : tensor<2x4xi32>) outs(%[[V1]] : tensor<4xi32>) dimensions = [0]
+// CHECK:             arith.addi
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         scf.for %[[ARG2:.*]] = %{{.*}} to %{{.*}} step %{{.*}} {
+// CHECK-NEXT:      %[[V3:.*]] = tensor.extract %[[PTRS:.*]][%[[C0]], %[[ARG2]]] : tensor<2x4xindex>
+// CHECK-NEXT:      %[[V4:.*]] = arith.index_cast %[[V3]] : index to i64
+// CHECK-NEXT:      %[[V5:.*]] = llvm.inttoptr %[[V4]] : i64 to !llvm.ptr<i32, 1>
+// CHECK-NEXT:      %[[V6:.*]] = tensor.extract %[[V2]][%[[ARG2]]] : tensor<4xi32>
+// CHECK-NEXT:      %{{.*}} = llvm.atomicrmw add %[[V5]], %[[V6]] acquire : !llvm.ptr<i32, 1>, i32
+// CHECK-NEXT:    }
+// CHECK-NEXT:    return
+func.func public @kernel(%arg0: tensor<1x4x!tt.ptr<i32>>, %arg1: tensor<2x4xi32>) {
+  %0 = tt.broadcast %arg0 : (tensor<1x4x!tt.ptr<i32>>) -> tensor<2x4x!tt.ptr<i32>>
+  %1 = arith.constant dense<0> : tensor<2x4xi32>
+  %2 = tt.addptr %0, %1 : tensor<2x4x!tt.ptr<i32>>, tensor<2x4xi32>
+  %3 = "tt.atomic_rmw" (%2, %arg1) {atomic_rmw_op = 4 : i32, sem = 2 : i32} : (tensor<2x4x!tt.ptr<i32>>, tensor<2x4xi32>) -> tensor<2x4xi32>
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-NOT:     linalg.reduce
+// CHECK:         scf.for
+// CHECK:           llvm.atomicrmw xchg
+func.func public @kernel(%arg0: !tt.ptr<i32>, %arg1: tensor<4xi32>) {
+  %0 = tt.splat %arg0 : (!tt.ptr<i32>) -> tensor<4x!tt.ptr<i32>>
+  %1 = "tt.atomic_rmw" (%0, %arg1) {atomic_rmw_op = 10 : i32, sem = 1 : i32} : (tensor<4x!tt.ptr<i32>>, tensor<4xi32>) -> tensor<4xi32>
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-NOT:     linalg.reduce
+// CHECK:         scf.for
+// CHECK:           llvm.atomicrmw add
+func.func public @kernel(%arg0: !tt.ptr<i32>, %arg1: tensor<4xi32>) -> tensor<4xi32> {
+  %0 = tt.splat %arg0 : (!tt.ptr<i32>) -> tensor<4x!tt.ptr<i32>>
+  %1 = "tt.atomic_rmw" (%0, %arg1) {atomic_rmw_op = 4 : i32, sem = 1 : i32} : (tensor<4x!tt.ptr<i32>>, tensor<4xi32>) -> tensor<4xi32>
+  return %1 : tensor<4xi32>
+}
@@ -8,11 +8,15 @@
 // RUN:   -convert-triton-to-llvm -canonicalize \
 // RUN: | FileCheck --check-prefix=CHECK-CANON %s
 
+// CHECK-DAG: #[[MAP0:.*]] = affine_map<(d0, d1) -> (d1)>
+// CHECK-DAG: #[[MAP1:.*]] = affine_map<(d0, d1) -> (d0, d1)>
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<1x4xi32>) -> tensor<4x4xi32> {
 // CHECK-DAG:     %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1]] : tensor<1x4xi32> into tensor<4xi32>
 // CHECK-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x4xi32>
-// CHECK-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) dimensions = [0]
+// CHECK-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel"]} ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) {
+// CHECK:           linalg.yield
+// CHECK-NEXT:    }
 // CHECK-NEXT:    return %[[V2]] : tensor<4x4xi32>
 func.func public @kernel(%arg0: tensor<1x4xi32>) -> tensor<4x4xi32> {
   %0 = tt.broadcast %arg0 : (tensor<1x4xi32>) -> tensor<4x4xi32>
@@ -21,11 +25,15 @@ func.func public @kernel(%arg0: tensor<1x4xi32>) -> tensor<4x4xi32> {
 
 // -----
 
+// CHECK-DAG: #[[MAP0:.*]] = affine_map<(d0, d1) -> (d0)>
+// CHECK-DAG: #[[MAP1:.*]] = affine_map<(d0, d1) -> (d0, d1)>
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<4x1xi32>) -> tensor<4x4xi32> {
 // CHECK-DAG:     %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1]] : tensor<4x1xi32> into tensor<4xi32>
 // CHECK-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x4xi32>
-// CHECK-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) dimensions = [1]
+// CHECK-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel"]} ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) {
+// CHECK:           linalg.yield
+// CHECK-NEXT:    }
 // CHECK-NEXT:    return %[[V2]] : tensor<4x4xi32>
 func.func public @kernel(%arg0: tensor<4x1xi32>) -> tensor<4x4xi32> {
   %0 = tt.broadcast %arg0 : (tensor<4x1xi32>) -> tensor<4x4xi32>
@@ -34,11 +42,15 @@ func.func public @kernel(%arg0: tensor<4x1xi32>) -> tensor<4x4xi32> {
 
 // -----
 
+// CHECK-DAG: #[[MAP0:.*]] = affine_map<(d0, d1, d2) -> (d1, d2)>
+// CHECK-DAG: #[[MAP1:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<1x1x4xi32>) -> tensor<4x1x4xi32> {
 // CHECK-DAG:     %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1], [2]] : tensor<1x1x4xi32> into tensor<1x4xi32>
 // CHECK-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x1x4xi32>
-// CHECK-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[V0]] : tensor<1x4xi32>) outs(%[[V1]] : tensor<4x1x4xi32>) dimensions = [0]
+// CHECK-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%[[V0]] : tensor<1x4xi32>) outs(%[[V1]] : tensor<4x1x4xi32>) {
+// CHECK:           linalg.yield
+// CHECK-NEXT:    }
 // CHECK-NEXT:    return %[[V2]] : tensor<4x1x4xi32>
 func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<4x1x4xi32> {
   %0 = tt.broadcast %arg0 : (tensor<1x1x4xi32>) -> tensor<4x1x4xi32>
@@ -47,11 +59,15 @@ func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<4x1x4xi32> {
 
 // -----
 
+// CHECK-DAG: #[[MAP0:.*]] = affine_map<(d0, d1, d2) -> (d0, d2)>
+// CHECK-DAG: #[[MAP1:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<1x1x4xi32>) -> tensor<1x4x4xi32> {
 // CHECK-DAG:     %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0], [1, 2]] : tensor<1x1x4xi32> into tensor<1x4xi32>
 // CHECK-DAG:     %[[V1:.*]] = tensor.empty() : tensor<1x4x4xi32>
-// CHECK-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[V0]] : tensor<1x4xi32>) outs(%[[V1]] : tensor<1x4x4xi32>) dimensions = [1]
+// CHECK-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%[[V0]] : tensor<1x4xi32>) outs(%[[V1]] : tensor<1x4x4xi32>) {
+// CHECK:           linalg.yield
+// CHECK-NEXT:    }
 // CHECK-NEXT:    return %[[V2]] : tensor<1x4x4xi32>
 func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<1x4x4xi32> {
   %0 = tt.broadcast %arg0 : (tensor<1x1x4xi32>) -> tensor<1x4x4xi32>
@@ -60,11 +76,15 @@ func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<1x4x4xi32> {
 
 // -----
 
+// CHECK-DAG: #[[MAP0:.*]] = affine_map<(d0, d1, d2) -> (d2)>
+// CHECK-DAG: #[[MAP1:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<1x1x4xi32>) -> tensor<4x4x4xi32> {
 // CHECK-DAG:     %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1, 2]] : tensor<1x1x4xi32> into tensor<4xi32>
 // CHECK-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x4x4xi32>
-// CHECK-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4x4xi32>) dimensions = [0, 1]
+// CHECK-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%[[V0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4x4xi32>) {
+// CHECK:           linalg.yield
+// CHECK-NEXT:    }
 // CHECK-NEXT:    return %[[V2]] : tensor<4x4x4xi32>
 func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<4x4x4xi32> {
   %0 = tt.broadcast %arg0 : (tensor<1x1x4xi32>) -> tensor<4x4x4xi32>
@@ -83,10 +103,14 @@ func.func public @kernel(%arg0: tensor<1x1x4xi32>) -> tensor<1x1x4xi32> {
 
 // -----
 
+// CHECK-CANON-DAG: #[[MAP0:.*]] = affine_map<(d0, d1) -> (d1)>
+// CHECK-CANON-DAG: #[[MAP1:.*]] = affine_map<(d0, d1) -> (d0, d1)>
 // CHECK-CANON-LABEL: func.func public @canonicalize(
 // CHECK-CANON-SAME:      %[[ARG0:.*]]: tensor<4xi32>) -> tensor<4x4xi32> {
 // CHECK-CANON-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x4xi32>
-// CHECK-CANON-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[ARG0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) dimensions = [0]
+// CHECK-CANON-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel"]} ins(%[[ARG0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4xi32>) {
+// CHECK-CANON:           linalg.yield
+// CHECK-CANON-NEXT:    }
 // CHECK-CANON-NEXT:    return %[[V2]] : tensor<4x4xi32>
 func.func public @canonicalize(%arg0: tensor<4xi32>) -> tensor<4x4xi32> {
   %0 = tt.expand_dims %arg0 {axis = 0 : i32} : (tensor<4xi32>) -> tensor<1x4xi32>
@@ -96,10 +120,14 @@ func.func public @canonicalize(%arg0: tensor<4xi32>) -> tensor<4x4xi32> {
 
 // -----
 
+// CHECK-CANON-DAG: #[[MAP0:.*]] = affine_map<(d0, d1, d2) -> (d2)>
+// CHECK-CANON-DAG: #[[MAP1:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
 // CHECK-CANON-LABEL: func.func public @canonicalize(
 // CHECK-CANON-SAME:      %[[ARG0:.*]]: tensor<4xi32>) -> tensor<4x4x4xi32> {
 // CHECK-CANON-DAG:     %[[V1:.*]] = tensor.empty() : tensor<4x4x4xi32>
-// CHECK-CANON-DAG:     %[[V2:.*]] = linalg.broadcast ins(%[[ARG0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4x4xi32>) dimensions = [0, 1]
+// CHECK-CANON-DAG:     %[[V2:.*]] = linalg.generic {indexing_maps = [#[[MAP0]], #[[MAP1]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%[[ARG0]] : tensor<4xi32>) outs(%[[V1]] : tensor<4x4x4xi32>) {
+// CHECK-CANON:           linalg.yield
+// CHECK-CANON-NEXT:    }
 // CHECK-CANON-NEXT:    return %[[V2]] :  tensor<4x4x4xi32>
 func.func public @canonicalize(%arg0: tensor<4xi32>) -> tensor<4x4x4xi32> {
   %0 = tt.expand_dims %arg0 {axis = 0 : i32} : (tensor<4xi32>) -> tensor<1x4xi32>
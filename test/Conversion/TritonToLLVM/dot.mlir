@@ -1,5 +1,6 @@
 // RUN: structured-opt %s \
-// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN:   -convert-triton-to-llvm="vectorize-dot-ops=false" \
+// RUN:   -split-input-file \
 // RUN: | FileCheck %s
 
 // CHECK-LABEL: func.func public @kernel(
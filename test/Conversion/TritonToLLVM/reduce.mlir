@@ -1,18 +1,23 @@
 // RUN: structured-opt %s \
-// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN:   -convert-triton-to-llvm="vectorize-reductions=false" -split-input-file \
 // RUN: | FileCheck %s
 
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<4xi32>) -> i32 {
-// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : i32
-// CHECK-DAG:     %[[V1:.*]] = tensor.splat %[[V0]] : tensor<i32>
-// CHECK-NEXT:    %[[V2:.*]] = linalg.reduce ins(%[[ARG0]] : tensor<4xi32>) outs(%[[V1]] : tensor<i32>) dimensions = [0]
-// CHECK-DAG:       (%[[ARG1:.*]]: i32, %[[ARG2:.*]]: i32) {
-// CHECK-DAG:         %[[V3:.*]] = arith.addi %[[ARG1]], %[[ARG2]] : i32
-// CHECK-DAG:         linalg.yield %[[V3]] : i32
-// CHECK-NEXT:      }
-// CHECK-DAG:     %[[V4:.*]] = tensor.extract %[[V2]][] : tensor<i32>
-// CHECK-DAG:     return %[[V4]] : i32
+// CHECK-DAG:     %[[V0:.*]] = tensor.extract_slice %[[ARG0]][0] [2] [1] : tensor<4xi32> to tensor<2xi32>
+// CHECK-DAG:     %[[V1:.*]] = tensor.extract_slice %[[ARG0]][2] [2] [1] : tensor<4xi32> to tensor<2xi32>
+// CHECK-DAG:     %[[V2:.*]] = tensor.empty() : tensor<2xi32>
+// CHECK:         %[[V3:.*]] = linalg.generic {{.*}} ins(%[[V0]], %[[V1]] : tensor<2xi32>, tensor<2xi32>) outs(%[[V2]] : tensor<2xi32>) {
+// CHECK-NEXT:    ^bb0(%[[ARG1:.*]]: i32, %[[ARG2:.*]]: i32, %{{.*}}: i32):
+// CHECK-NEXT:      %[[V4:.*]] = arith.addi %[[ARG1]], %[[ARG2]] : i32
+// CHECK-NEXT:      linalg.yield %[[V4]] : i32
+// CHECK-NEXT:    } -> tensor<2xi32>
+// CHECK-DAG:     %[[V5:.*]] = tensor.extract_slice %[[V3]][0] [1] [1] : tensor<2xi32> to tensor<1xi32>
+// CHECK-DAG:     %[[V6:.*]] = tensor.extract_slice %[[V3]][1] [1] [1] : tensor<2xi32> to tensor<1xi32>
+// CHECK:         %[[V7:.*]] = linalg.generic {{.*}} ins(%[[V5]], %[[V6]] : tensor<1xi32>, tensor<1xi32>)
+// CHECK:         } -> tensor<1xi32>
+// CHECK:         %[[V8:.*]] = tensor.extract %[[V7]][%{{.*}}] : tensor<1xi32>
+// CHECK-NEXT:    return %[[V8]] : i32
 func.func public @kernel(%arg0: tensor<4xi32>) -> i32 {
   %1 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
   ^bb0(%arg1: i32, %arg2: i32):
@@ -26,14 +31,16 @@ func.func public @kernel(%arg0: tensor<4xi32>) -> i32 {
 
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<2x2xi32>) -> tensor<2xi32> {
-// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : i32
-// CHECK-DAG:     %[[V1:.*]] = tensor.splat %[[V0]] : tensor<2xi32>
-// CHECK-NEXT:    %[[V2:.*]] = linalg.reduce ins(%[[ARG0]] : tensor<2x2xi32>) outs(%[[V1]] : tensor<2xi32>) dimensions = [0]
-// CHECK-DAG:       (%[[ARG1:.*]]: i32, %[[ARG2:.*]]: i32) {
-// CHECK-DAG:         %[[V3:.*]] = arith.addi %[[ARG1]], %[[ARG2]] : i32
-// CHECK-DAG:         linalg.yield %[[V3]] : i32
-// CHECK-NEXT:      }
-// CHECK-DAG:     return %[[V2]] : tensor<2xi32>
+// CHECK-DAG:     %[[V0:.*]] = tensor.extract_slice %[[ARG0]][0, 0] [1, 2] [1, 1] : tensor<2x2xi32> to tensor<1x2xi32>
+// CHECK-DAG:     %[[V1:.*]] = tensor.extract_slice %[[ARG0]][1, 0] [1, 2] [1, 1] : tensor<2x2xi32> to tensor<1x2xi32>
+// CHECK-DAG:     %[[V2:.*]] = tensor.empty() : tensor<1x2xi32>
+// CHECK:         %[[V3:.*]] = linalg.generic {{.*}} ins(%[[V0]], %[[V1]] : tensor<1x2xi32>, tensor<1x2xi32>) outs(%[[V2]] : tensor<1x2xi32>) {
+// CHECK-NEXT:    ^bb0(%[[ARG1:.*]]: i32, %[[ARG2:.*]]: i32, %{{.*}}: i32):
+// CHECK-NEXT:      %[[V4:.*]] = arith.addi %[[ARG1]], %[[ARG2]] : i32
+// CHECK-NEXT:      linalg.yield %[[V4]] : i32
+// CHECK-NEXT:    } -> tensor<1x2xi32>
+// CHECK-NEXT:    %[[V5:.*]] = tensor.extract_slice %[[V3]][0, 0] [1, 2] [1, 1] : tensor<1x2xi32> to tensor<2xi32>
+// CHECK-NEXT:    return %[[V5]] : tensor<2xi32>
 func.func public @kernel(%arg0: tensor<2x2xi32>) -> tensor<2xi32> {
   %1 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
   ^bb0(%arg1: i32, %arg2: i32):
@@ -50,17 +57,21 @@ func.func public @kernel(%arg0: tensor<2x2xi32>) -> tensor<2xi32> {
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<2x2xi32>,
 // CHECK-SAME:      %[[ARG1:.*]]: tensor<2x2xf32>
 // CHECK-SAME:    ) -> (tensor<2xi32>, tensor<2xf32>) {
-// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : i32
-// CHECK-DAG:     %[[V1:.*]] = tensor.splat %[[V0]] : tensor<2xi32>
-// CHECK-DAG:     %[[V2:.*]] = arith.constant 0.000000e+00 : f32
-// CHECK-DAG:     %[[V3:.*]] = tensor.splat %[[V2]] : tensor<2xf32>
-// CHECK-NEXT:    %[[V4:.*]]:2 = linalg.reduce ins(%[[ARG0]], %[[ARG1]] : tensor<2x2xi32>, tensor<2x2xf32>) outs(%[[V1]], %[[V3]] : tensor<2xi32>, tensor<2xf32>) dimensions = [0]
-// CHECK-DAG:       (%[[ARG2:.*]]: i32, %[[ARG3:.*]]: f32, %[[ARG4:.*]]: i32, %[[ARG5:.*]]: f32) {
-// CHECK-DAG:         %[[V0:.*]] = arith.addi %[[ARG2]], %[[ARG4]] : i32
-// CHECK-DAG:         %[[V1:.*]] = arith.addf %[[ARG3]], %[[ARG5]] : f32
-// CHECK-DAG:         linalg.yield %[[V0]], %[[V1]] : i32, f32
-// CHECK-NEXT:      }
-// CHECK-DAG:     return %[[V4]]#0, %[[V4]]#1 : tensor<2xi32>, tensor<2xf32>
+// CHECK-DAG:     %[[V0:.*]] = tensor.extract_slice %[[ARG0]][0, 0] [1, 2] [1, 1] : tensor<2x2xi32> to tensor<1x2xi32>
+// CHECK-DAG:     %[[V1:.*]] = tensor.extract_slice %[[ARG1]][0, 0] [1, 2] [1, 1] : tensor<2x2xf32> to tensor<1x2xf32>
+// CHECK-DAG:     %[[V2:.*]] = tensor.extract_slice %[[ARG0]][1, 0] [1, 2] [1, 1] : tensor<2x2xi32> to tensor<1x2xi32>
+// CHECK-DAG:     %[[V3:.*]] = tensor.extract_slice %[[ARG1]][1, 0] [1, 2] [1, 1] : tensor<2x2xf32> to tensor<1x2xf32>
+// CHECK-DAG:     %[[V4:.*]] = tensor.empty() : tensor<1x2xi32>
+// CHECK-DAG:     %[[V5:.*]] = tensor.empty() : tensor<1x2xf32>
+// CHECK:         %[[V6:.*]]:2 = linalg.generic {{.*}} ins(%[[V0]], %[[V1]], %[[V2]], %[[V3]] : tensor<1x2xi32>, tensor<1x2xf32>, tensor<1x2xi32>, tensor<1x2xf32>) outs(%[[V4]], %[[V5]] : tensor<1x2xi32>, tensor<1x2xf32>) {
+// CHECK-NEXT:    ^bb0(%[[ARG2:.*]]: i32, %[[ARG3:.*]]: f32, %[[ARG4:.*]]: i32, %[[ARG5:.*]]: f32, %{{.*}}: i32, %{{.*}}: f32):
+// CHECK-DAG:       %[[V7:.*]] = arith.addi %[[ARG2]], %[[ARG4]] : i32
+// CHECK-DAG:       %[[V8:.*]] = arith.addf %[[ARG3]], %[[ARG5]] : f32
+// CHECK-NEXT:      linalg.yield %[[V7]], %[[V8]] : i32, f32
+// CHECK-NEXT:    } -> (tensor<1x2xi32>, tensor<1x2xf32>)
+// CHECK-DAG:     %[[V9:.*]] = tensor.extract_slice %[[V6]]#0[0, 0] [1, 2] [1, 1] : tensor<1x2xi32> to tensor<2xi32>
+// CHECK-DAG:     %[[V10:.*]] = tensor.extract_slice %[[V6]]#1[0, 0] [1, 2] [1, 1] : tensor<1x2xf32> to tensor<2xf32>
+// CHECK-NEXT:    return %[[V9]], %[[V10]] : tensor<2xi32>, tensor<2xf32>
 func.func public @kernel(%arg0: tensor<2x2xi32>, %arg1: tensor<2x2xf32>) -> (tensor<2xi32>, tensor<2xf32>) {
   %1:2 = "tt.reduce"(%arg0, %arg1) <{axis = 0 : i32}> ({
   ^bb0(%arg2: i32, %arg3: f32, %arg4: i32, %arg5: f32):
@@ -70,3 +81,28 @@ func.func public @kernel(%arg0: tensor<2x2xi32>, %arg1: tensor<2x2xf32>) -> (ten
   }) : (tensor<2x2xi32>, tensor<2x2xf32>) -> (tensor<2xi32>, tensor<2xf32>)
   return %1#0, %1#1 : tensor<2xi32>, tensor<2xf32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<3xf32>) -> f32 {
+// CHECK-DAG:     %[[V0:.*]] = tensor.extract_slice %[[ARG0]][0] [1] [1] : tensor<3xf32> to tensor<1xf32>
+// CHECK-DAG:     %[[V1:.*]] = tensor.extract_slice %[[ARG0]][2] [1] [1] : tensor<3xf32> to tensor<1xf32>
+// CHECK:         %[[V2:.*]] = linalg.generic {{.*}} ins(%[[V0]], %[[V1]] : tensor<1xf32>, tensor<1xf32>)
+// CHECK:           arith.maxf
+// CHECK:         } -> tensor<1xf32>
+// CHECK-NEXT:    %[[V3:.*]] = tensor.extract_slice %[[ARG0]][0] [2] [1] : tensor<3xf32> to tensor<2xf32>
+// CHECK-NEXT:    %[[V4:.*]] = tensor.insert_slice %[[V2]] into %[[V3]][0] [1] [1] : tensor<1xf32> into tensor<2xf32>
+// CHECK-DAG:     %[[V5:.*]] = tensor.extract_slice %[[V4]][0] [1] [1] : tensor<2xf32> to tensor<1xf32>
+// CHECK-DAG:     %[[V6:.*]] = tensor.extract_slice %[[V4]][1] [1] [1] : tensor<2xf32> to tensor<1xf32>
+// CHECK:         %[[V7:.*]] = linalg.generic {{.*}} ins(%[[V5]], %[[V6]] : tensor<1xf32>, tensor<1xf32>)
+// CHECK:         %[[V8:.*]] = tensor.extract %[[V7]][%{{.*}}] : tensor<1xf32>
+// CHECK-NEXT:    return %[[V8]] : f32
+func.func public @kernel(%arg0: tensor<3xf32>) -> f32 {
+  %1 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
+  ^bb0(%arg1: f32, %arg2: f32):
+    %2 = arith.maxf %arg1, %arg2 : f32
+    tt.reduce.return %2 : f32
+  }) : (tensor<3xf32>) -> f32
+  return %1 : f32
+}
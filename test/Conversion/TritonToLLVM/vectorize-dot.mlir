@@ -0,0 +1,69 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN: | FileCheck %s
+// RUN: structured-opt %s \
+// RUN:   -convert-triton-to-llvm="dot-tile-sizes=2,8,4" -split-input-file \
+// RUN: | FileCheck %s --check-prefix=TILES
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<8x8xf32>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<8x32xf32>,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<8x32xf32>) -> tensor<8x32xf32> {
+// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : index
+// CHECK-DAG:     %[[V1:.*]] = arith.constant 8 : index
+// CHECK-DAG:     %[[V2:.*]] = arith.constant 32 : index
+// CHECK-DAG:     %[[V3:.*]] = arith.constant 4 : index
+// CHECK-DAG:     %[[V4:.*]] = arith.constant 16 : index
+// CHECK:         %[[V5:.*]] = scf.for %[[ARG3:.*]] = %[[V0]] to %[[V1]] step %[[V3]] iter_args(%[[ARG4:.*]] = %[[ARG2]]) -> (tensor<8x32xf32>) {
+// CHECK-NEXT:      %[[V6:.*]] = scf.for %[[ARG5:.*]] = %[[V0]] to %[[V2]] step %[[V4]] iter_args(%[[ARG6:.*]] = %[[ARG4]]) -> (tensor<8x32xf32>) {
+// CHECK:             %[[V7:.*]] = vector.transfer_read %[[ARG6]][%[[ARG3]], %[[ARG5]]], %{{.*}} {in_bounds = [true, true]} : tensor<8x32xf32>, vector<4x16xf32>
+// CHECK-NEXT:        %[[V8:.*]] = scf.for %[[ARG7:.*]] = %[[V0]] to %{{.*}} step %{{.*}} iter_args(%[[ARG8:.*]] = %[[V7]]) -> (vector<4x16xf32>) {
+// CHECK:               %[[V9:.*]] = vector.transfer_read %[[ARG0]][%[[ARG3]], %[[ARG7]]], %{{.*}} {in_bounds = [true, true]} : tensor<8x8xf32>, vector<4x4xf32>
+// CHECK:               %[[V10:.*]] = vector.transfer_read %[[ARG1]][%[[ARG7]], %[[ARG5]]], %{{.*}} {in_bounds = [true, true]} : tensor<8x32xf32>, vector<4x16xf32>
+// CHECK-NEXT:          %[[V11:.*]] = vector.contract {{.*}} %[[V9]], %[[V10]], %[[ARG8]] : vector<4x4xf32>, vector<4x16xf32> into vector<4x16xf32>
+// CHECK-NEXT:          scf.yield %[[V11]] : vector<4x16xf32>
+// CHECK-NEXT:        }
+// CHECK-NEXT:        %[[V12:.*]] = vector.transfer_write %[[V8]], %[[ARG6]][%[[ARG3]], %[[ARG5]]] {in_bounds = [true, true]} : vector<4x16xf32>, tensor<8x32xf32>
+// CHECK-NEXT:        scf.yield %[[V12]] : tensor<8x32xf32>
+// CHECK-NEXT:      }
+// CHECK-NEXT:      scf.yield %[[V6]] : tensor<8x32xf32>
+// CHECK-NEXT:    }
+// CHECK-NEXT:    return %[[V5]] : tensor<8x32xf32>
+// TILES-LABEL: func.func public @kernel(
+// TILES:         vector.transfer_read {{.*}} : tensor<8x32xf32>, vector<2x8xf32>
+// TILES:           vector.transfer_read {{.*}} : tensor<8x8xf32>, vector<2x4xf32>
+// TILES:           vector.transfer_read {{.*}} : tensor<8x32xf32>, vector<4x8xf32>
+// TILES-NEXT:      vector.contract {{.*}} : vector<2x4xf32>, vector<4x8xf32> into vector<2x8xf32>
+func.func public @kernel(%arg0: tensor<8x8xf32>, %arg1: tensor<8x32xf32>, %arg2: tensor<8x32xf32>) -> tensor<8x32xf32> {
+  %0 = tt.dot %arg0, %arg1, %arg2 {allowTF32 = true} : tensor<8x8xf32> * tensor<8x32xf32> -> tensor<8x32xf32>
+  return %0 : tensor<8x32xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<4x4xf16>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4x16xbf16>,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<4x16xf32>) -> tensor<4x16xf32> {
+// CHECK:         %[[V0:.*]] = vector.transfer_read %[[ARG0]]{{.*}} : tensor<4x4xf16>, vector<4x4xf16>
+// CHECK-NEXT:    %[[V1:.*]] = arith.extf %[[V0]] : vector<4x4xf16> to vector<4x4xf32>
+// CHECK:         %[[V2:.*]] = vector.transfer_read %[[ARG1]]{{.*}} : tensor<4x16xbf16>, vector<4x16xbf16>
+// CHECK-NEXT:    %[[V3:.*]] = arith.extf %[[V2]] : vector<4x16xbf16> to vector<4x16xf32>
+// CHECK-NEXT:    vector.contract {{.*}} %[[V1]], %[[V3]], %{{.*}} : vector<4x4xf32>, vector<4x16xf32> into vector<4x16xf32>
+func.func public @kernel(%arg0: tensor<4x4xf16>, %arg1: tensor<4x16xbf16>, %arg2: tensor<4x16xf32>) -> tensor<4x16xf32> {
+  %0 = tt.dot %arg0, %arg1, %arg2 {allowTF32 = true} : tensor<4x4xf16> * tensor<4x16xbf16> -> tensor<4x16xf32>
+  return %0 : tensor<4x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<6x4xf32>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4x8xf32>,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<6x8xf32>) -> tensor<6x8xf32> {
+// CHECK-DAG:     %[[V0:.*]] = linalg.matmul ins(%[[ARG0]], %[[ARG1]] : tensor<6x4xf32>, tensor<4x8xf32>) outs(%[[ARG2]] : tensor<6x8xf32>) -> tensor<6x8xf32>
+// CHECK-NEXT:    return %[[V0]] : tensor<6x8xf32>
+func.func public @kernel(%arg0: tensor<6x4xf32>, %arg1: tensor<4x8xf32>, %arg2: tensor<6x8xf32>) -> tensor<6x8xf32> {
+  %0 = tt.dot %arg0, %arg1, %arg2 {allowTF32 = true} : tensor<6x4xf32> * tensor<4x8xf32> -> tensor<6x8xf32>
+  return %0 : tensor<6x8xf32>
+}
@@ -0,0 +1,106 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN: | FileCheck %s
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: !llvm.ptr<f32, 1>,
+// CHECK-SAME:      %[[ARG1:.*]]: i32) -> tensor<4xf32> {
+// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : i32
+// CHECK-DAG:     %[[V1:.*]] = arith.addi %[[ARG1]], %[[V0]] : i32
+// CHECK-DAG:     %[[V2:.*]] = llvm.getelementptr %[[ARG0]][%[[V1]]] : (!llvm.ptr<f32, 1>, i32) -> !llvm.ptr<f32, 1>
+// CHECK-DAG:     %[[V3:.*]] = llvm.bitcast %[[V2]] : !llvm.ptr<f32, 1> to !llvm.ptr<vector<4xf32>, 1>
+// CHECK-DAG:     %[[V4:.*]] = llvm.load %[[V3]] {alignment = 4 : i64} : !llvm.ptr<vector<4xf32>, 1>
+// CHECK-DAG:     %[[V5:.*]] = tensor.empty() : tensor<4xf32>
+// CHECK-DAG:     %[[V6:.*]] = vector.transfer_write %[[V4]], %[[V5]][%{{.*}}] {in_bounds = [true]} : vector<4xf32>, tensor<4xf32>
+// CHECK:         return %[[V6]] : tensor<4xf32>
+func.func public @kernel(%arg0: !tt.ptr<f32>, %arg1: i32) -> tensor<4xf32> {
+  %0 = tt.make_range {start = 0 : i32, end = 4 : i32} : tensor<4xi32>
+  %1 = tt.splat %arg1 : (i32) -> tensor<4xi32>
+  %2 = arith.addi %1, %0 : tensor<4xi32>
+  %3 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<4x!tt.ptr<f32>>
+  %4 = tt.addptr %3, %2 : tensor<4x!tt.ptr<f32>>, tensor<4xi32>
+  %5 = tt.load %4 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<4xf32>
+  return %5 : tensor<4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: !llvm.ptr<i32, 1>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4xi1>,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<4xi32>) -> tensor<4xi32> {
+// CHECK-DAG:     %[[V0:.*]] = arith.constant 8 : i32
+// CHECK-DAG:     %[[V1:.*]] = llvm.getelementptr %[[ARG0]][%[[V0]]] : (!llvm.ptr<i32, 1>, i32) -> !llvm.ptr<i32, 1>
+// CHECK-DAG:     %[[V2:.*]] = llvm.bitcast %[[V1]] : !llvm.ptr<i32, 1> to !llvm.ptr<vector<4xi32>, 1>
+// CHECK-DAG:     %[[V3:.*]] = vector.transfer_read %[[ARG1]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xi1>, vector<4xi1>
+// CHECK-DAG:     %[[V4:.*]] = vector.transfer_read %[[ARG2]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xi32>, vector<4xi32>
+// CHECK-DAG:     %[[V5:.*]] = llvm.intr.masked.load %[[V2]], %[[V3]], %[[V4]] {alignment = 4 : i32} : (!llvm.ptr<vector<4xi32>, 1>, vector<4xi1>, vector<4xi32>) -> vector<4xi32>
+// CHECK-DAG:     %[[V6:.*]] = vector.transfer_write %[[V5]], %{{.*}}[%{{.*}}] {in_bounds = [true]} : vector<4xi32>, tensor<4xi32>
+// CHECK:         return %[[V6]] : tensor<4xi32>
+func.func public @kernel(%arg0: !tt.ptr<i32>, %arg1: tensor<4xi1>, %arg2: tensor<4xi32>) -> tensor<4xi32> {
+  %0 = tt.make_range {start = 8 : i32, end = 12 : i32} : tensor<4xi32>
+  %1 = tt.splat %arg0 : (!tt.ptr<i32>) -> tensor<4x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<4x!tt.ptr<i32>>, tensor<4xi32>
+  %3 = tt.load %2, %arg1, %arg2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<4xi32>
+  return %3 : tensor<4xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<4xindex>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4xi1>) -> tensor<4xi32> {
+// CHECK-DAG:     %[[V0:.*]] = vector.transfer_read %[[ARG1]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xi1>, vector<4xi1>
+// CHECK-DAG:     %[[V1:.*]] = llvm.mlir.undef : vector<4xi32>
+// CHECK-DAG:     %[[V2:.*]] = vector.transfer_read %[[ARG0]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xindex>, vector<4xindex>
+// CHECK-DAG:     %[[V3:.*]] = arith.index_cast %[[V2]] : vector<4xindex> to vector<4xi64>
+// CHECK-DAG:     %[[V4:.*]] = llvm.inttoptr %[[V3]] : vector<4xi64> to !llvm.vec<4 x ptr<i32, 1>>
+// CHECK-DAG:     %[[V5:.*]] = llvm.intr.masked.gather %[[V4]], %[[V0]], %[[V1]] {alignment = 4 : i32} : (!llvm.vec<4 x ptr<i32, 1>>, vector<4xi1>, vector<4xi32>) -> vector<4xi32>
+// CHECK-DAG:     %[[V6:.*]] = vector.transfer_write %[[V5]], %{{.*}}[%{{.*}}] {in_bounds = [true]} : vector<4xi32>, tensor<4xi32>
+// CHECK:         return %[[V6]] : tensor<4xi32>
+func.func public @kernel(%arg0: tensor<4x!tt.ptr<i32>>, %arg1: tensor<4xi1>) -> tensor<4xi32> {
+  %0 = tt.load %arg0, %arg1 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<4xi32>
+  return %0 : tensor<4xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: !llvm.ptr<f64, 1>,
+// CHECK-SAME:      %[[ARG1:.*]]: i32,
+// CHECK-SAME:      %[[ARG2:.*]]: tensor<4xf64>,
+// CHECK-SAME:      %[[ARG3:.*]]: tensor<4xi1>) {
+// CHECK-DAG:     %[[V0:.*]] = arith.constant 0 : i32
+// CHECK-DAG:     %[[V1:.*]] = arith.addi %[[ARG1]], %[[V0]] : i32
+// CHECK-DAG:     %[[V2:.*]] = llvm.getelementptr %[[ARG0]][%[[V1]]] : (!llvm.ptr<f64, 1>, i32) -> !llvm.ptr<f64, 1>
+// CHECK-DAG:     %[[V3:.*]] = llvm.bitcast %[[V2]] : !llvm.ptr<f64, 1> to !llvm.ptr<vector<4xf64>, 1>
+// CHECK-DAG:     %[[V4:.*]] = vector.transfer_read %[[ARG2]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xf64>, vector<4xf64>
+// CHECK-DAG:     %[[V5:.*]] = vector.transfer_read %[[ARG3]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xi1>, vector<4xi1>
+// CHECK-DAG:     llvm.intr.masked.store %[[V4]], %[[V3]], %[[V5]] {alignment = 8 : i32} : vector<4xf64>, vector<4xi1> into !llvm.ptr<vector<4xf64>, 1>
+// CHECK:         return
+func.func public @kernel(%arg0: !tt.ptr<f64>, %arg1: i32, %arg2: tensor<4xf64>, %arg3: tensor<4xi1>) {
+  %0 = tt.make_range {start = 0 : i32, end = 4 : i32} : tensor<4xi32>
+  %1 = tt.splat %arg1 : (i32) -> tensor<4xi32>
+  %2 = arith.addi %0, %1 : tensor<4xi32>
+  %3 = tt.splat %arg0 : (!tt.ptr<f64>) -> tensor<4x!tt.ptr<f64>>
+  %4 = tt.addptr %3, %2 : tensor<4x!tt.ptr<f64>>, tensor<4xi32>
+  tt.store %4, %arg2, %arg3 {cache = 1 : i32, evict = 1 : i32} : tensor<4xf64>
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<4xindex>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<4xi32>) {
+// CHECK-DAG:     %[[V0:.*]] = vector.transfer_read %[[ARG1]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xi32>, vector<4xi32>
+// CHECK-DAG:     %[[V1:.*]] = arith.constant dense<true> : vector<4xi1>
+// CHECK-DAG:     %[[V2:.*]] = vector.transfer_read %[[ARG0]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<4xindex>, vector<4xindex>
+// CHECK-DAG:     %[[V3:.*]] = arith.index_cast %[[V2]] : vector<4xindex> to vector<4xi64>
+// CHECK-DAG:     %[[V4:.*]] = llvm.inttoptr %[[V3]] : vector<4xi64> to !llvm.vec<4 x ptr<i32, 1>>
+// CHECK-DAG:     llvm.intr.masked.scatter %[[V0]], %[[V4]], %[[V1]] {alignment = 4 : i32} : vector<4xi32>, vector<4xi1> into !llvm.vec<4 x ptr<i32, 1>>
+// CHECK:         return
+func.func public @kernel(%arg0: tensor<4x!tt.ptr<i32>>, %arg1: tensor<4xi32>) {
+  tt.store %arg0, %arg1 {cache = 1 : i32, evict = 1 : i32} : tensor<4xi32>
+  return
+}
@@ -0,0 +1,171 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-triton-to-llvm -split-input-file \
+// RUN: | FileCheck %s
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<8xf32>) -> f32 {
+// CHECK:         %[[V0:.*]] = vector.transfer_read %[[ARG0]][%{{.*}}], %{{.*}} {in_bounds = [true]} : tensor<8xf32>, vector<8xf32>
+// CHECK-NEXT:    %[[V1:.*]] = vector.shape_cast %[[V0]] : vector<8xf32> to vector<1x8xf32>
+// CHECK-NEXT:    %[[V2:.*]] = vector.extract %[[V1]][0] : vector<1x8xf32>
+// CHECK-NEXT:    %[[V3:.*]] = vector.reduction <add>, %[[V2]] : vector<8xf32> into f32
+// CHECK-NEXT:    return %[[V3]] : f32
+func.func public @kernel(%arg0: tensor<8xf32>) -> f32 {
+  %0 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
+  ^bb0(%arg1: f32, %arg2: f32):
+    %1 = arith.addf %arg1, %arg2 : f32
+    tt.reduce.return %1 : f32
+  }) : (tensor<8xf32>) -> f32
+  return %0 : f32
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<2x8xf32>) -> tensor<2xf32> {
+// CHECK:         %[[V0:.*]] = vector.transfer_read %[[ARG0]][%{{.*}}, %{{.*}}], %{{.*}} {in_bounds = [true, true]} : tensor<2x8xf32>, vector<2x8xf32>
+// CHECK-NEXT:    %[[V1:.*]] = vector.shape_cast %[[V0]] : vector<2x8xf32> to vector<2x8xf32>
+// CHECK-NEXT:    %[[V2:.*]] = vector.extract %[[V1]][0] : vector<2x8xf32>
+// CHECK-NEXT:    %[[V3:.*]] = vector.extract %[[V1]][1] : vector<2x8xf32>
+// CHECK-NEXT:    %[[V4:.*]] = arith.constant dense<0xFF800000> : vector<2xf32>
+// CHECK-NEXT:    %[[V5:.*]] = vector.reduction <maxf>, %[[V2]] : vector<8xf32> into f32
+// CHECK-NEXT:    %[[V6:.*]] = vector.insert %[[V5]], %[[V4]] [0] : f32 into vector<2xf32>
+// CHECK-NEXT:    %[[V7:.*]] = vector.reduction <maxf>, %[[V3]] : vector<8xf32> into f32
+// CHECK-NEXT:    %[[V8:.*]] = vector.insert %[[V7]], %[[V6]] [1] : f32 into vector<2xf32>
+// CHECK-NEXT:    %[[V9:.*]] = vector.shape_cast %[[V8]] : vector<2xf32> to vector<2xf32>
+// CHECK-NEXT:    %[[V10:.*]] = tensor.empty() : tensor<2xf32>
+// CHECK:         %[[V11:.*]] = vector.transfer_write %[[V9]], %[[V10]][%{{.*}}] {in_bounds = [true]} : vector<2xf32>, tensor<2xf32>
+// CHECK-NEXT:    return %[[V11]] : tensor<2xf32>
+func.func public @kernel(%arg0: tensor<2x8xf32>) -> tensor<2xf32> {
+  %0 = "tt.reduce"(%arg0) <{axis = 1 : i32}> ({
+  ^bb0(%arg1: f32, %arg2: f32):
+    %1 = arith.maxf %arg1, %arg2 : f32
+    tt.reduce.return %1 : f32
+  }) : (tensor<2x8xf32>) -> tensor<2xf32>
+  return %0 : tensor<2xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<3x8xi32>) -> tensor<8xi32> {
+// CHECK:         %[[V0:.*]] = vector.transfer_read %[[ARG0]]{{.*}} : tensor<3x8xi32>, vector<3x8xi32>
+// CHECK-NEXT:    %[[V1:.*]] = vector.shape_cast %[[V0]] : vector<3x8xi32> to vector<3x8xi32>
+// CHECK-NEXT:    %[[V2:.*]] = vector.extract %[[V1]][0] : vector<3x8xi32>
+// CHECK-NEXT:    %[[V3:.*]] = vector.extract %[[V1]][1] : vector<3x8xi32>
+// CHECK-NEXT:    %[[V4:.*]] = vector.extract %[[V1]][2] : vector<3x8xi32>
+// CHECK-NEXT:    %[[V5:.*]] = arith.addi %[[V2]], %[[V3]] : vector<8xi32>
+// CHECK-NEXT:    %[[V6:.*]] = arith.addi %[[V5]], %[[V4]] : vector<8xi32>
+// CHECK-NEXT:    %[[V7:.*]] = vector.shape_cast %[[V6]] : vector<8xi32> to vector<8xi32>
+// CHECK:         vector.transfer_write %[[V7]]
+func.func public @kernel(%arg0: tensor<3x8xi32>) -> tensor<8xi32> {
+  %0 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
+  ^bb0(%arg1: i32, %arg2: i32):
+    %1 = arith.addi %arg2, %arg1 : i32
+    tt.reduce.return %1 : i32
+  }) : (tensor<3x8xi32>) -> tensor<8xi32>
+  return %0 : tensor<8xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<2x4x8xi32>) -> tensor<2x8xi32> {
+// CHECK:         %[[V0:.*]] = vector.transfer_read %[[ARG0]]{{.*}} : tensor<2x4x8xi32>, vector<2x4x8xi32>
+// CHECK-NEXT:    %[[V1:.*]] = vector.transpose %[[V0]], [1, 0, 2] : vector<2x4x8xi32> to vector<4x2x8xi32>
+// CHECK-NEXT:    %[[V2:.*]] = vector.shape_cast %[[V1]] : vector<4x2x8xi32> to vector<4x16xi32>
+// CHECK-NEXT:    %[[V3:.*]] = vector.extract %[[V2]][0] : vector<4x16xi32>
+// CHECK-NEXT:    %[[V4:.*]] = vector.extract %[[V2]][1] : vector<4x16xi32>
+// CHECK-NEXT:    %[[V5:.*]] = vector.extract %[[V2]][2] : vector<4x16xi32>
+// CHECK-NEXT:    %[[V6:.*]] = vector.extract %[[V2]][3] : vector<4x16xi32>
+// CHECK-NEXT:    %[[V7:.*]] = arith.minsi %[[V3]], %[[V4]] : vector<16xi32>
+// CHECK-NEXT:    %[[V8:.*]] = arith.minsi %[[V5]], %[[V6]] : vector<16xi32>
+// CHECK-NEXT:    %[[V9:.*]] = arith.minsi %[[V7]], %[[V8]] : vector<16xi32>
+// CHECK-NEXT:    %[[V10:.*]] = vector.shape_cast %[[V9]] : vector<16xi32> to vector<2x8xi32>
+// CHECK:         vector.transfer_write %[[V10]]
+func.func public @kernel(%arg0: tensor<2x4x8xi32>) -> tensor<2x8xi32> {
+  %0 = "tt.reduce"(%arg0) <{axis = 1 : i32}> ({
+  ^bb0(%arg1: i32, %arg2: i32):
+    %1 = arith.cmpi slt, %arg1, %arg2 : i32
+    %2 = arith.select %1, %arg1, %arg2 : i32
+    tt.reduce.return %2 : i32
+  }) : (tensor<2x4x8xi32>) -> tensor<2x8xi32>
+  return %0 : tensor<2x8xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<8xf32>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<8xi32>) -> (f32, i32) {
+// CHECK-DAG:     %[[V0:.*]] = vector.transfer_read %[[ARG0]]{{.*}} : tensor<8xf32>, vector<8xf32>
+// CHECK-DAG:     %[[V1:.*]] = vector.shape_cast %[[V0]] : vector<8xf32> to vector<1x8xf32>
+// CHECK-DAG:     %[[V2:.*]] = vector.extract %[[V1]][0] : vector<1x8xf32>
+// CHECK-DAG:     %[[V3:.*]] = vector.transfer_read %[[ARG1]]{{.*}} : tensor<8xi32>, vector<8xi32>
+// CHECK-DAG:     %[[V4:.*]] = vector.shape_cast %[[V3]] : vector<8xi32> to vector<1x8xi32>
+// CHECK-DAG:     %[[V5:.*]] = vector.extract %[[V4]][0] : vector<1x8xi32>
+// CHECK-DAG:     %[[V6:.*]] = vector.reduction <maxf>, %[[V2]] : vector<8xf32> into f32
+// CHECK-DAG:     %[[V7:.*]] = vector.broadcast %[[V6]] : f32 to vector<8xf32>
+// CHECK-DAG:     %[[V8:.*]] = arith.cmpf oeq, %[[V2]], %[[V7]] : vector<8xf32>
+// CHECK-DAG:     %[[V9:.*]] = arith.constant dense<2147483647> : vector<8xi32>
+// CHECK-DAG:     %[[V10:.*]] = arith.select %[[V8]], %[[V5]], %[[V9]] : vector<8xi1>, vector<8xi32>
+// CHECK-DAG:     %[[V11:.*]] = vector.reduction <minsi>, %[[V10]] : vector<8xi32> into i32
+// CHECK:         return %[[V6]], %[[V11]] : f32, i32
+func.func public @kernel(%arg0: tensor<8xf32>, %arg1: tensor<8xi32>) -> (f32, i32) {
+  %0:2 = "tt.reduce"(%arg0, %arg1) <{axis = 0 : i32}> ({
+  ^bb0(%arg2: f32, %arg3: i32, %arg4: f32, %arg5: i32):
+    %1 = arith.cmpf oeq, %arg2, %arg4 : f32
+    %2 = arith.cmpi slt, %arg3, %arg5 : i32
+    %3 = arith.andi %1, %2 : i1
+    %4 = arith.cmpf ogt, %arg2, %arg4 : f32
+    %5 = arith.ori %4, %3 : i1
+    %6 = arith.select %5, %arg2, %arg4 : f32
+    %7 = arith.select %5, %arg3, %arg5 : i32
+    tt.reduce.return %6, %7 : f32, i32
+  }) : (tensor<8xf32>, tensor<8xi32>) -> (f32, i32)
+  return %0#0, %0#1 : f32, i32
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<2x4xf32>,
+// CHECK-SAME:      %[[ARG1:.*]]: tensor<2x4xi32>) -> (tensor<4xf32>, tensor<4xi32>) {
+// CHECK-DAG:     %[[V0:.*]] = vector.extract %{{.*}}[0] : vector<2x4xf32>
+// CHECK-DAG:     %[[V1:.*]] = vector.extract %{{.*}}[1] : vector<2x4xf32>
+// CHECK-DAG:     %[[V2:.*]] = vector.extract %{{.*}}[0] : vector<2x4xi32>
+// CHECK-DAG:     %[[V3:.*]] = vector.extract %{{.*}}[1] : vector<2x4xi32>
+// CHECK-DAG:     %[[V4:.*]] = arith.cmpf olt, %[[V0]], %[[V1]] : vector<4xf32>
+// CHECK-DAG:     %[[V5:.*]] = arith.cmpf oeq, %[[V0]], %[[V1]] : vector<4xf32>
+// CHECK-DAG:     %[[V6:.*]] = arith.cmpi slt, %[[V2]], %[[V3]] : vector<4xi32>
+// CHECK-DAG:     %[[V7:.*]] = arith.andi %[[V5]], %[[V6]] : vector<4xi1>
+// CHECK-DAG:     %[[V8:.*]] = arith.ori %[[V4]], %[[V7]] : vector<4xi1>
+// CHECK-DAG:     %[[V9:.*]] = arith.select %[[V8]], %[[V0]], %[[V1]] : vector<4xi1>, vector<4xf32>
+// CHECK-DAG:     %[[V10:.*]] = arith.select %[[V8]], %[[V2]], %[[V3]] : vector<4xi1>, vector<4xi32>
+// CHECK-DAG:     vector.shape_cast %[[V9]] : vector<4xf32> to vector<4xf32>
+// CHECK-DAG:     vector.shape_cast %[[V10]] : vector<4xi32> to vector<4xi32>
+func.func public @kernel(%arg0: tensor<2x4xf32>, %arg1: tensor<2x4xi32>) -> (tensor<4xf32>, tensor<4xi32>) {
+  %0:2 = "tt.reduce"(%arg0, %arg1) <{axis = 0 : i32}> ({
+  ^bb0(%arg2: f32, %arg3: i32, %arg4: f32, %arg5: i32):
+    %1 = arith.cmpf olt, %arg2, %arg4 : f32
+    %2 = arith.select %1, %arg2, %arg4 : f32
+    %3 = arith.select %1, %arg3, %arg5 : i32
+    tt.reduce.return %2, %3 : f32, i32
+  }) : (tensor<2x4xf32>, tensor<2x4xi32>) -> (tensor<4xf32>, tensor<4xi32>)
+  return %0#0, %0#1 : tensor<4xf32>, tensor<4xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<4xf32>) -> f32 {
+// CHECK-NOT:     vector.reduction
+// CHECK:         linalg.generic
+// CHECK:           arith.subf
+func.func public @kernel(%arg0: tensor<4xf32>) -> f32 {
+  %0 = "tt.reduce"(%arg0) <{axis = 0 : i32}> ({
+  ^bb0(%arg1: f32, %arg2: f32):
+    %1 = arith.subf %arg1, %arg2 : f32
+    tt.reduce.return %1 : f32
+  }) : (tensor<4xf32>) -> f32
+  return %0 : f32
+}
@@ -1,13 +1,35 @@
-// RUN: structured-opt %s \
+// RUN: structured-opt %s -split-input-file \
 // RUN:   -convert-triton-to-llvm \
 // RUN: | FileCheck %s
 
 // CHECK-LABEL: func.func public @kernel(
 // CHECK-SAME:      %[[ARG0:.*]]: tensor<4xi32>) -> tensor<2x2xi32> {
-// CHECK-NEXT:    %[[V0:.*]] = arith.constant dense<2> : tensor<2xindex>
-// CHECK-NEXT:    %[[V1:.*]] = tensor.reshape %[[ARG0]](%[[V0]]) : (tensor<4xi32>, tensor<2xindex>) -> tensor<2x2xi32>
-// CHECK-NEXT:    return %[[V1]] : tensor<2x2xi32>
+// CHECK-NEXT:    %[[V0:.*]] = tensor.expand_shape %[[ARG0]] {{\[}}[0, 1]] : tensor<4xi32> into tensor<2x2xi32>
+// CHECK-NEXT:    return %[[V0]] : tensor<2x2xi32>
 func.func public @kernel(%arg0: tensor<4xi32>) -> tensor<2x2xi32> {
   %0 = tt.view %arg0 : (tensor<4xi32>) -> tensor<2x2xi32>
   return %0 : tensor<2x2xi32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<2x2x4xi32>) -> tensor<4x4xi32> {
+// CHECK-NEXT:    %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1], [2]] : tensor<2x2x4xi32> into tensor<4x4xi32>
+// CHECK-NEXT:    return %[[V0]] : tensor<4x4xi32>
+func.func public @kernel(%arg0: tensor<2x2x4xi32>) -> tensor<4x4xi32> {
+  %0 = tt.view %arg0 : (tensor<2x2x4xi32>) -> tensor<4x4xi32>
+  return %0 : tensor<4x4xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func public @kernel(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<2x4xi32>) -> tensor<4x2xi32> {
+// CHECK-NEXT:    %[[V0:.*]] = tensor.collapse_shape %[[ARG0]] {{\[}}[0, 1]] : tensor<2x4xi32> into tensor<8xi32>
+// CHECK-NEXT:    %[[V1:.*]] = tensor.expand_shape %[[V0]] {{\[}}[0, 1]] : tensor<8xi32> into tensor<4x2xi32>
+// CHECK-NEXT:    return %[[V1]] : tensor<4x2xi32>
+func.func public @kernel(%arg0: tensor<2x4xi32>) -> tensor<4x2xi32> {
+  %0 = tt.view %arg0 : (tensor<2x4xi32>) -> tensor<4x2xi32>
+  return %0 : tensor<4x2xi32>
+}
@@ -0,0 +1,97 @@
+// RUN: structured-opt %s -iterators-projection-pushdown \
+// RUN: | FileCheck %s
+
+func.func private @is_positive(%tuple : tuple<i32, i64, f64>) -> i1 {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, f64>
+  %zero = arith.constant 0 : i64
+  %cmp = arith.cmpi sgt, %b, %zero : i64
+  return %cmp : i1
+}
+
+func.func private @third(%tuple : tuple<i32, i64, f64>) -> tuple<f64> {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, f64>
+  %result = tuple.from_elements %c : tuple<f64>
+  return %result : tuple<f64>
+}
+
+// CHECK-LABEL: func.func private @is_positive_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<i64, f64>) -> i1 {
+// CHECK-NEXT:    %[[V0:.*]]:2 = tuple.to_elements %[[ARG0]] : tuple<i64, f64>
+// CHECK-NEXT:    %[[V1:.*]] = arith.constant 0 : i64
+// CHECK-NEXT:    %[[V2:.*]] = arith.cmpi sgt, %[[V0]]#0, %[[V1]] : i64
+// CHECK-NEXT:    return %[[V2]] : i1
+
+// CHECK-LABEL: func.func private @third_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<i64, f64>) -> tuple<f64> {
+// CHECK-NEXT:    %[[V0:.*]]:2 = tuple.to_elements %[[ARG0]] : tuple<i64, f64>
+// CHECK-NEXT:    %[[V1:.*]] = tuple.from_elements %[[V0]]#1 : tuple<f64>
+// CHECK-NEXT:    return %[[V1]] : tuple<f64>
+
+// CHECK-LABEL: func.func @filter_and_map(
+func.func @filter_and_map(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64, f64>>
+// CHECK-NEXT:    %[[V0:.*]] = iterators.tabular_view_to_stream %{{.*}} {columnIndices = array<i64: 1, 2>} to !iterators.stream<tuple<i64, f64>> from !tabular.tabular_view<i32, i64, f64>
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_positive}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+// CHECK-NEXT:    %[[V1:.*]] = "iterators.filter"(%[[V0]]) {predicateRef = @is_positive_projected} : (!iterators.stream<tuple<i64, f64>>) -> !iterators.stream<tuple<i64, f64>>
+  %mapped = "iterators.map"(%filtered) {mapFuncRef = @third}
+    : (!iterators.stream<tuple<i32, i64, f64>>) -> (!iterators.stream<tuple<f64>>)
+// CHECK-NEXT:    %[[V2:.*]] = "iterators.map"(%[[V1]]) {mapFuncRef = @third_projected} : (!iterators.stream<tuple<i64, f64>>) -> !iterators.stream<tuple<f64>>
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<f64>>) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @already_projected(
+func.func @already_projected(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                {columnIndices = array<i64: 0, 2>}
+                to !iterators.stream<tuple<i32, f64>>
+                from !tabular.tabular_view<i32, i64, f64>
+// CHECK-NEXT:    %[[V0:.*]] = iterators.tabular_view_to_stream %{{.*}} {columnIndices = array<i64: 2>} to !iterators.stream<tuple<f64>> from !tabular.tabular_view<i32, i64, f64>
+  %mapped = "iterators.map"(%stream) {mapFuncRef = @second}
+    : (!iterators.stream<tuple<i32, f64>>) -> (!iterators.stream<tuple<f64>>)
+// CHECK-NEXT:    %[[V1:.*]] = "iterators.map"(%[[V0]]) {mapFuncRef = @second_projected} : (!iterators.stream<tuple<f64>>) -> !iterators.stream<tuple<f64>>
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<f64>>) -> ()
+  return
+}
+
+func.func private @second(%tuple : tuple<i32, f64>) -> tuple<f64> {
+  %a, %b = tuple.to_elements %tuple : tuple<i32, f64>
+  %result = tuple.from_elements %b : tuple<f64>
+  return %result : tuple<f64>
+}
+
+// CHECK-LABEL: func.func private @second_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<f64>) -> tuple<f64> {
+// CHECK-NEXT:    %[[V0:.*]] = tuple.to_elements %[[ARG0]] : tuple<f64>
+// CHECK-NEXT:    %[[V1:.*]] = tuple.from_elements %[[V0]] : tuple<f64>
+// CHECK-NEXT:    return %[[V1]] : tuple<f64>
+
+func.func private @identity(%tuple : tuple<i32, i64>) -> tuple<i32, i64> {
+  return %tuple : tuple<i32, i64>
+}
+
+// CHECK-LABEL: func.func @opaque_use(
+func.func @opaque_use(%input : !tabular.tabular_view<i32, i64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64>>
+// CHECK-NEXT:    iterators.tabular_view_to_stream %{{.*}} to !iterators.stream<tuple<i32, i64>>{{$}}
+  %mapped = "iterators.map"(%stream) {mapFuncRef = @identity}
+    : (!iterators.stream<tuple<i32, i64>>) -> (!iterators.stream<tuple<i32, i64>>)
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @no_map(
+func.func @no_map(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64, f64>>
+// CHECK-NEXT:    iterators.tabular_view_to_stream %{{.*}} to !iterators.stream<tuple<i32, i64, f64>>{{$}}
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_positive}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+  "iterators.sink"(%filtered) : (!iterators.stream<tuple<i32, i64, f64>>) -> ()
+  return
+}
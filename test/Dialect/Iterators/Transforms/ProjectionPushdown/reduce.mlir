@@ -0,0 +1,100 @@
+// RUN: structured-opt %s -iterators-projection-pushdown \
+// RUN: | FileCheck %s
+
+func.func private @is_positive(%tuple : tuple<i32, i64, f64>) -> i1 {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, f64>
+  %zero = arith.constant 0 : i64
+  %cmp = arith.cmpi sgt, %b, %zero : i64
+  return %cmp : i1
+}
+
+// Sums up the first field and keeps the second one of the left-hand side.
+func.func private @sum_first(%lhs : tuple<i32, i64, f64>,
+                             %rhs : tuple<i32, i64, f64>)
+    -> tuple<i32, i64, f64> {
+  %lhsa, %lhsb, %lhsc = tuple.to_elements %lhs : tuple<i32, i64, f64>
+  %rhsa, %rhsb, %rhsc = tuple.to_elements %rhs : tuple<i32, i64, f64>
+  %a = arith.addi %lhsa, %rhsa : i32
+  %c = arith.constant 0.0 : f64
+  %result = tuple.from_elements %a, %lhsb, %c : tuple<i32, i64, f64>
+  return %result : tuple<i32, i64, f64>
+}
+
+func.func private @first(%tuple : tuple<i32, i64, f64>) -> tuple<i32> {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, f64>
+  %result = tuple.from_elements %a : tuple<i32>
+  return %result : tuple<i32>
+}
+
+// CHECK-LABEL: func.func private @is_positive_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<i32, i64>) -> i1 {
+// CHECK-NEXT:    %[[V0:.*]]:2 = tuple.to_elements %[[ARG0]] : tuple<i32, i64>
+// CHECK-NEXT:    %[[V1:.*]] = arith.constant 0 : i64
+// CHECK-NEXT:    %[[V2:.*]] = arith.cmpi sgt, %[[V0]]#1, %[[V1]] : i64
+// CHECK-NEXT:    return %[[V2]] : i1
+
+// CHECK-LABEL: func.func private @sum_first_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<i32, i64>,
+// CHECK-SAME:      %[[ARG1:.*]]: tuple<i32, i64>) -> tuple<i32, i64> {
+// CHECK-NEXT:    %[[V0:.*]]:2 = tuple.to_elements %[[ARG0]] : tuple<i32, i64>
+// CHECK-NEXT:    %[[V1:.*]]:2 = tuple.to_elements %[[ARG1]] : tuple<i32, i64>
+// CHECK-NEXT:    %[[V2:.*]] = arith.addi %[[V0]]#0, %[[V1]]#0 : i32
+// CHECK-NEXT:    %[[V3:.*]] = arith.constant 0.000000e+00 : f64
+// CHECK-NEXT:    %[[V4:.*]] = tuple.from_elements %[[V2]], %[[V0]]#1 : tuple<i32, i64>
+// CHECK-NEXT:    return %[[V4]] : tuple<i32, i64>
+
+// CHECK-LABEL: func.func private @first_projected(
+// CHECK-SAME:      %[[ARG0:.*]]: tuple<i32, i64>) -> tuple<i32> {
+// CHECK-NEXT:    %[[V0:.*]]:2 = tuple.to_elements %[[ARG0]] : tuple<i32, i64>
+// CHECK-NEXT:    %[[V1:.*]] = tuple.from_elements %[[V0]]#0 : tuple<i32>
+// CHECK-NEXT:    return %[[V1]] : tuple<i32>
+
+// CHECK-LABEL: func.func @filter_and_reduce(
+func.func @filter_and_reduce(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64, f64>>
+// CHECK-NEXT:    %[[V0:.*]] = iterators.tabular_view_to_stream %{{.*}} {columnIndices = array<i64: 0, 1>} to !iterators.stream<tuple<i32, i64>> from !tabular.tabular_view<i32, i64, f64>
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_positive}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+// CHECK-NEXT:    %[[V1:.*]] = "iterators.filter"(%[[V0]]) {predicateRef = @is_positive_projected} : (!iterators.stream<tuple<i32, i64>>) -> !iterators.stream<tuple<i32, i64>>
+  %reduced = "iterators.reduce"(%filtered) {reduceFuncRef = @sum_first}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+// CHECK-NEXT:    %[[V2:.*]] = "iterators.reduce"(%[[V1]]) {reduceFuncRef = @sum_first_projected} : (!iterators.stream<tuple<i32, i64>>) -> !iterators.stream<tuple<i32, i64>>
+  %mapped = "iterators.map"(%reduced) {mapFuncRef = @first}
+    : (!iterators.stream<tuple<i32, i64, f64>>) -> (!iterators.stream<tuple<i32>>)
+// CHECK-NEXT:    %[[V3:.*]] = "iterators.map"(%[[V2]]) {mapFuncRef = @first_projected} : (!iterators.stream<tuple<i32, i64>>) -> !iterators.stream<tuple<i32>>
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<i32>>) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @reduce(
+func.func @reduce(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64, f64>>
+// CHECK-NEXT:    %[[V0:.*]] = iterators.tabular_view_to_stream %{{.*}} {columnIndices = array<i64: 0, 1>} to !iterators.stream<tuple<i32, i64>> from !tabular.tabular_view<i32, i64, f64>
+  %reduced = "iterators.reduce"(%stream) {reduceFuncRef = @sum_first}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+// CHECK-NEXT:    %[[V1:.*]] = "iterators.reduce"(%[[V0]]) {reduceFuncRef = @sum_first_projected{{.*}}} : (!iterators.stream<tuple<i32, i64>>) -> !iterators.stream<tuple<i32, i64>>
+  %mapped = "iterators.map"(%reduced) {mapFuncRef = @first}
+    : (!iterators.stream<tuple<i32, i64, f64>>) -> (!iterators.stream<tuple<i32>>)
+// CHECK-NEXT:    %[[V2:.*]] = "iterators.map"(%[[V1]]) {mapFuncRef = @first_projected{{.*}}} : (!iterators.stream<tuple<i32, i64>>) -> !iterators.stream<tuple<i32>>
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<i32>>) -> ()
+  return
+}
+
+// The sink observes all fields of the reduced tuple, which is the input tuple
+// itself if there is only one.
+// CHECK-LABEL: func.func @reduce_without_map(
+func.func @reduce_without_map(%input : !tabular.tabular_view<i32, i64, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64, f64>>
+// CHECK-NEXT:    iterators.tabular_view_to_stream %{{.*}} to !iterators.stream<tuple<i32, i64, f64>>{{$}}
+  %reduced = "iterators.reduce"(%stream) {reduceFuncRef = @sum_first}
+    : (!iterators.stream<tuple<i32, i64, f64>>)
+        -> (!iterators.stream<tuple<i32, i64, f64>>)
+  "iterators.sink"(%reduced) : (!iterators.stream<tuple<i32, i64, f64>>) -> ()
+  return
+}
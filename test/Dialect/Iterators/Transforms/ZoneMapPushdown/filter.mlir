@@ -0,0 +1,55 @@
+// RUN: structured-opt %s -iterators-zone-map-pushdown \
+// RUN: | FileCheck %s
+
+func.func private @in_range(%tuple : tuple<i32, i64>) -> i1 {
+  %a, %b = tuple.to_elements %tuple : tuple<i32, i64>
+  %c10 = arith.constant 10 : i64
+  %c20 = arith.constant 20 : i64
+  %c30 = arith.constant 30 : i64
+  %c0 = arith.constant 0 : i32
+  %lower = arith.cmpi sgt, %b, %c10 : i64
+  %upper = arith.cmpi sge, %c30, %b : i64
+  %tighter = arith.cmpi slt, %b, %c20 : i64
+  %other = arith.cmpi ne, %a, %c0 : i32
+  %and1 = arith.andi %lower, %upper : i1
+  %and2 = arith.andi %and1, %tighter : i1
+  %and3 = arith.andi %and2, %other : i1
+  return %and3 : i1
+}
+
+// CHECK-LABEL: func.func @main(
+func.func @main(%input : !tabular.tabular_view<i32, i64>,
+                %zonemap : !tabular.zone_map<i64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i64>)
+                {zoneMapColumn = 1 : i64}
+                to !iterators.stream<tuple<i32, i64>>
+// CHECK:         iterators.tabular_view_to_stream
+// CHECK-SAME:      {zoneMapColumn = 1 : i64, zoneMapLowerBound = 10 : i64, zoneMapUpperBound = 20 : i64}
+  %filtered = "iterators.filter"(%stream) {predicateRef = @in_range}
+    : (!iterators.stream<tuple<i32, i64>>) -> (!iterators.stream<tuple<i32, i64>>)
+  "iterators.sink"(%filtered) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  return
+}
+
+func.func private @is_not_zero(%tuple : tuple<i32, i64>) -> i1 {
+  %a, %b = tuple.to_elements %tuple : tuple<i32, i64>
+  %c0 = arith.constant 0 : i64
+  %cmp = arith.cmpi ne, %b, %c0 : i64
+  return %cmp : i1
+}
+
+// CHECK-LABEL: func.func @no_bounds(
+func.func @no_bounds(%input : !tabular.tabular_view<i32, i64>,
+                     %zonemap : !tabular.zone_map<i64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i64>)
+                {zoneMapColumn = 1 : i64}
+                to !iterators.stream<tuple<i32, i64>>
+// CHECK:         iterators.tabular_view_to_stream
+// CHECK-SAME:      {zoneMapColumn = 1 : i64} to
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_not_zero}
+    : (!iterators.stream<tuple<i32, i64>>) -> (!iterators.stream<tuple<i32, i64>>)
+  "iterators.sink"(%filtered) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  return
+}
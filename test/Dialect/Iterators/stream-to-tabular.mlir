@@ -0,0 +1,12 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%stream : !iterators.stream<tuple<i32, f64>>) {
+  // CHECK-LABEL: func.func @main(%{{arg.*}}: !iterators.stream<tuple<i32, f64>>) {
+  %view = iterators.stream_to_tabular %stream
+            to !tabular.tabular_view<i32, f64>
+  // CHECK-NEXT:   %[[V0:totabular.*]] = iterators.stream_to_tabular %[[arg0:.*]] to !tabular.tabular_view<i32, f64>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
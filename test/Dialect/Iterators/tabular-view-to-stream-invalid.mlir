@@ -0,0 +1,126 @@
+// Test error messages of constraints of TabularViewToStreamOp.
+// RUN: structured-opt --verify-diagnostics --split-input-file %s
+
+func.func @testAttributesWithoutZoneMap(%input : !tabular.tabular_view<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has zone map attributes but no zone map}}
+  %stream = iterators.tabular_view_to_stream %input
+                {zoneMapColumn = 0 : i64}
+                to !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testMissingColumn(%input : !tabular.tabular_view<i32>,
+                             %zonemap : !tabular.zone_map<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has a zone map but no 'zoneMapColumn'}}
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i32>)
+                to !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testColumnOutOfBounds(%input : !tabular.tabular_view<i32>,
+                                 %zonemap : !tabular.zone_map<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has 'zoneMapColumn' 1, which is out of bounds for a view with 1 columns}}
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i32>)
+                {zoneMapColumn = 1 : i64}
+                to !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testElementTypeMismatch(%input : !tabular.tabular_view<i32>,
+                                   %zonemap : !tabular.zone_map<i64>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has a zone map with element type 'i64', which does not match the type 'i32' of column 0}}
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i64>)
+                {zoneMapColumn = 0 : i64}
+                to !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testBoundTypeMismatch(%input : !tabular.tabular_view<i32>,
+                                 %zonemap : !tabular.zone_map<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has a zone map bound of type 'i64', which does not match the type 'i32' of column 0}}
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i32>)
+                {zoneMapColumn = 0 : i64, zoneMapUpperBound = 42 : i64}
+                to !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testRowTypeMismatch(%input : !tabular.tabular_view<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op element type of result stream 'tuple<i64>' does not match row type 'tuple<i32>' of input}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    : (!tabular.tabular_view<i32>) -> !iterators.stream<tuple<i64>>
+  return
+}
+
+// -----
+
+func.func @testZoneMapOnChunked(%input : !tabular.chunked_tabular_view<i32>,
+                                %zonemap : !tabular.zone_map<i32>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op does not support zone maps on chunked inputs}}
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<i32>)
+                {zoneMapColumn = 0 : i64}
+                to !iterators.stream<tuple<i32>> chunked
+  return
+}
+
+// -----
+
+func.func @testEncodedRowTypeMismatch(%input : !tabular.tabular_view<!tabular.bit_packed<i32, 4>>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op element type of result stream 'tuple<i64>' does not match row type 'tuple<i32>' of input}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    : (!tabular.tabular_view<!tabular.bit_packed<i32, 4>>) -> !iterators.stream<tuple<i64>>
+  return
+}
+
+// -----
+
+func.func @testEncodedChunked(%input : !tabular.chunked_tabular_view<!tabular.run_length<i32>>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op does not support encoded columns in chunked inputs}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    : (!tabular.chunked_tabular_view<!tabular.run_length<i32>>) -> !iterators.stream<tuple<i32>>
+  return
+}
+
+// -----
+
+func.func @testColumnIndicesNotIncreasing(%input : !tabular.tabular_view<i32, i64>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has 'columnIndices' that are not strictly increasing indices into the 2 columns of the input}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    {columnIndices = array<i64: 1, 0>}
+    : (!tabular.tabular_view<i32, i64>) -> !iterators.stream<tuple<i64, i32>>
+  return
+}
+
+// -----
+
+func.func @testColumnIndicesOutOfBounds(%input : !tabular.tabular_view<i32, i64>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op has 'columnIndices' that are not strictly increasing indices into the 2 columns of the input}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    {columnIndices = array<i64: 2>}
+    : (!tabular.tabular_view<i32, i64>) -> !iterators.stream<tuple<i64>>
+  return
+}
+
+// -----
+
+func.func @testProjectedRowTypeMismatch(%input : !tabular.tabular_view<i32, i64>) {
+  // expected-error@+1 {{'iterators.tabular_view_to_stream' op element type of result stream 'tuple<i32>' does not match row type 'tuple<i64>' of input}}
+  %stream = "iterators.tabular_view_to_stream"(%input)
+    {columnIndices = array<i64: 1>}
+    : (!tabular.tabular_view<i32, i64>) -> !iterators.stream<tuple<i32>>
+  return
+}
@@ -10,3 +10,49 @@ func.func @main(%input : !tabular.tabular_view<i32>) {
 // CHECK-NEXT:    return
 }
 // CHECK-NEXT:  }
+
+func.func @zone_map(%input : !tabular.tabular_view<i32, f64>,
+                    %zonemap : !tabular.zone_map<f64>) {
+  // CHECK-LABEL: func.func @zone_map(%{{arg.*}}: !tabular.tabular_view<i32, f64>, %{{arg.*}}: !tabular.zone_map<f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                zone_map(%zonemap : !tabular.zone_map<f64>)
+                {zoneMapColumn = 1 : i64, zoneMapLowerBound = 1.0 : f64}
+                to !iterators.stream<tuple<i32, f64>>
+// CHECK-NEXT:    %[[V0:fromtabview.*]] = iterators.tabular_view_to_stream %[[arg0:.*]] zone_map(%[[arg1:.*]] : !tabular.zone_map<f64>) {zoneMapColumn = 1 : i64, zoneMapLowerBound = 1.000000e+00 : f64} to !iterators.stream<tuple<i32, f64>>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
+
+func.func @chunked(%input : !tabular.chunked_tabular_view<i32>) {
+  // CHECK-LABEL: func.func @chunked(%{{arg.*}}: !tabular.chunked_tabular_view<i32>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32>> chunked
+// CHECK-NEXT:    %[[V0:fromtabview.*]] = iterators.tabular_view_to_stream %[[arg0:.*]] to !iterators.stream<tuple<i32>> chunked
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
+
+func.func @encoded(%input : !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>) {
+  // CHECK-LABEL: func.func @encoded(%{{arg.*}}: !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>) {
+  %stream = iterators.tabular_view_to_stream %input
+                to !iterators.stream<tuple<i32, i64>>
+                from !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>
+// CHECK-NEXT:    %[[V0:fromtabview.*]] = iterators.tabular_view_to_stream %[[arg0:.*]] to !iterators.stream<tuple<i32, i64>> from !tabular.tabular_view<!tabular.bit_packed<i32, 4>, !tabular.run_length<i64>>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
+
+func.func @projected(%input : !tabular.tabular_view<i32, f64>) {
+  // CHECK-LABEL: func.func @projected(%{{arg.*}}: !tabular.tabular_view<i32, f64>) {
+  %stream = iterators.tabular_view_to_stream %input
+                {columnIndices = array<i64: 1>}
+                to !iterators.stream<tuple<f64>>
+                from !tabular.tabular_view<i32, f64>
+// CHECK-NEXT:    %[[V0:fromtabview.*]] = iterators.tabular_view_to_stream %[[arg0:.*]] {columnIndices = array<i64: 1>} to !iterators.stream<tuple<f64>> from !tabular.tabular_view<i32, f64>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
@@ -0,0 +1,11 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%view : !tabular.tabular_view<i32, f64>) {
+  // CHECK-LABEL: func.func @main(%{{arg.*}}: !tabular.tabular_view<i32, f64>) {
+  tabular.dealloc %view : !tabular.tabular_view<i32, f64>
+  // CHECK-NEXT:    tabular.dealloc %[[arg0:.*]] : !tabular.tabular_view<i32, f64>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
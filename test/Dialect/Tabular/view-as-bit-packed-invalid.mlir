@@ -0,0 +1,20 @@
+// Test error messages of constraints of ViewAsBitPackedOp and BitPackedType.
+// RUN: structured-opt --verify-diagnostics --split-input-file %s
+
+func.func @testTypeMismatch(%words : memref<?xi64>, %reference : i32,
+                            %numrows : i64) {
+  // expected-error@+1 {{'tabular.view_as_bit_packed' op type mismatch: returned column has value type 'i64' but should have type 'i32', the type of the reference value.}}
+  %column = "tabular.view_as_bit_packed"(%words, %reference, %numrows)
+    : (memref<?xi64>, i32, i64) -> !tabular.bit_packed<i64, 7>
+  return
+}
+
+// -----
+
+// expected-error@+1 {{expected bit width between 1 and 8 but got 9}}
+func.func private @testBitWidthTooLarge(!tabular.bit_packed<i8, 9>)
+
+// -----
+
+// expected-error@+1 {{expected integer value type of at most 64 bits but got 'f32'}}
+func.func private @testNonIntegerValueType(!tabular.bit_packed<f32, 8>)
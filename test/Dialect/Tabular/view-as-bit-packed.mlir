@@ -0,0 +1,16 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%words : memref<?xi64>, %reference : i32, %numrows : i64) {
+  // CHECK-LABEL: func.func @main(
+  %column = tabular.view_as_bit_packed %words, %reference, %numrows
+    : (memref<?xi64>, i32, i64) -> !tabular.bit_packed<i32, 7>
+  // CHECK-NEXT:    %[[V0:bitpacked.*]] = tabular.view_as_bit_packed %{{.*}}, %{{.*}}, %{{.*}} : (memref<?xi64>, i32, i64) -> !tabular.bit_packed<i32, 7>
+  %view = tabular.view_as_tabular %column
+    : (!tabular.bit_packed<i32, 7>)
+        -> !tabular.tabular_view<!tabular.bit_packed<i32, 7>>
+  // CHECK-NEXT:    %[[V1:tabularview.*]] = tabular.view_as_tabular %[[V0]] : (!tabular.bit_packed<i32, 7>) -> !tabular.tabular_view<!tabular.bit_packed<i32, 7>>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
@@ -0,0 +1,9 @@
+// Test error messages of constraints of ViewAsChunkedTabularOp.
+// RUN: structured-opt --verify-diagnostics --split-input-file %s
+
+func.func @testTypeMismatch(%view : !tabular.tabular_view<i64>) {
+  // expected-error@+1 {{'tabular.view_as_chunked_tabular' op type mismatch: chunk at index 0 has type '!tabular.tabular_view<i64>' but should have type '!tabular.tabular_view<i32>', the chunk type of the result.}}
+  %chunked = "tabular.view_as_chunked_tabular"(%view)
+    : (!tabular.tabular_view<i64>) -> !tabular.chunked_tabular_view<i32>
+  return
+}
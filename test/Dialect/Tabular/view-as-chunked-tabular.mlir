@@ -0,0 +1,14 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%view1 : !tabular.tabular_view<i32>,
+                %view2 : !tabular.tabular_view<i32>) {
+  // CHECK-LABEL: func.func @main(
+  %chunked = tabular.view_as_chunked_tabular %view1, %view2
+    : (!tabular.tabular_view<i32>, !tabular.tabular_view<i32>)
+        -> !tabular.chunked_tabular_view<i32>
+  // CHECK-NEXT:    %[[V0:chunkedview.*]] = tabular.view_as_chunked_tabular %{{.*}}, %{{.*}} : (!tabular.tabular_view<i32>, !tabular.tabular_view<i32>) -> !tabular.chunked_tabular_view<i32>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
@@ -0,0 +1,27 @@
+// Test error messages of constraints of ViewAsRunLengthOp.
+// RUN: structured-opt --verify-diagnostics --split-input-file %s
+
+func.func @testTypeMismatch(%values : memref<?xi32>, %runends : memref<?xi64>,
+                            %numrows : i64) {
+  // expected-error@+1 {{'tabular.view_as_run_length' op type mismatch: returned column has value type 'i64' but should have type 'i32', the element type of the memref of values.}}
+  %column = "tabular.view_as_run_length"(%values, %runends, %numrows)
+    : (memref<?xi32>, memref<?xi64>, i64) -> !tabular.run_length<i64>
+  return
+}
+
+// -----
+
+func.func @testEncodedColumnMismatch(%column : !tabular.run_length<i32>) {
+  // expected-error@+1 {{'tabular.view_as_tabular' op type mismatch: returned tabular view has column type 'i32' at index 0 but should have type '!tabular.run_length<i32>', the type of the encoded column at the same index.}}
+  %view = "tabular.view_as_tabular"(%column)
+    : (!tabular.run_length<i32>) -> !tabular.tabular_view<i32>
+  return
+}
+
+// -----
+
+func.func @testDeallocEncoded(%view : !tabular.tabular_view<!tabular.run_length<i32>>) {
+  // expected-error@+1 {{'tabular.dealloc' op does not support views with encoded columns}}
+  tabular.dealloc %view : !tabular.tabular_view<!tabular.run_length<i32>>
+  return
+}
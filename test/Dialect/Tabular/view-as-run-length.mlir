@@ -0,0 +1,17 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%values : memref<?xf64>, %runends : memref<?xi64>,
+                %numrows : i64, %other : memref<?xi32>) {
+  // CHECK-LABEL: func.func @main(
+  %column = tabular.view_as_run_length %values, %runends, %numrows
+    : (memref<?xf64>, memref<?xi64>, i64) -> !tabular.run_length<f64>
+  // CHECK-NEXT:    %[[V0:runlength.*]] = tabular.view_as_run_length %{{.*}}, %{{.*}}, %{{.*}} : (memref<?xf64>, memref<?xi64>, i64) -> !tabular.run_length<f64>
+  %view = tabular.view_as_tabular %other, %column
+    : (memref<?xi32>, !tabular.run_length<f64>)
+        -> !tabular.tabular_view<i32, !tabular.run_length<f64>>
+  // CHECK-NEXT:    %[[V1:tabularview.*]] = tabular.view_as_tabular %{{.*}}, %[[V0]] : (memref<?xi32>, !tabular.run_length<f64>) -> !tabular.tabular_view<i32, !tabular.run_length<f64>>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
@@ -0,0 +1,10 @@
+// Test error messages of constraints of ViewAsZoneMapOp.
+// RUN: structured-opt --verify-diagnostics --split-input-file %s
+
+func.func @testTypeMismatch(%mins : memref<?xi32>, %maxs : memref<?xi32>) {
+  %chunksize = arith.constant 1024 : i64
+  // expected-error@+1 {{'tabular.view_as_zone_map' op type mismatch: returned zone map has element type 'i64' but should have type 'i32', the element type of the input memrefs.}}
+  %zonemap = "tabular.view_as_zone_map"(%mins, %maxs, %chunksize)
+    : (memref<?xi32>, memref<?xi32>, i64) -> !tabular.zone_map<i64>
+  return
+}
@@ -0,0 +1,14 @@
+// RUN: structured-opt %s \
+// RUN: | FileCheck %s
+
+func.func @main(%mins : memref<?xi32>, %maxs : memref<?xi32>) {
+  // CHECK-LABEL: func.func @main(
+  %chunksize = arith.constant 1024 : i64
+  // CHECK-NEXT:    %[[V0:.*]] = arith.constant
+  %zonemap = tabular.view_as_zone_map %mins, %maxs, %chunksize
+    : (memref<?xi32>, memref<?xi32>, i64) -> !tabular.zone_map<i32>
+  // CHECK-NEXT:    %[[V1:zonemap.*]] = tabular.view_as_zone_map %{{.*}}, %{{.*}}, %[[V0]] : (memref<?xi32>, memref<?xi32>, i64) -> !tabular.zone_map<i32>
+  return
+// CHECK-NEXT:    return
+}
+// CHECK-NEXT:  }
@@ -0,0 +1,84 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-tabular-to-llvm \
+// RUN:   -convert-iterators-to-llvm \
+// RUN:   -decompose-iterator-states \
+// RUN:   -decompose-tuples \
+// RUN:   -arith-bufferize -cse \
+// RUN:   -expand-strided-metadata \
+// RUN:   -finalize-memref-to-llvm \
+// RUN:   -reconcile-unrealized-casts \
+// RUN:   -convert-func-to-llvm \
+// RUN:   -convert-scf-to-cf -convert-cf-to-llvm \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN: | FileCheck %s
+
+func.func private @is_odd(%tuple : tuple<i32, i64>) -> i1 {
+  %i, %j = tuple.to_elements %tuple : tuple<i32, i64>
+  %one = arith.constant 1 : i32
+  %bit = arith.andi %i, %one : i32
+  %cmp = arith.cmpi eq, %bit, %one : i32
+  return %cmp : i1
+}
+
+func.func @round_trip() {
+  iterators.print("round_trip")
+  %t1 = arith.constant dense<[0, 1, 2, 3, 4, 5]> : tensor<6xi32>
+  %t2 = arith.constant dense<[6, 7, 8, 9, 10, 11]> : tensor<6xi64>
+  %m1 = bufferization.to_memref %t1 : memref<6xi32>
+  %m2 = bufferization.to_memref %t2 : memref<6xi64>
+  %input = tabular.view_as_tabular %m1, %m2
+    : (memref<6xi32>, memref<6xi64>) -> !tabular.tabular_view<i32, i64>
+  %stream = iterators.tabular_view_to_stream %input
+    to !iterators.stream<tuple<i32, i64>>
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_odd}
+    : (!iterators.stream<tuple<i32, i64>>) -> (!iterators.stream<tuple<i32, i64>>)
+  %view = iterators.stream_to_tabular %filtered
+    to !tabular.tabular_view<i32, i64>
+  %result = iterators.tabular_view_to_stream %view
+    to !iterators.stream<tuple<i32, i64>>
+  "iterators.sink"(%result) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  tabular.dealloc %view : !tabular.tabular_view<i32, i64>
+  // CHECK-LABEL: round_trip
+  // CHECK-NEXT:  (1, 7)
+  // CHECK-NEXT:  (3, 9)
+  // CHECK-NEXT:  (5, 11)
+  // CHECK-NEXT:  -
+  return
+}
+
+func.func private @sum(%lhs : tuple<i32>, %rhs : tuple<i32>) -> tuple<i32> {
+  %lhsi = tuple.to_elements %lhs : tuple<i32>
+  %rhsi = tuple.to_elements %rhs : tuple<i32>
+  %i = arith.addi %lhsi, %rhsi : i32
+  %result = tuple.from_elements %i : tuple<i32>
+  return %result : tuple<i32>
+}
+
+// Materializes more rows than the initial capacity to exercise growing.
+func.func @growing() {
+  iterators.print("growing")
+  %t = arith.constant dense<1> : tensor<5000xi32>
+  %m = bufferization.to_memref %t : memref<5000xi32>
+  %input = tabular.view_as_tabular %m
+    : (memref<5000xi32>) -> !tabular.tabular_view<i32>
+  %stream = iterators.tabular_view_to_stream %input
+    to !iterators.stream<tuple<i32>>
+  %view = iterators.stream_to_tabular %stream
+    to !tabular.tabular_view<i32>
+  %rescan = iterators.tabular_view_to_stream %view
+    to !iterators.stream<tuple<i32>>
+  %reduced = "iterators.reduce"(%rescan) {reduceFuncRef = @sum}
+    : (!iterators.stream<tuple<i32>>) -> (!iterators.stream<tuple<i32>>)
+  "iterators.sink"(%reduced) : (!iterators.stream<tuple<i32>>) -> ()
+  tabular.dealloc %view : !tabular.tabular_view<i32>
+  // CHECK-LABEL: growing
+  // CHECK-NEXT:  (5000)
+  // CHECK-NEXT:  -
+  return
+}
+
+func.func @main() {
+  func.call @round_trip() : () -> ()
+  func.call @growing() : () -> ()
+  return
+}
@@ -0,0 +1,67 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-tabular-to-llvm \
+// RUN:   -convert-iterators-to-llvm \
+// RUN:   -decompose-iterator-states \
+// RUN:   -decompose-tuples \
+// RUN:   -arith-bufferize -cse \
+// RUN:   -expand-strided-metadata \
+// RUN:   -finalize-memref-to-llvm \
+// RUN:   -reconcile-unrealized-casts \
+// RUN:   -convert-func-to-llvm \
+// RUN:   -convert-scf-to-cf -convert-cf-to-llvm \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN: | FileCheck %s
+
+func.func @query(%view : !tabular.chunked_tabular_view<i32, i64>) {
+  %stream = iterators.tabular_view_to_stream %view
+    to !iterators.stream<tuple<i32, i64>> chunked
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i32, i64>>) -> ()
+  return
+}
+
+func.func @three_chunks() {
+  iterators.print("three_chunks")
+  %t1 = arith.constant dense<[0, 1]> : tensor<2xi32>
+  %t2 = arith.constant dense<[2, 3]> : tensor<2xi64>
+  %t3 = arith.constant dense<[4]> : tensor<1xi32>
+  %t4 = arith.constant dense<[5]> : tensor<1xi64>
+  %m1 = bufferization.to_memref %t1 : memref<2xi32>
+  %m2 = bufferization.to_memref %t2 : memref<2xi64>
+  %m3 = bufferization.to_memref %t3 : memref<1xi32>
+  %m4 = bufferization.to_memref %t4 : memref<1xi64>
+  %empty1 = memref.alloca() : memref<0xi32>
+  %empty2 = memref.alloca() : memref<0xi64>
+  %view1 = tabular.view_as_tabular %m1, %m2
+    : (memref<2xi32>, memref<2xi64>) -> !tabular.tabular_view<i32, i64>
+  %view2 = tabular.view_as_tabular %empty1, %empty2
+    : (memref<0xi32>, memref<0xi64>) -> !tabular.tabular_view<i32, i64>
+  %view3 = tabular.view_as_tabular %m3, %m4
+    : (memref<1xi32>, memref<1xi64>) -> !tabular.tabular_view<i32, i64>
+  %chunked = tabular.view_as_chunked_tabular %view1, %view2, %view3
+    : (!tabular.tabular_view<i32, i64>, !tabular.tabular_view<i32, i64>,
+       !tabular.tabular_view<i32, i64>)
+        -> !tabular.chunked_tabular_view<i32, i64>
+  func.call @query(%chunked) : (!tabular.chunked_tabular_view<i32, i64>) -> ()
+  // CHECK-LABEL: three_chunks
+  // CHECK-NEXT:  (0, 2)
+  // CHECK-NEXT:  (1, 3)
+  // CHECK-NEXT:  (4, 5)
+  // CHECK-NEXT:  -
+  return
+}
+
+func.func @no_chunks() {
+  iterators.print("no_chunks")
+  %chunked = tabular.view_as_chunked_tabular
+    : () -> !tabular.chunked_tabular_view<i32, i64>
+  func.call @query(%chunked) : (!tabular.chunked_tabular_view<i32, i64>) -> ()
+  // CHECK-LABEL: no_chunks
+  // CHECK-NEXT:  -
+  return
+}
+
+func.func @main() {
+  func.call @three_chunks() : () -> ()
+  func.call @no_chunks() : () -> ()
+  return
+}
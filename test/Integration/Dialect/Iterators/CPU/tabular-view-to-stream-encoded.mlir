@@ -0,0 +1,57 @@
+// RUN: structured-opt %s \
+// RUN:   -convert-tabular-to-llvm \
+// RUN:   -convert-iterators-to-llvm \
+// RUN:   -decompose-iterator-states \
+// RUN:   -decompose-tuples \
+// RUN:   -arith-bufferize -cse \
+// RUN:   -expand-strided-metadata \
+// RUN:   -finalize-memref-to-llvm \
+// RUN:   -reconcile-unrealized-casts \
+// RUN:   -convert-func-to-llvm \
+// RUN:   -convert-scf-to-cf -convert-cf-to-llvm \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN: | FileCheck %s
+
+!view_type = !tabular.tabular_view<!tabular.bit_packed<i32, 16>,
+                                   !tabular.run_length<i64>, i32>
+
+func.func @query(%view : !view_type) {
+  %stream = iterators.tabular_view_to_stream %view
+    to !iterators.stream<tuple<i32, i64, i32>> from !view_type
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i32, i64, i32>>) -> ()
+  return
+}
+
+func.func @main() {
+  // Offsets [0, 2, 1, 0, 15, 3] from reference 5, four per word.
+  %t1 = arith.constant dense<[4295098368, 196623]> : tensor<2xi64>
+  // Runs [1, 1], [2, 2, 2], [3].
+  %t2 = arith.constant dense<[1, 2, 3]> : tensor<3xi64>
+  %t3 = arith.constant dense<[2, 5, 6]> : tensor<3xi64>
+  %t4 = arith.constant dense<[0, 1, 2, 3, 4, 5]> : tensor<6xi32>
+  %m1 = bufferization.to_memref %t1 : memref<2xi64>
+  %m2 = bufferization.to_memref %t2 : memref<3xi64>
+  %m3 = bufferization.to_memref %t3 : memref<3xi64>
+  %m4 = bufferization.to_memref %t4 : memref<6xi32>
+  %words = memref.cast %m1 : memref<2xi64> to memref<?xi64>
+  %values = memref.cast %m2 : memref<3xi64> to memref<?xi64>
+  %runends = memref.cast %m3 : memref<3xi64> to memref<?xi64>
+  %reference = arith.constant 5 : i32
+  %numrows = arith.constant 6 : i64
+  %bitpacked = tabular.view_as_bit_packed %words, %reference, %numrows
+    : (memref<?xi64>, i32, i64) -> !tabular.bit_packed<i32, 16>
+  %runlength = tabular.view_as_run_length %values, %runends, %numrows
+    : (memref<?xi64>, memref<?xi64>, i64) -> !tabular.run_length<i64>
+  %view = tabular.view_as_tabular %bitpacked, %runlength, %m4
+    : (!tabular.bit_packed<i32, 16>, !tabular.run_length<i64>, memref<6xi32>)
+        -> !view_type
+  func.call @query(%view) : (!view_type) -> ()
+  // CHECK:      (5, 1, 0)
+  // CHECK-NEXT: (7, 1, 1)
+  // CHECK-NEXT: (6, 2, 2)
+  // CHECK-NEXT: (5, 2, 3)
+  // CHECK-NEXT: (20, 2, 4)
+  // CHECK-NEXT: (8, 3, 5)
+  // CHECK-NEXT: -
+  return
+}
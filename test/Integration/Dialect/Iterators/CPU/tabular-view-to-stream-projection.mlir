@@ -0,0 +1,52 @@
+// RUN: structured-opt %s \
+// RUN:   -iterators-projection-pushdown \
+// RUN:   -convert-tabular-to-llvm \
+// RUN:   -convert-iterators-to-llvm \
+// RUN:   -decompose-iterator-states \
+// RUN:   -decompose-tuples \
+// RUN:   -arith-bufferize -cse \
+// RUN:   -expand-strided-metadata \
+// RUN:   -finalize-memref-to-llvm \
+// RUN:   -reconcile-unrealized-casts \
+// RUN:   -convert-func-to-llvm \
+// RUN:   -convert-scf-to-cf -convert-cf-to-llvm \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN: | FileCheck %s
+
+func.func private @is_odd(%tuple : tuple<i32, i64, i32>) -> i1 {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, i32>
+  %one = arith.constant 1 : i64
+  %lowest = arith.andi %b, %one : i64
+  %cmp = arith.cmpi eq, %lowest, %one : i64
+  return %cmp : i1
+}
+
+func.func private @third(%tuple : tuple<i32, i64, i32>) -> tuple<i32> {
+  %a, %b, %c = tuple.to_elements %tuple : tuple<i32, i64, i32>
+  %result = tuple.from_elements %c : tuple<i32>
+  return %result : tuple<i32>
+}
+
+func.func @main() {
+  %t1 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi32>
+  %t2 = arith.constant dense<[1, 2, 3, 4]> : tensor<4xi64>
+  %t3 = arith.constant dense<[10, 20, 30, 40]> : tensor<4xi32>
+  %m1 = bufferization.to_memref %t1 : memref<4xi32>
+  %m2 = bufferization.to_memref %t2 : memref<4xi64>
+  %m3 = bufferization.to_memref %t3 : memref<4xi32>
+  %view = tabular.view_as_tabular %m1, %m2, %m3
+    : (memref<4xi32>, memref<4xi64>, memref<4xi32>)
+        -> !tabular.tabular_view<i32, i64, i32>
+  %stream = iterators.tabular_view_to_stream %view
+    to !iterators.stream<tuple<i32, i64, i32>>
+  %filtered = "iterators.filter"(%stream) {predicateRef = @is_odd}
+    : (!iterators.stream<tuple<i32, i64, i32>>)
+        -> (!iterators.stream<tuple<i32, i64, i32>>)
+  %mapped = "iterators.map"(%filtered) {mapFuncRef = @third}
+    : (!iterators.stream<tuple<i32, i64, i32>>) -> (!iterators.stream<tuple<i32>>)
+  "iterators.sink"(%mapped) : (!iterators.stream<tuple<i32>>) -> ()
+  // CHECK:      (10)
+  // CHECK-NEXT: (30)
+  // CHECK-NEXT: -
+  return
+}
@@ -0,0 +1,87 @@
+// RUN: structured-opt %s \
+// RUN:   -iterators-zone-map-pushdown \
+// RUN:   -convert-tabular-to-llvm \
+// RUN:   -convert-iterators-to-llvm \
+// RUN:   -decompose-iterator-states \
+// RUN:   -decompose-tuples \
+// RUN:   -arith-bufferize -cse \
+// RUN:   -expand-strided-metadata \
+// RUN:   -finalize-memref-to-llvm \
+// RUN:   -reconcile-unrealized-casts \
+// RUN:   -convert-func-to-llvm \
+// RUN:   -convert-scf-to-cf -convert-cf-to-llvm \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN: | FileCheck %s
+
+func.func private @in_range(%tuple : tuple<i32>) -> i1 {
+  %value = tuple.to_elements %tuple : tuple<i32>
+  %c3 = arith.constant 3 : i32
+  %c4 = arith.constant 4 : i32
+  %lower = arith.cmpi sge, %value, %c3 : i32
+  %upper = arith.cmpi sle, %value, %c4 : i32
+  %and = arith.andi %lower, %upper : i1
+  return %and : i1
+}
+
+// The scan skips the first and the last chunk; the filter removes the
+// remaining non-matching row of the middle chunk.
+func.func @filtered_scan() {
+  iterators.print("filtered_scan")
+  %t = arith.constant dense<[0, 1, 2, 3, 5, 6, 7]> : tensor<7xi32>
+  %tmins = arith.constant dense<[0, 2, 5, 7]> : tensor<4xi32>
+  %tmaxs = arith.constant dense<[1, 3, 6, 7]> : tensor<4xi32>
+  %m = bufferization.to_memref %t : memref<7xi32>
+  %mins = bufferization.to_memref %tmins : memref<4xi32>
+  %maxs = bufferization.to_memref %tmaxs : memref<4xi32>
+  %chunksize = arith.constant 2 : i64
+  %view = tabular.view_as_tabular %m
+    : (memref<7xi32>) -> !tabular.tabular_view<i32>
+  %zonemap = tabular.view_as_zone_map %mins, %maxs, %chunksize
+    : (memref<4xi32>, memref<4xi32>, i64) -> !tabular.zone_map<i32>
+  %stream = iterators.tabular_view_to_stream %view
+    zone_map(%zonemap : !tabular.zone_map<i32>) {zoneMapColumn = 0 : i64}
+    to !iterators.stream<tuple<i32>>
+  %filtered = "iterators.filter"(%stream) {predicateRef = @in_range}
+    : (!iterators.stream<tuple<i32>>) -> (!iterators.stream<tuple<i32>>)
+  "iterators.sink"(%filtered) : (!iterators.stream<tuple<i32>>) -> ()
+  // CHECK-LABEL: filtered_scan
+  // CHECK-NEXT:  (3)
+  // CHECK-NEXT:  -
+  return
+}
+
+// Only the middle chunks overlap with the bounds, so the scan alone produces
+// their rows, including the ones outside of the bounds.
+func.func @skipping_scan() {
+  iterators.print("skipping_scan")
+  %t = arith.constant dense<[0, 1, 2, 3, 5, 6, 7]> : tensor<7xi32>
+  %tmins = arith.constant dense<[0, 2, 5, 7]> : tensor<4xi32>
+  %tmaxs = arith.constant dense<[1, 3, 6, 7]> : tensor<4xi32>
+  %m = bufferization.to_memref %t : memref<7xi32>
+  %mins = bufferization.to_memref %tmins : memref<4xi32>
+  %maxs = bufferization.to_memref %tmaxs : memref<4xi32>
+  %chunksize = arith.constant 2 : i64
+  %view = tabular.view_as_tabular %m
+    : (memref<7xi32>) -> !tabular.tabular_view<i32>
+  %zonemap = tabular.view_as_zone_map %mins, %maxs, %chunksize
+    : (memref<4xi32>, memref<4xi32>, i64) -> !tabular.zone_map<i32>
+  %stream = iterators.tabular_view_to_stream %view
+    zone_map(%zonemap : !tabular.zone_map<i32>)
+    {zoneMapColumn = 0 : i64,
+     zoneMapLowerBound = 2 : i32, zoneMapUpperBound = 5 : i32}
+    to !iterators.stream<tuple<i32>>
+  "iterators.sink"(%stream) : (!iterators.stream<tuple<i32>>) -> ()
+  // CHECK-LABEL: skipping_scan
+  // CHECK-NEXT:  (2)
+  // CHECK-NEXT:  (3)
+  // CHECK-NEXT:  (5)
+  // CHECK-NEXT:  (6)
+  // CHECK-NEXT:  -
+  return
+}
+
+func.func @main() {
+  func.call @filtered_scan() : () -> ()
+  func.call @skipping_scan() : () -> ()
+  return
+}
@@ -38,6 +38,11 @@ config.substitutions.extend([
 # Python bindings) such that order is not preserved and FileCheck checks fail.
 config.environment['PYTHONUNBUFFERED'] = '1'
 
+# Keep the on-disk cache of compiled Triton kernels in the build tree rather
+# than in the home directory of the user running the tests.
+config.environment['STRUCTURED_TRITON_CACHE_DIR'] = os.path.join(
+    config.test_exec_root, 'triton-cache')
+
 # excludes: A list of directories to exclude from the testsuite. The 'Inputs'
 # subdirectories contain auxiliary inputs for various tests in their parent
 # directories.
@@ -0,0 +1,88 @@
+# RUN: %PYTHON %s | FileCheck %s
+
+import ctypes
+import os
+import subprocess
+import tempfile
+
+import torch
+
+from mlir_structured.triton.aot import AOTKernel, compile_kernels
+from mlir_structured.triton.compiler import get_runtime_libs
+from mlir_structured.triton.jit import jit
+import triton.language as tl
+
+
+def run(f):
+  print("\nTEST:", f.__name__)
+  f()
+  return f
+
+
+@jit
+def add_kernel(x_ptr, y_ptr, n, BLOCK_SIZE: tl.constexpr):
+  pid = tl.program_id(axis=0)
+  offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+  mask = offsets < n
+  x = tl.load(x_ptr + offsets, mask=mask)
+  y = tl.load(y_ptr + offsets, mask=mask)
+  tl.store(x_ptr + offsets, x + y, mask=mask)
+
+
+@jit
+def fill_kernel(ptr, value):
+  pid = tl.program_id(axis=0)
+  tl.store(ptr + pid, value)
+
+
+# CHECK-LABEL: TEST: static_library
+@run
+def static_library():
+  kernels = [
+      AOTKernel(add_kernel, ["*fp32", "*fp32", "i32"], {"BLOCK_SIZE": 4},
+                name="add_f32"),
+      AOTKernel(fill_kernel, {"ptr": "*i64", "value": "i64"}),
+  ]
+
+  with tempfile.TemporaryDirectory() as tmp_dir:
+    archive = os.path.join(tmp_dir, "libkernels.a")
+    header = os.path.join(tmp_dir, "kernels.h")
+    compile_kernels(kernels, archive, header)
+
+    # CHECK:      #ifndef KERNELS_H
+    # CHECK:      void add_f32_grid(int32_t num_programs_x, int32_t num_programs_y, int32_t num_programs_z, float *x_ptr, float *y_ptr, int32_t n);
+    # CHECK:      void add_f32(int32_t program_id_x, int32_t program_id_y, int32_t program_id_z, int32_t num_programs_x, int32_t num_programs_y, int32_t num_programs_z, float *x_ptr, float *y_ptr, int32_t n);
+    # CHECK:      void fill_kernel_grid(int32_t num_programs_x, int32_t num_programs_y, int32_t num_programs_z, int64_t *ptr, int64_t value);
+    # CHECK:      void fill_kernel(int32_t program_id_x, int32_t program_id_y, int32_t program_id_z, int32_t num_programs_x, int32_t num_programs_y, int32_t num_programs_z, int64_t *ptr, int64_t value);
+    with open(header) as f:
+      print(f.read())
+
+    # Link the library into a shared object such that we can call it here.
+    library_path = os.path.join(tmp_dir, "libkernels.so")
+    subprocess.run([
+        "cc", "-shared", "-o", library_path,
+        "-Wl,--whole-archive", archive, "-Wl,--no-whole-archive"
+    ],
+                   check=True)
+    for lib in get_runtime_libs():
+      ctypes.CDLL(lib, mode=ctypes.RTLD_GLOBAL)
+    library = ctypes.CDLL(library_path)
+
+  X = torch.arange(10, dtype=torch.float32)
+  Y = torch.ones(10, dtype=torch.float32)
+  library.add_f32_grid(3, 1, 1, ctypes.c_void_p(X.data_ptr()),
+                       ctypes.c_void_p(Y.data_ptr()), ctypes.c_int32(10))
+
+  # CHECK-LABEL: add_f32
+  # CHECK-NEXT:  tensor([ 1.,  2.,  3.,  4.,  5.,  6.,  7.,  8.,  9., 10.])
+  print("add_f32")
+  print(X)
+
+  Z = torch.zeros(4, dtype=torch.int64)
+  library.fill_kernel_grid(4, 1, 1, ctypes.c_void_p(Z.data_ptr()),
+                           ctypes.c_int64(42))
+
+  # CHECK-LABEL: fill_kernel
+  # CHECK-NEXT:  tensor([42, 42, 42, 42])
+  print("fill_kernel")
+  print(Z)
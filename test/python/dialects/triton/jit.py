@@ -1,5 +1,8 @@
 # RUN: %PYTHON %s | FileCheck %s
 
+import os
+import tempfile
+
 import torch
 
 import mlir_structured
@@ -30,6 +33,66 @@ def addptr_scalar():
   print(X)
 
 
+# CHECK-LABEL: TEST: atomic_add_aggregated
+@run
+def atomic_add_aggregated():
+
+  @jit
+  def kernel(x_ptr, sum_ptr, col_sums_ptr, n):
+    pid = tl.program_id(axis=0)
+    rows = pid * 2 + tl.arange(0, 2)
+    cols = tl.arange(0, 4)
+    offsets = rows[:, None] * 4 + cols[None, :]
+    mask = offsets < n
+    x = tl.load(x_ptr + offsets, mask=mask, other=0)
+    tl.atomic_add(sum_ptr + tl.zeros_like(offsets), x, mask=mask)
+    tl.atomic_add(col_sums_ptr + cols[None, :] + tl.zeros_like(offsets), x)
+
+  X = torch.arange(14, dtype=torch.int32)
+  S = torch.zeros(1, dtype=torch.int32)
+  C = torch.zeros(4, dtype=torch.int32)
+  kernel[(2,)](X, S, C, 14)
+
+  # CHECK-NEXT: tensor([91], dtype=torch.int32)
+  # CHECK-NEXT: tensor([24, 28, 18, 21], dtype=torch.int32)
+  print(S)
+  print(C)
+
+
+# CHECK-LABEL: TEST: autotune_configs
+@run
+def autotune_configs():
+  from mlir_structured.triton.autotuner import Config, autotune
+
+  @autotune(configs=[
+      Config({'BLOCK_SIZE': 4}),
+      Config({'BLOCK_SIZE': 16}, num_threads=2),
+      Config({'BLOCK_SIZE': 8}, num_threads=1, dot_tile_sizes=(2, 8, 2)),
+  ],
+            key=['n'],
+            warmup=1,
+            rep=1)
+  @jit
+  def kernel(x_ptr, y_ptr, n, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.program_id(axis=0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(y_ptr + offsets, x + 1, mask=mask)
+
+  grid = lambda meta: (triton.cdiv(meta['n'], meta['BLOCK_SIZE']),)
+  for n in [10, 100, 100]:
+    X = torch.arange(n, dtype=torch.float32)
+    Y = torch.zeros(n, dtype=torch.float32)
+    kernel[grid](X, Y, n)
+    print(torch.equal(Y, X + 1))
+
+  # CHECK-NEXT: True
+  # CHECK-NEXT: True
+  # CHECK-NEXT: True
+  # CHECK-NEXT: 2 True
+  print(len(kernel.cache), kernel.best_config in kernel.configs)
+
+
 @jit
 def times_two(x):
   return x + x
@@ -52,6 +115,43 @@ def call_other_kernel():
   print(X)
 
 
+# CHECK-LABEL: TEST: concurrent_launches
+@run
+def concurrent_launches():
+  import threading
+  from mlir_structured.triton.launcher import configure
+
+  @jit
+  def kernel(ptr, value):
+    pid = tl.program_id(axis=0)
+    tl.store(ptr + pid, pid + value)
+
+  # Launch from two Python threads at the same time, which share the workers
+  # of the launcher (and run while the GIL is released).
+  configure(num_threads=4)
+  results = [None, None]
+
+  def launch(idx):
+    X = torch.tensor([-1] * 1000, dtype=torch.int32)
+    ok = True
+    for value in range(50):
+      kernel[(1000,)](X, value + idx * 1000)
+      ok &= torch.equal(X, torch.arange(1000).int() + value + idx * 1000)
+    results[idx] = ok
+
+  # Compile the kernel first such that both threads only launch it.
+  kernel[(1000,)](torch.empty(1000, dtype=torch.int32), 0)
+  threads = [threading.Thread(target=launch, args=(idx,)) for idx in range(2)]
+  for thread in threads:
+    thread.start()
+  for thread in threads:
+    thread.join()
+  configure()
+
+  # CHECK-NEXT: [True, True]
+  print(results)
+
+
 # CHECK-LABEL: TEST: dot
 @run
 def dot():
@@ -85,6 +185,73 @@ def dot():
   print(torch.sum(C))
 
 
+# CHECK-LABEL: TEST: grid_launcher
+@run
+def grid_launcher():
+  from mlir_structured.triton.launcher import configure, get_launcher
+
+  @jit
+  def kernel(ptr):
+    x = tl.program_id(axis=0)
+    y = tl.program_id(axis=1)
+    tl.store(ptr + y * 100 + x, x + y * 100)
+
+  # Many small programs, batched into tasks of several programs each.
+  for num_threads, grain_size in [(1, 0), (4, 0), (4, 7)]:
+    launcher = configure(num_threads=num_threads, grain_size=grain_size)
+    X = torch.tensor([-1] * 10000, dtype=torch.int32)
+    kernel[(100, 100)](X)
+    print(launcher.num_threads, torch.equal(X, torch.arange(10000).int()))
+
+  # CHECK-NEXT: 1 True
+  # CHECK-NEXT: 4 True
+  # CHECK-NEXT: 4 True
+  configure()
+  assert get_launcher().grain_size == 0
+
+
+# CHECK-LABEL: TEST: kernel_cache
+@run
+def kernel_cache():
+  from mlir_structured.triton import cache
+
+  def kernel(ptr):
+    x = tl.load(ptr)
+    tl.store(ptr, x + 1)
+
+  # Count the kernels loaded from the on-disk cache.
+  load_kernel = cache.load_kernel
+  num_loaded = 0
+
+  def counting_load_kernel(*args):
+    nonlocal num_loaded
+    loaded = load_kernel(*args)
+    num_loaded += loaded is not None
+    return loaded
+
+  cache.load_kernel = counting_load_kernel
+  old_cache_dir = os.environ.get("STRUCTURED_TRITON_CACHE_DIR")
+  with tempfile.TemporaryDirectory() as cache_dir:
+    os.environ["STRUCTURED_TRITON_CACHE_DIR"] = cache_dir
+    X = torch.tensor([40], dtype=torch.int32)
+    # Each `jit` has its own in-memory cache, so the second one has to look
+    # into the on-disk cache, which contains the kernel compiled by the first.
+    jit(kernel)[(1,)](X)
+    print(num_loaded)
+    jit(kernel)[(1,)](X)
+    print(num_loaded, cache.get_num_load_failures())
+  if old_cache_dir is None:
+    del os.environ["STRUCTURED_TRITON_CACHE_DIR"]
+  else:
+    os.environ["STRUCTURED_TRITON_CACHE_DIR"] = old_cache_dir
+  cache.load_kernel = load_kernel
+
+  # CHECK-NEXT: 0
+  # CHECK-NEXT: 1 0
+  # CHECK-NEXT: tensor([42], dtype=torch.int32)
+  print(X)
+
+
 # CHECK-LABEL: TEST: load_store_scalar
 @run
 def load_store_scalar():
@@ -224,6 +391,35 @@ def reduce_combine_func():
   print(B)
 
 
+# CHECK-LABEL: TEST: reduce_max_argmax
+@run
+def reduce_max_argmax():
+
+  @jit
+  def kernel(x_ptr, max_ptr, argmax_ptr, min_ptr):
+    r = tl.arange(0, 8)
+    r = tl.view(r, (2, 4))
+    x = tl.load(x_ptr + r)
+    r = tl.arange(0, 2)
+    tl.store(max_ptr + r, tl.max(x, axis=1))
+    tl.store(argmax_ptr + r, tl.argmax(x, axis=1))
+    tl.store(min_ptr + r, tl.sum(tl.min(x, axis=0), axis=0) + r)
+
+  # Negative values catch reductions that start from zero.
+  X = torch.tensor([-5, -2, -7, -2, 3, 1, 3, 0], dtype=torch.float32)
+  MAX = torch.tensor([0] * 2, dtype=torch.float32)
+  ARGMAX = torch.tensor([0] * 2, dtype=torch.int32)
+  MIN = torch.tensor([0] * 2, dtype=torch.float32)
+  kernel[(1,)](X, MAX, ARGMAX, MIN)
+
+  # CHECK-NEXT: tensor([-2.,  3.])
+  # CHECK-NEXT: tensor([1, 0], dtype=torch.int32)
+  # CHECK-NEXT: tensor([-16., -15.])
+  print(MAX)
+  print(ARGMAX)
+  print(MIN)
+
+
 # CHECK-LABEL: TEST: reduce_sum_axis
 @run
 def reduce_sum_axis():
@@ -269,6 +465,26 @@ def reduce_sum_noaxis():
   print(Y)
 
 
+# CHECK-LABEL: TEST: scalar_args
+@run
+def scalar_args():
+
+  @jit
+  def kernel(x_ptr, y_ptr, a, b, c):
+    r = tl.arange(0, 4)
+    tl.store(x_ptr + r, r * a + b)
+    tl.store(y_ptr + r, r + c)
+
+  X = torch.zeros(4, dtype=torch.float32)
+  Y = torch.zeros(4, dtype=torch.int64)
+  kernel[(1,)](X, Y, 3, 0.5, 2**40)
+
+  # CHECK-NEXT: tensor([0.5000, 3.5000, 6.5000, 9.5000])
+  # CHECK-NEXT: tensor([1099511627776, 1099511627777, 1099511627778, 1099511627779])
+  print(X)
+  print(Y)
+
+
 # CHECK-LABEL: TEST: view_op
 @run
 def view_op():